@@ -0,0 +1,351 @@
+/**
+ * @file allocation_tracker.cpp
+ * @brief AllocationTracker class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "allocation_tracker.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#include "structs/allocation_stats/allocation_stats.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		// Everything is static storage so that counting never allocates.
+		std::atomic<unsigned long> allocations[AllocationTracker::MAX_TAGS];
+		std::atomic<unsigned long> bytes[AllocationTracker::MAX_TAGS];
+		std::atomic<unsigned long> frees[AllocationTracker::MAX_TAGS];
+		AllocationStats last_frame[AllocationTracker::MAX_TAGS];
+		const char *tags[AllocationTracker::MAX_TAGS] = { "untagged" };
+		std::atomic<int> num_tags(1);
+		std::mutex tags_mutex;
+		thread_local int active_tag = 0;
+
+		long budget = -1;
+		long warmup = 0;
+		long frames = 0;
+
+	}
+
+	void AllocationTracker::beginFrame() {
+
+		for (int i = 0; i < MAX_TAGS; i++) {
+
+			allocations[i].store(0, std::memory_order_relaxed);
+			bytes[i].store(0, std::memory_order_relaxed);
+			frees[i].store(0, std::memory_order_relaxed);
+
+		}
+
+	}
+
+	bool AllocationTracker::endFrame() {
+
+		// Keep the counters of this frame for the report.
+		int count = num_tags.load(std::memory_order_acquire);
+		unsigned long total = 0;
+		for (int i = 0; i < count; i++) {
+
+			last_frame[i].tag = tags[i];
+			last_frame[i].allocations = allocations[i].load(std::memory_order_relaxed);
+			last_frame[i].bytes = bytes[i].load(std::memory_order_relaxed);
+			last_frame[i].frees = frees[i].load(std::memory_order_relaxed);
+			total += last_frame[i].allocations;
+
+		}
+
+		// Loading and the first frames are allowed to allocate.
+		frames++;
+		if (budget < 0 || frames <= warmup)
+			return true;
+
+		return total <= (unsigned long) budget;
+
+	}
+
+	AllocationStats AllocationTracker::getStats(int index) {
+
+		return last_frame[index];
+
+	}
+
+	AllocationStats AllocationTracker::getTotal() {
+
+		AllocationStats total = { "total", 0, 0, 0 };
+		for (int i = 0; i < getNumTags(); i++) {
+
+			total.allocations += last_frame[i].allocations;
+			total.bytes += last_frame[i].bytes;
+			total.frees += last_frame[i].frees;
+
+		}
+
+		return total;
+
+	}
+
+	int AllocationTracker::getNumTags() {
+
+		return num_tags.load(std::memory_order_acquire);
+
+	}
+
+	bool AllocationTracker::isEnabled() {
+
+#ifdef BGQ_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+
+	}
+
+	void AllocationTracker::recordAllocation(std::size_t size) {
+
+		allocations[active_tag].fetch_add(1, std::memory_order_relaxed);
+		bytes[active_tag].fetch_add(size, std::memory_order_relaxed);
+
+	}
+
+	void AllocationTracker::recordFree() {
+
+		frees[active_tag].fetch_add(1, std::memory_order_relaxed);
+
+	}
+
+	void AllocationTracker::setBudget(long max_allocations, long warmup_frames) {
+
+		budget = max_allocations;
+		warmup = warmup_frames;
+
+	}
+
+	int AllocationTracker::getTag(const char *tag) {
+
+		// Look for it without locking, as tags are only ever appended.
+		int count = num_tags.load(std::memory_order_acquire);
+		for (int i = 0; i < count; i++)
+			if (tags[i] == tag)
+				return i;
+
+		// Register it. When there is no room left it counts as untagged.
+		std::lock_guard<std::mutex> lock(tags_mutex);
+		count = num_tags.load(std::memory_order_relaxed);
+		for (int i = 0; i < count; i++)
+			if (tags[i] == tag)
+				return i;
+
+		if (count == MAX_TAGS)
+			return 0;
+
+		tags[count] = tag;
+		num_tags.store(count + 1, std::memory_order_release);
+
+		return count;
+
+	}
+
+	AllocationScope::AllocationScope(const char *tag) {
+
+#ifdef BGQ_TRACK_ALLOCATIONS
+		this->previous = active_tag;
+		active_tag = AllocationTracker::getTag(tag);
+#else
+		(void) tag;
+#endif
+
+	}
+
+	AllocationScope::~AllocationScope() {
+
+#ifdef BGQ_TRACK_ALLOCATIONS
+		active_tag = this->previous;
+#endif
+
+	}
+
+}  // namespace bgq_opengl
+
+#ifdef BGQ_TRACK_ALLOCATIONS
+
+// Replace the global allocation functions so every allocation is counted. The
+// array, nothrow, sized and aligned versions are replaced too, as their defaults
+// do not necessarily go through these ones.
+
+namespace {
+
+	// Over-aligned blocks come from posix_memalign, which std::free releases like any other.
+	void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+
+		bgq_opengl::AllocationTracker::recordAllocation(size);
+		std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+		void *ptr = nullptr;
+		if (posix_memalign(&ptr, align, size ? size : 1) != 0)
+			return nullptr;
+
+		return ptr;
+
+	}
+
+}
+
+void* operator new(std::size_t size) {
+
+	bgq_opengl::AllocationTracker::recordAllocation(size);
+	if (void *ptr = std::malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+
+}
+
+void* operator new[](std::size_t size) {
+
+	bgq_opengl::AllocationTracker::recordAllocation(size);
+	if (void *ptr = std::malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+
+	bgq_opengl::AllocationTracker::recordAllocation(size);
+	return std::malloc(size ? size : 1);
+
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+
+	bgq_opengl::AllocationTracker::recordAllocation(size);
+	return std::malloc(size ? size : 1);
+
+}
+
+void operator delete(void *ptr) noexcept {
+
+	if (ptr)
+		bgq_opengl::AllocationTracker::recordFree();
+	std::free(ptr);
+
+}
+
+void operator delete[](void *ptr) noexcept {
+
+	if (ptr)
+		bgq_opengl::AllocationTracker::recordFree();
+	std::free(ptr);
+
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+
+	operator delete(ptr);
+
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+
+	operator delete[](ptr);
+
+}
+
+void operator delete(void *ptr, const std::nothrow_t&) noexcept {
+
+	operator delete(ptr);
+
+}
+
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept {
+
+	operator delete[](ptr);
+
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+
+	if (void *ptr = allocateAligned(size, alignment))
+		return ptr;
+
+	throw std::bad_alloc();
+
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+
+	if (void *ptr = allocateAligned(size, alignment))
+		return ptr;
+
+	throw std::bad_alloc();
+
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+
+	return allocateAligned(size, alignment);
+
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+
+	return allocateAligned(size, alignment);
+
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+
+	operator delete(ptr);
+
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+
+	operator delete[](ptr);
+
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+
+	operator delete(ptr);
+
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+
+	operator delete[](ptr);
+
+}
+
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+
+	operator delete(ptr);
+
+}
+
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+
+	operator delete[](ptr);
+
+}
+
+#endif  // BGQ_TRACK_ALLOCATIONS
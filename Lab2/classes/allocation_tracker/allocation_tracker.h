@@ -0,0 +1,183 @@
+/**
+ * @file allocation_tracker.h
+ * @brief AllocationTracker class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_ALLOCATIONTRACKER_H_
+#define BGQ_OPENGL_CLASSES_ALLOCATIONTRACKER_H_
+
+#include <cstddef>
+
+#include "structs/allocation_stats/allocation_stats.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of an AllocationTracker class.
+	 *
+	 * Counts the heap allocations of every frame, split by the AllocationScope
+	 * that was active when they happened. The counting only exists when the
+	 * program is built with BGQ_TRACK_ALLOCATIONS defined, which replaces the
+	 * global operator new and delete. Otherwise every function does nothing.
+	 *
+	 * The tracker itself never allocates, so it can be called from the hooks.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class AllocationTracker {
+
+		public:
+
+			static const int MAX_TAGS = 16;	/// Maximum number of different scopes.
+
+			/**
+			 * @brief Starts a new frame.
+			 *
+			 * Resets the counters of the current frame.
+			 */
+			static void beginFrame();
+
+			/**
+			 * @brief Ends the current frame.
+			 *
+			 * Keeps the counters of the frame so they can be reported, and checks
+			 * them against the budget once the warm up frames have passed.
+			 *
+			 * @returns True if the frame is within the budget. False otherwise.
+			 */
+			static bool endFrame();
+
+			/**
+			 * @brief Get the counters of the last frame.
+			 *
+			 * Get the counters of one of the scopes in the last frame.
+			 *
+			 * @param index The index of the scope, up to getNumTags.
+			 *
+			 * @returns The counters struct.
+			 */
+			static AllocationStats getStats(int index);
+
+			/**
+			 * @brief Get the counters of the whole last frame.
+			 *
+			 * Get the counters of all the scopes in the last frame added up.
+			 *
+			 * @returns The counters struct.
+			 */
+			static AllocationStats getTotal();
+
+			/**
+			 * @brief Get the number of scopes.
+			 *
+			 * Get the number of different scopes seen so far, including the
+			 * allocations made outside any scope.
+			 *
+			 * @returns The number of scopes.
+			 */
+			static int getNumTags();
+
+			/**
+			 * @brief Whether the tracking is compiled in.
+			 *
+			 * Whether the program was built with BGQ_TRACK_ALLOCATIONS.
+			 *
+			 * @returns True if the allocations are being tracked.
+			 */
+			static bool isEnabled();
+
+			/**
+			 * @brief Records an allocation.
+			 *
+			 * Records an allocation in the active scope. Called by operator new.
+			 *
+			 * @param size The bytes requested.
+			 */
+			static void recordAllocation(std::size_t size);
+
+			/**
+			 * @brief Records a deallocation.
+			 *
+			 * Records a deallocation in the active scope. Called by operator delete.
+			 */
+			static void recordFree();
+
+			/**
+			 * @brief Sets the allocation budget.
+			 *
+			 * Sets the maximum number of allocations a frame can make once the
+			 * program has warmed up.
+			 *
+			 * @param max_allocations The maximum allocations per frame, or -1 for no budget.
+			 * @param warmup_frames The number of frames that are not checked.
+			 */
+			static void setBudget(long max_allocations, long warmup_frames);
+
+		private:
+
+			friend class AllocationScope;
+
+			/**
+			 * @brief Gets the index of a scope.
+			 *
+			 * Gets the index of a scope, registering it the first time it is seen.
+			 * Tags are compared by address, so they should be string literals.
+			 *
+			 * @param tag The name of the scope.
+			 *
+			 * @returns The index of the scope.
+			 */
+			static int getTag(const char *tag);
+
+	};
+
+	/**
+	 * @brief Implementation of an AllocationScope class.
+	 *
+	 * Tags the allocations made while it is alive, in the thread that created it,
+	 * with its name. Scopes can be nested; the innermost one gets the allocations.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class AllocationScope {
+
+		public:
+
+			/**
+			 * @brief Opens the scope.
+			 *
+			 * Makes this scope the active one.
+			 *
+			 * @param tag The name of the scope. It has to outlive the program, like a string literal.
+			 */
+			AllocationScope(const char *tag);
+
+			/**
+			 * @brief Closes the scope.
+			 *
+			 * Makes the previous scope the active one again.
+			 */
+			~AllocationScope();
+
+			AllocationScope(const AllocationScope&) = delete;
+			AllocationScope& operator=(const AllocationScope&) = delete;
+
+		private:
+
+			int previous = 0;	/// Scope that was active before this one.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_ALLOCATIONTRACKER_H_
@@ -0,0 +1,372 @@
+/**
+ * @file asset_loader.cpp
+ * @brief AssetLoader class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "asset_loader.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <filesystem>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/cubemap/cubemap.h"
+#include "classes/cubemap_filter/cubemap_filter.h"
+#include "classes/texture_file/texture_file.h"
+#include "classes/loader/loader.h"
+#include "classes/loader_assimp/loader_assimp.h"
+#include "classes/object/object.h"
+#include "classes/spherical_harmonics/spherical_harmonics.h"
+#include "classes/thread_pool/thread_pool.h"
+#include "structs/asset_timing/asset_timing.h"
+#include "structs/image_data/image_data.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
+
+namespace bgq_opengl {
+
+	AssetLoader::AssetLoader(std::chrono::steady_clock::time_point origin, unsigned int num_threads) : ready(MAX_ASSETS), pool(num_threads) {
+
+		this->origin = origin;
+		this->assets.reserve(MAX_ASSETS);
+		this->timeline.reserve(MAX_ASSETS);
+
+	}
+
+	int AssetLoader::addCubemap(const std::vector<std::string> &textures_faces, const char *type, GLuint slot) {
+
+		assert(this->assets.size() < MAX_ASSETS);
+
+		int index = (int) this->assets.size();
+		this->assets.push_back(std::make_unique<PendingAsset>());
+		PendingAsset *asset = this->assets.back().get();
+		asset->name = type;
+		asset->face_files = textures_faces;
+		asset->faces = std::vector<ImageData>(textures_faces.size());
+		asset->slot = slot;
+		asset->job_start = std::vector<double>(textures_faces.size(), 0.0);
+		asset->job_end = std::vector<double>(textures_faces.size(), 0.0);
+		asset->remaining.store((int) textures_faces.size());
+		asset->decoding.store((int) textures_faces.size());
+		asset->failed.store(false);
+
+		// A baked cubemap only has to be read in, which is a single job.
+		std::string baked_filename = TextureFile::getBakedFilename(textures_faces[0], ".cubemap");
+		std::error_code error;
+		if (std::filesystem::exists(baked_filename, error)) {
+
+			asset->job_start.resize(1);
+			asset->job_end.resize(1);
+			asset->remaining.store(1);
+
+			this->pool.submit([this, asset, index, baked_filename] {
+
+				double start = this->getTime();
+				asset->baked = std::make_unique<TextureFile>(baked_filename);
+				if ((*asset->baked).isOpen() && (*asset->baked).isSupported() && (*asset->baked).getNumFaces() == 6) {
+
+					(*asset->baked).prefetch();
+
+				} else {
+
+					// Not a baked file this context can use, so decode the faces after all.
+					asset->baked.reset();
+					for (size_t i = 0; i < asset->face_files.size(); i++)
+						if (!Cubemap::loadFace(asset->face_files[i], &asset->faces[i]))
+							asset->failed.store(true);
+
+				}
+				if (!asset->failed.load())
+					this->prepareLighting(asset);
+				this->endJob(asset, index, 0, start);
+
+			});
+
+			return index;
+
+		}
+
+		// Every face is decoded on its own, so one cubemap keeps several workers busy.
+		for (int i = 0; i < (int) textures_faces.size(); i++) {
+
+			this->pool.submit([this, asset, index, i] {
+
+				double start = this->getTime();
+				if (!Cubemap::loadFace(asset->face_files[i], &asset->faces[i]))
+					asset->failed.store(true);
+				else if (asset->decoding.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					this->prepareLighting(asset);
+				this->endJob(asset, index, i, start);
+
+			});
+
+		}
+
+		return index;
+
+	}
+
+	int AssetLoader::addModel(const char *filename, const char *filetype, const char *cache_directory) {
+
+		assert(this->assets.size() < MAX_ASSETS);
+
+		int index = (int) this->assets.size();
+		this->assets.push_back(std::make_unique<PendingAsset>());
+		PendingAsset *asset = this->assets.back().get();
+		asset->name = filename;
+		asset->job_start = std::vector<double>(1, 0.0);
+		asset->job_end = std::vector<double>(1, 0.0);
+		asset->remaining.store(1);
+		asset->failed.store(false);
+
+		// Choose the specific loader type.
+		if (strcmp(filetype, "Assimp") == 0) {
+
+			asset->model_loader = std::make_unique<LoaderAssimp>(filename, cache_directory);
+
+		} else {
+
+			assert(false);
+			exit(1);
+
+		}
+
+		// Import it, convert the vertices and get the bounds, all away from the OpenGL thread.
+		this->pool.submit([this, asset, index] {
+
+			double start = this->getTime();
+			(*asset->model_loader).loadModel();
+			this->endJob(asset, index, 0, start);
+
+		});
+
+		return index;
+
+	}
+
+	void AssetLoader::endJob(PendingAsset *asset, int index, int job, double start) {
+
+		asset->job_start[job] = start;
+		asset->job_end[job] = this->getTime();
+
+		// The last job to end hands the asset over. The counter orders the writes of every job before the upload.
+		if (asset->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		// The queue has a slot per asset, so it cannot be full.
+		this->ready.push(index);
+		this->completed.fetch_add(1, std::memory_order_release);
+		this->completed.notify_one();
+
+	}
+
+	void AssetLoader::finish() {
+
+		size_t uploaded = this->timeline.size();
+		while (uploaded < this->assets.size()) {
+
+			// Read the counter before draining, so an asset pushed after the queue looks empty still wakes us up.
+			unsigned int seen = this->completed.load(std::memory_order_acquire);
+
+			int index;
+			while (this->ready.pop(&index)) {
+
+				this->upload(index);
+				uploaded++;
+
+			}
+
+			if (uploaded < this->assets.size())
+				this->completed.wait(seen, std::memory_order_acquire);
+
+		}
+
+	}
+
+	double AssetLoader::getTime() {
+
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - this->origin;
+
+		return elapsed.count();
+
+	}
+
+	std::span<const AssetTiming> AssetLoader::getTimeline() {
+
+		return this->timeline;
+
+	}
+
+	void AssetLoader::prepareLighting(PendingAsset *asset) {
+
+		// The caches have to match the first level, whichever way it was loaded.
+		int size = asset->baked ? (*asset->baked).getWidth(0) : asset->faces[0].width;
+		GLenum internal_format = asset->baked ? (*asset->baked).getInternalFormat() : GL_RGB;
+		std::string filename = CubemapFilter::getCacheFilename(asset->face_files[0]);
+		std::string irradiance_filename = SphericalHarmonics::getCacheFilename(asset->face_files[0]);
+		bool projected = SphericalHarmonics::load(irradiance_filename, size, &asset->irradiance);
+		asset->prefiltered = std::make_unique<TextureFile>(filename);
+		if (CubemapFilter::isCacheValid(*asset->prefiltered, size, internal_format)) {
+
+			(*asset->prefiltered).prefetch();
+			if (projected)
+				return;
+
+		} else {
+
+			asset->prefiltered.reset();
+
+		}
+
+		// Build the missing caches from the faces, which a baked cubemap has to decode first.
+		bool decoded = true;
+		if (asset->baked)
+			for (size_t i = 0; i < asset->face_files.size(); i++)
+				decoded = Cubemap::loadFace(asset->face_files[i], &asset->faces[i]) && decoded;
+
+		if (decoded && !asset->prefiltered && CubemapFilter::prefilter(asset->faces, filename, internal_format, 0)) {
+
+			asset->prefiltered = std::make_unique<TextureFile>(filename);
+			if (!CubemapFilter::isCacheValid(*asset->prefiltered, size, internal_format))
+				asset->prefiltered.reset();
+
+		}
+
+		if (decoded && !projected && SphericalHarmonics::project(asset->faces, 0, &asset->irradiance)) {
+
+			projected = true;
+			if (!SphericalHarmonics::save(irradiance_filename, size, asset->irradiance))
+				std::cerr << "Cubemap warning: " << irradiance_filename << " could not be written." << std::endl;
+
+		}
+
+		if (!asset->prefiltered)
+			std::cerr << "Cubemap warning: " << filename << " could not be built, so " << asset->name << " keeps its box filtered levels." << std::endl;
+
+		if (!projected) {
+
+			std::cerr << "Cubemap warning: " << irradiance_filename << " could not be built, so " << asset->name << " lights evenly in white." << std::endl;
+			asset->irradiance = SphericalHarmonics::getFlat();
+
+		}
+
+		// A baked cubemap does not need its faces.
+		if (asset->baked)
+			asset->faces = std::vector<ImageData>(asset->faces.size());
+
+	}
+
+	void AssetLoader::printTimeline() {
+
+		std::cerr << "Startup timeline (ms since start, " << this->pool.getNumThreads() << " workers):" << std::endl;
+		for (size_t i = 0; i < this->timeline.size(); i++) {
+
+			const AssetTiming &timing = this->timeline[i];
+			char line[256];
+			snprintf(line, sizeof(line), "  %-20s %d job%s  load %8.1f - %8.1f (%8.1f busy)  upload %8.1f - %8.1f",
+					 timing.name.c_str(), timing.jobs, timing.jobs == 1 ? " " : "s", timing.load_start, timing.load_end,
+					 timing.load_time, timing.upload_start, timing.upload_end);
+			std::cerr << line << std::endl;
+
+		}
+
+	}
+
+	Cubemap AssetLoader::takeCubemap(int handle) {
+
+		assert(this->assets[handle]->cubemap);
+
+		Cubemap cubemap = std::move(*this->assets[handle]->cubemap);
+		this->assets[handle]->cubemap.reset();
+
+		return cubemap;
+
+	}
+
+	Object AssetLoader::takeObject(int handle) {
+
+		assert(this->assets[handle]->object);
+
+		Object object = std::move(*this->assets[handle]->object);
+		this->assets[handle]->object.reset();
+
+		return object;
+
+	}
+
+	void AssetLoader::upload(int index) {
+
+		PendingAsset *asset = this->assets[index].get();
+
+		if (asset->failed.load()) {
+
+			std::cerr << "Asset error: " << asset->name << " could not be loaded." << std::endl;
+			exit(1);
+
+		}
+
+		AssetTiming timing;
+		timing.name = asset->name;
+		timing.jobs = (int) asset->job_start.size();
+		timing.load_start = *std::min_element(asset->job_start.begin(), asset->job_start.end());
+		timing.load_end = *std::max_element(asset->job_end.begin(), asset->job_end.end());
+		timing.load_time = 0.0;
+		for (int i = 0; i < timing.jobs; i++)
+			timing.load_time += asset->job_end[i] - asset->job_start[i];
+
+		// Upload it, and free what is not needed any more.
+		timing.upload_start = this->getTime();
+		if (asset->model_loader) {
+
+			asset->object = std::make_unique<Object>(*asset->model_loader);
+			asset->model_loader.reset();
+
+		} else if (asset->baked) {
+
+			asset->cubemap = std::make_unique<Cubemap>(*asset->baked, asset->name.c_str(), asset->slot);
+			asset->baked.reset();
+
+		} else {
+
+			asset->cubemap = std::make_unique<Cubemap>(asset->faces, asset->name.c_str(), asset->slot);
+			asset->faces.clear();
+
+		}
+
+		// Give the cubemaps their glossy levels and their diffuse light.
+		if (asset->prefiltered) {
+
+			(*asset->cubemap).setPrefiltered(*asset->prefiltered);
+			asset->prefiltered.reset();
+
+		}
+		if (asset->cubemap)
+			(*asset->cubemap).setIrradiance(asset->irradiance);
+		timing.upload_end = this->getTime();
+
+		this->timeline.push_back(std::move(timing));
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,230 @@
+/**
+ * @file asset_loader.h
+ * @brief AssetLoader class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_ASSETLOADER_H_
+#define BGQ_OPENGL_CLASSES_ASSETLOADER_H_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/concurrent_queue/concurrent_queue.h"
+#include "classes/cubemap/cubemap.h"
+#include "classes/texture_file/texture_file.h"
+#include "classes/loader/loader.h"
+#include "classes/object/object.h"
+#include "classes/spherical_harmonics/spherical_harmonics.h"
+#include "classes/thread_pool/thread_pool.h"
+#include "structs/asset_timing/asset_timing.h"
+#include "structs/image_data/image_data.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of an AssetLoader class.
+	 *
+	 * Loads the models and cubemaps of the scene in parallel. Every model is
+	 * imported and converted, and every cubemap face is decoded, by a job in a
+	 * thread pool. Cubemaps with a baked file are just read in by a single job. When the last job of an asset ends, its index is pushed to a
+	 * lock-free queue that the thread with the OpenGL context drains, uploading
+	 * the assets as they become ready.
+	 *
+	 * The cubemaps also get their prefiltered mip chain and the spherical
+	 * harmonics of their diffuse light, read from their caches or built by
+	 * the job that finishes decoding them.
+	 *
+	 * It also records when every asset was loaded and uploaded.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class AssetLoader {
+
+		public:
+
+			static const int MAX_ASSETS = 64;	/// Maximum number of assets.
+
+			/**
+			 * @brief Starts the loader.
+			 *
+			 * Starts the worker threads, which wait for assets.
+			 *
+			 * @param origin The time the timeline is measured from, like the start of the program.
+			 * @param num_threads The number of workers, or 0 for one per hardware thread.
+			 */
+			AssetLoader(std::chrono::steady_clock::time_point origin, unsigned int num_threads);
+
+			AssetLoader(const AssetLoader&) = delete;
+			AssetLoader& operator=(const AssetLoader&) = delete;
+
+			/**
+			 * @brief Queues a cubemap.
+			 *
+			 * Queues a cubemap, whose faces start decoding straight away.
+			 *
+			 * @param textures_faces The faces in the right, left, top, bottom, back, and front order.
+			 * @param type Texture type.
+			 * @param slot Texture slot.
+			 *
+			 * @returns The handle of the cubemap.
+			 */
+			int addCubemap(const std::vector<std::string> &textures_faces, const char *type, GLuint slot);
+
+			/**
+			 * @brief Queues a model.
+			 *
+			 * Queues a model, which starts loading straight away.
+			 *
+			 * @param filename The name of the model file.
+			 * @param filetype The type of the model file.
+			 * @param cache_directory The directory of the mesh cache, or nullptr to always import the file.
+			 *
+			 * @returns The handle of the model.
+			 */
+			int addModel(const char *filename, const char *filetype, const char *cache_directory);
+
+			/**
+			 * @brief Uploads everything.
+			 *
+			 * Uploads the assets as their jobs end, until all of them are uploaded.
+			 * It has to be called from the thread with the OpenGL context.
+			 */
+			void finish();
+
+			/**
+			 * @brief Gets the time since the origin.
+			 *
+			 * Gets the time elapsed since the origin of the timeline.
+			 *
+			 * @returns The time in milliseconds.
+			 */
+			double getTime();
+
+			/**
+			 * @brief Gets the timeline.
+			 *
+			 * Gets the timings of the assets, in the order they were uploaded.
+			 *
+			 * @returns The timings.
+			 */
+			std::span<const AssetTiming> getTimeline();
+
+			/**
+			 * @brief Prints the timeline.
+			 *
+			 * Prints when every asset was loaded and uploaded.
+			 */
+			void printTimeline();
+
+			/**
+			 * @brief Takes a cubemap.
+			 *
+			 * Moves an uploaded cubemap out of the loader.
+			 *
+			 * @param handle The handle of the cubemap.
+			 *
+			 * @returns The cubemap.
+			 */
+			Cubemap takeCubemap(int handle);
+
+			/**
+			 * @brief Takes a model.
+			 *
+			 * Moves an uploaded model out of the loader.
+			 *
+			 * @param handle The handle of the model.
+			 *
+			 * @returns The object.
+			 */
+			Object takeObject(int handle);
+
+		private:
+
+			/**
+			 * @brief An asset being loaded.
+			 *
+			 * Everything about an asset from the moment it is queued until it is taken.
+			 */
+			struct PendingAsset {
+
+				std::string name;						/// Name of the asset.
+				std::unique_ptr<Loader> model_loader;	/// Loader of a model.
+				std::vector<std::string> face_files;	/// Files of the faces of a cubemap.
+				std::vector<ImageData> faces;			/// Decoded faces of a cubemap.
+				std::unique_ptr<TextureFile> baked;		/// Baked file of a cubemap, when there is one.
+				GLuint slot = 0;						/// Texture slot of a cubemap.
+				std::unique_ptr<TextureFile> prefiltered;	/// Prefiltered levels of a cubemap, when they could be loaded or built.
+				IrradianceBlock irradiance = SphericalHarmonics::getFlat();	/// Diffuse light of a cubemap.
+				std::atomic<int> decoding;				/// Faces of a cubemap that are still being decoded.
+				std::vector<double> job_start;			/// When every job started.
+				std::vector<double> job_end;			/// When every job ended.
+				std::atomic<int> remaining;				/// Jobs that have not ended yet.
+				std::atomic<bool> failed;				/// Whether a job could not load its part.
+				std::unique_ptr<Object> object;			/// Uploaded model.
+				std::unique_ptr<Cubemap> cubemap;		/// Uploaded cubemap.
+
+			};
+
+			/**
+			 * @brief Ends a job.
+			 *
+			 * Records the end of a job and, if it was the last one of its asset,
+			 * queues the asset for upload.
+			 *
+			 * @param asset The asset.
+			 * @param index The index of the asset.
+			 * @param job The index of the job in the asset.
+			 * @param start When the job started.
+			 */
+			void endJob(PendingAsset *asset, int index, int job, double start);
+
+			/**
+			 * @brief Prepares the lighting of a cubemap.
+			 *
+			 * Loads the prefiltered levels and the diffuse light of a cubemap from
+			 * their caches, or builds the missing caches from the faces, decoding
+			 * them first if the cubemap was baked. If that does not work either,
+			 * the cubemap keeps its box filtered levels and an even white light.
+			 *
+			 * @param asset The cubemap, whose first level is already loaded.
+			 */
+			void prepareLighting(PendingAsset *asset);
+
+			/**
+			 * @brief Uploads an asset.
+			 *
+			 * Uploads an asset whose jobs have all ended.
+			 *
+			 * @param index The index of the asset.
+			 */
+			void upload(int index);
+
+			std::chrono::steady_clock::time_point origin;			/// Time the timeline is measured from.
+			std::vector<std::unique_ptr<PendingAsset>> assets;		/// Assets queued so far.
+			std::vector<AssetTiming> timeline;						/// Timings of the uploaded assets.
+			ConcurrentQueue<int> ready;								/// Assets whose jobs have all ended.
+			std::atomic<unsigned int> completed{0};					/// Number of assets pushed to the ready queue.
+			ThreadPool pool;										/// Workers. Declared last so it is joined first.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_ASSETLOADER_H_
@@ -0,0 +1,283 @@
+/**
+ * @file benchmark.cpp
+ * @brief Benchmark class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "benchmark.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "structs/benchmark_result/benchmark_result.h"
+#include "structs/draw_stats/draw_stats.h"
+#include "structs/uniform/uniform.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		const double MIN_SLOWDOWN = 0.05;
+
+		const char *CSV_HEADER = "scene,model,skybox,shader,"
+			"cpu_samples,cpu_mean,cpu_median,cpu_p95,cpu_stddev,"
+			"gpu_samples,gpu_mean,gpu_median,gpu_p95,gpu_stddev,"
+			"draws,instances,program_binds,vao_binds,texture_binds,uniform_uploads,block_uploads";
+
+		TimeStats summarize(std::vector<double> times) {
+
+			TimeStats stats = {(long) times.size(), 0.0, 0.0, 0.0, 0.0};
+			if (times.empty())
+				return stats;
+
+			std::sort(times.begin(), times.end());
+
+			for (double time : times)
+				stats.mean += time / times.size();
+
+			for (double time : times)
+				stats.stddev += (time - stats.mean) * (time - stats.mean);
+			stats.stddev = times.size() > 1 ? std::sqrt(stats.stddev / (times.size() - 1)) : 0.0;
+
+			// Nearest rank percentiles.
+			stats.median = times[(times.size() - 1) / 2];
+			stats.p95 = times[std::min(times.size() - 1, (size_t) std::ceil(0.95 * times.size()) - 1)];
+
+			return stats;
+
+		}
+
+		std::string getName(const BenchmarkResult &result) {
+
+			return result.scene + "/" + result.model + "/" + result.skybox + "/" + result.shader;
+
+		}
+
+		bool isRegression(const TimeStats &baseline, const TimeStats &current, double threshold, double *t, double *slowdown) {
+
+			if (baseline.samples < 2 || current.samples < 2 || baseline.mean <= 0.0)
+				return false;
+
+			// Welch's t statistic, which does not assume both runs are equally noisy.
+			double error = std::sqrt(baseline.stddev * baseline.stddev / baseline.samples + current.stddev * current.stddev / current.samples);
+			*slowdown = (current.mean - baseline.mean) / baseline.mean;
+			*t = error > 0.0 ? (current.mean - baseline.mean) / error : (*slowdown > 0.0 ? INFINITY : 0.0);
+
+			return *t > threshold && *slowdown > MIN_SLOWDOWN;
+
+		}
+
+		void writeTimes(std::ostream &file, const char *name, const TimeStats &stats) {
+
+			file << "\"" << name << "\": {\"samples\": " << stats.samples << ", \"mean\": " << stats.mean << ", \"median\": " << stats.median;
+			file << ", \"p95\": " << stats.p95 << ", \"stddev\": " << stats.stddev << "}";
+
+		}
+
+	}
+
+	void Benchmark::addFrame(double cpu_time, const DrawStats &draws, const UniformStats &uniforms, unsigned long block_uploads) {
+
+		this->cpu_times.push_back(cpu_time);
+
+		// Add the counters up, they are averaged when the case ends.
+		this->current.draws += draws.draws;
+		this->current.instances += draws.instances;
+		this->current.program_binds += draws.program_binds;
+		this->current.vao_binds += draws.vao_binds;
+		this->current.texture_binds += draws.texture_binds;
+		this->current.uniform_uploads += uniforms.uploads;
+		this->current.block_uploads += block_uploads;
+
+	}
+
+	void Benchmark::beginCase(const std::string &scene, const std::string &model, const std::string &skybox, const std::string &shader) {
+
+		this->current = BenchmarkResult();
+		this->current.scene = scene;
+		this->current.model = model;
+		this->current.skybox = skybox;
+		this->current.shader = shader;
+		this->cpu_times.clear();
+
+	}
+
+	int Benchmark::compare(const std::vector<BenchmarkResult> &baseline, const std::vector<BenchmarkResult> &current, double threshold, std::ostream &output) {
+
+		int regressions = 0;
+		for (const BenchmarkResult &result : current) {
+
+			std::string name = getName(result);
+			auto match = std::find_if(baseline.begin(), baseline.end(), [&name](const BenchmarkResult &other) { return getName(other) == name; });
+			if (match == baseline.end()) {
+
+				output << name << ": not in the baseline" << std::endl;
+				continue;
+
+			}
+
+			double t = 0.0, slowdown = 0.0;
+			if (isRegression((*match).cpu, result.cpu, threshold, &t, &slowdown)) {
+
+				output << name << ": CPU " << (*match).cpu.mean << " ms -> " << result.cpu.mean << " ms (+" << slowdown * 100.0 << "%, t = " << t << ")" << std::endl;
+				regressions++;
+
+			}
+
+			if (isRegression((*match).gpu, result.gpu, threshold, &t, &slowdown)) {
+
+				output << name << ": GPU " << (*match).gpu.mean << " ms -> " << result.gpu.mean << " ms (+" << slowdown * 100.0 << "%, t = " << t << ")" << std::endl;
+				regressions++;
+
+			}
+
+		}
+
+		output << regressions << " regression(s) in " << current.size() << " case(s)" << std::endl;
+
+		return regressions;
+
+	}
+
+	void Benchmark::endCase(const std::vector<double> &gpu_times) {
+
+		this->current.cpu = summarize(this->cpu_times);
+		this->current.gpu = summarize(gpu_times);
+
+		// Turn the counters into averages per frame.
+		double frames = std::max((double) this->cpu_times.size(), 1.0);
+		this->current.draws /= frames;
+		this->current.instances /= frames;
+		this->current.program_binds /= frames;
+		this->current.vao_binds /= frames;
+		this->current.texture_binds /= frames;
+		this->current.uniform_uploads /= frames;
+		this->current.block_uploads /= frames;
+
+		this->results.push_back(this->current);
+
+	}
+
+	const std::vector<BenchmarkResult>& Benchmark::getResults() const {
+
+		return this->results;
+
+	}
+
+	bool Benchmark::readCSV(const std::string &filename, std::vector<BenchmarkResult> *results) {
+
+		std::ifstream file(filename);
+		if (!file)
+			return false;
+
+		// Skip the header.
+		std::string line;
+		if (!std::getline(file, line))
+			return false;
+
+		results->clear();
+		while (std::getline(file, line)) {
+
+			std::vector<std::string> fields;
+			std::stringstream stream(line);
+			std::string field;
+			while (std::getline(stream, field, ','))
+				fields.push_back(field);
+
+			if (fields.size() != 21)
+				return false;
+
+			std::vector<double> values;
+			for (size_t i = 4; i < fields.size(); i++)
+				values.push_back(strtod(fields[i].c_str(), nullptr));
+
+			BenchmarkResult result;
+			result.scene = fields[0];
+			result.model = fields[1];
+			result.skybox = fields[2];
+			result.shader = fields[3];
+			result.cpu = {(long) values[0], values[1], values[2], values[3], values[4]};
+			result.gpu = {(long) values[5], values[6], values[7], values[8], values[9]};
+			result.draws = values[10];
+			result.instances = values[11];
+			result.program_binds = values[12];
+			result.vao_binds = values[13];
+			result.texture_binds = values[14];
+			result.uniform_uploads = values[15];
+			result.block_uploads = values[16];
+			results->push_back(result);
+
+		}
+
+		return true;
+
+	}
+
+	bool Benchmark::writeCSV(const std::string &filename) const {
+
+		std::ofstream file(filename, std::ios::trunc);
+		if (!file)
+			return false;
+
+		file << CSV_HEADER << "\n";
+		for (const BenchmarkResult &result : this->results) {
+
+			file << result.scene << "," << result.model << "," << result.skybox << "," << result.shader;
+			for (const TimeStats *stats : {&result.cpu, &result.gpu})
+				file << "," << (*stats).samples << "," << (*stats).mean << "," << (*stats).median << "," << (*stats).p95 << "," << (*stats).stddev;
+			file << "," << result.draws << "," << result.instances << "," << result.program_binds << "," << result.vao_binds;
+			file << "," << result.texture_binds << "," << result.uniform_uploads << "," << result.block_uploads << "\n";
+
+		}
+
+		file.close();
+
+		return (bool) file;
+
+	}
+
+	bool Benchmark::writeJSON(const std::string &filename) const {
+
+		std::ofstream file(filename, std::ios::trunc);
+		if (!file)
+			return false;
+
+		file << "[\n";
+		for (size_t i = 0; i < this->results.size(); i++) {
+
+			const BenchmarkResult &result = this->results[i];
+			file << "  {\"scene\": \"" << result.scene << "\", \"model\": \"" << result.model << "\", \"skybox\": \"" << result.skybox << "\", \"shader\": \"" << result.shader << "\",\n   ";
+			writeTimes(file, "cpu_ms", result.cpu);
+			file << ",\n   ";
+			writeTimes(file, "gpu_ms", result.gpu);
+			file << ",\n   \"draws\": " << result.draws << ", \"instances\": " << result.instances << ", \"program_binds\": " << result.program_binds;
+			file << ", \"vao_binds\": " << result.vao_binds << ", \"texture_binds\": " << result.texture_binds;
+			file << ", \"uniform_uploads\": " << result.uniform_uploads << ", \"block_uploads\": " << result.block_uploads << "}";
+			file << (i + 1 < this->results.size() ? ",\n" : "\n");
+
+		}
+		file << "]\n";
+
+		file.close();
+
+		return (bool) file;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,146 @@
+/**
+ * @file benchmark.h
+ * @brief Benchmark class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_BENCHMARK_H_
+#define BGQ_OPENGL_CLASSES_BENCHMARK_H_
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "structs/benchmark_result/benchmark_result.h"
+#include "structs/draw_stats/draw_stats.h"
+#include "structs/uniform/uniform.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a Benchmark class.
+	 *
+	 * Collects the times and counters of the frames rendered for every case of
+	 * a benchmark, writes them as JSON and CSV, and compares two runs to find
+	 * the cases that got slower.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class Benchmark {
+
+		public:
+
+			/**
+			 * @brief Adds a frame to the current case.
+			 *
+			 * Adds the time and counters of a frame to the current case.
+			 *
+			 * @param cpu_time The CPU time of the frame in milliseconds.
+			 * @param draws The draw counters of the frame.
+			 * @param uniforms The uniform counters of the frame.
+			 * @param block_uploads The uniform block uploads of the frame.
+			 */
+			void addFrame(double cpu_time, const DrawStats &draws, const UniformStats &uniforms, unsigned long block_uploads);
+
+			/**
+			 * @brief Starts a case.
+			 *
+			 * Starts collecting the frames of a new case.
+			 *
+			 * @param scene The name of the scene.
+			 * @param model The name of the model.
+			 * @param skybox The name of the skybox.
+			 * @param shader The name of the shading program.
+			 */
+			void beginCase(const std::string &scene, const std::string &model, const std::string &skybox, const std::string &shader);
+
+			/**
+			 * @brief Compares two runs.
+			 *
+			 * Compares every case of a run with the same case of a baseline and
+			 * reports the ones whose CPU or GPU time got significantly worse. A case
+			 * is a regression when the Welch t statistic of the means is above the
+			 * threshold and the mean is at least 5% slower, so that tiny but steady
+			 * differences are not reported.
+			 *
+			 * @param baseline The results of the baseline.
+			 * @param current The results to check.
+			 * @param threshold The minimum t statistic of a regression.
+			 * @param output The stream to write the report to.
+			 *
+			 * @returns The number of regressions.
+			 */
+			static int compare(const std::vector<BenchmarkResult> &baseline, const std::vector<BenchmarkResult> &current, double threshold, std::ostream &output);
+
+			/**
+			 * @brief Ends the current case.
+			 *
+			 * Summarises the frames of the current case and adds it to the results.
+			 *
+			 * @param gpu_times The GPU times of the frames in milliseconds, which can be empty.
+			 */
+			void endCase(const std::vector<double> &gpu_times);
+
+			/**
+			 * @brief Get the results.
+			 *
+			 * Get the results of the cases ended so far.
+			 *
+			 * @returns The results.
+			 */
+			const std::vector<BenchmarkResult>& getResults() const;
+
+			/**
+			 * @brief Reads the results from a CSV file.
+			 *
+			 * Reads the results written by writeCSV.
+			 *
+			 * @param filename The name of the file.
+			 * @param results Outputs the results.
+			 *
+			 * @returns True if the file could be read. False otherwise.
+			 */
+			static bool readCSV(const std::string &filename, std::vector<BenchmarkResult> *results);
+
+			/**
+			 * @brief Writes the results to a CSV file.
+			 *
+			 * Writes the results as a CSV file, one case per row.
+			 *
+			 * @param filename The name of the file.
+			 *
+			 * @returns True if the file could be written. False otherwise.
+			 */
+			bool writeCSV(const std::string &filename) const;
+
+			/**
+			 * @brief Writes the results to a JSON file.
+			 *
+			 * Writes the results as a JSON array, one object per case.
+			 *
+			 * @param filename The name of the file.
+			 *
+			 * @returns True if the file could be written. False otherwise.
+			 */
+			bool writeJSON(const std::string &filename) const;
+
+		private:
+
+			BenchmarkResult current;				/// Case being collected.
+			std::vector<double> cpu_times;			/// CPU times of the frames of the current case.
+			std::vector<BenchmarkResult> results;	/// Cases ended so far.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_BENCHMARK_H_
@@ -0,0 +1,686 @@
+/**
+ * @file block_compressor.cpp
+ * @brief BlockCompressor class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "block_compressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		const int BLOCK_PIXELS = 16;
+
+		// Weights of the 4 bit BC7 indices, out of 64.
+		const int BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		// Weights of the 3 bit BC7 indices, out of 64.
+		const int BC7_WEIGHTS_3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+
+		// Pixels in the second subset of every BC7 partition in two, one bit per pixel.
+		const uint16_t BC7_PARTITIONS[64] = {
+			0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+			0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+			0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+			0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22
+		};
+
+		// Pixel whose index leaves out its top bit in the second subset of every partition. The first subset always uses pixel 0.
+		const int BC7_ANCHORS[64] = {
+			15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+			15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+			15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+			6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15
+		};
+
+		// Partitions of mode 1 that are encoded in full, picked by how well two lines fit them.
+		const int BC7_PARTITION_CANDIDATES = 4;
+
+		// Mode 6 errors up to this much come from rounding the block alone, which the coarser mode 1 does not beat.
+		const int BC7_MODE1_MIN_ERROR = 8 * BLOCK_PIXELS;
+
+		typedef unsigned char Block[BLOCK_PIXELS][4];
+
+		void fetchBlock(const unsigned char *rgba, int width, int height, int block_x, int block_y, Block block) {
+
+			for (int y = 0; y < 4; y++) {
+
+				int source_y = std::min(block_y * 4 + y, height - 1);
+				for (int x = 0; x < 4; x++) {
+
+					int source_x = std::min(block_x * 4 + x, width - 1);
+					memcpy(block[y * 4 + x], rgba + ((size_t) source_y * width + source_x) * 4, 4);
+
+				}
+
+			}
+
+		}
+
+		// Fits a line to the pixels of a block in a mask.
+		void fitLine(const Block block, int channels, uint16_t pixels, float start[4], float end[4]) {
+
+			int count = 0;
+			float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+			for (int i = 0; i < BLOCK_PIXELS; i++) {
+
+				if (!((pixels >> i) & 1))
+					continue;
+
+				count++;
+				for (int c = 0; c < channels; c++)
+					mean[c] += block[i][c];
+
+			}
+
+			for (int c = 0; c < channels; c++)
+				mean[c] /= (float) count;
+
+			float covariance[4][4] = {};
+			for (int i = 0; i < BLOCK_PIXELS; i++)
+				if ((pixels >> i) & 1)
+					for (int a = 0; a < channels; a++)
+						for (int b = 0; b < channels; b++)
+							covariance[a][b] += (block[i][a] - mean[a]) * (block[i][b] - mean[b]);
+
+			// Find the principal axis with a few power iterations, starting from the diagonal.
+			float axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+			for (int iteration = 0; iteration < 8; iteration++) {
+
+				float next[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+				float length = 0.0f;
+				for (int a = 0; a < channels; a++) {
+
+					for (int b = 0; b < channels; b++)
+						next[a] += covariance[a][b] * axis[b];
+					length = std::max(length, std::fabs(next[a]));
+
+				}
+
+				// Flat blocks have no axis, and their line is a single point.
+				if (length < 1e-6f)
+					break;
+
+				for (int c = 0; c < channels; c++)
+					axis[c] = next[c] / length;
+
+			}
+
+			// The ends of the line are the extreme projections on the axis.
+			float length = 0.0f;
+			for (int c = 0; c < channels; c++)
+				length += axis[c] * axis[c];
+
+			float low = 0.0f, high = 0.0f;
+			for (int i = 0; i < BLOCK_PIXELS; i++) {
+
+				if (!((pixels >> i) & 1))
+					continue;
+
+				float t = 0.0f;
+				for (int c = 0; c < channels; c++)
+					t += (block[i][c] - mean[c]) * axis[c];
+				low = std::min(low, t / length);
+				high = std::max(high, t / length);
+
+			}
+
+			for (int c = 0; c < channels; c++) {
+
+				start[c] = std::clamp(mean[c] + low * axis[c], 0.0f, 255.0f);
+				end[c] = std::clamp(mean[c] + high * axis[c], 0.0f, 255.0f);
+
+			}
+
+		}
+
+		// Sums of the channels of some pixels, and of the products of every pair of channels.
+		typedef int Moments[9];
+
+		void addMoments(const unsigned char *pixel, Moments moments) {
+
+			moments[0] += pixel[0];
+			moments[1] += pixel[1];
+			moments[2] += pixel[2];
+			moments[3] += pixel[0] * pixel[0];
+			moments[4] += pixel[0] * pixel[1];
+			moments[5] += pixel[0] * pixel[2];
+			moments[6] += pixel[1] * pixel[1];
+			moments[7] += pixel[1] * pixel[2];
+			moments[8] += pixel[2] * pixel[2];
+
+		}
+
+		// Estimates how far the colours of some pixels are from their best line, squared, from their moments. It is
+		// the spread left out of the principal axis.
+		float getLineResidual(const Moments moments, int count) {
+
+			const int PRODUCTS[3][3] = {{3, 4, 5}, {4, 6, 7}, {5, 7, 8}};
+			float covariance[3][3];
+			for (int a = 0; a < 3; a++)
+				for (int b = 0; b < 3; b++)
+					covariance[a][b] = moments[PRODUCTS[a][b]] - (float) moments[a] * moments[b] / count;
+
+			float axis[3] = {1.0f, 1.0f, 1.0f};
+			for (int iteration = 0; iteration < 4; iteration++) {
+
+				float next[3] = {0.0f, 0.0f, 0.0f};
+				float length = 0.0f;
+				for (int a = 0; a < 3; a++) {
+
+					for (int b = 0; b < 3; b++)
+						next[a] += covariance[a][b] * axis[b];
+					length = std::max(length, std::fabs(next[a]));
+
+				}
+
+				if (length < 1e-6f)
+					return 0.0f;
+
+				for (int c = 0; c < 3; c++)
+					axis[c] = next[c] / length;
+
+			}
+
+			float spread = 0.0f, length = 0.0f;
+			for (int a = 0; a < 3; a++) {
+
+				length += axis[a] * axis[a];
+				for (int b = 0; b < 3; b++)
+					spread += axis[a] * covariance[a][b] * axis[b];
+
+			}
+
+			return covariance[0][0] + covariance[1][1] + covariance[2][2] - spread / length;
+
+		}
+
+		int getError(const unsigned char *pixel, const int *color, int channels) {
+
+			int error = 0;
+			for (int c = 0; c < channels; c++)
+				error += (pixel[c] - color[c]) * (pixel[c] - color[c]);
+
+			return error;
+
+		}
+
+		uint16_t to565(const float color[3]) {
+
+			int r = (int) std::lround(color[0] * 31.0f / 255.0f);
+			int g = (int) std::lround(color[1] * 63.0f / 255.0f);
+			int b = (int) std::lround(color[2] * 31.0f / 255.0f);
+
+			return (uint16_t) ((r << 11) | (g << 5) | b);
+
+		}
+
+		void from565(uint16_t value, int color[3]) {
+
+			int r = (value >> 11) & 31, g = (value >> 5) & 63, b = value & 31;
+			color[0] = (r << 3) | (r >> 2);
+			color[1] = (g << 2) | (g >> 4);
+			color[2] = (b << 3) | (b >> 2);
+
+		}
+
+		void compressBC1(const Block block, std::byte *output) {
+
+			float start[4], end[4];
+			fitLine(block, 3, 0xFFFF, start, end);
+
+			// The four colour mode needs the first endpoint to be the bigger one.
+			uint16_t endpoints[2] = {to565(end), to565(start)};
+			if (endpoints[0] < endpoints[1])
+				std::swap(endpoints[0], endpoints[1]);
+
+			int palette[4][3];
+			from565(endpoints[0], palette[0]);
+			from565(endpoints[1], palette[1]);
+			for (int c = 0; c < 3; c++) {
+
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+
+			}
+
+			// Equal endpoints would switch to the three colour mode, so every pixel takes the first one.
+			uint32_t indices = 0;
+			if (endpoints[0] != endpoints[1]) {
+
+				for (int i = 0; i < BLOCK_PIXELS; i++) {
+
+					int best = 0;
+					int best_error = getError(block[i], palette[0], 3);
+					for (int j = 1; j < 4; j++) {
+
+						int error = getError(block[i], palette[j], 3);
+						if (error < best_error) {
+
+							best = j;
+							best_error = error;
+
+						}
+
+					}
+
+					indices |= (uint32_t) best << (2 * i);
+
+				}
+
+			}
+
+			// Everything is little endian.
+			unsigned char bytes[8] = {
+				(unsigned char) (endpoints[0] & 0xFF), (unsigned char) (endpoints[0] >> 8),
+				(unsigned char) (endpoints[1] & 0xFF), (unsigned char) (endpoints[1] >> 8),
+				(unsigned char) (indices & 0xFF), (unsigned char) ((indices >> 8) & 0xFF),
+				(unsigned char) ((indices >> 16) & 0xFF), (unsigned char) (indices >> 24)
+			};
+			memcpy(output, bytes, sizeof(bytes));
+
+		}
+
+		class BitWriter {
+
+			public:
+
+				BitWriter(std::byte *output) : output(output) {
+
+					memset(output, 0, 16);
+
+				}
+
+				void write(uint32_t value, int bits) {
+
+					for (int i = 0; i < bits; i++, this->position++)
+						if ((value >> i) & 1)
+							this->output[this->position / 8] |= (std::byte) (1 << (this->position % 8));
+
+				}
+
+			private:
+
+				std::byte *output;
+				int position = 0;
+
+		};
+
+		// Mode 6 fits the whole block to a single line, with 16 steps along it. Returns the error of the block.
+		int compressBC7Mode6(const Block block, std::byte *output) {
+
+			float start[4], end[4];
+			fitLine(block, 4, 0xFFFF, start, end);
+
+			// Mode 6 stores 7 bits per channel and one shared low bit per endpoint, so try the four low bits.
+			int best_error = -1;
+			int best_endpoints[2][4];
+			int best_bits[2];
+			int best_indices[BLOCK_PIXELS];
+			for (int bits = 0; bits < 4; bits++) {
+
+				int low_bits[2] = {bits & 1, bits >> 1};
+				int endpoints[2][4];
+				int colors[2][4];
+				for (int c = 0; c < 4; c++) {
+
+					endpoints[0][c] = std::clamp((int) std::floor((start[c] - low_bits[0]) / 2.0f + 0.5f), 0, 127);
+					endpoints[1][c] = std::clamp((int) std::floor((end[c] - low_bits[1]) / 2.0f + 0.5f), 0, 127);
+					colors[0][c] = (endpoints[0][c] << 1) | low_bits[0];
+					colors[1][c] = (endpoints[1][c] << 1) | low_bits[1];
+
+				}
+
+				int palette[16][4];
+				for (int j = 0; j < 16; j++)
+					for (int c = 0; c < 4; c++)
+						palette[j][c] = ((64 - BC7_WEIGHTS[j]) * colors[0][c] + BC7_WEIGHTS[j] * colors[1][c] + 32) >> 6;
+
+				int direction[4], length = 0;
+				for (int c = 0; c < 4; c++) {
+
+					direction[c] = colors[1][c] - colors[0][c];
+					length += direction[c] * direction[c];
+
+				}
+
+				int total = 0;
+				int indices[BLOCK_PIXELS];
+				for (int i = 0; i < BLOCK_PIXELS; i++) {
+
+					// The steps are almost even, so project on the line and only check the closest ones.
+					int projection = 0;
+					for (int c = 0; c < 4; c++)
+						projection += (block[i][c] - colors[0][c]) * direction[c];
+					int guess = length > 0 ? std::clamp((int) std::lround(15.0f * projection / length), 0, 15) : 0;
+
+					int best = std::max(guess - 1, 0);
+					int best_pixel_error = getError(block[i], palette[best], 4);
+					for (int j = best + 1; j <= std::min(guess + 1, 15); j++) {
+
+						int error = getError(block[i], palette[j], 4);
+						if (error < best_pixel_error) {
+
+							best = j;
+							best_pixel_error = error;
+
+						}
+
+					}
+
+					indices[i] = best;
+					total += best_pixel_error;
+
+				}
+
+				if (best_error < 0 || total < best_error) {
+
+					best_error = total;
+					memcpy(best_endpoints, endpoints, sizeof(endpoints));
+					memcpy(best_bits, low_bits, sizeof(low_bits));
+					memcpy(best_indices, indices, sizeof(indices));
+
+				}
+
+			}
+
+			// The first index only has 3 bits, so its top bit has to be 0.
+			if (best_indices[0] & 8) {
+
+				for (int c = 0; c < 4; c++)
+					std::swap(best_endpoints[0][c], best_endpoints[1][c]);
+				std::swap(best_bits[0], best_bits[1]);
+				for (int i = 0; i < BLOCK_PIXELS; i++)
+					best_indices[i] = 15 - best_indices[i];
+
+			}
+
+			BitWriter writer(output);
+			writer.write(1 << 6, 7);
+			for (int c = 0; c < 4; c++) {
+
+				writer.write((uint32_t) best_endpoints[0][c], 7);
+				writer.write((uint32_t) best_endpoints[1][c], 7);
+
+			}
+			writer.write((uint32_t) best_bits[0], 1);
+			writer.write((uint32_t) best_bits[1], 1);
+			writer.write((uint32_t) best_indices[0], 3);
+			for (int i = 1; i < BLOCK_PIXELS; i++)
+				writer.write((uint32_t) best_indices[i], 4);
+
+			return best_error;
+
+		}
+
+		// Encodes one subset of a mode 1 block, and returns its error.
+		int encodeBC7Subset(const Block block, uint16_t pixels, const float start[4], const float end[4], int endpoints[2][3], int *low_bit, int indices[BLOCK_PIXELS]) {
+
+			// Mode 1 stores 6 bits per channel and one low bit shared by both endpoints, so try both low bits.
+			int best_error = -1;
+			for (int bit = 0; bit < 2; bit++) {
+
+				int candidate[2][3];
+				int colors[2][3];
+				for (int c = 0; c < 3; c++) {
+
+					candidate[0][c] = std::clamp((int) std::lround((start[c] * 127.0f / 255.0f - bit) / 2.0f), 0, 63);
+					candidate[1][c] = std::clamp((int) std::lround((end[c] * 127.0f / 255.0f - bit) / 2.0f), 0, 63);
+					for (int e = 0; e < 2; e++) {
+
+						// The 7 bits are widened to 8 by repeating the top one.
+						int value = (candidate[e][c] << 1) | bit;
+						colors[e][c] = (value << 1) | (value >> 6);
+
+					}
+
+				}
+
+				int palette[8][3];
+				for (int j = 0; j < 8; j++)
+					for (int c = 0; c < 3; c++)
+						palette[j][c] = ((64 - BC7_WEIGHTS_3[j]) * colors[0][c] + BC7_WEIGHTS_3[j] * colors[1][c] + 32) >> 6;
+
+				int direction[3], length = 0;
+				for (int c = 0; c < 3; c++) {
+
+					direction[c] = colors[1][c] - colors[0][c];
+					length += direction[c] * direction[c];
+
+				}
+
+				// The blocks are opaque, so the alpha is always right and only the colour is compared.
+				int total = 0;
+				int candidate_indices[BLOCK_PIXELS];
+				for (int i = 0; i < BLOCK_PIXELS; i++) {
+
+					if (!((pixels >> i) & 1))
+						continue;
+
+					// Like in mode 6, only the steps next to the projection on the line are checked.
+					int projection = 0;
+					for (int c = 0; c < 3; c++)
+						projection += (block[i][c] - colors[0][c]) * direction[c];
+					int guess = length > 0 ? std::clamp((int) std::lround(7.0f * projection / length), 0, 7) : 0;
+
+					int best = std::max(guess - 1, 0);
+					int best_pixel_error = getError(block[i], palette[best], 3);
+					for (int j = best + 1; j <= std::min(guess + 1, 7); j++) {
+
+						int error = getError(block[i], palette[j], 3);
+						if (error < best_pixel_error) {
+
+							best = j;
+							best_pixel_error = error;
+
+						}
+
+					}
+
+					candidate_indices[i] = best;
+					total += best_pixel_error;
+
+				}
+
+				if (best_error < 0 || total < best_error) {
+
+					best_error = total;
+					memcpy(endpoints, candidate, sizeof(candidate));
+					*low_bit = bit;
+					for (int i = 0; i < BLOCK_PIXELS; i++)
+						if ((pixels >> i) & 1)
+							indices[i] = candidate_indices[i];
+
+				}
+
+			}
+
+			return best_error;
+
+		}
+
+		// Mode 1 splits an opaque block in two subsets with a line each, and 8 steps along them. Returns the error of the block.
+		int compressBC7Mode1(const Block block, std::byte *output) {
+
+			// The moments of the whole block, so that those of the first subset are what is left from the second one.
+			Moments moments = {};
+			for (int i = 0; i < BLOCK_PIXELS; i++)
+				addMoments(block[i], moments);
+
+			// Rank the partitions by how far the pixels are from the lines of their subsets.
+			std::pair<float, int> ranking[64];
+			for (int p = 0; p < 64; p++) {
+
+				int count = 0;
+				Moments second = {};
+				for (int i = 0; i < BLOCK_PIXELS; i++) {
+
+					if ((BC7_PARTITIONS[p] >> i) & 1) {
+
+						addMoments(block[i], second);
+						count++;
+
+					}
+
+				}
+
+				Moments first;
+				for (int m = 0; m < 9; m++)
+					first[m] = moments[m] - second[m];
+
+				ranking[p] = {getLineResidual(first, BLOCK_PIXELS - count) + getLineResidual(second, count), p};
+
+			}
+			std::partial_sort(ranking, ranking + BC7_PARTITION_CANDIDATES, ranking + 64);
+
+			int best_error = -1;
+			int best_partition = 0;
+			int best_endpoints[2][2][3];
+			int best_bits[2];
+			int best_indices[BLOCK_PIXELS];
+			for (int k = 0; k < BC7_PARTITION_CANDIDATES; k++) {
+
+				int p = ranking[k].second;
+				int endpoints[2][2][3];
+				int low_bits[2];
+				int indices[BLOCK_PIXELS];
+				int total = 0;
+				for (int s = 0; s < 2; s++) {
+
+					uint16_t pixels = s == 0 ? (uint16_t) ~BC7_PARTITIONS[p] : BC7_PARTITIONS[p];
+					float start[4], end[4];
+					fitLine(block, 3, pixels, start, end);
+					total += encodeBC7Subset(block, pixels, start, end, endpoints[s], &low_bits[s], indices);
+
+				}
+
+				if (best_error < 0 || total < best_error) {
+
+					best_error = total;
+					best_partition = p;
+					memcpy(best_endpoints, endpoints, sizeof(endpoints));
+					memcpy(best_bits, low_bits, sizeof(low_bits));
+					memcpy(best_indices, indices, sizeof(indices));
+
+				}
+
+			}
+
+			// The index of the anchor of every subset only has 2 bits, so its top bit has to be 0.
+			int anchors[2] = {0, BC7_ANCHORS[best_partition]};
+			for (int s = 0; s < 2; s++) {
+
+				if (!(best_indices[anchors[s]] & 4))
+					continue;
+
+				for (int c = 0; c < 3; c++)
+					std::swap(best_endpoints[s][0][c], best_endpoints[s][1][c]);
+				for (int i = 0; i < BLOCK_PIXELS; i++)
+					if (((BC7_PARTITIONS[best_partition] >> i) & 1) == s)
+						best_indices[i] = 7 - best_indices[i];
+
+			}
+
+			BitWriter writer(output);
+			writer.write(1 << 1, 2);
+			writer.write((uint32_t) best_partition, 6);
+			for (int c = 0; c < 3; c++)
+				for (int s = 0; s < 2; s++)
+					for (int e = 0; e < 2; e++)
+						writer.write((uint32_t) best_endpoints[s][e][c], 6);
+			writer.write((uint32_t) best_bits[0], 1);
+			writer.write((uint32_t) best_bits[1], 1);
+			for (int i = 0; i < BLOCK_PIXELS; i++)
+				writer.write((uint32_t) best_indices[i], i == anchors[0] || i == anchors[1] ? 2 : 3);
+
+			return best_error;
+
+		}
+
+		void compressBC7(const Block block, std::byte *output) {
+
+			int error = compressBC7Mode6(block, output);
+
+			// Mode 1 has no alpha, so it is only tried on opaque blocks, and kept if it is closer.
+			bool opaque = true;
+			for (int i = 0; i < BLOCK_PIXELS; i++)
+				opaque &= block[i][3] == 255;
+
+			std::byte split[16];
+			if (opaque && error > BC7_MODE1_MIN_ERROR && compressBC7Mode1(block, split) < error)
+				memcpy(output, split, sizeof(split));
+
+		}
+
+		size_t getBlockBytes(GLenum format) {
+
+			if (format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+				return 8;
+			if (format == GL_COMPRESSED_RGBA_BPTC_UNORM_ARB)
+				return 16;
+
+			return 0;
+
+		}
+
+	}
+
+	bool BlockCompressor::compress(GLenum format, const unsigned char *rgba, int width, int height, std::byte *output) {
+
+		size_t block_bytes = getBlockBytes(format);
+		if (block_bytes == 0)
+			return false;
+
+		int blocks_x = (width + 3) / 4;
+		int blocks_y = (height + 3) / 4;
+		Block block;
+		for (int y = 0; y < blocks_y; y++) {
+
+			for (int x = 0; x < blocks_x; x++) {
+
+				fetchBlock(rgba, width, height, x, y, block);
+				std::byte *destination = output + ((size_t) y * blocks_x + x) * block_bytes;
+				if (format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+					compressBC1(block, destination);
+				else
+					compressBC7(block, destination);
+
+			}
+
+		}
+
+		return true;
+
+	}
+
+	size_t BlockCompressor::getCompressedSize(GLenum format, int width, int height) {
+
+		return (size_t) ((width + 3) / 4) * ((height + 3) / 4) * getBlockBytes(format);
+
+	}
+
+	bool BlockCompressor::isSupported(GLenum format) {
+
+		return getBlockBytes(format) != 0;
+
+	}
+
+}  // namespace bgq_opengl
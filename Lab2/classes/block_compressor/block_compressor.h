@@ -0,0 +1,88 @@
+/**
+ * @file block_compressor.h
+ * @brief BlockCompressor class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_BLOCKCOMPRESSOR_H_
+#define BGQ_OPENGL_CLASSES_BLOCKCOMPRESSOR_H_
+
+#include <cstddef>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a BlockCompressor class.
+	 *
+	 * Compresses RGBA images into 4x4 blocks on the CPU, so that textures take
+	 * less memory and bandwidth on the GPU. It supports BC1, which stores every
+	 * block in 8 bytes and has no alpha, and BC7, which stores it in 16 bytes with
+	 * alpha and a much better quality.
+	 *
+	 * Both fit the colours of a block to a line along its principal axis. BC7
+	 * uses mode 6, which has a single line and 16 steps along it. Opaque blocks
+	 * also try mode 1, which splits them in two with a line each, and keep
+	 * whichever is closer.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class BlockCompressor {
+
+		public:
+
+			/**
+			 * @brief Compresses an image.
+			 *
+			 * Compresses an RGBA image block by block. Blocks over the edge of images
+			 * whose size is not a multiple of 4 repeat the last row and column.
+			 *
+			 * @param format GL_COMPRESSED_RGB_S3TC_DXT1_EXT for BC1 or GL_COMPRESSED_RGBA_BPTC_UNORM_ARB for BC7.
+			 * @param rgba The pixels of the image, 4 bytes each.
+			 * @param width The width of the image in pixels.
+			 * @param height The height of the image in pixels.
+			 * @param output Outputs the blocks. It has to hold getCompressedSize bytes.
+			 *
+			 * @returns True if the format is supported. False otherwise.
+			 */
+			static bool compress(GLenum format, const unsigned char *rgba, int width, int height, std::byte *output);
+
+			/**
+			 * @brief Gets the size of a compressed image.
+			 *
+			 * Gets how many bytes an image takes once compressed.
+			 *
+			 * @param format The compressed format.
+			 * @param width The width of the image in pixels.
+			 * @param height The height of the image in pixels.
+			 *
+			 * @returns The size in bytes, or 0 if the format is not supported.
+			 */
+			static size_t getCompressedSize(GLenum format, int width, int height);
+
+			/**
+			 * @brief Whether a format can be compressed.
+			 *
+			 * Whether a format is one of the compressed formats this class writes.
+			 *
+			 * @param format The format.
+			 *
+			 * @returns True if it is supported. False otherwise.
+			 */
+			static bool isSupported(GLenum format);
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_BLOCKCOMPRESSOR_H_
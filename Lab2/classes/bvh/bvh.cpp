@@ -0,0 +1,619 @@
+/**
+ * @file bvh.cpp
+ * @brief Bvh class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "bvh.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/thread_pool/thread_pool.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/bvh_node/bvh_node.h"
+#include "structs/bvh_wide_node/bvh_wide_node.h"
+#include "structs/ray/ray.h"
+#include "structs/ray_hit/ray_hit.h"
+#include "structs/vertex/vertex.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BGQ_BVH_AVX2
+#include <immintrin.h>
+#endif
+
+namespace bgq_opengl {
+
+	namespace {
+
+		typedef uint32_t (*BoxTest)(const BvhWideNode &node, const glm::vec3 &origin, const glm::vec3 &inverse_direction, float max_t, float *entries);
+
+		uint32_t intersectBoxesScalar(const BvhWideNode &node, const glm::vec3 &origin, const glm::vec3 &inverse_direction, float max_t, float *entries) {
+
+			// Slab test. Infinite inverses work out, as long as the origin is not on a slab.
+			uint32_t mask = 0;
+			for (int i = 0; i < Bvh::WIDTH; i++) {
+
+				float t0x = (node.min_x[i] - origin.x) * inverse_direction.x, t1x = (node.max_x[i] - origin.x) * inverse_direction.x;
+				float t0y = (node.min_y[i] - origin.y) * inverse_direction.y, t1y = (node.max_y[i] - origin.y) * inverse_direction.y;
+				float t0z = (node.min_z[i] - origin.z) * inverse_direction.z, t1z = (node.max_z[i] - origin.z) * inverse_direction.z;
+
+				float t_near = std::max(std::max(std::min(t0x, t1x), std::min(t0y, t1y)), std::max(std::min(t0z, t1z), 0.0f));
+				float t_far = std::min(std::min(std::max(t0x, t1x), std::max(t0y, t1y)), std::min(std::max(t0z, t1z), max_t));
+				entries[i] = t_near;
+				if (t_near <= t_far)
+					mask |= 1u << i;
+
+			}
+
+			return mask;
+
+		}
+
+#ifdef BGQ_BVH_AVX2
+
+		__attribute__((target("avx2"))) uint32_t intersectBoxesAvx2(const BvhWideNode &node, const glm::vec3 &origin, const glm::vec3 &inverse_direction, float max_t, float *entries) {
+
+			// The same slab test, on the 8 children at once.
+			__m256 t0x = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(node.min_x), _mm256_set1_ps(origin.x)), _mm256_set1_ps(inverse_direction.x));
+			__m256 t1x = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(node.max_x), _mm256_set1_ps(origin.x)), _mm256_set1_ps(inverse_direction.x));
+			__m256 t0y = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(node.min_y), _mm256_set1_ps(origin.y)), _mm256_set1_ps(inverse_direction.y));
+			__m256 t1y = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(node.max_y), _mm256_set1_ps(origin.y)), _mm256_set1_ps(inverse_direction.y));
+			__m256 t0z = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(node.min_z), _mm256_set1_ps(origin.z)), _mm256_set1_ps(inverse_direction.z));
+			__m256 t1z = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(node.max_z), _mm256_set1_ps(origin.z)), _mm256_set1_ps(inverse_direction.z));
+
+			__m256 t_near = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(t0x, t1x), _mm256_min_ps(t0y, t1y)), _mm256_max_ps(_mm256_min_ps(t0z, t1z), _mm256_setzero_ps()));
+			__m256 t_far = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(t0x, t1x), _mm256_max_ps(t0y, t1y)), _mm256_min_ps(_mm256_max_ps(t0z, t1z), _mm256_set1_ps(max_t)));
+			_mm256_storeu_ps(entries, t_near);
+
+			return (uint32_t) _mm256_movemask_ps(_mm256_cmp_ps(t_near, t_far, _CMP_LE_OQ));
+
+		}
+
+#endif  // BGQ_BVH_AVX2
+
+		BoxTest getBoxTest(bool simd) {
+
+#ifdef BGQ_BVH_AVX2
+			if (simd && __builtin_cpu_supports("avx2"))
+				return intersectBoxesAvx2;
+#endif  // BGQ_BVH_AVX2
+
+			return intersectBoxesScalar;
+
+		}
+
+		BoxTest box_test = getBoxTest(true);
+
+		bool intersectTriangle(const glm::vec3 *corners, const glm::vec3 &origin, const glm::vec3 &direction, float max_t, float *t, float *u, float *v) {
+
+			// Möller-Trumbore, without culling either side.
+			glm::vec3 edge1 = corners[1] - corners[0];
+			glm::vec3 edge2 = corners[2] - corners[0];
+			glm::vec3 p = glm::cross(direction, edge2);
+			float determinant = glm::dot(edge1, p);
+			if (std::abs(determinant) < 1e-12f)
+				return false;
+
+			float inverse = 1.0f / determinant;
+			glm::vec3 s = origin - corners[0];
+			*u = glm::dot(s, p) * inverse;
+			if (*u < 0.0f || *u > 1.0f)
+				return false;
+
+			glm::vec3 q = glm::cross(s, edge1);
+			*v = glm::dot(direction, q) * inverse;
+			if (*v < 0.0f || *u + *v > 1.0f)
+				return false;
+
+			*t = glm::dot(edge2, q) * inverse;
+
+			return *t > 0.0f && *t < max_t;
+
+		}
+
+		float getArea(const glm::vec3 &min, const glm::vec3 &max) {
+
+			glm::vec3 size = glm::max(max - min, glm::vec3(0.0f));
+
+			return size.x * size.y + size.y * size.z + size.z * size.x;
+
+		}
+
+	}
+
+	Bvh::Bvh(std::span<const Vertex> vertices, std::span<const GLuint> indices, ThreadPool *pool) {
+
+		size_t num_triangles = indices.size() / 3;
+
+		std::vector<BoundingBox> bounds(num_triangles);
+		std::vector<glm::vec3> centroids(num_triangles);
+		this->normals.resize(3 * num_triangles);
+		for (size_t i = 0; i < num_triangles; i++) {
+
+			glm::vec3 a = vertices[indices[3 * i]].position;
+			glm::vec3 b = vertices[indices[3 * i + 1]].position;
+			glm::vec3 c = vertices[indices[3 * i + 2]].position;
+			bounds[i] = BoundingBox{glm::min(a, glm::min(b, c)), glm::max(a, glm::max(b, c))};
+			centroids[i] = (a + b + c) / 3.0f;
+
+			for (int corner = 0; corner < 3; corner++)
+				this->normals[3 * i + corner] = vertices[indices[3 * i + corner]].normal;
+
+		}
+
+		// Sort the triangles into the nodes, starting with all of them in the root.
+		this->triangles.resize(num_triangles);
+		std::iota(this->triangles.begin(), this->triangles.end(), 0);
+
+		std::vector<BvhNode> binary;
+		binary.reserve(2 * num_triangles / MAX_LEAF_SIZE + 1);
+		binary.push_back(BvhNode());
+
+		if (num_triangles == 0) {
+
+			this->bounding_box = BoundingBox{glm::vec3(0.0f), glm::vec3(0.0f)};
+			return;
+
+		}
+
+		if (pool == nullptr || num_triangles < PARALLEL_SIZE) {
+
+			build(&binary, 0, 0, this->triangles, bounds, centroids, 0, nullptr);
+
+		} else {
+
+			// Split the top of the tree here, and leave the smaller subtrees to the workers.
+			std::vector<std::pair<uint32_t, int>> subtrees;
+			build(&binary, 0, 0, this->triangles, bounds, centroids, 0, &subtrees);
+
+			std::vector<std::vector<BvhNode>> built(subtrees.size());
+			for (size_t i = 0; i < subtrees.size(); i++) {
+
+				const BvhNode &root = binary[subtrees[i].first];
+				uint32_t first = root.first;
+				std::span<uint32_t> range = std::span<uint32_t>(this->triangles).subspan(first, root.count);
+				int depth = subtrees[i].second;
+
+				(*pool).submit([&built, &bounds, &centroids, i, first, range, depth] {
+
+					built[i].push_back(BvhNode());
+					build(&built[i], 0, first, range, bounds, centroids, depth, nullptr);
+
+				});
+
+			}
+
+			(*pool).wait();
+
+			// Append every subtree, with its root in the place that was left for it.
+			for (size_t i = 0; i < subtrees.size(); i++) {
+
+				uint32_t base = (uint32_t) binary.size() - 1;
+				for (size_t j = 0; j < built[i].size(); j++) {
+
+					BvhNode node = built[i][j];
+					if (node.count == 0)
+						node.first += base;
+
+					if (j == 0)
+						binary[subtrees[i].first] = node;
+					else
+						binary.push_back(node);
+
+				}
+
+			}
+
+		}
+
+		this->bounding_box = BoundingBox{binary[0].min, binary[0].max};
+
+		// Copy the corners in the order of the leaves.
+		this->positions.resize(3 * num_triangles);
+		for (size_t i = 0; i < num_triangles; i++)
+			for (int corner = 0; corner < 3; corner++)
+				this->positions[3 * i + corner] = vertices[indices[3 * this->triangles[i] + corner]].position;
+
+		this->nodes.reserve(binary.size() / 4 + 1);
+		this->collapse(binary, 0);
+
+	}
+
+	void Bvh::build(std::vector<BvhNode> *nodes, uint32_t node, uint32_t first, std::span<uint32_t> triangles, const std::vector<BoundingBox> &bounds, const std::vector<glm::vec3> &centroids, int depth, std::vector<std::pair<uint32_t, int>> *subtrees) {
+
+		// Fit the node, and find how its centroids spread.
+		glm::vec3 box_min(INFINITY), box_max(-INFINITY);
+		glm::vec3 centroid_min(INFINITY), centroid_max(-INFINITY);
+		for (uint32_t triangle : triangles) {
+
+			box_min = glm::min(box_min, bounds[triangle].min);
+			box_max = glm::max(box_max, bounds[triangle].max);
+			centroid_min = glm::min(centroid_min, centroids[triangle]);
+			centroid_max = glm::max(centroid_max, centroids[triangle]);
+
+		}
+
+		(*nodes)[node].min = box_min;
+		(*nodes)[node].max = box_max;
+
+		if (triangles.size() <= MAX_LEAF_SIZE || depth == MAX_DEPTH - 1) {
+
+			(*nodes)[node].first = first;
+			(*nodes)[node].count = (uint32_t) triangles.size();
+			return;
+
+		}
+
+		// Bin the centroids along every axis, and keep the split with the lowest surface area heuristic.
+		float best_cost = INFINITY;
+		int best_axis = -1, best_split = 0;
+		for (int axis = 0; axis < 3; axis++) {
+
+			float extent = centroid_max[axis] - centroid_min[axis];
+			if (extent <= 0.0f)
+				continue;
+
+			float scale = NUM_BINS / extent;
+			uint32_t counts[NUM_BINS] = {};
+			glm::vec3 bin_min[NUM_BINS], bin_max[NUM_BINS];
+			for (int bin = 0; bin < NUM_BINS; bin++) {
+
+				bin_min[bin] = glm::vec3(INFINITY);
+				bin_max[bin] = glm::vec3(-INFINITY);
+
+			}
+
+			for (uint32_t triangle : triangles) {
+
+				int bin = std::min((int) ((centroids[triangle][axis] - centroid_min[axis]) * scale), NUM_BINS - 1);
+				counts[bin]++;
+				bin_min[bin] = glm::min(bin_min[bin], bounds[triangle].min);
+				bin_max[bin] = glm::max(bin_max[bin], bounds[triangle].max);
+
+			}
+
+			// Sweep from the right to get the cost of every right side, then from the left.
+			float right_costs[NUM_BINS];
+			glm::vec3 side_min(INFINITY), side_max(-INFINITY);
+			uint32_t side_count = 0;
+			for (int split = NUM_BINS - 1; split > 0; split--) {
+
+				side_min = glm::min(side_min, bin_min[split]);
+				side_max = glm::max(side_max, bin_max[split]);
+				side_count += counts[split];
+				right_costs[split] = side_count * getArea(side_min, side_max);
+
+			}
+
+			side_min = glm::vec3(INFINITY);
+			side_max = glm::vec3(-INFINITY);
+			side_count = 0;
+			for (int split = 1; split < NUM_BINS; split++) {
+
+				side_min = glm::min(side_min, bin_min[split - 1]);
+				side_max = glm::max(side_max, bin_max[split - 1]);
+				side_count += counts[split - 1];
+
+				float cost = side_count * getArea(side_min, side_max) + right_costs[split];
+				if (side_count > 0 && side_count < triangles.size() && cost < best_cost) {
+
+					best_cost = cost;
+					best_axis = axis;
+					best_split = split;
+
+				}
+
+			}
+
+		}
+
+		size_t half;
+		if (best_axis >= 0) {
+
+			float scale = NUM_BINS / (centroid_max[best_axis] - centroid_min[best_axis]);
+			auto middle = std::partition(triangles.begin(), triangles.end(), [&](uint32_t triangle) {
+
+				return std::min((int) ((centroids[triangle][best_axis] - centroid_min[best_axis]) * scale), NUM_BINS - 1) < best_split;
+
+			});
+			half = (size_t) (middle - triangles.begin());
+
+		} else {
+
+			// Every centroid is in the same place, so any split is as good as another.
+			half = triangles.size() / 2;
+
+		}
+
+		uint32_t left = (uint32_t) (*nodes).size();
+		(*nodes).push_back(BvhNode());
+		(*nodes).push_back(BvhNode());
+		(*nodes)[node].first = left;
+		(*nodes)[node].count = 0;
+
+		std::span<uint32_t> children[2] = {triangles.subspan(0, half), triangles.subspan(half)};
+		uint32_t child_first[2] = {first, first + (uint32_t) half};
+		for (int i = 0; i < 2; i++) {
+
+			if (subtrees != nullptr && children[i].size() < PARALLEL_SIZE) {
+
+				// Keep the range in the node until a worker builds it.
+				(*nodes)[left + i].first = child_first[i];
+				(*nodes)[left + i].count = (uint32_t) children[i].size();
+				(*subtrees).push_back(std::make_pair(left + i, depth + 1));
+
+			} else {
+
+				build(nodes, left + i, child_first[i], children[i], bounds, centroids, depth + 1, subtrees);
+
+			}
+
+		}
+
+	}
+
+	uint32_t Bvh::collapse(const std::vector<BvhNode> &binary, uint32_t node) {
+
+		uint32_t index = (uint32_t) this->nodes.size();
+		this->nodes.push_back(BvhWideNode());
+
+		// The unused children are empty boxes at infinity, which no ray hits.
+		for (int i = 0; i < WIDTH; i++) {
+
+			this->nodes[index].min_x[i] = this->nodes[index].min_y[i] = this->nodes[index].min_z[i] = INFINITY;
+			this->nodes[index].max_x[i] = this->nodes[index].max_y[i] = this->nodes[index].max_z[i] = INFINITY;
+			this->nodes[index].child[i] = 0;
+			this->nodes[index].count[i] = 0;
+
+		}
+
+		uint32_t children[WIDTH];
+		int num_children = 0;
+		if (binary[node].count > 0) {
+
+			children[num_children++] = node;
+
+		} else {
+
+			children[num_children++] = binary[node].first;
+			children[num_children++] = binary[node].first + 1;
+
+		}
+
+		// Open the inner child with the biggest surface until there are enough children.
+		while (num_children < WIDTH) {
+
+			int best = -1;
+			float best_area = -1.0f;
+			for (int i = 0; i < num_children; i++) {
+
+				const BvhNode &child = binary[children[i]];
+				float area = getArea(child.min, child.max);
+				if (child.count == 0 && area > best_area) {
+
+					best = i;
+					best_area = area;
+
+				}
+
+			}
+
+			if (best < 0)
+				break;
+
+			uint32_t opened = children[best];
+			children[best] = binary[opened].first;
+			children[num_children++] = binary[opened].first + 1;
+
+		}
+
+		for (int i = 0; i < num_children; i++) {
+
+			const BvhNode &child = binary[children[i]];
+
+			uint32_t target = child.first;
+			if (child.count == 0)
+				target = this->collapse(binary, children[i]);
+
+			BvhWideNode &wide = this->nodes[index];
+			wide.min_x[i] = child.min.x;
+			wide.min_y[i] = child.min.y;
+			wide.min_z[i] = child.min.z;
+			wide.max_x[i] = child.max.x;
+			wide.max_y[i] = child.max.y;
+			wide.max_z[i] = child.max.z;
+			wide.child[i] = target;
+			wide.count[i] = child.count;
+
+		}
+
+		return index;
+
+	}
+
+	BoundingBox Bvh::getBoundingBox() const {
+
+		return this->bounding_box;
+
+	}
+
+	glm::vec3 Bvh::getNormal(const RayHit &hit) const {
+
+		const glm::vec3 *normals = &this->normals[3 * hit.triangle];
+
+		return (1.0f - hit.u - hit.v) * normals[0] + hit.u * normals[1] + hit.v * normals[2];
+
+	}
+
+	size_t Bvh::getNumNodes() const {
+
+		return this->nodes.size();
+
+	}
+
+	size_t Bvh::getNumTriangles() const {
+
+		return this->triangles.size();
+
+	}
+
+	bool Bvh::intersect(const glm::vec3 &origin, const glm::vec3 &direction, float max_t, RayHit *hit) const {
+
+		if (this->positions.empty())
+			return false;
+
+		glm::vec3 inverse_direction = glm::vec3(1.0f) / direction;
+		bool found = false;
+
+		// The empty children are at infinity, so infinite rays are cut just before it.
+		max_t = std::min(max_t, std::numeric_limits<float>::max());
+
+		// Every node pops one entry and pushes at most 8, and the tree is not deeper than the binary one.
+		struct Entry {
+
+			uint32_t node;
+			float entry;
+
+		} stack[WIDTH * MAX_DEPTH];
+		int size = 0;
+		stack[size++] = Entry{0, 0.0f};
+
+		float entries[WIDTH];
+		int order[WIDTH];
+		while (size > 0) {
+
+			// Nodes pushed before the ray got shorter may be behind the closest hit by now.
+			Entry top = stack[--size];
+			if (top.entry > max_t)
+				continue;
+
+			const BvhWideNode &node = this->nodes[top.node];
+			uint32_t mask = box_test(node, origin, inverse_direction, max_t, entries);
+
+			// Test the leaves right away, since their hits shorten the ray for the rest.
+			int num_inner = 0;
+			while (mask != 0) {
+
+				int i = std::countr_zero(mask);
+				mask &= mask - 1;
+
+				if (node.count[i] == 0) {
+
+					order[num_inner++] = i;
+					continue;
+
+				}
+
+				for (uint32_t j = node.child[i]; j < node.child[i] + node.count[i]; j++) {
+
+					float t, u, v;
+					if (intersectTriangle(&this->positions[3 * j], origin, direction, max_t, &t, &u, &v)) {
+
+						max_t = t;
+						*hit = RayHit{t, u, v, this->triangles[j], -1};
+						found = true;
+
+					}
+
+				}
+
+			}
+
+			// Push the farthest children first, so the closest one is visited next.
+			for (int i = 1; i < num_inner; i++)
+				for (int j = i; j > 0 && entries[order[j]] > entries[order[j - 1]]; j--)
+					std::swap(order[j], order[j - 1]);
+
+			for (int i = 0; i < num_inner; i++)
+				if (entries[order[i]] <= max_t)
+					stack[size++] = Entry{node.child[order[i]], entries[order[i]]};
+
+		}
+
+		return found;
+
+	}
+
+	bool Bvh::intersect(const Ray &ray, RayHit *hit) const {
+
+		return this->intersect(ray.origin, ray.direction, ray.max_t, hit);
+
+	}
+
+	size_t Bvh::intersect(std::span<const Ray> rays, std::span<RayHit> hits, ThreadPool *pool) const {
+
+		std::atomic<size_t> num_hits = 0;
+		auto cast = [this, rays, hits, &num_hits](size_t begin, size_t end) {
+
+			size_t found = 0;
+			for (size_t i = begin; i < end; i++) {
+
+				hits[i] = RayHit{INFINITY, 0.0f, 0.0f, 0, -1};
+				if (this->intersect(rays[i], &hits[i]))
+					found++;
+
+			}
+
+			num_hits += found;
+
+		};
+
+		if (pool == nullptr || rays.size() <= BATCH_SIZE) {
+
+			cast(0, rays.size());
+			return num_hits;
+
+		}
+
+		for (size_t begin = 0; begin < rays.size(); begin += BATCH_SIZE) {
+
+			size_t end = std::min(begin + BATCH_SIZE, rays.size());
+			(*pool).submit([&cast, begin, end] {
+
+				cast(begin, end);
+
+			});
+
+		}
+
+		(*pool).wait();
+
+		return num_hits;
+
+	}
+
+	bool Bvh::isSimdSupported() {
+
+		return getBoxTest(true) != intersectBoxesScalar;
+
+	}
+
+	void Bvh::setSimd(bool enabled) {
+
+		box_test = getBoxTest(enabled);
+
+	}
+
+}  // namespace bgq_opengl
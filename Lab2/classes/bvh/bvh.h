@@ -0,0 +1,223 @@
+/**
+ * @file bvh.h
+ * @brief Bvh class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_BVH_H_
+#define BGQ_OPENGL_CLASSES_BVH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/thread_pool/thread_pool.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/bvh_node/bvh_node.h"
+#include "structs/bvh_wide_node/bvh_wide_node.h"
+#include "structs/ray/ray.h"
+#include "structs/ray_hit/ray_hit.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a Bvh class.
+	 *
+	 * A bounding volume hierarchy over the triangles of a mesh, to find the
+	 * closest triangle a ray hits. It is built as a binary tree with the
+	 * surface area heuristic and then collapsed into nodes of 8 children, so
+	 * that a ray is tested against 8 boxes at once with AVX2 when the CPU has
+	 * it, or one after the other when it does not.
+	 *
+	 * It keeps its own copy of the positions and normals, so it does not
+	 * depend on the mesh once it is built. Casting rays only reads it, so it
+	 * can be done from any number of threads at once.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class Bvh {
+
+		public:
+
+			static const int MAX_LEAF_SIZE = 4;				/// Maximum number of triangles in a leaf.
+			static const int MAX_DEPTH = 64;				/// Maximum depth of the binary tree.
+			static const int NUM_BINS = 16;					/// Candidate splits per axis of the surface area heuristic.
+			static const int WIDTH = 8;						/// Children of every node after collapsing the tree.
+			static const size_t PARALLEL_SIZE = 16384;		/// Triangles below which a subtree is built by a single worker.
+			static const size_t BATCH_SIZE = 1024;			/// Rays per job when casting them on a pool.
+
+			/**
+			 * @brief Builds a Bvh.
+			 *
+			 * Builds the hierarchy over the triangles of a mesh, splitting every
+			 * node where the surface area heuristic expects the cheapest
+			 * traversal. With a pool, the big subtrees are built by its workers,
+			 * so it must not be called from one of them.
+			 *
+			 * @param vertices The vertices of the mesh.
+			 * @param indices The indices of the triangles, three per triangle.
+			 * @param pool The workers to build with, or nullptr to build on this thread.
+			 */
+			Bvh(std::span<const Vertex> vertices, std::span<const GLuint> indices, ThreadPool *pool = nullptr);
+
+			/**
+			 * @brief Get the bounding box.
+			 *
+			 * Get the box of all the triangles.
+			 *
+			 * @returns The bounding box.
+			 */
+			BoundingBox getBoundingBox() const;
+
+			/**
+			 * @brief Get the normal at a hit.
+			 *
+			 * Get the normal at a hit, interpolated from the normals of the vertices.
+			 *
+			 * @param hit The hit.
+			 *
+			 * @returns The normal, not normalized.
+			 */
+			glm::vec3 getNormal(const RayHit &hit) const;
+
+			/**
+			 * @brief Get the number of nodes.
+			 *
+			 * Get the number of nodes of the collapsed tree.
+			 *
+			 * @returns The number of nodes.
+			 */
+			size_t getNumNodes() const;
+
+			/**
+			 * @brief Get the number of triangles.
+			 *
+			 * Get the number of triangles of the mesh.
+			 *
+			 * @returns The number of triangles.
+			 */
+			size_t getNumTriangles() const;
+
+			/**
+			 * @brief Casts a ray.
+			 *
+			 * Finds the closest triangle a ray hits, from either side, closer than
+			 * a maximum distance.
+			 *
+			 * @param origin The origin of the ray.
+			 * @param direction The direction of the ray, which does not need to be normalized.
+			 * @param max_t The maximum distance, in units of the direction.
+			 * @param hit Outputs the closest hit, if there is one.
+			 *
+			 * @returns True if the ray hit a triangle. False otherwise.
+			 */
+			bool intersect(const glm::vec3 &origin, const glm::vec3 &direction, float max_t, RayHit *hit) const;
+
+			/**
+			 * @brief Casts a ray.
+			 *
+			 * Finds the closest triangle a ray hits, from either side.
+			 *
+			 * @param ray The ray.
+			 * @param hit Outputs the closest hit, if there is one.
+			 *
+			 * @returns True if the ray hit a triangle. False otherwise.
+			 */
+			bool intersect(const Ray &ray, RayHit *hit) const;
+
+			/**
+			 * @brief Casts a batch of rays.
+			 *
+			 * Finds the closest triangle every ray hits. The rays that miss get a
+			 * hit at an infinite distance. With a pool, the rays are split in
+			 * batches between its workers, so it must not be called from one of
+			 * them.
+			 *
+			 * @param rays The rays.
+			 * @param hits Outputs the hit of every ray.
+			 * @param pool The workers to cast with, or nullptr to cast on this thread.
+			 *
+			 * @returns The number of rays that hit a triangle.
+			 */
+			size_t intersect(std::span<const Ray> rays, std::span<RayHit> hits, ThreadPool *pool = nullptr) const;
+
+			/**
+			 * @brief Whether the CPU has AVX2.
+			 *
+			 * Whether the boxes can be tested with AVX2 on this CPU.
+			 *
+			 * @returns True if AVX2 can be used. False otherwise.
+			 */
+			static bool isSimdSupported();
+
+			/**
+			 * @brief Sets whether AVX2 is used.
+			 *
+			 * Sets whether the boxes are tested with AVX2, which is the default
+			 * when the CPU has it, or one at a time. It is meant to compare both,
+			 * so it must not be called while rays are being cast.
+			 *
+			 * @param enabled True to use AVX2 when the CPU has it.
+			 */
+			static void setSimd(bool enabled);
+
+		private:
+
+			/**
+			 * @brief Builds a binary node.
+			 *
+			 * Fits a node to its triangles and splits it, unless it is small or
+			 * deep enough to be a leaf. With a list of subtrees, the children
+			 * smaller than PARALLEL_SIZE are added to it instead of being built.
+			 *
+			 * @param nodes The nodes of the tree being built.
+			 * @param node The index of the node.
+			 * @param first The index of the first triangle of the node among the sorted ones.
+			 * @param triangles The triangles of the node, sorted in place.
+			 * @param bounds The boxes of all the triangles.
+			 * @param centroids The centroids of all the triangles.
+			 * @param depth The depth of the node.
+			 * @param subtrees Outputs the nodes left to build and their depths, or nullptr to build them all.
+			 */
+			static void build(std::vector<BvhNode> *nodes, uint32_t node, uint32_t first, std::span<uint32_t> triangles, const std::vector<BoundingBox> &bounds, const std::vector<glm::vec3> &centroids, int depth, std::vector<std::pair<uint32_t, int>> *subtrees);
+
+			/**
+			 * @brief Collapses a binary node.
+			 *
+			 * Turns a binary node into a node of up to 8 children, by opening its
+			 * biggest inner descendants until there are enough of them, and then
+			 * collapses those children too.
+			 *
+			 * @param binary The binary tree.
+			 * @param node The index of the binary node.
+			 *
+			 * @returns The index of the collapsed node.
+			 */
+			uint32_t collapse(const std::vector<BvhNode> &binary, uint32_t node);
+
+			BoundingBox bounding_box;			/// Box of all the triangles.
+			std::vector<BvhWideNode> nodes;		/// Nodes of the collapsed tree, the root first.
+			std::vector<glm::vec3> positions;	/// Positions of the corners of every sorted triangle.
+			std::vector<uint32_t> triangles;	/// Index in the mesh of every sorted triangle.
+			std::vector<glm::vec3> normals;		/// Normals of the corners of every triangle, in the order of the mesh.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_BVH_H_
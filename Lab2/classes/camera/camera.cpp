@@ -61,6 +61,18 @@ namespace bgq_opengl {
 
 	}
 
+	float Camera::getFar() {
+
+		return this->far;
+
+	}
+
+	float Camera::getNear() {
+
+		return this->near;
+
+	}
+
 	glm::mat4 Camera::getProjection() {
 
 		return this->projection;
@@ -79,6 +91,13 @@ namespace bgq_opengl {
 
 	}
 
+	void Camera::lookAt(glm::vec3 position, glm::vec3 target) {
+
+		this->position = position;
+		this->direction = glm::normalize(target - position);
+
+	}
+
 	void Camera::moveBack() {
 
 		// Clone the direction.
@@ -235,10 +254,24 @@ namespace bgq_opengl {
 
 	}
 
+	void Camera::setMirrored(bool mirrored) {
+
+		this->mirrored = mirrored;
+
+	}
+
+	void Camera::setUp(glm::vec3 up) {
+
+		this->up = up;
+
+	}
+
 	void Camera::update() {
 
-		// Calculate the view matrix.
-		this->view = glm::lookAt(this->position, this->position + this->direction, this->up);
+		// Calculate the view matrix, mirroring the world along z around the camera for the cube maps.
+		glm::vec3 flip = this->mirrored ? glm::vec3(1.0f, 1.0f, -1.0f) : glm::vec3(1.0f);
+		glm::vec3 eye = this->position * flip;
+		this->view = glm::scale(glm::lookAt(eye, eye + this->direction, this->up), flip);
 
 		// Adds perspective to the scene.
 		float ratio = (float)this->window_width / this->window_height;
@@ -61,6 +61,20 @@ namespace bgq_opengl {
 			 */
 			glm::vec3 getDirection();
 
+			/**
+			 * @brief Get the far clipping distance.
+			 *
+			 * Get the far clipping distance.
+			 */
+			float getFar();
+
+			/**
+			 * @brief Get the near clipping distance.
+			 *
+			 * Get the near clipping distance.
+			 */
+			float getNear();
+
 			/**
 			 * @brief Get the camera position.
 			 *
@@ -89,6 +103,16 @@ namespace bgq_opengl {
 			 */
 			glm::mat4 getView();
 
+			/**
+			 * @brief Point the camera at a target.
+			 *
+			 * Move the camera to a position and make it look at a target.
+			 *
+			 * @param position The new camera coordinates.
+			 * @param target The point to look at.
+			 */
+			void lookAt(glm::vec3 position, glm::vec3 target);
+
 			/**
 			 * @brief Move tha camera backwards.
 			 * 
@@ -159,6 +183,28 @@ namespace bgq_opengl {
 			 */
 			void rotateUp();
 
+			/**
+			 * @brief Mirror the world along z.
+			 * 
+			 * Mirror the world along the z axis before looking at it, so that the
+			 * camera renders the faces of a cube map the way the skyboxes lay
+			 * them out. The direction and the up vector are given in the mirrored
+			 * world.
+			 *
+			 * @param mirrored Whether to mirror the world.
+			 */
+			void setMirrored(bool mirrored);
+
+			/**
+			 * @brief Set the camera up vector.
+			 * 
+			 * Set the vector that tells the rotation of the camera around its
+			 * direction. It must not be parallel to the direction.
+			 *
+			 * @param up The new up vector.
+			 */
+			void setUp(glm::vec3 up);
+
 			/**
 			 * @brief Calculate the camera matrix from the parameters.
 			 *
@@ -172,6 +218,7 @@ namespace bgq_opengl {
 			glm::vec3 direction;		/// Vector indicating where the camera is looking.
 			float far;					/// Maximum clipping limit.
 			float fov;					/// Field of view;
+			bool mirrored = false;		/// Whether the world is mirrored along z.
 			float near;					/// Minimum clipping limit.
 			glm::vec3 position;			/// Coordinates of the camera.
 			glm::vec3 up;				/// Vector that tells us the rotation of the camera.
@@ -0,0 +1,178 @@
+/**
+ * @file concurrent_queue.h
+ * @brief ConcurrentQueue class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_CONCURRENTQUEUE_H_
+#define BGQ_OPENGL_CLASSES_CONCURRENTQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a ConcurrentQueue class.
+	 *
+	 * A bounded lock-free queue that any number of threads can push to and pop
+	 * from at the same time. Every slot has a sequence number that tells whether
+	 * it is ready to be written or read in the current lap around the ring, so
+	 * threads only ever race on the head and tail counters.
+	 *
+	 * It is meant for small trivially copyable items, like indices.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	template <typename T>
+	class ConcurrentQueue {
+
+		public:
+
+			/**
+			 * @brief Constructs the queue.
+			 *
+			 * Constructs the queue and allocates all its slots.
+			 *
+			 * @param capacity The minimum number of items it can hold. It is rounded up to a power of two.
+			 */
+			ConcurrentQueue(size_t capacity) {
+
+				size_t size = 2;
+				while (size < capacity)
+					size *= 2;
+
+				this->slots = std::vector<Slot>(size);
+				this->mask = size - 1;
+				for (size_t i = 0; i < size; i++)
+					this->slots[i].sequence.store(i, std::memory_order_relaxed);
+
+			}
+
+			ConcurrentQueue(const ConcurrentQueue&) = delete;
+			ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+			/**
+			 * @brief Pushes an item.
+			 *
+			 * Pushes an item at the back of the queue.
+			 *
+			 * @param item The item.
+			 *
+			 * @returns True if it was pushed. False if the queue is full.
+			 */
+			bool push(const T &item) {
+
+				size_t position = this->tail.load(std::memory_order_relaxed);
+				while (true) {
+
+					Slot &slot = this->slots[position & this->mask];
+					size_t sequence = slot.sequence.load(std::memory_order_acquire);
+					ptrdiff_t difference = (ptrdiff_t) sequence - (ptrdiff_t) position;
+
+					// The slot is free in this lap, so try to claim it.
+					if (difference == 0) {
+
+						if (this->tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+
+							slot.item = item;
+							slot.sequence.store(position + 1, std::memory_order_release);
+							return true;
+
+						}
+
+					// The slot still holds an item from the previous lap.
+					} else if (difference < 0) {
+
+						return false;
+
+					// Another thread claimed it first.
+					} else {
+
+						position = this->tail.load(std::memory_order_relaxed);
+
+					}
+
+				}
+
+			}
+
+			/**
+			 * @brief Pops an item.
+			 *
+			 * Pops the item at the front of the queue.
+			 *
+			 * @param item Outputs the item.
+			 *
+			 * @returns True if an item was popped. False if the queue is empty.
+			 */
+			bool pop(T *item) {
+
+				size_t position = this->head.load(std::memory_order_relaxed);
+				while (true) {
+
+					Slot &slot = this->slots[position & this->mask];
+					size_t sequence = slot.sequence.load(std::memory_order_acquire);
+					ptrdiff_t difference = (ptrdiff_t) sequence - (ptrdiff_t) (position + 1);
+
+					// The slot was written in this lap, so try to claim it.
+					if (difference == 0) {
+
+						if (this->head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+
+							*item = slot.item;
+							slot.sequence.store(position + this->mask + 1, std::memory_order_release);
+							return true;
+
+						}
+
+					// Nothing has been written there yet.
+					} else if (difference < 0) {
+
+						return false;
+
+					// Another thread claimed it first.
+					} else {
+
+						position = this->head.load(std::memory_order_relaxed);
+
+					}
+
+				}
+
+			}
+
+		private:
+
+			/**
+			 * @brief A slot of the ring.
+			 *
+			 * An item and the sequence number that says who can use it next.
+			 */
+			struct Slot {
+
+				std::atomic<size_t> sequence;	/// Position this slot can be written at, or that position plus one once written.
+				T item;							/// The item.
+
+			};
+
+			std::vector<Slot> slots;				/// Ring of slots.
+			size_t mask = 0;						/// Number of slots minus one.
+			alignas(64) std::atomic<size_t> head{0};	/// Next position to read.
+			alignas(64) std::atomic<size_t> tail{0};	/// Next position to write.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_CONCURRENTQUEUE_H_
@@ -16,12 +16,22 @@
 #include "cubemap.h"
 
 #include <iostream>
+#include <memory>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "GL/glew.h"
 #include "stb/stb_image.h"
 
+#include "classes/draw_counter/draw_counter.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/texture_file/texture_file.h"
+#include "classes/thread_pool/thread_pool.h"
+#include "structs/image_data/image_data.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
+
 namespace bgq_opengl {
 
     Cubemap::Cubemap(GLuint id, std::string name, GLuint slot) {
@@ -32,48 +42,114 @@ namespace bgq_opengl {
         
     }
 
+    namespace {
+
+        std::vector<ImageData> loadFaces(const std::vector<std::string> &textures_faces) {
+
+            // Decode every face on its own thread, as decoding is most of the time spent here.
+            std::vector<ImageData> faces(textures_faces.size());
+            std::vector<char> loaded(textures_faces.size(), 0);
+            {
+                ThreadPool pool((unsigned int) textures_faces.size());
+                for (size_t i = 0; i < textures_faces.size(); i++)
+                    pool.submit([&, i] { loaded[i] = Cubemap::loadFace(textures_faces[i], &faces[i]); });
+                pool.wait();
+            }
+
+            for (size_t i = 0; i < textures_faces.size(); i++) {
+
+                if (!loaded[i]) {
+
+                    std::cerr << "Cubemap error: cubemap " << textures_faces[i] << " could not be loaded." << std::endl;
+                    exit(1);
+
+                }
+
+            }
+
+            return faces;
+
+        }
+
+    }
+
     Cubemap::Cubemap(const std::vector<std::string> &textures_faces, const char* type, GLuint slot) {
 
-        // Generate a texture in OpenGL and store the parameters in the attributes.
-        glGenTextures(1, &this->ID);
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, this->ID);
+        this->create(type, slot);
+
+        // Use the baked file if there is one, and decode the faces otherwise.
+        TextureFile baked(TextureFile::getBakedFilename(textures_faces[0], ".cubemap"));
+        if (baked.isOpen() && baked.isSupported() && baked.getNumFaces() == 6)
+            this->upload(baked);
+        else
+            this->upload(loadFaces(textures_faces));
+
+    }
+
+    Cubemap::Cubemap(std::span<const ImageData> faces, const char* type, GLuint slot) {
+
+        this->create(type, slot);
+        this->upload(faces);
+
+    }
+
+    Cubemap::Cubemap(const TextureFile &file, const char* type, GLuint slot) {
+
+        this->create(type, slot);
+        this->upload(file);
+
+    }
+
+    Cubemap::Cubemap(Cubemap&& other) noexcept : ID(other.ID), slot(other.slot), memory_size(other.memory_size), base_size(other.base_size), internal_format(other.internal_format), irradiance(other.irradiance), name(std::move(other.name)) {
+
+        // Leave the other one empty so it does not delete the object.
+        other.ID = 0;
+
+    }
+
+    Cubemap& Cubemap::operator=(Cubemap&& other) noexcept {
+
+        if (this != &other) {
+
+            // Release the current object before taking the other one.
+            this->remove();
+
+            this->ID = other.ID;
+            this->slot = other.slot;
+            this->memory_size = other.memory_size;
+            this->base_size = other.base_size;
+            this->internal_format = other.internal_format;
+            this->irradiance = other.irradiance;
+            this->name = std::move(other.name);
+            other.ID = 0;
+
+        }
+
+        return *this;
+
+    }
+
+    Cubemap::~Cubemap() {
+
+        this->remove();
+
+    }
+
+    GLuint Cubemap::getID() {
         
-        this->name = std::string(name);
-        this->slot = slot;
+        return this->ID;
         
-        int width, height, channels;
-        
-        // Loop through the images, load them and pass them to OpenGL.
-        for (unsigned int i = 0; i < textures_faces.size(); i++) {
-            
-            unsigned char *data = stbi_load(textures_faces[i].c_str(), &width, &height, &channels, 0);
-            if (data) {
-                
-                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-                stbi_image_free(data);
-                
-            } else {
-                
-                std::cerr << "Cubemap error: cubemap " << textures_faces[i] << " could not be loaded." << std::endl;
-                stbi_image_free(data);
-                exit(1);
-                
-            }
-            
-        }
+    }
+
+    const IrradianceBlock& Cubemap::getIrradiance() {
         
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        return this->irradiance;
         
     }
 
-    GLuint Cubemap::getID() {
+    size_t Cubemap::getMemorySize() {
         
-        return this->ID;
+        return this->memory_size;
         
     }
 
@@ -83,7 +159,7 @@ namespace bgq_opengl {
         
     }
 
-    std::string Cubemap::getName() {
+    const std::string& Cubemap::getName() {
         
         return this->name;
         
@@ -91,21 +167,133 @@ namespace bgq_opengl {
 
     void Cubemap::bind() {
         
-        // Activate the texture and bind it.
-        glActiveTexture(GL_TEXTURE0 + this->slot);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, this->ID);
+        // Activate the texture and bind it, unless it already is.
+        if (GlState::bindTexture(this->slot, GL_TEXTURE_CUBE_MAP, this->ID))
+            DrawCounter::recordTextureBind();
         
     }
 
     void Cubemap::remove() {
         
-        glDeleteTextures(1, &this->ID);
+        // Delete the texture in OpenGL, if there is one.
+        if (this->ID != 0)
+            GlState::deleteTexture(this->ID);
+        this->ID = 0;
+        
+    }
+
+    void Cubemap::setIrradiance(const IrradianceBlock &irradiance) {
+        
+        this->irradiance = irradiance;
+        
+    }
+
+    void Cubemap::setPrefiltered(const TextureFile &file) {
+        
+        GlState::bindTexture(this->slot, GL_TEXTURE_CUBE_MAP, this->ID);
+        
+        // The first level stays, and the file holds the ones after it.
+        for (int level = 0; level < file.getNumLevels(); level++) {
+
+            int width = file.getWidth(level), height = file.getHeight(level);
+            for (int i = 0; i < 6; i++) {
+
+                std::span<const std::byte> face = file.getFace(level, i);
+                if (file.isCompressed())
+                    glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level + 1, file.getInternalFormat(), width, height, 0, (GLsizei) face.size(), face.data());
+                else
+                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level + 1, this->internal_format, width, height, 0, file.getFormat(), file.getType(), face.data());
+
+            }
+
+        }
+
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, file.getNumLevels());
+        this->memory_size = this->base_size + file.getMemorySize();
         
     }
 
     void Cubemap::unbind() {
         
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        // Unbind it from its slot.
+        if (GlState::bindTexture(this->slot, GL_TEXTURE_CUBE_MAP, 0))
+            DrawCounter::recordTextureBind();
+        
+    }
+
+    void Cubemap::create(const char* type, GLuint slot) {
+
+        // Generate a texture in OpenGL and store the parameters in the attributes.
+        glGenTextures(1, &this->ID);
+        GlState::bindTexture(slot, GL_TEXTURE_CUBE_MAP, this->ID);
+        
+        this->name = std::string(type);
+        this->slot = slot;
+
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    }
+
+    void Cubemap::upload(std::span<const ImageData> faces) {
+
+        // Loop through the images and pass them to OpenGL.
+        for (unsigned int i = 0; i < faces.size(); i++)
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, faces[i].width, faces[i].height, 0, GL_RGB, GL_UNSIGNED_BYTE, faces[i].pixels.get());
+
+        // Let the driver build the mip chain the baked files already have.
+        glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+
+        // Drivers keep RGB as RGBA, and the mip chain adds a third.
+        this->internal_format = GL_RGB;
+        this->base_size = 0;
+        for (const ImageData &face : faces)
+            this->base_size += (size_t) face.width * face.height * 4;
+        this->memory_size = this->base_size * 4 / 3;
+
+    }
+
+    void Cubemap::upload(const TextureFile &file) {
+
+        // Every level is handed over straight from the mapping.
+        for (int level = 0; level < file.getNumLevels(); level++) {
+
+            int width = file.getWidth(level), height = file.getHeight(level);
+            for (int i = 0; i < 6; i++) {
+
+                std::span<const std::byte> face = file.getFace(level, i);
+                if (file.isCompressed())
+                    glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level, file.getInternalFormat(), width, height, 0, (GLsizei) face.size(), face.data());
+                else
+                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level, file.getInternalFormat(), width, height, 0, file.getFormat(), file.getType(), face.data());
+
+            }
+
+        }
+
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, file.getNumLevels() - 1);
+        this->internal_format = file.getInternalFormat();
+        this->base_size = 6 * file.getFace(0, 0).size();
+        this->memory_size = file.getMemorySize();
+
+    }
+
+    bool Cubemap::loadFace(const std::string &filename, ImageData *image) {
+        
+        // Cubemap faces are not flipped, whatever the textures loaded in this thread did.
+        stbi_set_flip_vertically_on_load_thread(false);
+        
+        unsigned char *data = stbi_load(filename.c_str(), &image->width, &image->height, &image->channels, 0);
+        if (!data)
+            return false;
+        
+        // The pixels are freed by stb when the last copy of the image is gone.
+        image->pixels = std::shared_ptr<unsigned char>(data, stbi_image_free);
+        
+        return true;
         
     }
 
@@ -18,11 +18,17 @@
 #ifndef BGQ_OPENGL_CLASSES_CUBEMAP_H_
 #define BGQ_OPENGL_CLASSES_CUBEMAP_H_
 
+#include <span>
 #include <string>
 #include <vector>
 
 #include "GL/glew.h"
 
+#include "classes/spherical_harmonics/spherical_harmonics.h"
+#include "classes/texture_file/texture_file.h"
+#include "structs/image_data/image_data.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
+
 namespace bgq_opengl {
 
     /**
@@ -37,11 +43,11 @@ namespace bgq_opengl {
         public:
         
             /**
-             * @brief Copies a cubemap from another.
+             * @brief Wraps an existing cubemap.
              *
-             * Copies a cubemap from another.
+             * Wraps an existing cubemap texture and takes ownership of it.
              *
-             * @param id The cubemap to be copied.
+             * @param id The cubemap to be wrapped, or 0 for none.
              * @param name The name of this texture.
              * @param slot The slot for this texture.
              */
@@ -50,7 +56,9 @@ namespace bgq_opengl {
             /**
              * @brief Constructs a skybox instance.
              *
-             * Constructs a skybox instance.
+             * Constructs a skybox instance. If the first face has a baked file next
+             * to it, in a format the context supports, that is loaded instead. Otherwise the faces are decoded in
+             * parallel, one thread each.
              *
              * @param textures_faces A vector containing the skybox faces in the right, left, top, bottom, back, and front order.
              * @param type Texture type.
@@ -58,6 +66,66 @@ namespace bgq_opengl {
              */
             Cubemap(const std::vector<std::string> &textures_faces, const char* type, GLuint slot);
 
+            /**
+             * @brief Constructs a skybox instance from decoded faces.
+             *
+             * Constructs a skybox instance from faces that were already decoded,
+             * maybe on another thread, with loadFace.
+             *
+             * @param faces The decoded faces in the right, left, top, bottom, back, and front order.
+             * @param type Texture type.
+             * @param slot Texture slot.
+             */
+            Cubemap(std::span<const ImageData> faces, const char* type, GLuint slot);
+
+            /**
+             * @brief Constructs a skybox instance from a baked file.
+             *
+             * Constructs a skybox instance from a baked cubemap, uploading all its
+             * mip levels straight from the mapped file.
+             *
+             * @param file The baked cubemap.
+             * @param type Texture type.
+             * @param slot Texture slot.
+             */
+            Cubemap(const TextureFile &file, const char* type, GLuint slot);
+
+            /**
+             * @brief Cubemap objects cannot be copied.
+             *
+             * Cubemap objects own their texture, so they cannot be copied.
+             */
+            Cubemap(const Cubemap&) = delete;
+            Cubemap& operator=(const Cubemap&) = delete;
+
+            /**
+             * @brief Moves a Cubemap.
+             *
+             * Takes the texture from another Cubemap, which is left empty.
+             *
+             * @param other The Cubemap to move from.
+             */
+            Cubemap(Cubemap&& other) noexcept;
+
+            /**
+             * @brief Moves a Cubemap.
+             *
+             * Removes the current texture and takes the one of another Cubemap, which
+             * is left empty.
+             *
+             * @param other The Cubemap to move from.
+             *
+             * @returns This Cubemap.
+             */
+            Cubemap& operator=(Cubemap&& other) noexcept;
+
+            /**
+             * @brief Destroys the Cubemap.
+             *
+             * Removes the texture from OpenGL.
+             */
+            ~Cubemap();
+
             /**
              * @brief Get the ID of the texture.
              *
@@ -67,6 +135,26 @@ namespace bgq_opengl {
              */
             GLuint getID();
 
+            /**
+             * @brief Get the diffuse light of the texture.
+             *
+             * Get the spherical harmonics of the diffuse light the texture casts,
+             * or an even white light if they were never set.
+             *
+             * @returns The coefficients.
+             */
+            const IrradianceBlock& getIrradiance();
+
+            /**
+             * @brief Get the size of the texture.
+             *
+             * Get how much memory the texture takes on the GPU, mip levels included.
+             * It is worked out from its format, so drivers may round it up.
+             *
+             * @returns The size in bytes.
+             */
+            size_t getMemorySize();
+
             /**
              * @brief Get the slot of the texture.
              *
@@ -83,7 +171,7 @@ namespace bgq_opengl {
              *
              * @returns A char string containing the name name of the texture.
              */
-            std::string getName();
+            const std::string& getName();
 
             /**
              * @brief Binds the texture.
@@ -99,6 +187,27 @@ namespace bgq_opengl {
              */
             void remove();
 
+            /**
+             * @brief Sets the diffuse light of the texture.
+             *
+             * Sets the spherical harmonics of the diffuse light the texture
+             * casts, as SphericalHarmonics projects them.
+             *
+             * @param irradiance The coefficients.
+             */
+            void setIrradiance(const IrradianceBlock &irradiance);
+
+            /**
+             * @brief Replaces the mip chain with a prefiltered one.
+             *
+             * Replaces the levels past the first one with the ones of a
+             * CubemapFilter cache and stops sampling the rest, so that the levels
+             * go from a roughness of 0 to 1.
+             *
+             * @param file The prefiltered levels, which have to match the first level.
+             */
+            void setPrefiltered(const TextureFile &file);
+
             /**
              * @brief Unbinds the texture.
              *
@@ -106,10 +215,55 @@ namespace bgq_opengl {
              */
             void unbind();
 
+            /**
+             * @brief Decodes a face.
+             *
+             * Decodes the image of a face. It does not touch OpenGL, so it can be
+             * called from a worker thread.
+             *
+             * @param filename The name of the image file.
+             * @param image Outputs the decoded image.
+             *
+             * @returns True if the image could be decoded. False otherwise.
+             */
+            static bool loadFace(const std::string &filename, ImageData *image);
+
         private:
 
-            GLuint ID;                      /// Texture OpenGL ID.
+            /**
+             * @brief Creates the texture.
+             *
+             * Generates and binds the texture and sets its sampling parameters.
+             *
+             * @param type Texture type.
+             * @param slot Texture slot.
+             */
+            void create(const char* type, GLuint slot);
+
+            /**
+             * @brief Uploads decoded faces.
+             *
+             * Uploads decoded faces to the bound texture and builds their mip chain.
+             *
+             * @param faces The decoded faces.
+             */
+            void upload(std::span<const ImageData> faces);
+
+            /**
+             * @brief Uploads a baked file.
+             *
+             * Uploads all the mip levels of a baked cubemap to the bound texture.
+             *
+             * @param file The baked cubemap.
+             */
+            void upload(const TextureFile &file);
+
+            GLuint ID = 0;                  /// Texture OpenGL ID.
             GLuint slot;                    /// Stores the texture slot number.
+            size_t memory_size = 0;         /// Size of the texture on the GPU in bytes.
+            size_t base_size = 0;           /// Size of the first level on the GPU in bytes.
+            GLenum internal_format = GL_RGB;    /// Internal format of the first level.
+            IrradianceBlock irradiance = SphericalHarmonics::getFlat();    /// Diffuse light of the texture.
             std::string name;               /// Texture name.
 
     };
@@ -0,0 +1,384 @@
+/**
+ * @file cubemap_filter.cpp
+ * @brief CubemapFilter class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "cubemap_filter.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/block_compressor/block_compressor.h"
+#include "classes/texture_file/texture_file.h"
+#include "classes/thread_pool/thread_pool.h"
+#include "structs/image_data/image_data.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		const float PI = 3.14159265358979f;
+		const int ROWS_PER_JOB = 16;
+
+		// The lobes are much wider than the texels of the big levels, so those are integrated at this size and scaled up.
+		const int MAX_FILTER_SIZE = 256;
+
+		// Box filtered levels of the six faces in RGB, past the first one, which is read from the images.
+		typedef std::vector<std::array<std::vector<float>, 6>> FaceChain;
+
+		// A sample of the lobe around +Z, with the level it is read from.
+		struct LobeSample {
+
+			glm::vec3 direction;
+			float weight;
+			float lod;
+
+		};
+
+		glm::vec3 getDirection(int face, float sc, float tc) {
+
+			// The inverse of the face selection of the OpenGL specification.
+			switch (face) {
+
+				case 0: return glm::vec3(1.0f, -tc, -sc);
+				case 1: return glm::vec3(-1.0f, -tc, sc);
+				case 2: return glm::vec3(sc, 1.0f, tc);
+				case 3: return glm::vec3(sc, -1.0f, -tc);
+				case 4: return glm::vec3(sc, -tc, 1.0f);
+				default: return glm::vec3(-sc, -tc, -1.0f);
+
+			}
+
+		}
+
+		void getFaceCoordinates(const glm::vec3 &direction, int *face, float *u, float *v) {
+
+			glm::vec3 a = glm::abs(direction);
+			float sc, tc, ma;
+			if (a.x >= a.y && a.x >= a.z) {
+
+				*face = direction.x > 0.0f ? 0 : 1;
+				sc = direction.x > 0.0f ? -direction.z : direction.z;
+				tc = -direction.y;
+				ma = a.x;
+
+			} else if (a.y >= a.z) {
+
+				*face = direction.y > 0.0f ? 2 : 3;
+				sc = direction.x;
+				tc = direction.y > 0.0f ? direction.z : -direction.z;
+				ma = a.y;
+
+			} else {
+
+				*face = direction.z > 0.0f ? 4 : 5;
+				sc = direction.z > 0.0f ? direction.x : -direction.x;
+				tc = -direction.y;
+				ma = a.z;
+
+			}
+
+			*u = (sc / ma + 1.0f) / 2.0f;
+			*v = (tc / ma + 1.0f) / 2.0f;
+
+		}
+
+		glm::vec3 getTexel(std::span<const ImageData> faces, const FaceChain &chain, int level, int face, int size, int x, int y) {
+
+			if (level > 0) {
+
+				const float *texel = &chain[level][face][((size_t) y * size + x) * 3];
+				return glm::vec3(texel[0], texel[1], texel[2]);
+
+			}
+
+			// Grey images only have one channel for the three.
+			const ImageData &image = faces[face];
+			const unsigned char *texel = image.pixels.get() + ((size_t) y * size + x) * image.channels;
+			if (image.channels < 3)
+				return glm::vec3(texel[0]);
+
+			return glm::vec3(texel[0], texel[1], texel[2]);
+
+		}
+
+		glm::vec3 sampleLevel(std::span<const ImageData> faces, const FaceChain &chain, int level, int face, float u, float v) {
+
+			// Bilinear, clamped to the edges of the face.
+			int size = std::max(faces[0].width >> level, 1);
+			float x = u * size - 0.5f, y = v * size - 0.5f;
+			int x0 = (int) std::floor(x), y0 = (int) std::floor(y);
+			float fx = x - x0, fy = y - y0;
+			int x1 = std::clamp(x0 + 1, 0, size - 1), y1 = std::clamp(y0 + 1, 0, size - 1);
+			x0 = std::clamp(x0, 0, size - 1);
+			y0 = std::clamp(y0, 0, size - 1);
+
+			glm::vec3 top = glm::mix(getTexel(faces, chain, level, face, size, x0, y0), getTexel(faces, chain, level, face, size, x1, y0), fx);
+			glm::vec3 bottom = glm::mix(getTexel(faces, chain, level, face, size, x0, y1), getTexel(faces, chain, level, face, size, x1, y1), fx);
+
+			return glm::mix(top, bottom, fy);
+
+		}
+
+		glm::vec3 sample(std::span<const ImageData> faces, const FaceChain &chain, const glm::vec3 &direction, float lod) {
+
+			int face;
+			float u, v;
+			getFaceCoordinates(direction, &face, &u, &v);
+
+			lod = std::clamp(lod, 0.0f, (float) (chain.size() - 1));
+			int level = (int) lod;
+			glm::vec3 color = sampleLevel(faces, chain, level, face, u, v);
+			if (level + 1 < (int) chain.size())
+				color = glm::mix(color, sampleLevel(faces, chain, level + 1, face, u, v), lod - level);
+
+			return color;
+
+		}
+
+		void buildChain(std::span<const ImageData> faces, int face, FaceChain *chain) {
+
+			// Average every 2x2 block of the level above.
+			for (size_t level = 1; level < (*chain).size(); level++) {
+
+				int size = std::max(faces[0].width >> level, 1);
+				int above = std::max(faces[0].width >> (level - 1), 1);
+				std::vector<float> &pixels = (*chain)[level][face];
+				pixels.resize((size_t) size * size * 3);
+				for (int y = 0; y < size; y++) {
+
+					for (int x = 0; x < size; x++) {
+
+						int x0 = std::min(2 * x, above - 1), x1 = std::min(2 * x + 1, above - 1);
+						int y0 = std::min(2 * y, above - 1), y1 = std::min(2 * y + 1, above - 1);
+						glm::vec3 sum = getTexel(faces, *chain, (int) level - 1, face, above, x0, y0) + getTexel(faces, *chain, (int) level - 1, face, above, x1, y0)
+									  + getTexel(faces, *chain, (int) level - 1, face, above, x0, y1) + getTexel(faces, *chain, (int) level - 1, face, above, x1, y1);
+						for (int c = 0; c < 3; c++)
+							pixels[((size_t) y * size + x) * 3 + c] = sum[c] / 4.0f;
+
+					}
+
+				}
+
+			}
+
+		}
+
+		std::vector<LobeSample> getLobe(float roughness, int size) {
+
+			// The view and the normal are taken to be the reflected direction, so the lobe only depends on the roughness.
+			float alpha = roughness * roughness;
+			float texel_angle = 4.0f * PI / (6.0f * size * size);
+
+			std::vector<LobeSample> lobe;
+			for (uint32_t i = 0; i < (uint32_t) CubemapFilter::NUM_SAMPLES; i++) {
+
+				// Hammersley point.
+				uint32_t bits = i;
+				bits = (bits << 16u) | (bits >> 16u);
+				bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+				bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+				bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+				bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+				float xi_x = (float) i / CubemapFilter::NUM_SAMPLES, xi_y = bits * 2.3283064365386963e-10f;
+
+				// Half vector of the GGX distribution, and the light direction it reflects to.
+				float phi = 2.0f * PI * xi_x;
+				float cos_theta = std::sqrt((1.0f - xi_y) / (1.0f + (alpha * alpha - 1.0f) * xi_y));
+				float sin_theta = std::sqrt(1.0f - cos_theta * cos_theta);
+				glm::vec3 half(sin_theta * std::cos(phi), sin_theta * std::sin(phi), cos_theta);
+				glm::vec3 direction = 2.0f * half.z * half - glm::vec3(0.0f, 0.0f, 1.0f);
+				if (direction.z <= 0.0f)
+					continue;
+
+				// Read the sample from the level whose texels cover about the solid angle of the sample.
+				float denominator = cos_theta * cos_theta * (alpha * alpha - 1.0f) + 1.0f;
+				float distribution = alpha * alpha / (PI * denominator * denominator);
+				float sample_angle = 1.0f / (CubemapFilter::NUM_SAMPLES * distribution / 4.0f + 1e-6f);
+				float lod = roughness == 0.0f ? 0.0f : std::max(0.5f * std::log2(sample_angle / texel_angle) + 1.0f, 0.0f);
+
+				lobe.push_back({direction, direction.z, lod});
+
+			}
+
+			return lobe;
+
+		}
+
+		void filterRows(std::span<const ImageData> faces, const FaceChain &chain, const std::vector<LobeSample> &lobe, int face, int size, int first_row, std::vector<unsigned char> *output) {
+
+			for (int y = first_row; y < std::min(first_row + ROWS_PER_JOB, size); y++) {
+
+				for (int x = 0; x < size; x++) {
+
+					glm::vec3 normal = glm::normalize(getDirection(face, 2.0f * (x + 0.5f) / size - 1.0f, 2.0f * (y + 0.5f) / size - 1.0f));
+					glm::vec3 up = std::abs(normal.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+					glm::vec3 tangent = glm::normalize(glm::cross(up, normal));
+					glm::vec3 bitangent = glm::cross(normal, tangent);
+
+					glm::vec3 color(0.0f);
+					float total = 0.0f;
+					for (const LobeSample &lobe_sample : lobe) {
+
+						glm::vec3 direction = tangent * lobe_sample.direction.x + bitangent * lobe_sample.direction.y + normal * lobe_sample.direction.z;
+						color += sample(faces, chain, direction, lobe_sample.lod) * lobe_sample.weight;
+						total += lobe_sample.weight;
+
+					}
+					color /= total;
+
+					unsigned char *texel = &(*output)[((size_t) y * size + x) * 4];
+					for (int c = 0; c < 3; c++)
+						texel[c] = (unsigned char) std::clamp((int) std::lround(color[c]), 0, 255);
+					texel[3] = 255;
+
+				}
+
+			}
+
+		}
+
+		std::vector<unsigned char> upsample(const std::vector<unsigned char> &src, int src_size, int size) {
+
+			// Bilinear, clamped to the edges of the face.
+			std::vector<unsigned char> dst((size_t) size * size * 4);
+			float scale = (float) src_size / size;
+			for (int y = 0; y < size; y++) {
+
+				float source_y = std::max((y + 0.5f) * scale - 0.5f, 0.0f);
+				int y0 = std::min((int) source_y, src_size - 1), y1 = std::min(y0 + 1, src_size - 1);
+				float fy = source_y - y0;
+				for (int x = 0; x < size; x++) {
+
+					float source_x = std::max((x + 0.5f) * scale - 0.5f, 0.0f);
+					int x0 = std::min((int) source_x, src_size - 1), x1 = std::min(x0 + 1, src_size - 1);
+					float fx = source_x - x0;
+					for (int c = 0; c < 4; c++) {
+
+						float top = src[((size_t) y0 * src_size + x0) * 4 + c] * (1.0f - fx) + src[((size_t) y0 * src_size + x1) * 4 + c] * fx;
+						float bottom = src[((size_t) y1 * src_size + x0) * 4 + c] * (1.0f - fx) + src[((size_t) y1 * src_size + x1) * 4 + c] * fx;
+						dst[((size_t) y * size + x) * 4 + c] = (unsigned char) std::lround(top * (1.0f - fy) + bottom * fy);
+
+					}
+
+				}
+
+			}
+
+			return dst;
+
+		}
+
+	}
+
+	std::string CubemapFilter::getCacheFilename(const std::string &first_face) {
+
+		return TextureFile::getBakedFilename(first_face, ".ggx");
+
+	}
+
+	GLenum CubemapFilter::getCacheFormat(GLenum internal_format) {
+
+		return BlockCompressor::isSupported(internal_format) ? internal_format : GL_RGBA8;
+
+	}
+
+	float CubemapFilter::getRoughness(int level) {
+
+		return (float) level / (NUM_LEVELS - 1);
+
+	}
+
+	bool CubemapFilter::isCacheValid(const TextureFile &cache, int size, GLenum internal_format) {
+
+		int level_size = std::max(size / 2, 1);
+		return cache.isOpen() && cache.isSupported() && cache.getNumFaces() == 6 && cache.getNumLevels() == NUM_LEVELS - 1
+			&& cache.getInternalFormat() == getCacheFormat(internal_format) && cache.getWidth(0) == level_size && cache.getHeight(0) == level_size;
+
+	}
+
+	bool CubemapFilter::prefilter(std::span<const ImageData> faces, const std::string &filename, GLenum internal_format, unsigned int num_threads) {
+
+		if (faces.size() != 6)
+			return false;
+
+		int size = faces[0].width;
+		for (const ImageData &face : faces)
+			if (face.width != size || face.height != size || !face.pixels)
+				return false;
+
+		// Every level of the chain needs at least a texel.
+		if ((size >> (NUM_LEVELS - 1)) == 0)
+			return false;
+
+		// The box filtered levels go down to 1x1.
+		int num_box_levels = 1;
+		while ((size >> num_box_levels) > 0)
+			num_box_levels++;
+
+		ThreadPool pool(num_threads);
+		FaceChain chain(num_box_levels);
+		for (int face = 0; face < 6; face++)
+			pool.submit([&, face] { buildChain(faces, face, &chain); });
+		pool.wait();
+
+		// Every level and face is split in bands of rows.
+		std::vector<std::vector<LobeSample>> lobes(NUM_LEVELS);
+		std::vector<std::vector<unsigned char>> levels((NUM_LEVELS - 1) * 6);
+		for (int level = 1; level < NUM_LEVELS; level++) {
+
+			int filter_size = std::min(size >> level, MAX_FILTER_SIZE);
+			lobes[level] = getLobe(getRoughness(level), size);
+			for (int face = 0; face < 6; face++) {
+
+				std::vector<unsigned char> *output = &levels[(level - 1) * 6 + face];
+				(*output).resize((size_t) filter_size * filter_size * 4);
+				for (int row = 0; row < filter_size; row += ROWS_PER_JOB)
+					pool.submit([&, level, filter_size, face, row, output] { filterRows(faces, chain, lobes[level], face, filter_size, row, output); });
+
+			}
+
+		}
+		pool.wait();
+
+		// Then the levels that were integrated smaller are scaled up to their size.
+		for (int level = 1; level < NUM_LEVELS; level++) {
+
+			int level_size = size >> level;
+			int filter_size = std::min(level_size, MAX_FILTER_SIZE);
+			if (filter_size == level_size)
+				continue;
+
+			for (int face = 0; face < 6; face++) {
+
+				std::vector<unsigned char> *output = &levels[(level - 1) * 6 + face];
+				pool.submit([output, filter_size, level_size] { *output = upsample(*output, filter_size, level_size); });
+
+			}
+
+		}
+		pool.wait();
+
+		return TextureFile::write(levels, 6, size / 2, size / 2, filename, getCacheFormat(internal_format));
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,120 @@
+/**
+ * @file cubemap_filter.h
+ * @brief CubemapFilter class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_CUBEMAPFILTER_H_
+#define BGQ_OPENGL_CLASSES_CUBEMAPFILTER_H_
+
+#include <span>
+#include <string>
+
+#include "GL/glew.h"
+
+#include "classes/texture_file/texture_file.h"
+#include "structs/image_data/image_data.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a CubemapFilter class.
+	 *
+	 * Builds the mip chain of an environment for glossy surfaces. Every level
+	 * past the first one holds the environment convolved with a GGX lobe,
+	 * from a roughness of 0 in the first level to 1 in the last one, so that
+	 * the shaders pick the roughness of a material with the level they read.
+	 *
+	 * The lobe is importance sampled, reading every sample from the level of
+	 * the box filtered faces whose texels cover about as much as the sample,
+	 * so that few samples are enough. The texels are spread over a thread
+	 * pool. The chain takes a while, so it is stored in a baked texture file
+	 * next to the faces and only built when that is missing.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class CubemapFilter {
+
+		public:
+
+			static const int NUM_LEVELS = 6;	/// Levels of the chain, the first one being the environment itself.
+			static const int NUM_SAMPLES = 64;	/// Samples of the lobe per texel.
+
+			/**
+			 * @brief Gets the cache file of a cubemap.
+			 *
+			 * Gets the name of the file that stores the prefiltered levels of a
+			 * cubemap, which sits next to its first face.
+			 *
+			 * @param first_face The name of the first face.
+			 *
+			 * @returns The name of the cache file.
+			 */
+			static std::string getCacheFilename(const std::string &first_face);
+
+			/**
+			 * @brief Gets the format of the cache.
+			 *
+			 * Gets the format the prefiltered levels are stored in, which is the
+			 * one of the first level if it is compressed, so that every level of
+			 * the texture matches.
+			 *
+			 * @param internal_format The internal format of the first level.
+			 *
+			 * @returns The internal format of the cache.
+			 */
+			static GLenum getCacheFormat(GLenum internal_format);
+
+			/**
+			 * @brief Gets the roughness of a level.
+			 *
+			 * @param level The level of the chain.
+			 *
+			 * @returns The roughness the level was convolved with.
+			 */
+			static float getRoughness(int level);
+
+			/**
+			 * @brief Whether a cache file can be used.
+			 *
+			 * Whether a cache file holds the prefiltered levels of a cubemap of
+			 * this size and format, and the context can upload them.
+			 *
+			 * @param cache The cache file.
+			 * @param size The side of the faces of the first level.
+			 * @param internal_format The internal format of the first level.
+			 *
+			 * @returns True if the cache can be used. False otherwise.
+			 */
+			static bool isCacheValid(const TextureFile &cache, int size, GLenum internal_format);
+
+			/**
+			 * @brief Prefilters a cubemap.
+			 *
+			 * Builds every level of the chain past the first one from the decoded
+			 * faces and stores them in a cache file. It does not touch OpenGL, so
+			 * it can be called from a worker thread.
+			 *
+			 * @param faces The decoded faces in the +X, -X, +Y, -Y, +Z, -Z order, all square and the same size.
+			 * @param filename The name of the cache file.
+			 * @param internal_format The internal format of the first level.
+			 * @param num_threads The number of threads, or 0 for one per core.
+			 *
+			 * @returns True if the file was written. False otherwise.
+			 */
+			static bool prefilter(std::span<const ImageData> faces, const std::string &filename, GLenum internal_format, unsigned int num_threads);
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_CUBEMAPFILTER_H_
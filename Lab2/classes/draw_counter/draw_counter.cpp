@@ -0,0 +1,67 @@
+/**
+ * @file draw_counter.cpp
+ * @brief DrawCounter class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "draw_counter.h"
+
+#include "structs/draw_stats/draw_stats.h"
+
+namespace bgq_opengl {
+
+	DrawStats DrawCounter::stats = {0, 0, 0, 0, 0, 0};
+
+	DrawStats DrawCounter::getStats() {
+
+		return stats;
+
+	}
+
+	void DrawCounter::recordCulled(unsigned long draws) {
+
+		stats.culled += draws;
+
+	}
+
+	void DrawCounter::recordDraw(unsigned long instances) {
+
+		stats.draws++;
+		stats.instances += instances;
+
+	}
+
+	void DrawCounter::recordProgramBind() {
+
+		stats.program_binds++;
+
+	}
+
+	void DrawCounter::recordTextureBind() {
+
+		stats.texture_binds++;
+
+	}
+
+	void DrawCounter::recordVAOBind() {
+
+		stats.vao_binds++;
+
+	}
+
+	void DrawCounter::reset() {
+
+		stats = {0, 0, 0, 0, 0, 0};
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,100 @@
+/**
+ * @file draw_counter.h
+ * @brief DrawCounter class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_DRAWCOUNTER_H_
+#define BGQ_OPENGL_CLASSES_DRAWCOUNTER_H_
+
+#include "structs/draw_stats/draw_stats.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a DrawCounter class.
+	 *
+	 * Counts the draw calls and binds of every frame. The classes that make
+	 * those calls record them here, which is only ever done from the thread
+	 * that owns the context.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class DrawCounter {
+
+		public:
+
+			/**
+			 * @brief Get the counters.
+			 *
+			 * Get the counters since the last reset.
+			 *
+			 * @returns The counters.
+			 */
+			static DrawStats getStats();
+
+			/**
+			 * @brief Records culled draw calls.
+			 *
+			 * Records draw calls that were skipped because their geometry was
+			 * outside the view.
+			 *
+			 * @param draws The number of draw calls.
+			 */
+			static void recordCulled(unsigned long draws);
+
+			/**
+			 * @brief Records a draw call.
+			 *
+			 * Records a draw call and the instances it draws.
+			 *
+			 * @param instances The number of instances.
+			 */
+			static void recordDraw(unsigned long instances);
+
+			/**
+			 * @brief Records a program bind.
+			 *
+			 * Records a call to glUseProgram.
+			 */
+			static void recordProgramBind();
+
+			/**
+			 * @brief Records a texture bind.
+			 *
+			 * Records a call to glBindTexture.
+			 */
+			static void recordTextureBind();
+
+			/**
+			 * @brief Records a VAO bind.
+			 *
+			 * Records a call to glBindVertexArray.
+			 */
+			static void recordVAOBind();
+
+			/**
+			 * @brief Reset the counters.
+			 *
+			 * Reset the counters, typically at the beginning of every frame.
+			 */
+			static void reset();
+
+		private:
+
+			static DrawStats stats;		/// Counters since the last reset.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_DRAWCOUNTER_H_
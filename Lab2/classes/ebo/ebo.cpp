@@ -15,41 +15,81 @@
 
 #include "ebo.h"
 
-#include <vector>
+#include <span>
 
 #include "GL/glew.h"
 
+#include "classes/gl_state/gl_state.h"
+
 namespace bgq_opengl {
 
 	// Constructor that generates a Elements Buffer Object and links it to indices
-	EBO::EBO(const std::vector<GLuint> &indices) {
+	EBO::EBO(std::span<const GLuint> indices) {
 		
 		// Generate the buffer.
 		glGenBuffers(1, &this->ID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID);
+		GlState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID);
 
 		// Link the indices.
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
 	
 	}
 
+	EBO::EBO() {
+
+		// Nothing to do. It holds no buffer until another one is moved into it.
+
+	}
+
+	EBO::EBO(EBO&& other) noexcept : ID(other.ID) {
+
+		// Leave the other one empty so it does not delete the object.
+		other.ID = 0;
+
+	}
+
+	EBO& EBO::operator=(EBO&& other) noexcept {
+
+		if (this != &other) {
+
+			// Release the current object before taking the other one.
+			this->remove();
+
+			this->ID = other.ID;
+			other.ID = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	EBO::~EBO() {
+
+		this->remove();
+
+	}
+
 	void EBO::bind() {
 
 		// Binds the EBO.
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID);
+		GlState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID);
 	
 	}
 
 	void EBO::remove() {
 
-		glDeleteBuffers(1, &this->ID);
+		// Delete the buffer in OpenGL, if there is one.
+		if (this->ID != 0)
+			GlState::deleteBuffer(this->ID);
+		this->ID = 0;
 
 	}
 
 	void EBO::unbind() {
 
 		// Unbinds the EBO.
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		GlState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	
 	}	
 
@@ -16,7 +16,7 @@
 #ifndef BGQ_OPENGL_CLASS_EBO_H_
 #define BGQ_OPENGL_CLASS_EBO_H_
 
-#include <vector>
+#include <span>
 
 #include "GL/glew.h"
 
@@ -41,7 +41,51 @@ namespace bgq_opengl {
 			 *
 			 * @param indices Indices that will be linked.
 			 */
-			EBO(const std::vector<GLuint> &indices);
+			EBO(std::span<const GLuint> indices);
+
+			/**
+			 * @brief Constructs an empty Elements Buffer Object.
+			 *
+			 * Constructs an Elements Buffer Object that holds no buffer yet, so that
+			 * it can be moved into later.
+			 */
+			EBO();
+
+			/**
+			 * @brief EBO objects cannot be copied.
+			 *
+			 * EBO objects own their buffer, so they cannot be copied.
+			 */
+			EBO(const EBO&) = delete;
+			EBO& operator=(const EBO&) = delete;
+
+			/**
+			 * @brief Moves a EBO.
+			 *
+			 * Takes the buffer from another EBO, which is left empty.
+			 *
+			 * @param other The EBO to move from.
+			 */
+			EBO(EBO&& other) noexcept;
+
+			/**
+			 * @brief Moves a EBO.
+			 *
+			 * Removes the current buffer and takes the one of another EBO, which
+			 * is left empty.
+			 *
+			 * @param other The EBO to move from.
+			 *
+			 * @returns This EBO.
+			 */
+			EBO& operator=(EBO&& other) noexcept;
+
+			/**
+			 * @brief Destroys the EBO.
+			 *
+			 * Removes the buffer from OpenGL.
+			 */
+			~EBO();
 
 			/**
 			 * @brief Binds the EBO.
@@ -66,7 +110,7 @@ namespace bgq_opengl {
 
 		private:
 
-			GLuint ID; // GL ID of the EBO.
+			GLuint ID = 0; /// GL ID of the EBO.
 
 	};
 
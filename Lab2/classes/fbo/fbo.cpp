@@ -0,0 +1,172 @@
+/**
+ * @file fbo.cpp
+ * @brief FBO class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "fbo.h"
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/gl_state/gl_state.h"
+
+namespace bgq_opengl {
+
+	FBO::FBO(GLsizei width, GLsizei height, bool color) {
+
+		this->width = width;
+		this->height = height;
+
+		// Generate the buffers and allocate them.
+		if (color) {
+
+			glGenRenderbuffers(1, &this->color);
+			glBindRenderbuffer(GL_RENDERBUFFER, this->color);
+			glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+		}
+
+		glGenRenderbuffers(1, &this->depth);
+		glBindRenderbuffer(GL_RENDERBUFFER, this->depth);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		// Attach them to the framebuffer.
+		glGenFramebuffers(1, &this->ID);
+		GlState::bindFramebuffer(GL_FRAMEBUFFER, this->ID);
+		if (color)
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, this->color);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, this->depth);
+
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		GlState::bindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		// Without a colour buffer it is only complete once a texture is attached.
+		if (color && status != GL_FRAMEBUFFER_COMPLETE) {
+
+			std::cerr << "FBO error - The framebuffer is not complete: " << status << std::endl;
+			exit(1);
+
+		}
+
+	}
+
+	FBO::FBO(FBO&& other) noexcept : ID(other.ID), color(other.color), depth(other.depth), width(other.width), height(other.height) {
+
+		// Leave the other one empty so it does not delete the objects.
+		other.ID = 0;
+		other.color = 0;
+		other.depth = 0;
+
+	}
+
+	FBO& FBO::operator=(FBO&& other) noexcept {
+
+		if (this != &other) {
+
+			// Release the current objects before taking the other ones.
+			this->remove();
+
+			this->ID = other.ID;
+			this->color = other.color;
+			this->depth = other.depth;
+			this->width = other.width;
+			this->height = other.height;
+			other.ID = 0;
+			other.color = 0;
+			other.depth = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	FBO::~FBO() {
+
+		this->remove();
+
+	}
+
+	void FBO::attach(GLenum target, GLuint texture, GLint level) {
+
+		GlState::bindFramebuffer(GL_FRAMEBUFFER, this->ID);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, texture, level);
+
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		if (status != GL_FRAMEBUFFER_COMPLETE) {
+
+			std::cerr << "FBO error - The framebuffer is not complete with the texture attached: " << status << std::endl;
+			exit(1);
+
+		}
+
+	}
+
+	void FBO::bind() {
+
+		GlState::bindFramebuffer(GL_FRAMEBUFFER, this->ID);
+		glViewport(0, 0, this->width, this->height);
+
+	}
+
+	GLsizei FBO::getHeight() {
+
+		return this->height;
+
+	}
+
+	GLsizei FBO::getWidth() {
+
+		return this->width;
+
+	}
+
+	void FBO::read(std::vector<unsigned char> *pixels) {
+
+		pixels->resize((size_t) this->width * this->height * 4);
+
+		// Rows are tightly packed, whatever the width.
+		GlState::bindFramebuffer(GL_READ_FRAMEBUFFER, this->ID);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, this->width, this->height, GL_RGBA, GL_UNSIGNED_BYTE, pixels->data());
+		GlState::bindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+	}
+
+	void FBO::remove() {
+
+		// Delete the framebuffer and its buffers in OpenGL, if there are any.
+		if (this->ID != 0)
+			GlState::deleteFramebuffer(this->ID);
+		if (this->color != 0)
+			glDeleteRenderbuffers(1, &this->color);
+		if (this->depth != 0)
+			glDeleteRenderbuffers(1, &this->depth);
+		this->ID = 0;
+		this->color = 0;
+		this->depth = 0;
+
+	}
+
+	void FBO::unbind() {
+
+		GlState::bindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	}
+
+}  // namespace bgq_opengl
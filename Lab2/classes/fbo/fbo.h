@@ -0,0 +1,161 @@
+/**
+ * @file fbo.h
+ * @brief FBO class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASS_FBO_H_
+#define BGQ_OPENGL_CLASS_FBO_H_
+
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a FBO class.
+	 *
+	 * Implementation of a Framebuffer Object class with an RGBA colour buffer
+	 * and a depth buffer, so that frames can be rendered and read back without a
+	 * window.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class FBO {
+
+	public:
+
+		/**
+		 * @brief Constructs a Framebuffer Object.
+		 *
+		 * Constructs a Framebuffer Object of the given size. The program is ended
+		 * if the driver cannot render to it. Without a colour buffer, a texture
+		 * has to be attached with attach before drawing.
+		 *
+		 * @param width The width in pixels.
+		 * @param height The height in pixels.
+		 * @param color Whether to allocate a colour buffer.
+		 */
+		FBO(GLsizei width, GLsizei height, bool color = true);
+
+		/**
+		 * @brief FBO objects cannot be copied.
+		 *
+		 * FBO objects own their buffers, so they cannot be copied.
+		 */
+		FBO(const FBO&) = delete;
+		FBO& operator=(const FBO&) = delete;
+
+		/**
+		 * @brief Moves a FBO.
+		 *
+		 * Takes the buffers from another FBO, which is left empty.
+		 *
+		 * @param other The FBO to move from.
+		 */
+		FBO(FBO&& other) noexcept;
+
+		/**
+		 * @brief Moves a FBO.
+		 *
+		 * Removes the current buffers and takes the ones of another FBO, which
+		 * is left empty.
+		 *
+		 * @param other The FBO to move from.
+		 *
+		 * @returns This FBO.
+		 */
+		FBO& operator=(FBO&& other) noexcept;
+
+		/**
+		 * @brief Destroys the FBO.
+		 *
+		 * Removes the buffers from OpenGL.
+		 */
+		~FBO();
+
+		/**
+		 * @brief Attaches a texture.
+		 *
+		 * Binds the FBO and renders the next draws into a level of a texture
+		 * instead of the colour buffer.
+		 *
+		 * @param target The target of the texture, like a face of a cube map.
+		 * @param texture The texture.
+		 * @param level The mip level.
+		 */
+		void attach(GLenum target, GLuint texture, GLint level);
+
+		/**
+		 * @brief Binds the FBO.
+		 *
+		 * Binds the FBO and sets the viewport to cover it, so the next draws end
+		 * up in it.
+		 */
+		void bind();
+
+		/**
+		 * @brief Get the height.
+		 *
+		 * Get the height of the FBO.
+		 *
+		 * @returns The height in pixels.
+		 */
+		GLsizei getHeight();
+
+		/**
+		 * @brief Get the width.
+		 *
+		 * Get the width of the FBO.
+		 *
+		 * @returns The width in pixels.
+		 */
+		GLsizei getWidth();
+
+		/**
+		 * @brief Reads the colour buffer.
+		 *
+		 * Reads the colour buffer back to the CPU, which waits for the frame to
+		 * be finished.
+		 *
+		 * @param pixels Outputs the pixels, 4 bytes each, bottom row first.
+		 */
+		void read(std::vector<unsigned char> *pixels);
+
+		/**
+		 * @brief Removes the FBO.
+		 *
+		 * Removes the FBO and its buffers from OpenGL.
+		 */
+		void remove();
+
+		/**
+		 * @brief Unbinds the FBO.
+		 *
+		 * Binds the default framebuffer back.
+		 */
+		void unbind();
+
+	private:
+
+		GLuint ID = 0;				/// GL ID of the FBO.
+		GLuint color = 0;			/// GL ID of the colour renderbuffer.
+		GLuint depth = 0;			/// GL ID of the depth renderbuffer.
+		GLsizei width;				/// Width in pixels.
+		GLsizei height;				/// Height in pixels.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_CLASS_FBO_H_
@@ -0,0 +1,188 @@
+/**
+ * @file frustum.cpp
+ * @brief Frustum class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "frustum.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "glm/glm.hpp"
+
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/bounding_sphere/bounding_sphere.h"
+#include "structs/bounds_batch/bounds_batch.h"
+
+namespace bgq_opengl {
+
+	Frustum::Frustum(const glm::mat4 &camera_matrix) {
+
+		// Every plane is the last row of the matrix plus or minus one of the others.
+		for (int i = 0; i < NUM_PLANES; i++) {
+
+			int row = i / 2;
+			float sign = i % 2 == 0 ? 1.0f : -1.0f;
+			glm::vec4 plane(camera_matrix[0][3] + sign * camera_matrix[0][row],
+							camera_matrix[1][3] + sign * camera_matrix[1][row],
+							camera_matrix[2][3] + sign * camera_matrix[2][row],
+							camera_matrix[3][3] + sign * camera_matrix[3][row]);
+
+			// Normalize them, so the distances to them are in world units.
+			float length = glm::length(glm::vec3(plane));
+			this->plane_x[i] = plane.x / length;
+			this->plane_y[i] = plane.y / length;
+			this->plane_z[i] = plane.z / length;
+			this->plane_w[i] = plane.w / length;
+
+		}
+
+	}
+
+	void Frustum::addBounds(BoundsBatch *batch, const BoundingBox &box, const BoundingSphere &sphere, const glm::mat4 &model) {
+
+		// Transform the box as centre and half extents, like the world boxes of the geometries.
+		glm::vec3 centre = (box.min + box.max) / 2.0f;
+		glm::vec3 extents = (box.max - box.min) / 2.0f;
+		glm::vec3 world_centre = glm::vec3(model * glm::vec4(centre, 1.0f));
+		glm::mat3 abs_matrix = glm::mat3(glm::abs(glm::vec3(model[0])), glm::abs(glm::vec3(model[1])), glm::abs(glm::vec3(model[2])));
+		glm::vec3 world_extents = abs_matrix * extents;
+
+		// The sphere grows with the biggest scale, and moves to the centre of the box.
+		float scale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+		float radius = (sphere.radius + glm::length(sphere.centre - centre)) * scale;
+
+		(*batch).centre_x.push_back(world_centre.x);
+		(*batch).centre_y.push_back(world_centre.y);
+		(*batch).centre_z.push_back(world_centre.z);
+		(*batch).extent_x.push_back(world_extents.x);
+		(*batch).extent_y.push_back(world_extents.y);
+		(*batch).extent_z.push_back(world_extents.z);
+		(*batch).radius.push_back(radius);
+
+	}
+
+	void Frustum::clear(BoundsBatch *batch) {
+
+		(*batch).centre_x.clear();
+		(*batch).centre_y.clear();
+		(*batch).centre_z.clear();
+		(*batch).extent_x.clear();
+		(*batch).extent_y.clear();
+		(*batch).extent_z.clear();
+		(*batch).radius.clear();
+
+	}
+
+	size_t Frustum::cull(const BoundsBatch &batch, std::vector<unsigned char> *visible) const {
+
+		size_t n = batch.centre_x.size();
+		(*visible).resize(n);
+
+		// A volume is behind a plane when its signed distance is below minus the
+		// projected radius of the box, or minus the radius of the sphere, so only
+		// the smallest of both matters.
+		size_t i = 0;
+
+#if defined(__SSE__) || defined(__ARM_NEON)
+
+		for (; i + 4 <= n; i += 4) {
+
+#if defined(__SSE__)
+			__m128 centre_x = _mm_loadu_ps(&batch.centre_x[i]);
+			__m128 centre_y = _mm_loadu_ps(&batch.centre_y[i]);
+			__m128 centre_z = _mm_loadu_ps(&batch.centre_z[i]);
+			__m128 extent_x = _mm_loadu_ps(&batch.extent_x[i]);
+			__m128 extent_y = _mm_loadu_ps(&batch.extent_y[i]);
+			__m128 extent_z = _mm_loadu_ps(&batch.extent_z[i]);
+			__m128 radius = _mm_loadu_ps(&batch.radius[i]);
+
+			__m128 outside = _mm_setzero_ps();
+			for (int p = 0; p < NUM_PLANES; p++) {
+
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(centre_x, _mm_set1_ps(this->plane_x[p])), _mm_mul_ps(centre_y, _mm_set1_ps(this->plane_y[p]))),
+											 _mm_add_ps(_mm_mul_ps(centre_z, _mm_set1_ps(this->plane_z[p])), _mm_set1_ps(this->plane_w[p])));
+				__m128 projected = _mm_add_ps(_mm_add_ps(_mm_mul_ps(extent_x, _mm_set1_ps(std::fabs(this->plane_x[p]))), _mm_mul_ps(extent_y, _mm_set1_ps(std::fabs(this->plane_y[p])))),
+											  _mm_mul_ps(extent_z, _mm_set1_ps(std::fabs(this->plane_z[p]))));
+				__m128 reach = _mm_min_ps(projected, radius);
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, reach), _mm_setzero_ps()));
+
+			}
+
+			int mask = _mm_movemask_ps(outside);
+			for (int lane = 0; lane < 4; lane++)
+				(*visible)[i + lane] = ((mask >> lane) & 1) ? 0 : 1;
+#else
+			float32x4_t centre_x = vld1q_f32(&batch.centre_x[i]);
+			float32x4_t centre_y = vld1q_f32(&batch.centre_y[i]);
+			float32x4_t centre_z = vld1q_f32(&batch.centre_z[i]);
+			float32x4_t extent_x = vld1q_f32(&batch.extent_x[i]);
+			float32x4_t extent_y = vld1q_f32(&batch.extent_y[i]);
+			float32x4_t extent_z = vld1q_f32(&batch.extent_z[i]);
+			float32x4_t radius = vld1q_f32(&batch.radius[i]);
+
+			uint32x4_t outside = vdupq_n_u32(0);
+			for (int p = 0; p < NUM_PLANES; p++) {
+
+				float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_n_f32(centre_x, this->plane_x[p]), vmulq_n_f32(centre_y, this->plane_y[p])),
+												 vaddq_f32(vmulq_n_f32(centre_z, this->plane_z[p]), vdupq_n_f32(this->plane_w[p])));
+				float32x4_t projected = vaddq_f32(vaddq_f32(vmulq_n_f32(extent_x, std::fabs(this->plane_x[p])), vmulq_n_f32(extent_y, std::fabs(this->plane_y[p]))),
+												  vmulq_n_f32(extent_z, std::fabs(this->plane_z[p])));
+				float32x4_t reach = vminq_f32(projected, radius);
+				outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, reach), vdupq_n_f32(0.0f)));
+
+			}
+
+			uint32_t lanes[4];
+			vst1q_u32(lanes, outside);
+			for (int lane = 0; lane < 4; lane++)
+				(*visible)[i + lane] = lanes[lane] ? 0 : 1;
+#endif
+
+		}
+
+#endif
+
+		// The rest, or all of them without SIMD, one at a time.
+		for (; i < n; i++) {
+
+			bool outside = false;
+			for (int p = 0; p < NUM_PLANES && !outside; p++) {
+
+				float distance = batch.centre_x[i] * this->plane_x[p] + batch.centre_y[i] * this->plane_y[p] + batch.centre_z[i] * this->plane_z[p] + this->plane_w[p];
+				float projected = batch.extent_x[i] * std::fabs(this->plane_x[p]) + batch.extent_y[i] * std::fabs(this->plane_y[p]) + batch.extent_z[i] * std::fabs(this->plane_z[p]);
+				outside = distance + std::min(projected, batch.radius[i]) < 0.0f;
+
+			}
+
+			(*visible)[i] = outside ? 0 : 1;
+
+		}
+
+		size_t num_visible = 0;
+		for (unsigned char flag : *visible)
+			num_visible += flag;
+
+		return num_visible;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,103 @@
+/**
+ * @file frustum.h
+ * @brief Frustum class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_FRUSTUM_H_
+#define BGQ_OPENGL_CLASSES_FRUSTUM_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/bounding_sphere/bounding_sphere.h"
+#include "structs/bounds_batch/bounds_batch.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a Frustum class.
+	 *
+	 * The six planes of the volume a camera sees, taken from its camera
+	 * matrix, to tell which bounding volumes are outside of it. Whole batches
+	 * of volumes are tested four at a time with SSE or NEON when they are
+	 * available.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class Frustum {
+
+		public:
+
+			static const int NUM_PLANES = 6;	/// Left, right, bottom, top, near and far.
+
+			/**
+			 * @brief Builds a Frustum.
+			 *
+			 * Extracts the planes from the product of the projection and the view
+			 * matrices, with their normals pointing inwards.
+			 *
+			 * @param camera_matrix The camera matrix.
+			 */
+			Frustum(const glm::mat4 &camera_matrix);
+
+			/**
+			 * @brief Adds a volume to a batch.
+			 *
+			 * Transforms a bounding box and a bounding sphere to world space and
+			 * adds them to a batch. The sphere is grown so that it shares the
+			 * centre of the box.
+			 *
+			 * @param batch The batch.
+			 * @param box The bounding box, in model space.
+			 * @param sphere The bounding sphere, in model space.
+			 * @param model The model matrix.
+			 */
+			static void addBounds(BoundsBatch *batch, const BoundingBox &box, const BoundingSphere &sphere, const glm::mat4 &model);
+
+			/**
+			 * @brief Empties a batch.
+			 *
+			 * Removes every volume of a batch, keeping its memory for the next frame.
+			 *
+			 * @param batch The batch.
+			 */
+			static void clear(BoundsBatch *batch);
+
+			/**
+			 * @brief Culls a batch.
+			 *
+			 * Tests every volume of a batch against the planes. A volume is outside
+			 * when its box or its sphere is completely behind any plane.
+			 *
+			 * @param batch The batch.
+			 * @param visible Outputs 1 for every volume that may be visible and 0 for the rest.
+			 *
+			 * @returns The number of volumes that may be visible.
+			 */
+			size_t cull(const BoundsBatch &batch, std::vector<unsigned char> *visible) const;
+
+		private:
+
+			float plane_x[NUM_PLANES];	/// X of the normals of the planes.
+			float plane_y[NUM_PLANES];	/// Y of the normals of the planes.
+			float plane_z[NUM_PLANES];	/// Z of the normals of the planes.
+			float plane_w[NUM_PLANES];	/// Distances of the planes to the origin.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_FRUSTUM_H_
@@ -15,35 +15,95 @@
 
 #include "geometry.h"
 
+#include <math.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
 #include <vector>
 #include <stdexcept>
 
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "GL/glew.h"
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
+#include "classes/bvh/bvh.h"
 #include "classes/camera/camera.h"
+#include "classes/draw_counter/draw_counter.h"
 #include "classes/ebo/ebo.h"
+#include "classes/mapped_file/mapped_file.h"
 #include "classes/shader/shader.h"
 #include "classes/texture/texture.h"
+#include "classes/thread_pool/thread_pool.h"
 #include "classes/vao/vao.h"
+#include "structs/instance/instance.h"
+#include "structs/mesh_data/mesh_data.h"
+#include "structs/ray/ray.h"
+#include "structs/ray_hit/ray_hit.h"
 #include "structs/vertex/vertex.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/bounding_sphere/bounding_sphere.h"
 
 namespace bgq_opengl {
 
-	Geometry::Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess) {
+	Geometry::Geometry(std::vector<Vertex> vertices, std::vector<GLuint> indices, std::vector<Texture> textures, const float shininess) {
 
-		// Store a copy of these in the attributes.
-		this->vertices = vertices;
-		this->indices = indices;
-        this->textures = textures;
+		// Take these over in the attributes.
+		this->vertices = std::move(vertices);
+		this->indices = std::move(indices);
+        this->textures = std::move(textures);
         this->shininess = shininess;
+		this->vertex_view = this->vertices;
+		this->index_view = this->indices;
+
+		// Get the bounding volumes once so they never have to be scanned again.
+		computeBounds(this->vertex_view, &this->bounding_box, &this->bounding_sphere);
+
+		this->upload();
+
+	}
+
+	Geometry::Geometry(MeshData mesh) {
+
+		// Take the vertices over, or point at them in the mapping, which is kept alive with the geometry.
+		if (mesh.mapping) {
+
+			this->mapping = std::move(mesh.mapping);
+			this->vertex_view = mesh.mapped_vertices;
+			this->index_view = mesh.mapped_indices;
+
+		} else {
+
+			this->vertices = std::move(mesh.vertices);
+			this->indices = std::move(mesh.indices);
+			this->vertex_view = this->vertices;
+			this->index_view = this->indices;
+
+		}
+
+		this->shininess = mesh.shininess;
+		this->bounding_box = mesh.bounding_box;
+		this->bounding_sphere = mesh.bounding_sphere;
+
+		this->upload();
+
+	}
+
+	void Geometry::upload() {
 
 		// Generate a VAO and bind it, generate a VBO for the vertices and a EBO for the indices.
+		// The buffers are kept so they are deleted with the geometry.
 		this->vao.bind();
-		VBO vbo(vertices);
-		EBO ebo(indices);
+		this->vbo = VBO(this->vertex_view);
+		this->ebo = EBO(this->index_view);
 
 		// Links VBO attributes such as coordinates and colors to VAO.
 		vao.link_attribute(vbo, 0, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)0);
@@ -58,27 +118,27 @@ namespace bgq_opengl {
 
 	}
 
-	std::vector<GLuint> Geometry::getIndices() {
+	std::span<const GLuint> Geometry::getIndices() {
 
-		return this->indices;
+		return this->index_view;
 
 	}
 
-	std::vector<Texture>  Geometry::getTextures() {
+	std::span<Texture> Geometry::getTextures() {
 
 		return this->textures;
 
 	}
 
-	VAO Geometry::getVAO() {
+	VAO& Geometry::getVAO() {
 
 		return this->vao;
 
 	}
 
-	std::vector<Vertex> Geometry::getVertices() {
+	std::span<const Vertex> Geometry::getVertices() {
 
-		return this->vertices;
+		return this->vertex_view;
 
 	}
 
@@ -103,19 +163,99 @@ namespace bgq_opengl {
     void Geometry::setTransformMat(glm::mat4 transform) {
         
         this->transforms = transform;
+        this->world_bounds_dirty = true;
         
     }
 
     void Geometry::addTexture(const char* image, const char* name) {
         
-        // Create the new texture from the parameters.
-        Texture new_tex(image, name, (int) this->textures.size());
-        
-        // Add this texture to the texture vector.
-        this->textures.push_back(new_tex);
+        // Create the new texture from the parameters in the texture vector.
+        this->textures.emplace_back(image, name, (int) this->textures.size());
         
     }
 
+	void Geometry::computeBounds(std::span<const Vertex> vertices, BoundingBox *bounding_box, BoundingSphere *bounding_sphere) {
+
+		if (vertices.empty()) {
+
+			bounding_box->min = glm::vec3(0.0f);
+			bounding_box->max = glm::vec3(0.0f);
+			bounding_sphere->centre = glm::vec3(0.0f);
+			bounding_sphere->radius = 0.0f;
+			return;
+
+		}
+
+		const float *first = &vertices[0].position.x;
+		size_t n = vertices.size();
+		size_t stride = sizeof(Vertex) / sizeof(float);
+
+#if defined(__SSE__) || defined(__ARM_NEON)
+
+		// Each load takes the position and the first component of the normal, which
+		// always follows it in the vertex, and the fourth lane is just ignored.
+#if defined(__SSE__)
+		__m128 min = _mm_loadu_ps(first);
+		__m128 max = min;
+		for (size_t i = 1; i < n; i++) {
+
+			__m128 position = _mm_loadu_ps(first + i * stride);
+			min = _mm_min_ps(min, position);
+			max = _mm_max_ps(max, position);
+
+		}
+
+		float min_lanes[4], max_lanes[4];
+		_mm_storeu_ps(min_lanes, min);
+		_mm_storeu_ps(max_lanes, max);
+#else
+		float32x4_t min = vld1q_f32(first);
+		float32x4_t max = min;
+		for (size_t i = 1; i < n; i++) {
+
+			float32x4_t position = vld1q_f32(first + i * stride);
+			min = vminq_f32(min, position);
+			max = vmaxq_f32(max, position);
+
+		}
+
+		float min_lanes[4], max_lanes[4];
+		vst1q_f32(min_lanes, min);
+		vst1q_f32(max_lanes, max);
+#endif
+
+		bounding_box->min = glm::vec3(min_lanes[0], min_lanes[1], min_lanes[2]);
+		bounding_box->max = glm::vec3(max_lanes[0], max_lanes[1], max_lanes[2]);
+
+#else
+
+		// Loop through the vertices and get the min and max values.
+		bounding_box->min = vertices[0].position;
+		bounding_box->max = vertices[0].position;
+		for (size_t i = 1; i < n; i++) {
+
+			bounding_box->min = glm::min(bounding_box->min, vertices[i].position);
+			bounding_box->max = glm::max(bounding_box->max, vertices[i].position);
+
+		}
+
+#endif
+
+		// The sphere is centred in the box and reaches the furthest vertex.
+		glm::vec3 centre = (bounding_box->min + bounding_box->max) / 2.0f;
+		float max_dist2 = 0.0f;
+		for (size_t i = 0; i < n; i++) {
+
+			glm::vec3 d = vertices[i].position - centre;
+			max_dist2 = std::max(max_dist2, glm::dot(d, d));
+
+		}
+
+		bounding_sphere->centre = centre;
+		bounding_sphere->radius = sqrtf(max_dist2);
+
+	}
+
 	void Geometry::draw(Shader &shader, Camera &camera) {
 
 		// Activate the VAO and the shader to access the uniforms.
@@ -124,77 +264,133 @@ namespace bgq_opengl {
 
 		for (size_t i = 0; i < textures.size(); i++) {
 
-			std::string name = textures[i].getName();
-			std::string id = "";
-			
 			shader.passTexture(textures[i]);
 			textures[i].bind();
 
 		}
 
-		// Pass the camera to the shader.
-		shader.passCamera(camera);
-        
         // Pass the shininess to the shader.
-        shader.passFloat("materialShininess", this->shininess);
+        shader.passFloat(shader.getUniform(Shader::MATERIAL_SHININESS), this->shininess);
         
-		// Get the model matrix and pass it.
-		glm::mat4 model = this->transforms;
-		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "Model"), 1, GL_FALSE, glm::value_ptr(model));
+		// Pass the model matrix and the ones derived from it.
+		shader.passModel(this->transforms, camera.getView());
 
-		// Get the View matrix and compute the modelView;
-		glm::mat4 view = camera.getView();
-		glm::mat4 model_view = view * model;
-		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "modelView"), 1, GL_FALSE, glm::value_ptr(model_view));
+		// Draw the actual Geometry
+		glDrawElements(GL_TRIANGLES, (GLsizei) index_view.size(), GL_UNSIGNED_INT, 0);
+		DrawCounter::recordDraw(1);
 
-		// Get the normal matrix and pass it.
-		glm::mat4 normal_matrix = glm::transpose(glm::inverse(model_view));
-		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "normalMatrix"), 1, GL_FALSE, glm::value_ptr(normal_matrix));
+	}
 
-		// Draw the actual Geometry
-		glDrawElements(GL_TRIANGLES, (GLsizei) indices.size(), GL_UNSIGNED_INT, 0);
+	void Geometry::linkInstances(VBO &instances) {
+
+		vao.bind();
+
+		// A mat4 attribute takes four consecutive locations, one per column.
+		for (GLuint i = 0; i < 4; i++)
+			vao.link_instance_attribute(instances, 5 + i, 4, GL_FLOAT, sizeof(bgq_opengl::Instance), (void*)(offsetof(bgq_opengl::Instance, model) + i * sizeof(glm::vec4)));
+		vao.link_instance_attribute(instances, 9, 1, GL_INT, sizeof(bgq_opengl::Instance), (void*)offsetof(bgq_opengl::Instance, shading_model));
+
+		vao.unbind();
+
+	}
+
+	void Geometry::drawInstanced(Shader &shader, GLsizei count) {
+
+		// Activate the VAO and the shader to access the uniforms.
+		shader.activate();
+		vao.bind();
+
+		for (size_t i = 0; i < textures.size(); i++) {
+
+			shader.passTexture(textures[i]);
+			textures[i].bind();
+
+		}
+
+        // Pass the shininess to the shader.
+        shader.passFloat(shader.getUniform(Shader::MATERIAL_SHININESS), this->shininess);
+
+		// Draw all the copies at once.
+		glDrawElementsInstanced(GL_TRIANGLES, (GLsizei) index_view.size(), GL_UNSIGNED_INT, 0, count);
+		DrawCounter::recordDraw((unsigned long) count);
 
 	}
 
 	BoundingBox Geometry::getBoundingBox() {
 
-		// Create the bb.
-		BoundingBox bb;
+		return this->bounding_box;
+
+	}
+
+	BoundingSphere Geometry::getBoundingSphere() {
+
+		return this->bounding_sphere;
+
+	}
+
+	BoundingBox Geometry::getWorldBoundingBox() {
+
+		if (!this->world_bounds_dirty)
+			return this->world_bounding_box;
 
-		// Init the bounding box with the first vertex.
-		bb.min = glm::vec3(this->vertices[0].position.x, this->vertices[0].position.y, this->vertices[0].position.z);
-		bb.max = glm::vec3(this->vertices[0].position.x, this->vertices[0].position.y, this->vertices[0].position.z);
+		// Transform the box as centre and half extents so only one pass over the matrix is needed.
+		glm::vec3 centre = (this->bounding_box.min + this->bounding_box.max) / 2.0f;
+		glm::vec3 extents = (this->bounding_box.max - this->bounding_box.min) / 2.0f;
+		glm::vec3 world_centre = glm::vec3(this->transforms * glm::vec4(centre, 1.0f));
+		glm::mat3 abs_matrix = glm::mat3(glm::abs(glm::vec3(this->transforms[0])), glm::abs(glm::vec3(this->transforms[1])), glm::abs(glm::vec3(this->transforms[2])));
+		glm::vec3 world_extents = abs_matrix * extents;
 
-		// Loop through the vertices and get tge min and max values.
-		for (int i = 1; i < this->vertices.size(); i++) {
+		this->world_bounding_box.min = world_centre - world_extents;
+		this->world_bounding_box.max = world_centre + world_extents;
+		this->world_bounds_dirty = false;
 
-			if (bb.min.x > this->vertices[i].position.x)
-				bb.min.x = this->vertices[i].position.x;
+		return this->world_bounding_box;
 
-			if (bb.min.y > this->vertices[i].position.y)
-				bb.min.y = this->vertices[i].position.y;
+	}
+
+	void Geometry::buildBvh(ThreadPool *pool) {
+
+		if (!this->bvh)
+			this->bvh = std::make_shared<const Bvh>(this->vertex_view, this->index_view, pool);
+
+	}
+
+	bool Geometry::intersect(const Ray &ray, RayHit *hit) {
+
+		this->buildBvh();
+
+		// Bring the ray into the space of the vertices. The transforms are affine, so distances along it do not change.
+		glm::mat4 inverse = glm::inverse(this->transforms);
+		Ray local = ray;
+		local.origin = glm::vec3(inverse * glm::vec4(ray.origin, 1.0f));
+		local.direction = glm::mat3(inverse) * ray.direction;
+
+		return (*this->bvh).intersect(local, hit);
+
+	}
 
-			if (bb.min.z > this->vertices[i].position.z)
-				bb.min.z = this->vertices[i].position.z;
+	size_t Geometry::intersect(std::span<const Ray> rays, std::span<RayHit> hits, ThreadPool *pool) {
 
-			if (bb.max.x < this->vertices[i].position.x)
-				bb.max.x = this->vertices[i].position.x;
+		this->buildBvh(pool);
 
-			if (bb.max.y < this->vertices[i].position.y)
-				bb.max.y = this->vertices[i].position.y;
+		glm::mat4 inverse = glm::inverse(this->transforms);
+		glm::mat3 inverse_rotation = glm::mat3(inverse);
+		std::vector<Ray> local(rays.begin(), rays.end());
+		for (Ray &ray : local) {
 
-			if (bb.max.z < this->vertices[i].position.z)
-				bb.max.z = this->vertices[i].position.z;
+			ray.origin = glm::vec3(inverse * glm::vec4(ray.origin, 1.0f));
+			ray.direction = inverse_rotation * ray.direction;
 
 		}
 
-		return bb;
+		return (*this->bvh).intersect(local, hits, pool);
 
 	}
 
 	void Geometry::resetTransforms() {
 
 		this->transforms = glm::mat4(1.0f);
+		this->world_bounds_dirty = true;
 
 	}
 
@@ -208,6 +404,7 @@ namespace bgq_opengl {
 		glm::mat4 rotation_matrix = glm::rotate(identity_matrix, radians, glm::vec3(x, y, z));
 
 		this->transforms *= rotation_matrix;
+		this->world_bounds_dirty = true;
 
 	}
 
@@ -218,6 +415,7 @@ namespace bgq_opengl {
 		glm::mat4 scale_matrix = glm::scale(identity_matrix, glm::vec3(x, y, z));
 
 		this->transforms *= scale_matrix;
+		this->world_bounds_dirty = true;
 
 	}
 
@@ -228,6 +426,7 @@ namespace bgq_opengl {
 
 		// Apply it to the transormations.
 		this->transforms *= trans_matrix;
+		this->world_bounds_dirty = true;
 
 	}
 
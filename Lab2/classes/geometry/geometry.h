@@ -16,20 +16,30 @@
 #ifndef BGQ_OPENGL_CLASSES_GEOMETRY_H_
 #define BGQ_OPENGL_CLASSES_GEOMETRY_H_
 
+#include <memory>
+#include <span>
 #include <vector>
 
 #include "GL/glew.h"
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
+#include "classes/bvh/bvh.h"
 #include "classes/camera/camera.h"
 #include "classes/shader/shader.h"
 #include "classes/texture/texture.h"
+#include "classes/thread_pool/thread_pool.h"
 #include "classes/ebo/ebo.h"
+#include "classes/mapped_file/mapped_file.h"
 #include "classes/vbo/vbo.h"
 #include "classes/vao/vao.h"
+#include "structs/instance/instance.h"
+#include "structs/mesh_data/mesh_data.h"
+#include "structs/ray/ray.h"
+#include "structs/ray_hit/ray_hit.h"
 #include "structs/vertex/vertex.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/bounding_sphere/bounding_sphere.h"
 
 namespace bgq_opengl {
 
@@ -48,41 +58,54 @@ namespace bgq_opengl {
 			/**
 			 * @brief Initializes the Geometry.
 			 * 
-			 * Initializes the geometry and stores it.
+			 * Initializes the geometry and stores it. The data is moved into the
+			 * geometry, so pass temporaries or std::move to avoid copying it.
 			 * 
 			 * @param vertices Vertices of the object.
 			 * @param indices Indices of the vertices.
 			 * @param textures Textures in connection with this geometry.
 			 */
-			Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess);
+			Geometry(std::vector<Vertex> vertices, std::vector<GLuint> indices, std::vector<Texture> textures, const float shininess);
+
+			/**
+			 * @brief Initializes the Geometry from a loaded mesh.
+			 *
+			 * Initializes the geometry from a mesh that was loaded, maybe on another
+			 * thread, and uploads it. Mapped vertices and indices are uploaded straight
+			 * from the mapping and never copied, and the geometry keeps the mapping
+			 * alive so they can still be read. The bounding volumes are taken as given.
+			 *
+			 * @param mesh The loaded mesh.
+			 */
+			Geometry(MeshData mesh);
 
 			/**
 			 * @brief Get the indices of the geometry.
 			 *
-			 * Get the indices of the geometry.
+			 * Get a view of the indices of the geometry, without copying them.
 			 */
-			std::vector<GLuint> getIndices();
+			std::span<const GLuint> getIndices();
 			
 			/**
 			 * @brief Get the textures.
 			 *
-			 * Get the textures.
+			 * Get a view of the textures, without copying them.
 			 */
-			std::vector<Texture> getTextures();
+			std::span<Texture> getTextures();
 			
 			/**
 			 * @brief Get the VAO.
 			 *
 			 * Get the VAO.
 			 */
-			VAO getVAO();
+			VAO& getVAO();
 			
 			/**
 			 * @brief Get the vertices of the geometry.
 			 *
-			 * Get the vertices of the geometry.
+			 * Get a view of the vertices of the geometry, without copying them.
 			 */
-			std::vector<Vertex> getVertices();
+			std::span<const Vertex> getVertices();
         
             /**
              * @brief Get the object shininess.
@@ -133,15 +156,96 @@ namespace bgq_opengl {
 			 */
 			void draw(Shader &shader, Camera &camera);
 
+			/**
+			 * @brief Links the per-instance attributes.
+			 *
+			 * Links the attributes of a VBO of Instance structs to the VAO of this
+			 * Geometry, so that it can be drawn with instancing.
+			 *
+			 * @param instances The VBO holding the instances.
+			 */
+			void linkInstances(VBO &instances);
+
+			/**
+			 * @brief Draws several copies of the Geometry.
+			 *
+			 * Displays several copies of the Geometry in one draw call. The model
+			 * matrices come from the instances linked with linkInstances.
+			 *
+			 * @param shader The shader that reads the per-instance attributes.
+			 * @param count The number of copies to draw.
+			 */
+			void drawInstanced(Shader &shader, GLsizei count);
+
 			/**
 			 * @brief Gets the bounding box.
 			 * 
-			 * Gets the bounding box of the geometry.
+			 * Gets the bounding box of the geometry. It is computed once when the
+			 * geometry is built.
 			 * 
 			 * @returns The bounding box struct.
 			 */
 			BoundingBox getBoundingBox();
 
+			/**
+			 * @brief Gets the bounding sphere.
+			 *
+			 * Gets the bounding sphere of the geometry. It is computed once when the
+			 * geometry is built.
+			 *
+			 * @returns The bounding sphere struct.
+			 */
+			BoundingSphere getBoundingSphere();
+
+			/**
+			 * @brief Gets the bounding box in world space.
+			 *
+			 * Gets the bounding box of the geometry after applying its transforms.
+			 * It is only recomputed, from the corners of the local box, when the
+			 * transforms have changed.
+			 *
+			 * @returns The bounding box struct.
+			 */
+			BoundingBox getWorldBoundingBox();
+
+			/**
+			 * @brief Builds the Bvh.
+			 *
+			 * Builds the hierarchy the rays are cast against, which is otherwise
+			 * built the first time one is. It does not touch OpenGL.
+			 *
+			 * @param pool The workers to build with, or nullptr to build on this thread.
+			 */
+			void buildBvh(ThreadPool *pool = nullptr);
+
+			/**
+			 * @brief Casts a ray.
+			 *
+			 * Finds the closest triangle a ray in world space hits, after the
+			 * transforms of the geometry.
+			 *
+			 * @param ray The ray, in world space.
+			 * @param hit Outputs the closest hit, if there is one.
+			 *
+			 * @returns True if the ray hit a triangle. False otherwise.
+			 */
+			bool intersect(const Ray &ray, RayHit *hit);
+
+			/**
+			 * @brief Casts a batch of rays.
+			 *
+			 * Finds the closest triangle every ray in world space hits, after the
+			 * transforms of the geometry. The rays that miss get a hit at an
+			 * infinite distance.
+			 *
+			 * @param rays The rays, in world space.
+			 * @param hits Outputs the hit of every ray.
+			 * @param pool The workers to cast with, or nullptr to cast on this thread.
+			 *
+			 * @returns The number of rays that hit a triangle.
+			 */
+			size_t intersect(std::span<const Ray> rays, std::span<RayHit> hits, ThreadPool *pool = nullptr);
+
 			/**
 			 * @brief Reset
 			 *
@@ -183,8 +287,28 @@ namespace bgq_opengl {
 			 */
 			void translate(float x, float y, float z);
 
+			/**
+			 * @brief Computes the bounding volumes.
+			 *
+			 * Computes the bounding box and the bounding sphere of some vertices. It
+			 * does not touch OpenGL, so it can be called from any thread.
+			 *
+			 * @param vertices The vertices.
+			 * @param bounding_box Outputs the bounding box.
+			 * @param bounding_sphere Outputs the bounding sphere.
+			 */
+			static void computeBounds(std::span<const Vertex> vertices, BoundingBox *bounding_box, BoundingSphere *bounding_sphere);
+
 		private:
 
+			/**
+			 * @brief Uploads the Geometry.
+			 *
+			 * Uploads the vertices and the indices to OpenGL and links the vertex
+			 * attributes to the VAO.
+			 */
+			void upload();
+
 			/**
 			 * @brief Updates the normal matrix.
 			 * 
@@ -195,9 +319,19 @@ namespace bgq_opengl {
 			std::vector<GLuint> indices;				/// Indices of the vertices.
 			std::vector<Texture> textures;				/// Textures that will color this geometry.
 			VAO vao;									/// VAO containing this object.
+			VBO vbo;									/// VBO holding the vertices.
+			EBO ebo;									/// EBO holding the indices.
 			std::vector<Vertex> vertices;				/// Geometry vertices.
+			std::shared_ptr<const MappedFile> mapping;	/// File holding the vertices and indices, if they were mapped.
+			std::span<const Vertex> vertex_view;		/// Vertices, either in the vector or in the mapping.
+			std::span<const GLuint> index_view;			/// Indices, either in the vector or in the mapping.
 			glm::mat4 transforms = glm::mat4(1.0f);		/// Tranform matrixes that will be passed to the shader.
             float shininess = 1.0;
+			BoundingBox bounding_box;					/// Bounding box of the vertices.
+			BoundingSphere bounding_sphere;				/// Bounding sphere of the vertices.
+			BoundingBox world_bounding_box;				/// Bounding box after the transforms.
+			bool world_bounds_dirty = true;				/// Whether the transforms changed since the last world box.
+			std::shared_ptr<const Bvh> bvh;				/// Hierarchy the rays are cast against, once it is built.
 
 	};
 
@@ -0,0 +1,333 @@
+/**
+ * @file gl_state.cpp
+ * @brief GlState class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "gl_state.h"
+
+#include "GL/glew.h"
+
+#include "structs/gl_state_stats/gl_state_stats.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		template <int N>
+		void forget(GLuint (&values)[N]) {
+
+			for (int i = 0; i < N; i++)
+				values[i] = 0xFFFFFFFF;
+
+		}
+
+		template <int N>
+		void forget(GLuint (&values)[N], GLuint name) {
+
+			for (int i = 0; i < N; i++)
+				if (values[i] == name)
+					values[i] = 0xFFFFFFFF;
+
+		}
+
+	}
+
+	GLuint GlState::program = GlState::UNKNOWN;
+	GLuint GlState::vao = GlState::UNKNOWN;
+	GLuint GlState::draw_framebuffer = GlState::UNKNOWN;
+	GLuint GlState::read_framebuffer = GlState::UNKNOWN;
+	GLuint GlState::array_buffer = GlState::UNKNOWN;
+	GLuint GlState::element_buffer = GlState::UNKNOWN;
+	GLuint GlState::uniform_buffer = GlState::UNKNOWN;
+	GLuint GlState::texture_buffer = GlState::UNKNOWN;
+	GLuint GlState::uniform_blocks[MAX_BUFFER_BINDINGS] = {};
+	GLuint GlState::active_unit = GlState::UNKNOWN;
+	GLuint GlState::textures_2d[MAX_TEXTURE_UNITS] = {};
+	GLuint GlState::textures_cube[MAX_TEXTURE_UNITS] = {};
+	GLuint GlState::textures_buffer[MAX_TEXTURE_UNITS] = {};
+	GLuint GlState::depth_func = GlState::UNKNOWN;
+	GLuint GlState::depth_test = GlState::UNKNOWN;
+	GLuint GlState::blend = GlState::UNKNOWN;
+	GLuint GlState::cull_face = GlState::UNKNOWN;
+	GlStateStats GlState::stats = {0, 0};
+
+	bool GlState::bindBuffer(GLenum target, GLuint buffer) {
+
+		GLuint *current = nullptr;
+		if (target == GL_ARRAY_BUFFER)
+			current = &array_buffer;
+		else if (target == GL_ELEMENT_ARRAY_BUFFER)
+			current = &element_buffer;
+		else if (target == GL_UNIFORM_BUFFER)
+			current = &uniform_buffer;
+		else if (target == GL_TEXTURE_BUFFER)
+			current = &texture_buffer;
+
+		if (current != nullptr && !update(current, buffer))
+			return false;
+
+		if (current == nullptr)
+			stats.calls++;
+
+		glBindBuffer(target, buffer);
+		return true;
+
+	}
+
+	bool GlState::bindUniformBlock(GLuint index, GLuint buffer) {
+
+		// The generic binding changes even when the indexed one does not.
+		if (index >= (GLuint) MAX_BUFFER_BINDINGS) {
+
+			stats.calls++;
+			uniform_buffer = buffer;
+
+		} else if (!update(&uniform_blocks[index], buffer)) {
+
+			return false;
+
+		}
+
+		glBindBufferBase(GL_UNIFORM_BUFFER, index, buffer);
+		uniform_buffer = buffer;
+		return true;
+
+	}
+
+	bool GlState::bindFramebuffer(GLenum target, GLuint framebuffer) {
+
+		// Binding both targets only goes through if either of them changes.
+		if (target == GL_FRAMEBUFFER) {
+
+			if (draw_framebuffer == framebuffer && read_framebuffer == framebuffer) {
+
+				stats.filtered++;
+				return false;
+
+			}
+
+			draw_framebuffer = framebuffer;
+			read_framebuffer = framebuffer;
+			stats.calls++;
+
+		} else if (target == GL_DRAW_FRAMEBUFFER) {
+
+			if (!update(&draw_framebuffer, framebuffer))
+				return false;
+
+		} else if (target == GL_READ_FRAMEBUFFER) {
+
+			if (!update(&read_framebuffer, framebuffer))
+				return false;
+
+		} else {
+
+			stats.calls++;
+
+		}
+
+		glBindFramebuffer(target, framebuffer);
+		return true;
+
+	}
+
+	bool GlState::bindTexture(GLuint unit, GLenum target, GLuint texture) {
+
+		if (update(&active_unit, unit))
+			glActiveTexture(GL_TEXTURE0 + unit);
+
+		GLuint *current = nullptr;
+		if (unit < (GLuint) MAX_TEXTURE_UNITS) {
+
+			if (target == GL_TEXTURE_2D)
+				current = &textures_2d[unit];
+			else if (target == GL_TEXTURE_CUBE_MAP)
+				current = &textures_cube[unit];
+			else if (target == GL_TEXTURE_BUFFER)
+				current = &textures_buffer[unit];
+
+		}
+
+		if (current != nullptr && !update(current, texture))
+			return false;
+
+		if (current == nullptr)
+			stats.calls++;
+
+		glBindTexture(target, texture);
+		return true;
+
+	}
+
+	bool GlState::bindVertexArray(GLuint vao) {
+
+		if (!update(&GlState::vao, vao))
+			return false;
+
+		glBindVertexArray(vao);
+
+		// Every VAO has its own element array buffer.
+		element_buffer = UNKNOWN;
+		return true;
+
+	}
+
+	void GlState::deleteBuffer(GLuint buffer) {
+
+		glDeleteBuffers(1, &buffer);
+
+		GLuint *buffers[] = {&array_buffer, &element_buffer, &uniform_buffer, &texture_buffer};
+		for (GLuint *current : buffers)
+			if (*current == buffer)
+				*current = UNKNOWN;
+		forget(uniform_blocks, buffer);
+
+	}
+
+	void GlState::deleteFramebuffer(GLuint framebuffer) {
+
+		glDeleteFramebuffers(1, &framebuffer);
+
+		if (draw_framebuffer == framebuffer)
+			draw_framebuffer = 0;
+		if (read_framebuffer == framebuffer)
+			read_framebuffer = 0;
+
+	}
+
+	void GlState::deleteProgram(GLuint program) {
+
+		glDeleteProgram(program);
+
+		if (GlState::program == program)
+			GlState::program = UNKNOWN;
+
+	}
+
+	void GlState::deleteTexture(GLuint texture) {
+
+		glDeleteTextures(1, &texture);
+
+		forget(textures_2d, texture);
+		forget(textures_cube, texture);
+		forget(textures_buffer, texture);
+
+	}
+
+	void GlState::deleteVertexArray(GLuint vao) {
+
+		glDeleteVertexArrays(1, &vao);
+
+		if (GlState::vao == vao) {
+
+			GlState::vao = UNKNOWN;
+			element_buffer = UNKNOWN;
+
+		}
+
+	}
+
+	GlStateStats GlState::getStats() {
+
+		return stats;
+
+	}
+
+	void GlState::invalidate() {
+
+		program = UNKNOWN;
+		vao = UNKNOWN;
+		draw_framebuffer = UNKNOWN;
+		read_framebuffer = UNKNOWN;
+		array_buffer = UNKNOWN;
+		element_buffer = UNKNOWN;
+		uniform_buffer = UNKNOWN;
+		texture_buffer = UNKNOWN;
+		forget(uniform_blocks);
+		active_unit = UNKNOWN;
+		forget(textures_2d);
+		forget(textures_cube);
+		forget(textures_buffer);
+		depth_func = UNKNOWN;
+		depth_test = UNKNOWN;
+		blend = UNKNOWN;
+		cull_face = UNKNOWN;
+
+	}
+
+	void GlState::resetStats() {
+
+		stats = {0, 0};
+
+	}
+
+	bool GlState::setDepthFunc(GLenum function) {
+
+		if (!update(&depth_func, function))
+			return false;
+
+		glDepthFunc(function);
+		return true;
+
+	}
+
+	bool GlState::setEnabled(GLenum capability, bool enabled) {
+
+		GLuint *current = nullptr;
+		if (capability == GL_DEPTH_TEST)
+			current = &depth_test;
+		else if (capability == GL_BLEND)
+			current = &blend;
+		else if (capability == GL_CULL_FACE)
+			current = &cull_face;
+
+		if (current != nullptr && !update(current, enabled ? 1 : 0))
+			return false;
+
+		if (current == nullptr)
+			stats.calls++;
+
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+		return true;
+
+	}
+
+	bool GlState::update(GLuint *current, GLuint value) {
+
+		if (*current == value) {
+
+			stats.filtered++;
+			return false;
+
+		}
+
+		*current = value;
+		stats.calls++;
+		return true;
+
+	}
+
+	bool GlState::useProgram(GLuint program) {
+
+		if (!update(&GlState::program, program))
+			return false;
+
+		glUseProgram(program);
+		return true;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,256 @@
+/**
+ * @file gl_state.h
+ * @brief GlState class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_GLSTATE_H_
+#define BGQ_OPENGL_CLASSES_GLSTATE_H_
+
+#include "GL/glew.h"
+
+#include "structs/gl_state_stats/gl_state_stats.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a GlState class.
+	 *
+	 * Keeps a copy of the bound program, VAO, framebuffers, buffers and textures, and of the
+	 * depth and blend state, so that the calls that would set them to what
+	 * they already are never reach the driver. Every class changes that state
+	 * through here, only ever from the thread that owns the context.
+	 *
+	 * Nothing is known at first, so the first call for every piece of state
+	 * always goes through. Code that changes the state behind the cache has to
+	 * call invalidate afterwards.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GlState {
+
+		public:
+
+			static const int MAX_TEXTURE_UNITS = 32;	/// Texture units that are tracked.
+			static const int MAX_BUFFER_BINDINGS = 16;	/// Uniform block binding points that are tracked.
+
+			/**
+			 * @brief Binds a buffer.
+			 *
+			 * Binds a buffer to a target. Array, element array, uniform and texture
+			 * buffers are tracked, and any other target always goes through.
+			 *
+			 * @param target The target.
+			 * @param buffer The buffer, or 0 to unbind it.
+			 *
+			 * @returns True if the call reached the driver.
+			 */
+			static bool bindBuffer(GLenum target, GLuint buffer);
+
+			/**
+			 * @brief Binds a uniform buffer to a binding point.
+			 *
+			 * Binds a whole uniform buffer to a binding point of the uniform blocks,
+			 * which also binds it to the uniform buffer target.
+			 *
+			 * @param index The binding point.
+			 * @param buffer The buffer, or 0 to unbind it.
+			 *
+			 * @returns True if the call reached the driver.
+			 */
+			static bool bindUniformBlock(GLuint index, GLuint buffer);
+
+			/**
+			 * @brief Binds a framebuffer.
+			 *
+			 * Binds a framebuffer to the draw or read target, or to both of them
+			 * with GL_FRAMEBUFFER.
+			 *
+			 * @param target The target.
+			 * @param framebuffer The framebuffer, or 0 for the default one.
+			 *
+			 * @returns True if the call reached the driver.
+			 */
+			static bool bindFramebuffer(GLenum target, GLuint framebuffer);
+
+			/**
+			 * @brief Binds a texture.
+			 *
+			 * Binds a texture to a target of a texture unit, which is left as the
+			 * active one so that the texture can be filled right after.
+			 *
+			 * @param unit The texture unit.
+			 * @param target The target, which is 2D, cube map or buffer.
+			 * @param texture The texture, or 0 to unbind it.
+			 *
+			 * @returns True if the bind reached the driver.
+			 */
+			static bool bindTexture(GLuint unit, GLenum target, GLuint texture);
+
+			/**
+			 * @brief Binds a VAO.
+			 *
+			 * Binds a VAO. The element array buffer belongs to the VAO, so it is
+			 * forgotten too.
+			 *
+			 * @param vao The VAO, or 0 to unbind it.
+			 *
+			 * @returns True if the call reached the driver.
+			 */
+			static bool bindVertexArray(GLuint vao);
+
+			/**
+			 * @brief Deletes a buffer.
+			 *
+			 * Deletes a buffer and forgets every binding of it.
+			 *
+			 * @param buffer The buffer.
+			 */
+			static void deleteBuffer(GLuint buffer);
+
+			/**
+			 * @brief Deletes a framebuffer.
+			 *
+			 * Deletes a framebuffer and forgets it if it was bound. OpenGL binds the
+			 * default framebuffer instead, so that is what is remembered.
+			 *
+			 * @param framebuffer The framebuffer.
+			 */
+			static void deleteFramebuffer(GLuint framebuffer);
+
+			/**
+			 * @brief Deletes a program.
+			 *
+			 * Deletes a program and forgets it if it was in use.
+			 *
+			 * @param program The program.
+			 */
+			static void deleteProgram(GLuint program);
+
+			/**
+			 * @brief Deletes a texture.
+			 *
+			 * Deletes a texture and forgets every binding of it.
+			 *
+			 * @param texture The texture.
+			 */
+			static void deleteTexture(GLuint texture);
+
+			/**
+			 * @brief Deletes a VAO.
+			 *
+			 * Deletes a VAO and forgets it if it was bound.
+			 *
+			 * @param vao The VAO.
+			 */
+			static void deleteVertexArray(GLuint vao);
+
+			/**
+			 * @brief Get the counters.
+			 *
+			 * Get the counters since the last reset.
+			 *
+			 * @returns The counters.
+			 */
+			static GlStateStats getStats();
+
+			/**
+			 * @brief Forgets the whole state.
+			 *
+			 * Forgets everything that was tracked, so that the next call for every
+			 * piece of state goes through.
+			 */
+			static void invalidate();
+
+			/**
+			 * @brief Reset the counters.
+			 *
+			 * Reset the counters, typically at the beginning of every frame.
+			 */
+			static void resetStats();
+
+			/**
+			 * @brief Sets the depth function.
+			 *
+			 * Sets the function that compares the depths of the fragments.
+			 *
+			 * @param function The function.
+			 *
+			 * @returns True if the call reached the driver.
+			 */
+			static bool setDepthFunc(GLenum function);
+
+			/**
+			 * @brief Enables or disables a capability.
+			 *
+			 * Enables or disables a capability. The depth test, blending and face
+			 * culling are tracked, and any other one always goes through.
+			 *
+			 * @param capability The capability.
+			 * @param enabled True to enable it.
+			 *
+			 * @returns True if the call reached the driver.
+			 */
+			static bool setEnabled(GLenum capability, bool enabled);
+
+			/**
+			 * @brief Uses a program.
+			 *
+			 * Makes a program the one that draws.
+			 *
+			 * @param program The program, or 0 for none.
+			 *
+			 * @returns True if the call reached the driver.
+			 */
+			static bool useProgram(GLuint program);
+
+		private:
+
+			static const GLuint UNKNOWN = 0xFFFFFFFF;	/// Value of the state that is not known.
+
+			/**
+			 * @brief Checks a piece of state.
+			 *
+			 * Checks whether a piece of state already has a value and stores the
+			 * value otherwise, counting the call either way.
+			 *
+			 * @param current The tracked value.
+			 * @param value The new value.
+			 *
+			 * @returns True if the value changed and the call has to be made.
+			 */
+			static bool update(GLuint *current, GLuint value);
+
+			static GLuint program;									/// Program in use.
+			static GLuint vao;										/// VAO bound.
+			static GLuint draw_framebuffer;							/// Framebuffer bound to the draw target.
+			static GLuint read_framebuffer;							/// Framebuffer bound to the read target.
+			static GLuint array_buffer;								/// Buffer bound to the array buffer target.
+			static GLuint element_buffer;							/// Buffer bound to the element array buffer target.
+			static GLuint uniform_buffer;							/// Buffer bound to the uniform buffer target.
+			static GLuint texture_buffer;							/// Buffer bound to the texture buffer target.
+			static GLuint uniform_blocks[MAX_BUFFER_BINDINGS];		/// Buffer bound to each uniform block binding point.
+			static GLuint active_unit;								/// Active texture unit.
+			static GLuint textures_2d[MAX_TEXTURE_UNITS];			/// 2D texture bound to each unit.
+			static GLuint textures_cube[MAX_TEXTURE_UNITS];			/// Cube map bound to each unit.
+			static GLuint textures_buffer[MAX_TEXTURE_UNITS];		/// Buffer texture bound to each unit.
+			static GLuint depth_func;								/// Depth function.
+			static GLuint depth_test;								/// Whether the depth test is on.
+			static GLuint blend;									/// Whether blending is on.
+			static GLuint cull_face;								/// Whether face culling is on.
+			static GlStateStats stats;								/// Counters since the last reset.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_GLSTATE_H_
@@ -0,0 +1,278 @@
+/**
+ * @file gpu_profiler.cpp
+ * @brief GpuProfiler class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "gpu_profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "GL/glew.h"
+
+#include "structs/zone_stats/zone_stats.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		// Everything is static storage so that profiling never allocates.
+		GLuint queries[GpuProfiler::FRAMES_IN_FLIGHT][GpuProfiler::MAX_RECORDS][2];
+		int record_zones[GpuProfiler::FRAMES_IN_FLIGHT][GpuProfiler::MAX_RECORDS];
+		bool record_closed[GpuProfiler::FRAMES_IN_FLIGHT][GpuProfiler::MAX_RECORDS];
+		int num_records[GpuProfiler::FRAMES_IN_FLIGHT];
+		GLuint last_query[GpuProfiler::FRAMES_IN_FLIGHT];
+		int oldest = 0;
+		int in_flight = 0;
+		int current = 0;
+		int frame_record = -1;
+		bool recording = false;
+
+		// Names are copied, since equal literals of different files may not share an address.
+		const size_t MAX_NAME = 32;
+		char names[GpuProfiler::MAX_ZONES][MAX_NAME];
+		int num_zones = 0;
+		double history[GpuProfiler::MAX_ZONES][GpuProfiler::HISTORY];
+		int history_size[GpuProfiler::MAX_ZONES];
+		int history_next[GpuProfiler::MAX_ZONES];
+		double frame_times[GpuProfiler::MAX_ZONES];
+		bool frame_seen[GpuProfiler::MAX_ZONES];
+
+		unsigned long dropped = 0;
+		bool enabled = false;
+
+		void readFrame(int frame) {
+
+			for (int i = 0; i < num_zones; i++) {
+
+				frame_times[i] = 0.0;
+				frame_seen[i] = false;
+
+			}
+
+			// Add up the times of every zone, which may have been entered several times.
+			for (int i = 0; i < num_records[frame]; i++) {
+
+				if (!record_closed[frame][i])
+					continue;
+
+				GLuint64 start = 0, end = 0;
+				glGetQueryObjectui64v(queries[frame][i][0], GL_QUERY_RESULT, &start);
+				glGetQueryObjectui64v(queries[frame][i][1], GL_QUERY_RESULT, &end);
+
+				int zone = record_zones[frame][i];
+				frame_times[zone] += (end - start) / 1e6;
+				frame_seen[zone] = true;
+
+			}
+
+			for (int i = 0; i < num_zones; i++) {
+
+				if (!frame_seen[i])
+					continue;
+
+				history[i][history_next[i]] = frame_times[i];
+				history_next[i] = (history_next[i] + 1) % GpuProfiler::HISTORY;
+				if (history_size[i] < GpuProfiler::HISTORY)
+					history_size[i]++;
+
+			}
+
+		}
+
+	}
+
+	void GpuProfiler::beginFrame() {
+
+		if (!enabled)
+			return;
+
+		// Read the frames the GPU is done with. They finish in order, so stop at the first one that is not.
+		while (in_flight > 0) {
+
+			if (num_records[oldest] > 0) {
+
+				GLint available = 0;
+				glGetQueryObjectiv(last_query[oldest], GL_QUERY_RESULT_AVAILABLE, &available);
+				if (!available)
+					break;
+
+				readFrame(oldest);
+
+			}
+
+			oldest = (oldest + 1) % FRAMES_IN_FLIGHT;
+			in_flight--;
+
+		}
+
+		// Reuse the queries of the oldest frame rather than waiting for them.
+		if (in_flight == FRAMES_IN_FLIGHT) {
+
+			dropped++;
+			oldest = (oldest + 1) % FRAMES_IN_FLIGHT;
+			in_flight--;
+
+		}
+
+		current = (oldest + in_flight) % FRAMES_IN_FLIGHT;
+		num_records[current] = 0;
+		recording = true;
+
+		frame_record = beginZone(getZone("frame"));
+
+	}
+
+	int GpuProfiler::beginZone(int zone) {
+
+		if (!recording || zone < 0 || num_records[current] == MAX_RECORDS)
+			return -1;
+
+		int record = num_records[current]++;
+		record_zones[current][record] = zone;
+		record_closed[current][record] = false;
+		glQueryCounter(queries[current][record][0], GL_TIMESTAMP);
+
+		return record;
+
+	}
+
+	void GpuProfiler::endFrame() {
+
+		if (!recording)
+			return;
+
+		endZone(frame_record);
+		frame_record = -1;
+
+		recording = false;
+		in_flight++;
+
+	}
+
+	void GpuProfiler::endZone(int record) {
+
+		if (!recording || record < 0)
+			return;
+
+		glQueryCounter(queries[current][record][1], GL_TIMESTAMP);
+		record_closed[current][record] = true;
+		last_query[current] = queries[current][record][1];
+
+	}
+
+	unsigned long GpuProfiler::getDropped() {
+
+		return dropped;
+
+	}
+
+	int GpuProfiler::getNumZones() {
+
+		return num_zones;
+
+	}
+
+	ZoneStats GpuProfiler::getStats(int index) {
+
+		ZoneStats stats = {names[index], history_size[index], 0.0, 0.0, 0.0, 0.0, 0.0};
+		if (history_size[index] == 0)
+			return stats;
+
+		// Sort a copy of the history for the percentiles.
+		static double sorted[HISTORY];
+		int size = history_size[index];
+		std::copy(history[index], history[index] + size, sorted);
+		std::sort(sorted, sorted + size);
+
+		for (int i = 0; i < size; i++)
+			stats.mean += sorted[i] / size;
+
+		stats.last = history[index][(history_next[index] + HISTORY - 1) % HISTORY];
+		stats.median = sorted[(size - 1) / 2];
+		stats.p95 = sorted[std::min(size - 1, (size * 95 + 99) / 100 - 1)];
+		stats.max = sorted[size - 1];
+
+		return stats;
+
+	}
+
+	int GpuProfiler::getZone(const char *name) {
+
+		for (int i = 0; i < num_zones; i++)
+			if (strncmp(names[i], name, MAX_NAME - 1) == 0)
+				return i;
+
+		if (num_zones == MAX_ZONES)
+			return -1;
+
+		strncpy(names[num_zones], name, MAX_NAME - 1);
+		names[num_zones][MAX_NAME - 1] = '\0';
+		history_size[num_zones] = 0;
+		history_next[num_zones] = 0;
+
+		return num_zones++;
+
+	}
+
+	void GpuProfiler::init() {
+
+		// Timestamp queries are core since OpenGL 3.3.
+		if (enabled || !(GLEW_VERSION_3_3 || GLEW_ARB_timer_query))
+			return;
+
+		glGenQueries(FRAMES_IN_FLIGHT * MAX_RECORDS * 2, &queries[0][0][0]);
+		oldest = 0;
+		in_flight = 0;
+		enabled = true;
+
+	}
+
+	bool GpuProfiler::isEnabled() {
+
+		return enabled;
+
+	}
+
+	void GpuProfiler::remove() {
+
+		if (!enabled)
+			return;
+
+		glDeleteQueries(FRAMES_IN_FLIGHT * MAX_RECORDS * 2, &queries[0][0][0]);
+		enabled = false;
+		recording = false;
+
+	}
+
+	GpuZone::GpuZone(const char *name) {
+
+		if (GpuProfiler::isEnabled())
+			this->record = GpuProfiler::beginZone(GpuProfiler::getZone(name));
+
+	}
+
+	GpuZone::~GpuZone() {
+
+		this->end();
+
+	}
+
+	void GpuZone::end() {
+
+		GpuProfiler::endZone(this->record);
+		this->record = -1;
+
+	}
+
+}  // namespace bgq_opengl
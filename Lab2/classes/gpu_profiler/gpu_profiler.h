@@ -0,0 +1,203 @@
+/**
+ * @file gpu_profiler.h
+ * @brief GpuProfiler class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_GPUPROFILER_H_
+#define BGQ_OPENGL_CLASSES_GPUPROFILER_H_
+
+#include "structs/zone_stats/zone_stats.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a GpuProfiler class.
+	 *
+	 * Measures the GPU time of the zones of every frame, which are opened with
+	 * GpuZone, and keeps the times of the last frames of every zone. The zones
+	 * are marked with timestamp queries, so they can be nested and used while
+	 * a GL_TIME_ELAPSED query is running. The queries of a few frames are kept
+	 * in a ring and only read once the GPU is done with them, so the pipeline
+	 * never waits for the results. If the GPU falls further behind than that,
+	 * the oldest frame is dropped instead.
+	 *
+	 * The whole frame is measured as the "frame" zone. Everything lives in
+	 * static storage, so profiling never allocates, and it must only be used
+	 * from the thread that owns the context.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GpuProfiler {
+
+		public:
+
+			static const int MAX_ZONES = 16;		/// Maximum number of different zones.
+			static const int MAX_RECORDS = 64;		/// Maximum number of zones entered in a frame.
+			static const int FRAMES_IN_FLIGHT = 4;	/// Frames whose queries can be waiting for the GPU.
+			static const int HISTORY = 120;			/// Frames kept for the statistics of every zone.
+
+			/**
+			 * @brief Starts a new frame.
+			 *
+			 * Reads the results of the previous frames that the GPU has finished
+			 * and opens the zone of the whole frame.
+			 */
+			static void beginFrame();
+
+			/**
+			 * @brief Ends the current frame.
+			 *
+			 * Closes the zone of the whole frame and leaves its queries in flight.
+			 */
+			static void endFrame();
+
+			/**
+			 * @brief Get the number of dropped frames.
+			 *
+			 * Get the number of frames whose results were not ready when their
+			 * queries had to be reused.
+			 *
+			 * @returns The number of dropped frames.
+			 */
+			static unsigned long getDropped();
+
+			/**
+			 * @brief Get the number of zones.
+			 *
+			 * Get the number of different zones seen so far.
+			 *
+			 * @returns The number of zones.
+			 */
+			static int getNumZones();
+
+			/**
+			 * @brief Get the times of a zone.
+			 *
+			 * Get the statistics of a zone over the last frames measured.
+			 *
+			 * @param index The index of the zone, up to getNumZones.
+			 *
+			 * @returns The statistics struct.
+			 */
+			static ZoneStats getStats(int index);
+
+			/**
+			 * @brief Creates the queries.
+			 *
+			 * Creates the queries of every frame in flight. Without timer queries
+			 * the profiler stays disabled and every function does nothing.
+			 */
+			static void init();
+
+			/**
+			 * @brief Whether the profiler is running.
+			 *
+			 * Whether the profiler was initialised with timer queries available.
+			 *
+			 * @returns True if the zones are being measured.
+			 */
+			static bool isEnabled();
+
+			/**
+			 * @brief Removes the queries.
+			 *
+			 * Removes the queries from OpenGL and disables the profiler.
+			 */
+			static void remove();
+
+		private:
+
+			friend class GpuZone;
+
+			/**
+			 * @brief Opens a zone.
+			 *
+			 * Writes the timestamp of the beginning of a zone.
+			 *
+			 * @param zone The index of the zone.
+			 *
+			 * @returns The record of the zone in this frame, or -1 if it is not measured.
+			 */
+			static int beginZone(int zone);
+
+			/**
+			 * @brief Closes a zone.
+			 *
+			 * Writes the timestamp of the end of a zone.
+			 *
+			 * @param record The record returned by beginZone.
+			 */
+			static void endZone(int record);
+
+			/**
+			 * @brief Gets the index of a zone.
+			 *
+			 * Gets the index of a zone, registering it the first time it is seen.
+			 * Names are compared by their contents, up to their first 31 characters.
+			 *
+			 * @param name The name of the zone.
+			 *
+			 * @returns The index of the zone, or -1 if there is no room for it.
+			 */
+			static int getZone(const char *name);
+
+	};
+
+	/**
+	 * @brief Implementation of a GpuZone class.
+	 *
+	 * Measures the GPU time of the commands issued while it is alive, or until
+	 * it is ended. Zones can be nested, and a zone entered several times in a
+	 * frame adds its times up.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GpuZone {
+
+		public:
+
+			/**
+			 * @brief Opens the zone.
+			 *
+			 * Starts measuring the zone.
+			 *
+			 * @param name The name of the zone. It has to outlive the program, like a string literal.
+			 */
+			GpuZone(const char *name);
+
+			/**
+			 * @brief Closes the zone.
+			 *
+			 * Stops measuring the zone, if it was not ended already.
+			 */
+			~GpuZone();
+
+			GpuZone(const GpuZone&) = delete;
+			GpuZone& operator=(const GpuZone&) = delete;
+
+			/**
+			 * @brief Closes the zone early.
+			 *
+			 * Stops measuring the zone before it goes out of scope.
+			 */
+			void end();
+
+		private:
+
+			int record = -1;	/// Record of the zone in the current frame, or -1 if it is not measured.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_GPUPROFILER_H_
@@ -0,0 +1,143 @@
+/**
+ * @file gpu_timer.cpp
+ * @brief GpuTimer class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "gpu_timer.h"
+
+#include <utility>
+#include <cstddef>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	GpuTimer::GpuTimer(int size) {
+
+		this->queries.resize(size);
+		glGenQueries(size, this->queries.data());
+
+	}
+
+	GpuTimer::GpuTimer(GpuTimer&& other) noexcept : queries(std::move(other.queries)), first(other.first), pending(other.pending), times(std::move(other.times)) {
+
+		// Leave the other one empty so it does not delete the queries.
+		other.queries.clear();
+		other.first = 0;
+		other.pending = 0;
+
+	}
+
+	GpuTimer& GpuTimer::operator=(GpuTimer&& other) noexcept {
+
+		if (this != &other) {
+
+			// Release the current queries before taking the other ones.
+			this->remove();
+
+			this->queries = std::move(other.queries);
+			this->first = other.first;
+			this->pending = other.pending;
+			this->times = std::move(other.times);
+			other.queries.clear();
+			other.first = 0;
+			other.pending = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	GpuTimer::~GpuTimer() {
+
+		this->remove();
+
+	}
+
+	void GpuTimer::begin() {
+
+		// Make room in the ring, waiting for the oldest query if needed.
+		if (this->pending == this->queries.size()) {
+
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(this->queries[this->first], GL_QUERY_RESULT, &elapsed);
+			this->times.push_back(elapsed / 1e6);
+			this->first = (this->first + 1) % this->queries.size();
+			this->pending--;
+
+		}
+
+		glBeginQuery(GL_TIME_ELAPSED, this->queries[(this->first + this->pending) % this->queries.size()]);
+
+	}
+
+	void GpuTimer::clear() {
+
+		this->times.clear();
+
+	}
+
+	void GpuTimer::collect(bool wait) {
+
+		// The queries finish in order, so stop at the first one that is not ready.
+		while (this->pending > 0) {
+
+			GLuint query = this->queries[this->first];
+			if (!wait) {
+
+				GLint available = 0;
+				glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+				if (!available)
+					break;
+
+			}
+
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+			this->times.push_back(elapsed / 1e6);
+			this->first = (this->first + 1) % this->queries.size();
+			this->pending--;
+
+		}
+
+	}
+
+	void GpuTimer::end() {
+
+		glEndQuery(GL_TIME_ELAPSED);
+		this->pending++;
+
+		this->collect(false);
+
+	}
+
+	const std::vector<double>& GpuTimer::getTimes() const {
+
+		return this->times;
+
+	}
+
+	void GpuTimer::remove() {
+
+		// Delete the queries in OpenGL, if there are any.
+		if (!this->queries.empty())
+			glDeleteQueries((GLsizei) this->queries.size(), this->queries.data());
+		this->queries.clear();
+		this->first = 0;
+		this->pending = 0;
+
+	}
+
+}  // namespace bgq_opengl
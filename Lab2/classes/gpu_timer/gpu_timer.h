@@ -0,0 +1,143 @@
+/**
+ * @file gpu_timer.h
+ * @brief GpuTimer class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_GPUTIMER_H_
+#define BGQ_OPENGL_CLASSES_GPUTIMER_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a GpuTimer class.
+	 *
+	 * Measures how long the GPU takes to run a series of commands with timer
+	 * queries. The queries are kept in a ring and only read once they are
+	 * available, so measuring a frame does not wait for it to finish.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GpuTimer {
+
+		public:
+
+			/**
+			 * @brief Constructs a GpuTimer.
+			 *
+			 * Creates the ring of queries.
+			 *
+			 * @param size The number of measurements that can be in flight.
+			 */
+			GpuTimer(int size = 4);
+
+			/**
+			 * @brief GpuTimer objects cannot be copied.
+			 *
+			 * GpuTimer objects own their queries, so they cannot be copied.
+			 */
+			GpuTimer(const GpuTimer&) = delete;
+			GpuTimer& operator=(const GpuTimer&) = delete;
+
+			/**
+			 * @brief Moves a GpuTimer.
+			 *
+			 * Takes the queries from another GpuTimer, which is left empty.
+			 *
+			 * @param other The GpuTimer to move from.
+			 */
+			GpuTimer(GpuTimer&& other) noexcept;
+
+			/**
+			 * @brief Moves a GpuTimer.
+			 *
+			 * Removes the current queries and takes the ones of another GpuTimer,
+			 * which is left empty.
+			 *
+			 * @param other The GpuTimer to move from.
+			 *
+			 * @returns This GpuTimer.
+			 */
+			GpuTimer& operator=(GpuTimer&& other) noexcept;
+
+			/**
+			 * @brief Destroys the GpuTimer.
+			 *
+			 * Removes the queries from OpenGL.
+			 */
+			~GpuTimer();
+
+			/**
+			 * @brief Starts a measurement.
+			 *
+			 * Starts measuring the commands issued from now on. If every query of
+			 * the ring is in flight, waits for the oldest one first.
+			 */
+			void begin();
+
+			/**
+			 * @brief Forgets the measured times.
+			 *
+			 * Forgets the times read so far. Measurements in flight are kept.
+			 */
+			void clear();
+
+			/**
+			 * @brief Reads the finished measurements.
+			 *
+			 * Reads the queries that are available, oldest first.
+			 *
+			 * @param wait Whether to wait for every measurement in flight.
+			 */
+			void collect(bool wait);
+
+			/**
+			 * @brief Ends a measurement.
+			 *
+			 * Ends the measurement started by begin and reads any older ones that
+			 * are already available.
+			 */
+			void end();
+
+			/**
+			 * @brief Get the measured times.
+			 *
+			 * Get the times read so far, oldest first.
+			 *
+			 * @returns The times in milliseconds.
+			 */
+			const std::vector<double>& getTimes() const;
+
+			/**
+			 * @brief Removes the GpuTimer.
+			 *
+			 * Removes the queries from OpenGL.
+			 */
+			void remove();
+
+		private:
+
+			std::vector<GLuint> queries;	/// GL IDs of the ring of queries.
+			size_t first = 0;				/// Oldest query in flight.
+			size_t pending = 0;				/// Number of queries in flight.
+			std::vector<double> times;		/// Times read so far, in milliseconds.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_GPUTIMER_H_
@@ -0,0 +1,121 @@
+/**
+ * @file headless_context.cpp
+ * @brief HeadlessContext class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "headless_context.h"
+
+#ifdef BGQ_HEADLESS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#include <iostream>
+
+namespace bgq_opengl {
+
+	HeadlessContext::HeadlessContext(int major, int minor) {
+
+#ifdef BGQ_HEADLESS
+		// Ask for a display that needs no window system, and fall back to the default one.
+		EGLDisplay display = EGL_NO_DISPLAY;
+		PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+		if (getPlatformDisplay)
+			display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		if (display == EGL_NO_DISPLAY)
+			display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+		EGLint egl_major, egl_minor;
+		if (display == EGL_NO_DISPLAY || !eglInitialize(display, &egl_major, &egl_minor)) {
+
+			std::cerr << "Headless error - Could not initialize EGL: " << eglGetError() << std::endl;
+			return;
+
+		}
+		this->display = display;
+
+		// Surfaceless displays have no window configs, so ask for a pbuffer one.
+		const EGLint config_attributes[] = {
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_NONE
+		};
+
+		EGLConfig config;
+		EGLint num_configs = 0;
+		if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(display, config_attributes, &config, 1, &num_configs) || num_configs == 0) {
+
+			std::cerr << "Headless error - There is no desktop OpenGL config: " << eglGetError() << std::endl;
+			return;
+
+		}
+
+		const EGLint context_attributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, major,
+			EGL_CONTEXT_MINOR_VERSION, minor,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+
+		// The context is made current without any surface.
+		EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+		if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+
+			std::cerr << "Headless error - Could not create a surfaceless context: " << eglGetError() << std::endl;
+			if (context != EGL_NO_CONTEXT)
+				eglDestroyContext(display, context);
+			return;
+
+		}
+		this->context = context;
+#else
+		(void) major;
+		(void) minor;
+		std::cerr << "Headless error - The program was built without BGQ_HEADLESS." << std::endl;
+#endif
+
+	}
+
+	HeadlessContext::~HeadlessContext() {
+
+#ifdef BGQ_HEADLESS
+		if (this->context) {
+
+			eglMakeCurrent(this->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			eglDestroyContext(this->display, this->context);
+
+		}
+
+		if (this->display)
+			eglTerminate(this->display);
+#endif
+
+	}
+
+	bool HeadlessContext::isOpen() const {
+
+		return this->context != nullptr;
+
+	}
+
+	bool HeadlessContext::isEnabled() {
+
+#ifdef BGQ_HEADLESS
+		return true;
+#else
+		return false;
+#endif
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,92 @@
+/**
+ * @file headless_context.h
+ * @brief HeadlessContext class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_HEADLESSCONTEXT_H_
+#define BGQ_OPENGL_CLASSES_HEADLESSCONTEXT_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a HeadlessContext class.
+	 *
+	 * Creates an OpenGL core context without a window or a display, through a
+	 * surfaceless EGL display, and makes it current. It works with Mesa's
+	 * llvmpipe, so it runs on machines without a GPU. There is no default
+	 * framebuffer, so everything has to be drawn into an FBO.
+	 *
+	 * It only exists when the program is built with BGQ_HEADLESS defined and
+	 * linked with EGL. Otherwise the context is never created.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class HeadlessContext {
+
+		public:
+
+			/**
+			 * @brief Creates a headless context.
+			 *
+			 * Creates a core context of the given version and makes it current. If
+			 * it cannot be created the object is left empty, which can be checked
+			 * with isOpen.
+			 *
+			 * @param major The major OpenGL version.
+			 * @param minor The minor OpenGL version.
+			 */
+			HeadlessContext(int major, int minor);
+
+			/**
+			 * @brief HeadlessContext objects cannot be copied.
+			 *
+			 * HeadlessContext objects own their context, so they cannot be copied.
+			 */
+			HeadlessContext(const HeadlessContext&) = delete;
+			HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+			/**
+			 * @brief Destroys the HeadlessContext.
+			 *
+			 * Releases and destroys the context.
+			 */
+			~HeadlessContext();
+
+			/**
+			 * @brief Whether the context exists.
+			 *
+			 * Whether the context could be created and made current.
+			 *
+			 * @returns True if the context is current. False otherwise.
+			 */
+			bool isOpen() const;
+
+			/**
+			 * @brief Whether headless contexts are compiled in.
+			 *
+			 * Whether the program was built with BGQ_HEADLESS.
+			 *
+			 * @returns True if headless contexts can be created.
+			 */
+			static bool isEnabled();
+
+		private:
+
+			void *display = nullptr;	/// The EGL display.
+			void *context = nullptr;	/// The EGL context.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_HEADLESSCONTEXT_H_
@@ -0,0 +1,210 @@
+/**
+ * @file light_clusters.cpp
+ * @brief LightClusters class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "light_clusters.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/camera/camera.h"
+#include "classes/tbo/tbo.h"
+#include "classes/ubo/ubo.h"
+#include "structs/point_light/point_light.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
+
+namespace bgq_opengl {
+
+	LightClusters::LightClusters(GLuint max_lights, GLuint grid_x, GLuint grid_y, GLuint grid_z, GLuint max_per_cluster) :
+		light_buffer(max_lights * 2 * sizeof(glm::vec4), GL_RGBA32F),
+		range_buffer(grid_x * grid_y * grid_z * 2 * sizeof(GLuint), GL_RG32UI),
+		index_buffer(grid_x * grid_y * grid_z * max_per_cluster * sizeof(GLuint), GL_R32UI),
+		block(sizeof(ClusterBlock), CLUSTER_BLOCK_BINDING) {
+
+		this->grid = glm::uvec3(grid_x, grid_y, grid_z);
+		this->max_lights = max_lights;
+		this->max_per_cluster = max_per_cluster;
+
+		// Allocate everything now so that updating never does.
+		GLuint num_clusters = grid_x * grid_y * grid_z;
+		this->light_data = std::vector<glm::vec4>(max_lights * 2);
+		this->light_min = std::vector<glm::ivec3>(max_lights);
+		this->light_max = std::vector<glm::ivec3>(max_lights);
+		this->counts = std::vector<GLuint>(num_clusters, 0);
+		this->ranges = std::vector<GLuint>(num_clusters * 2, 0);
+		this->indices = std::vector<GLuint>(num_clusters * max_per_cluster, 0);
+
+	}
+
+	void LightClusters::bind() {
+
+		this->light_buffer.bind(LIGHT_DATA_UNIT);
+		this->range_buffer.bind(CLUSTER_RANGES_UNIT);
+		this->index_buffer.bind(LIGHT_INDICES_UNIT);
+		this->block.bind();
+
+	}
+
+	GLuint LightClusters::getAssigned() {
+
+		return this->assigned;
+
+	}
+
+	GLuint LightClusters::getDropped() {
+
+		return this->dropped;
+
+	}
+
+	void LightClusters::update(std::span<const PointLight> lights, Camera &camera, int width, int height) {
+
+		glm::mat4 view = camera.getView();
+		glm::mat4 projection = camera.getProjection();
+		float near = camera.getNear();
+		float far = camera.getFar();
+
+		// The slices grow exponentially with the depth, so slice = log(depth) * scale + bias.
+		this->slice_scale = this->grid.z / logf(far / near);
+		this->slice_bias = -(this->grid.z * logf(near) / logf(far / near));
+
+		this->num_lights = (GLuint) std::min(lights.size(), (size_t) this->max_lights);
+		std::fill(this->counts.begin(), this->counts.end(), 0);
+
+		// Transform the lights and count how many touch every cluster.
+		for (GLuint i = 0; i < this->num_lights; i++) {
+
+			glm::vec3 centre = glm::vec3(view * glm::vec4(lights[i].position, 1.0f));
+			this->light_data[2 * i] = glm::vec4(centre, lights[i].radius);
+			this->light_data[2 * i + 1] = glm::vec4(lights[i].color, lights[i].intensity);
+
+			// Lights that do not touch anything get an empty range.
+			if (!this->getClusterRange(centre, lights[i].radius, projection, near, far, &this->light_min[i], &this->light_max[i])) {
+
+				this->light_min[i] = glm::ivec3(0);
+				this->light_max[i] = glm::ivec3(-1);
+				continue;
+
+			}
+
+			for (int z = this->light_min[i].z; z <= this->light_max[i].z; z++)
+				for (int y = this->light_min[i].y; y <= this->light_max[i].y; y++)
+					for (int x = this->light_min[i].x; x <= this->light_max[i].x; x++)
+						this->counts[(z * this->grid.y + y) * this->grid.x + x]++;
+
+		}
+
+		// Turn the counts into ranges of the index list.
+		GLuint offset = 0;
+		this->dropped = 0;
+		for (size_t c = 0; c < this->counts.size(); c++) {
+
+			GLuint count = std::min(this->counts[c], this->max_per_cluster);
+			this->dropped += this->counts[c] - count;
+			this->ranges[2 * c] = offset;
+			this->ranges[2 * c + 1] = count;
+			offset += count;
+
+			// Reuse the counts as the write cursor of every cluster.
+			this->counts[c] = 0;
+
+		}
+		this->assigned = offset;
+
+		// Write the light indices of every cluster.
+		for (GLuint i = 0; i < this->num_lights; i++) {
+
+			for (int z = this->light_min[i].z; z <= this->light_max[i].z; z++) {
+
+				for (int y = this->light_min[i].y; y <= this->light_max[i].y; y++) {
+
+					for (int x = this->light_min[i].x; x <= this->light_max[i].x; x++) {
+
+						GLuint c = (z * this->grid.y + y) * this->grid.x + x;
+						if (this->counts[c] < this->ranges[2 * c + 1])
+							this->indices[this->ranges[2 * c] + this->counts[c]++] = i;
+
+					}
+
+				}
+
+			}
+
+		}
+
+		// Upload everything.
+		this->light_buffer.update(this->light_data.data(), this->num_lights * 2 * sizeof(glm::vec4));
+		this->range_buffer.update(this->ranges.data(), this->ranges.size() * sizeof(GLuint));
+		this->index_buffer.update(this->indices.data(), this->assigned * sizeof(GLuint));
+
+		ClusterBlock cluster_block;
+		cluster_block.grid = glm::uvec4(this->grid, this->num_lights);
+		cluster_block.screen_size = glm::vec2(width, height);
+		cluster_block.slice_scale = this->slice_scale;
+		cluster_block.slice_bias = this->slice_bias;
+		this->block.update(&cluster_block);
+
+	}
+
+	bool LightClusters::getClusterRange(glm::vec3 centre, float radius, const glm::mat4 &projection, float near, float far, glm::ivec3 *min, glm::ivec3 *max) {
+
+		// Distances from the camera of the front and the back of the light.
+		float depth_min = -centre.z - radius;
+		float depth_max = -centre.z + radius;
+		if (depth_max < near || depth_min > far)
+			return false;
+
+		depth_min = std::max(depth_min, near);
+		depth_max = std::min(depth_max, far);
+
+		// x / depth is monotonic in depth for a fixed x, so the extremes of the
+		// projected box are at its front or its back.
+		float x_min = centre.x - radius, x_max = centre.x + radius;
+		float y_min = centre.y - radius, y_max = centre.y + radius;
+		glm::vec2 ndc_min = glm::vec2(projection[0][0] * std::min(x_min / depth_min, x_min / depth_max),
+									  projection[1][1] * std::min(y_min / depth_min, y_min / depth_max));
+		glm::vec2 ndc_max = glm::vec2(projection[0][0] * std::max(x_max / depth_min, x_max / depth_max),
+									  projection[1][1] * std::max(y_max / depth_min, y_max / depth_max));
+		if (ndc_max.x < -1.0f || ndc_min.x > 1.0f || ndc_max.y < -1.0f || ndc_min.y > 1.0f)
+			return false;
+
+		// Get the tiles from the normalized device coordinates.
+		glm::vec2 tiles = glm::vec2(this->grid.x, this->grid.y);
+		glm::ivec2 tile_min = glm::ivec2(glm::floor((ndc_min * 0.5f + 0.5f) * tiles));
+		glm::ivec2 tile_max = glm::ivec2(glm::floor((ndc_max * 0.5f + 0.5f) * tiles));
+		tile_min = glm::clamp(tile_min, glm::ivec2(0), glm::ivec2(tiles) - 1);
+		tile_max = glm::clamp(tile_max, glm::ivec2(0), glm::ivec2(tiles) - 1);
+
+		*min = glm::ivec3(tile_min, this->getSlice(depth_min));
+		*max = glm::ivec3(tile_max, this->getSlice(depth_max));
+
+		return true;
+
+	}
+
+	int LightClusters::getSlice(float depth) {
+
+		int slice = (int) floorf(logf(depth) * this->slice_scale + this->slice_bias);
+
+		return std::clamp(slice, 0, (int) this->grid.z - 1);
+
+	}
+
+}  // namespace bgq_opengl
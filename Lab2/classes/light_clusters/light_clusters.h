@@ -0,0 +1,165 @@
+/**
+ * @file light_clusters.h
+ * @brief LightClusters class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_LIGHTCLUSTERS_H_
+#define BGQ_OPENGL_CLASSES_LIGHTCLUSTERS_H_
+
+#include <span>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/camera/camera.h"
+#include "classes/tbo/tbo.h"
+#include "classes/ubo/ubo.h"
+#include "structs/point_light/point_light.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a LightClusters class.
+	 *
+	 * Implementation of a clustered forward light culling class. The view frustum
+	 * is split in screen tiles and exponential depth slices, and every frame each
+	 * point light is assigned to the clusters its sphere touches. The lights, the
+	 * range of every cluster and the light indices are uploaded to buffer textures
+	 * so that every fragment only loops through the lights of its own cluster.
+	 *
+	 * All the memory is allocated in the constructor, so updating does not touch
+	 * the heap.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class LightClusters {
+
+		public:
+
+			/**
+			 * @brief Constructs the clusters.
+			 *
+			 * Constructs the cluster grid and allocates all the memory it will need.
+			 *
+			 * @param max_lights The maximum number of lights.
+			 * @param grid_x The number of clusters across the screen.
+			 * @param grid_y The number of clusters down the screen.
+			 * @param grid_z The number of depth slices.
+			 * @param max_per_cluster The maximum number of lights in a cluster.
+			 */
+			LightClusters(GLuint max_lights, GLuint grid_x, GLuint grid_y, GLuint grid_z, GLuint max_per_cluster);
+
+			/**
+			 * @brief LightClusters objects cannot be copied.
+			 *
+			 * LightClusters objects own their buffers, so they cannot be copied.
+			 */
+			LightClusters(const LightClusters&) = delete;
+			LightClusters& operator=(const LightClusters&) = delete;
+
+			/**
+			 * @brief Binds the clusters.
+			 *
+			 * Binds the buffer textures and the uniform block so the shaders can read them.
+			 */
+			void bind();
+
+			/**
+			 * @brief Gets the number of light indices.
+			 *
+			 * Gets the number of light indices written in the last update.
+			 *
+			 * @returns The number of light indices.
+			 */
+			GLuint getAssigned();
+
+			/**
+			 * @brief Gets the number of dropped light indices.
+			 *
+			 * Gets the number of light indices that did not fit in their cluster in
+			 * the last update.
+			 *
+			 * @returns The number of dropped light indices.
+			 */
+			GLuint getDropped();
+
+			/**
+			 * @brief Assigns the lights to the clusters.
+			 *
+			 * Transforms the lights to view space, assigns them to the clusters
+			 * and uploads the result. Lights past the maximum are ignored.
+			 *
+			 * @param lights The lights in world space.
+			 * @param camera The camera.
+			 * @param width The width of the framebuffer in pixels.
+			 * @param height The height of the framebuffer in pixels.
+			 */
+			void update(std::span<const PointLight> lights, Camera &camera, int width, int height);
+
+		private:
+
+			/**
+			 * @brief Gets the clusters touched by a light.
+			 *
+			 * Gets the range of clusters touched by the bounding box of a light in view space.
+			 *
+			 * @param centre The centre of the light in view space.
+			 * @param radius The radius of the light.
+			 * @param projection The projection matrix.
+			 * @param near The near clipping distance.
+			 * @param far The far clipping distance.
+			 * @param min Outputs the first cluster in each axis.
+			 * @param max Outputs the last cluster in each axis.
+			 *
+			 * @returns True if the light touches any cluster. False otherwise.
+			 */
+			bool getClusterRange(glm::vec3 centre, float radius, const glm::mat4 &projection, float near, float far, glm::ivec3 *min, glm::ivec3 *max);
+
+			/**
+			 * @brief Gets the depth slice of a distance.
+			 *
+			 * Gets the depth slice of a distance from the camera.
+			 *
+			 * @param depth The distance from the camera.
+			 *
+			 * @returns The depth slice.
+			 */
+			int getSlice(float depth);
+
+			glm::uvec3 grid;						/// Number of clusters in each axis.
+			GLuint max_lights;						/// Maximum number of lights.
+			GLuint max_per_cluster;					/// Maximum number of lights in a cluster.
+			float slice_scale = 0.0f;				/// Scale applied to the log of the depth.
+			float slice_bias = 0.0f;				/// Bias added to the scaled log of the depth.
+			GLuint assigned = 0;					/// Light indices written in the last update.
+			GLuint dropped = 0;						/// Light indices that did not fit in the last update.
+			GLuint num_lights = 0;					/// Lights in the last update.
+
+			std::vector<glm::vec4> light_data;		/// Position and radius, and color and intensity of every light.
+			std::vector<glm::ivec3> light_min;		/// First cluster touched by every light.
+			std::vector<glm::ivec3> light_max;		/// Last cluster touched by every light.
+			std::vector<GLuint> counts;				/// Lights in every cluster.
+			std::vector<GLuint> ranges;				/// Offset and count of every cluster in the indices.
+			std::vector<GLuint> indices;			/// Light indices of all the clusters.
+
+			TBO light_buffer;						/// Lights in the GPU.
+			TBO range_buffer;						/// Ranges of the clusters in the GPU.
+			TBO index_buffer;						/// Light indices in the GPU.
+			UBO block;								/// Cluster grid parameters in the GPU.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_LIGHTCLUSTERS_H_
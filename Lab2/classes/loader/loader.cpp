@@ -16,6 +16,8 @@
 #include "loader.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -66,4 +68,12 @@ namespace bgq_opengl {
 
     }
 
+	void Loader::takeMeshes(std::vector<MeshData> *meshes, std::vector<glm::mat4> *matrices) {
+
+		(*meshes) = std::move(this->meshes);
+		(*matrices) = std::move(this->transform_matrixes);
+		this->meshes.clear();
+
+	}
+
 }
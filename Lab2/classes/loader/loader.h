@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "classes/geometry/geometry.h"
+#include "structs/mesh_data/mesh_data.h"
 
 namespace bgq_opengl {
 
@@ -48,10 +49,19 @@ namespace bgq_opengl {
 			 */
 			Loader(const char *filename);
 
+			/**
+			 * @brief Destroys the loader.
+			 *
+			 * Destroys the loader and whatever it still holds.
+			 */
+			virtual ~Loader() = default;
+
 			/**
 			 * @brief Get the geometries from the loaded model.
 			 *
-			 * Get the geometries from the loaded model.
+			 * Get the geometries from the loaded model. They are moved out of the
+			 * loader, so this can only be called once, and they are uploaded, so it
+			 * has to be called from the thread with the OpenGL context.
 			 *
 			 * @param geoms Outputs the geometries returned.
 			 * @param matrices Outputs the transformation matrices.
@@ -61,7 +71,8 @@ namespace bgq_opengl {
 			/**
 			 * @brief Loads the data from the file.
 			 * 
-			 * Loads the data from the file.
+			 * Loads the data from the file. It does not touch OpenGL, so it can be
+			 * called from a worker thread.
 			 */
 			virtual void loadModel() = 0;
 
@@ -76,9 +87,21 @@ namespace bgq_opengl {
 			 */
 			static std::string readFileContents(const char* filename);
 
+			/**
+			 * @brief Get the meshes from the loaded model.
+			 *
+			 * Get the meshes from the loaded model without uploading them, so it
+			 * does not need OpenGL. They are moved out of the loader, so this or
+			 * getGeometries can only be called once.
+			 *
+			 * @param meshes Outputs the meshes.
+			 * @param matrices Outputs the transformation matrices.
+			 */
+			void takeMeshes(std::vector<MeshData> *meshes, std::vector<glm::mat4> *matrices);
+
 		protected:
 
-			std::vector<Geometry> geometries;			/// The Geometries loaded by the model loader.
+			std::vector<MeshData> meshes;				/// The meshes loaded by the model loader, not uploaded yet.
 			const char *filename;						/// Name of the file containing the model.
 			std::vector<glm::mat4> transform_matrixes;	/// Transform matrixes for each Geometry in the object.
 
@@ -16,8 +16,13 @@
 #include "loader_assimp.h"
 #include "classes/loader/loader.h"
 
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
 #include <vector>
 #include <iostream>
+#include <sstream>
 
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
@@ -25,16 +30,47 @@
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 
+#include "classes/geometry/geometry.h"
+#include "classes/mesh_cache/mesh_cache.h"
+#include "structs/mesh_data/mesh_data.h"
 #include "structs/vertex/vertex.h"
 
 namespace bgq_opengl {
 
-	LoaderAssimp::LoaderAssimp(const char* filename) : Loader(filename) {}
+	LoaderAssimp::LoaderAssimp(const char* filename, const char *cache_directory) : Loader(filename) {
+
+		this->cache_directory = cache_directory;
+
+	}
 
 	void LoaderAssimp::loadModel() {
+
+		auto start = std::chrono::steady_clock::now();
+
+		// Try the cache first. It is keyed by the contents of the file, so editing the model invalidates it, but the
+		// file is only hashed when its size and time no longer tell that it did not change.
+		std::string cache_filename;
+		uint64_t source_size = 0;
+		int64_t source_time = 0;
+		bool cacheable = this->cache_directory != nullptr && MeshCache::getFileStamp(filename, &source_size, &source_time);
+		if (cacheable) {
+
+			cache_filename = MeshCache::getCacheFilename(this->cache_directory, filename);
+			if (MeshCache::load(cache_filename, filename, source_size, source_time, IMPORT_FLAGS, &this->meshes)) {
+
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+				std::ostringstream log;
+				log << "  " << filename << std::endl;
+				log << "  " << this->meshes.size() << " meshes from " << cache_filename << " in " << elapsed.count() << " ms" << std::endl;
+				std::cerr << log.str();
+				return;
+
+			}
+
+		}
         
         // Import the scene from the file.
-        const aiScene* scene = aiImportFile(filename, aiProcess_Triangulate | aiProcess_PreTransformVertices);
+        const aiScene* scene = aiImportFile(filename, IMPORT_FLAGS);
 
         // Check if the scene was not read correctly.
         if (!scene) {
@@ -44,11 +80,12 @@ namespace bgq_opengl {
             
         }
 
-        // Print info from the scene.
-        std::cerr << "  " << filename << std::endl;
-        std::cerr << "  " << scene->mNumMaterials << " materials" << std::endl;
-        std::cerr << "  " << scene->mNumMeshes << " meshes" << std::endl;
-        std::cerr << "  " << scene->mNumTextures << " textures" << std::endl;
+        // Print info from the scene. It is written at once, as other models may be loading at the same time.
+        std::ostringstream log;
+        log << "  " << filename << std::endl;
+        log << "  " << scene->mNumMaterials << " materials" << std::endl;
+        log << "  " << scene->mNumMeshes << " meshes" << std::endl;
+        log << "  " << scene->mNumTextures << " textures" << std::endl;
         
         // Loop through the different meshes in the scene.
         for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
@@ -63,6 +100,16 @@ namespace bgq_opengl {
 
         aiReleaseImport(scene);
 
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		log << "  imported in " << elapsed.count() << " ms" << std::endl;
+
+		// Store it for the next run.
+		uint64_t source_hash = 0;
+		if (cacheable && (!MeshCache::hashFile(filename, &source_hash, &source_size) || !MeshCache::store(cache_filename, source_hash, source_size, source_time, IMPORT_FLAGS, this->meshes)))
+			log << "  could not write " << cache_filename << std::endl;
+
+		std::cerr << log.str();
+
 	}
 
 	void LoaderAssimp::loadGeometry(const aiScene* scene, const aiMesh* mesh) {
@@ -70,6 +117,8 @@ namespace bgq_opengl {
         // Init the ds.
         std::vector<bgq_opengl::Vertex> vertices(0);
         std::vector<GLuint> indices(0);
+        vertices.reserve(mesh->mNumVertices);
+        indices.reserve(3 * mesh->mNumFaces);
         
         // If has materials, pass them.
         aiMaterial *mat = scene->mMaterials[mesh->mMaterialIndex];
@@ -129,37 +178,26 @@ namespace bgq_opengl {
         
         }
 
-		// Obtain the textures.
-		std::vector<bgq_opengl::Texture> textures = getTextures();
-
-		// Create a Geometry object that contains all this data.
-		this->geometries.push_back(bgq_opengl::Geometry(vertices, indices, textures, shine));
-
-	}
-
-	std::vector<bgq_opengl::Texture> LoaderAssimp::getTextures() {
-
-		// Init the textures holder.
-		std::vector<bgq_opengl::Texture> textures;
-        
-        // Get the texture filename.
-        // std::string texture_filename = "Textures/white.png";
-        //std::string texture_name = "baseColor";
-
-        // Load the texture.
-        //bgq_opengl::Texture new_texture = bgq_opengl::Texture((texture_filename).c_str(), texture_name.c_str(), (unsigned int) textures.size());
-
-        // Add it to the textures.
-        //textures.push_back(new_texture);
-
-		return textures;
+		// Keep it until the geometries are built in the thread with the OpenGL context.
+		MeshData data;
+		data.vertices = std::move(vertices);
+		data.indices = std::move(indices);
+		data.shininess = shine;
+		Geometry::computeBounds(data.vertices, &data.bounding_box, &data.bounding_sphere);
+		this->meshes.push_back(std::move(data));
 
 	}
 
 	void LoaderAssimp::getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices) {
 
-		(*geoms) = this->geometries;
-		(*matrices) = this->transform_matrixes;
+		// Upload the meshes.
+		geoms->clear();
+		geoms->reserve(this->meshes.size());
+		for (size_t i = 0; i < this->meshes.size(); i++)
+			geoms->emplace_back(std::move(this->meshes[i]));
+		this->meshes.clear();
+
+		(*matrices) = std::move(this->transform_matrixes);
 
 	}
 
@@ -38,12 +38,19 @@ namespace bgq_opengl {
 
 		public:
 
+			static const unsigned int IMPORT_FLAGS = aiProcess_Triangulate | aiProcess_PreTransformVertices;	/// Assimp post processing steps.
+
 			/**
 			 * @brief Build a loader instance.
 			 *
-			 * Build a loader instance.
+			 * Build a loader instance. When a cache directory is given, the
+			 * imported geometries are stored there and loaded from there on the
+			 * next runs, as long as the model file does not change.
+			 *
+			 * @param filename The name of the model file.
+			 * @param cache_directory The directory of the mesh cache, or nullptr to always import the file.
 			 */
-			LoaderAssimp(const char* filename);
+			LoaderAssimp(const char* filename, const char *cache_directory = nullptr);
 
 			/**
 			 * @brief Get the geometries from the loaded model.
@@ -72,13 +79,8 @@ namespace bgq_opengl {
 			 * @param mesh the assimp  mesh.
 			 */
 			void loadGeometry(const aiScene* scene, const aiMesh* mesh);
-        
-            /**
-             * @brief Load the textures for this model.
-             *
-             * Load the textures for this model.
-             */
-            std::vector<bgq_opengl::Texture> getTextures();
+
+			const char *cache_directory;	/// Directory of the mesh cache, or nullptr.
 
 	};
 
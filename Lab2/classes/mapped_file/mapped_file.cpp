@@ -0,0 +1,131 @@
+/**
+ * @file mapped_file.cpp
+ * @brief MappedFile class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+
+namespace bgq_opengl {
+
+	MappedFile::MappedFile(const char *filename) {
+
+		int fd = open(filename, O_RDONLY);
+		if (fd < 0)
+			return;
+
+		// Empty files cannot be mapped, so they are treated as missing.
+		struct stat info;
+		if (fstat(fd, &info) == 0 && info.st_size > 0) {
+
+			void *mapping = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapping != MAP_FAILED) {
+
+				this->data = (const std::byte*) mapping;
+				this->size = (size_t) info.st_size;
+
+			}
+
+		}
+
+		// The mapping stays valid after closing the descriptor.
+		close(fd);
+
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept : data(other.data), size(other.size) {
+
+		// Leave the other one empty so it does not unmap the file.
+		other.data = nullptr;
+		other.size = 0;
+
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+
+		if (this != &other) {
+
+			// Release the current mapping before taking the other one.
+			this->remove();
+
+			this->data = other.data;
+			this->size = other.size;
+			other.data = nullptr;
+			other.size = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	MappedFile::~MappedFile() {
+
+		this->remove();
+
+	}
+
+	const std::byte* MappedFile::getData() const {
+
+		return this->data;
+
+	}
+
+	size_t MappedFile::getSize() const {
+
+		return this->size;
+
+	}
+
+	bool MappedFile::isOpen() const {
+
+		return this->data != nullptr;
+
+	}
+
+	void MappedFile::prefetch() const {
+
+		if (this->data == nullptr)
+			return;
+
+		// Ask for the whole file at once, then fault in every page.
+		madvise((void*) this->data, this->size, MADV_WILLNEED);
+
+		long page_size = sysconf(_SC_PAGESIZE);
+		volatile std::byte sink{};
+		for (size_t i = 0; i < this->size; i += (size_t) page_size)
+			sink = this->data[i];
+		(void) sink;
+
+	}
+
+	void MappedFile::remove() {
+
+		// Unmap the file, if there is one.
+		if (this->data != nullptr) {
+
+			munmap((void*) this->data, this->size);
+			this->data = nullptr;
+			this->size = 0;
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
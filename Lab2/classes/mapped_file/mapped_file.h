@@ -0,0 +1,132 @@
+/**
+ * @file mapped_file.h
+ * @brief MappedFile class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MAPPEDFILE_H_
+#define BGQ_OPENGL_CLASSES_MAPPEDFILE_H_
+
+#include <cstddef>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a MappedFile class.
+	 *
+	 * Maps a whole file in memory as read only, so that it can be read without
+	 * copying it. The pages are only loaded when they are first touched.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class MappedFile {
+
+		public:
+
+			/**
+			 * @brief Maps a file.
+			 *
+			 * Maps a file in memory. If it cannot be opened, the object is left
+			 * empty, which can be checked with isOpen.
+			 *
+			 * @param filename The name of the file.
+			 */
+			MappedFile(const char *filename);
+
+			/**
+			 * @brief MappedFile objects cannot be copied.
+			 *
+			 * MappedFile objects own their mapping, so they cannot be copied.
+			 */
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			/**
+			 * @brief Moves a MappedFile.
+			 *
+			 * Takes the mapping from another MappedFile, which is left empty.
+			 *
+			 * @param other The MappedFile to move from.
+			 */
+			MappedFile(MappedFile&& other) noexcept;
+
+			/**
+			 * @brief Moves a MappedFile.
+			 *
+			 * Removes the current mapping and takes the one of another MappedFile, which
+			 * is left empty.
+			 *
+			 * @param other The MappedFile to move from.
+			 *
+			 * @returns This MappedFile.
+			 */
+			MappedFile& operator=(MappedFile&& other) noexcept;
+
+			/**
+			 * @brief Destroys the MappedFile.
+			 *
+			 * Unmaps the file.
+			 */
+			~MappedFile();
+
+			/**
+			 * @brief Get the contents of the file.
+			 *
+			 * Get a pointer to the first byte of the file.
+			 *
+			 * @returns The contents of the file, or nullptr if it is not open.
+			 */
+			const std::byte* getData() const;
+
+			/**
+			 * @brief Get the size of the file.
+			 *
+			 * Get the size of the file in bytes.
+			 *
+			 * @returns The size of the file.
+			 */
+			size_t getSize() const;
+
+			/**
+			 * @brief Whether the file is mapped.
+			 *
+			 * Whether the file could be opened and mapped.
+			 *
+			 * @returns True if the file is mapped. False otherwise.
+			 */
+			bool isOpen() const;
+
+			/**
+			 * @brief Reads the whole file in.
+			 *
+			 * Touches every page of the mapping, so that it is read from disk now and
+			 * later reads, maybe from another thread, do not wait for it.
+			 */
+			void prefetch() const;
+
+			/**
+			 * @brief Unmaps the file.
+			 *
+			 * Unmaps the file, leaving the object empty.
+			 */
+			void remove();
+
+		private:
+
+			const std::byte *data = nullptr;	/// First byte of the mapping.
+			size_t size = 0;					/// Size of the mapping in bytes.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_MAPPEDFILE_H_
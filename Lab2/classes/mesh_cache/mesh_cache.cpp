@@ -0,0 +1,254 @@
+/**
+ * @file mesh_cache.cpp
+ * @brief MeshCache class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mesh_cache.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/mesh_cache_header/mesh_cache_header.h"
+#include "structs/mesh_data/mesh_data.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		const char MAGIC[8] = "BGQMESH";
+		const uint64_t ALIGNMENT = 16;
+
+		uint64_t align(uint64_t offset) {
+
+			return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+		}
+
+		void writePadding(std::ofstream &file, uint64_t offset) {
+
+			static const char zeros[ALIGNMENT] = {};
+			file.write(zeros, (std::streamsize) (align(offset) - offset));
+
+		}
+
+	}
+
+	std::string MeshCache::getCacheFilename(const char *directory, const char *filename) {
+
+		// Keep the name of the model so the cache directory is easy to browse.
+		return (std::filesystem::path(directory) / std::filesystem::path(filename).filename()).string() + ".meshcache";
+
+	}
+
+	bool MeshCache::getFileStamp(const char *filename, uint64_t *size, int64_t *time) {
+
+		std::error_code error;
+		uint64_t file_size = std::filesystem::file_size(filename, error);
+		if (error)
+			return false;
+
+		std::filesystem::file_time_type write_time = std::filesystem::last_write_time(filename, error);
+		if (error)
+			return false;
+
+		*size = file_size;
+		*time = std::chrono::duration_cast<std::chrono::nanoseconds>(write_time.time_since_epoch()).count();
+
+		return true;
+
+	}
+
+	bool MeshCache::hashFile(const char *filename, uint64_t *hash, uint64_t *size) {
+
+		MappedFile file(filename);
+		if (!file.isOpen())
+			return false;
+
+		// 64 bit FNV-1a.
+		const std::byte *data = file.getData();
+		uint64_t h = 14695981039346656037ull;
+		for (size_t i = 0; i < file.getSize(); i++) {
+
+			h ^= (uint64_t) data[i];
+			h *= 1099511628211ull;
+
+		}
+
+		*hash = h;
+		*size = file.getSize();
+
+		return true;
+
+	}
+
+	bool MeshCache::load(const std::string &cache_filename, const char *source_filename, uint64_t source_size, int64_t source_time, uint32_t loader_flags, std::vector<MeshData> *meshes) {
+
+		std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(cache_filename.c_str());
+		if (!(*file).isOpen() || (*file).getSize() < sizeof(MeshCacheHeader))
+			return false;
+
+		// Check that the file was made from this model, with this format.
+		const std::byte *data = (*file).getData();
+		uint64_t file_size = (*file).getSize();
+		MeshCacheHeader header;
+		memcpy(&header, data, sizeof(MeshCacheHeader));
+
+		if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.vertex_size != sizeof(Vertex))
+			return false;
+
+		if (header.source_size != source_size || header.loader_flags != loader_flags)
+			return false;
+
+		if (sizeof(MeshCacheHeader) + (uint64_t) header.num_entries * sizeof(MeshCacheEntry) > file_size)
+			return false;
+
+		// Check every entry before building anything, so a damaged file is ignored as a whole.
+		const std::byte *entries = data + sizeof(MeshCacheHeader);
+		for (uint32_t i = 0; i < header.num_entries; i++) {
+
+			MeshCacheEntry entry;
+			memcpy(&entry, entries + i * sizeof(MeshCacheEntry), sizeof(MeshCacheEntry));
+
+			if (entry.vertex_offset % ALIGNMENT != 0 || entry.index_offset % ALIGNMENT != 0)
+				return false;
+
+			if (entry.vertex_offset > file_size || entry.num_vertices > (file_size - entry.vertex_offset) / sizeof(Vertex))
+				return false;
+
+			if (entry.index_offset > file_size || entry.num_indices > (file_size - entry.index_offset) / sizeof(GLuint))
+				return false;
+
+		}
+
+		// A model that was written again may still be the same, for instance after a checkout, so only then hash it.
+		if (header.source_time != source_time) {
+
+			uint64_t source_hash = 0, hashed_size = 0;
+			if (!hashFile(source_filename, &source_hash, &hashed_size) || source_hash != header.source_hash || hashed_size != source_size)
+				return false;
+
+			// Record the new time, so the next start trusts it again.
+			header.source_time = source_time;
+			std::fstream stamp(cache_filename, std::ios::binary | std::ios::in | std::ios::out);
+			stamp.write((const char*) &header, sizeof(MeshCacheHeader));
+
+		}
+
+		// Point the meshes straight at the mapping.
+		meshes->clear();
+		meshes->resize(header.num_entries);
+		for (uint32_t i = 0; i < header.num_entries; i++) {
+
+			MeshCacheEntry entry;
+			memcpy(&entry, entries + i * sizeof(MeshCacheEntry), sizeof(MeshCacheEntry));
+
+			MeshData &mesh = (*meshes)[i];
+			mesh.mapping = file;
+			mesh.mapped_vertices = std::span<const Vertex>((const Vertex*) (data + entry.vertex_offset), entry.num_vertices);
+			mesh.mapped_indices = std::span<const GLuint>((const GLuint*) (data + entry.index_offset), entry.num_indices);
+			mesh.shininess = entry.shininess;
+			mesh.bounding_box = entry.bounding_box;
+			mesh.bounding_sphere = entry.bounding_sphere;
+
+		}
+
+		return true;
+
+	}
+
+	bool MeshCache::store(const std::string &cache_filename, uint64_t source_hash, uint64_t source_size, int64_t source_time, uint32_t loader_flags, std::span<const MeshData> meshes) {
+
+		// Create the directory the first time.
+		std::error_code error;
+		std::filesystem::path path(cache_filename);
+		if (path.has_parent_path())
+			std::filesystem::create_directories(path.parent_path(), error);
+
+		std::string temporary_filename = cache_filename + ".tmp";
+		std::ofstream file(temporary_filename, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return false;
+
+		MeshCacheHeader header;
+		memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.vertex_size = sizeof(Vertex);
+		header.source_hash = source_hash;
+		header.source_size = source_size;
+		header.source_time = source_time;
+		header.loader_flags = loader_flags;
+		header.num_entries = (uint32_t) meshes.size();
+
+		// Lay the data out after the entries, every array aligned.
+		std::vector<MeshCacheEntry> entries(meshes.size());
+		uint64_t offset = sizeof(MeshCacheHeader) + meshes.size() * sizeof(MeshCacheEntry);
+		for (size_t i = 0; i < meshes.size(); i++) {
+
+			entries[i].vertex_offset = align(offset);
+			entries[i].num_vertices = meshes[i].vertices.size();
+			offset = entries[i].vertex_offset + entries[i].num_vertices * sizeof(Vertex);
+
+			entries[i].index_offset = align(offset);
+			entries[i].num_indices = meshes[i].indices.size();
+			offset = entries[i].index_offset + entries[i].num_indices * sizeof(GLuint);
+
+			entries[i].shininess = meshes[i].shininess;
+			entries[i].bounding_box = meshes[i].bounding_box;
+			entries[i].bounding_sphere = meshes[i].bounding_sphere;
+
+		}
+
+		file.write((const char*) &header, sizeof(MeshCacheHeader));
+		file.write((const char*) entries.data(), (std::streamsize) (entries.size() * sizeof(MeshCacheEntry)));
+
+		offset = sizeof(MeshCacheHeader) + meshes.size() * sizeof(MeshCacheEntry);
+		for (size_t i = 0; i < meshes.size(); i++) {
+
+			std::span<const Vertex> vertices = meshes[i].vertices;
+			writePadding(file, offset);
+			file.write((const char*) vertices.data(), (std::streamsize) vertices.size_bytes());
+			offset = entries[i].vertex_offset + vertices.size_bytes();
+
+			std::span<const GLuint> indices = meshes[i].indices;
+			writePadding(file, offset);
+			file.write((const char*) indices.data(), (std::streamsize) indices.size_bytes());
+			offset = entries[i].index_offset + indices.size_bytes();
+
+		}
+
+		file.close();
+		if (!file) {
+
+			std::filesystem::remove(temporary_filename, error);
+			return false;
+
+		}
+
+		std::filesystem::rename(temporary_filename, cache_filename, error);
+
+		return !error;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,131 @@
+/**
+ * @file mesh_cache.h
+ * @brief MeshCache class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MESHCACHE_H_
+#define BGQ_OPENGL_CLASSES_MESHCACHE_H_
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "structs/mesh_data/mesh_data.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a MeshCache class.
+	 *
+	 * Stores the meshes of a model, as they are after importing it, in a
+	 * binary file. Every cache file records the hash of the model file and the
+	 * flags it was imported with, and it is only used while both still match.
+	 *
+	 * Hashing the model file costs about as much as reading it, so the cache
+	 * also records its size and the time it was written. While those match,
+	 * the file is trusted without hashing it. When only the time changed, the
+	 * file is hashed, and if it still matches the new time is recorded.
+	 *
+	 * Cache files are mapped rather than read, so the vertices and indices go
+	 * from the page cache to OpenGL without being parsed or copied.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class MeshCache {
+
+		public:
+
+			static const uint32_t VERSION = 2;	/// Version of the file format. Older files are ignored.
+
+			/**
+			 * @brief Gets the cache file of a model.
+			 *
+			 * Gets the name of the cache file of a model inside a directory.
+			 *
+			 * @param directory The cache directory.
+			 * @param filename The name of the model file.
+			 *
+			 * @returns The name of the cache file.
+			 */
+			static std::string getCacheFilename(const char *directory, const char *filename);
+
+			/**
+			 * @brief Gets the stamp of a file.
+			 *
+			 * Gets the size of a file and the time it was last written, which
+			 * tell whether it changed without reading it.
+			 *
+			 * @param filename The name of the file.
+			 * @param size Outputs the size of the file in bytes.
+			 * @param time Outputs the time the file was last written, in nanoseconds of its clock.
+			 *
+			 * @returns True if the file exists. False otherwise.
+			 */
+			static bool getFileStamp(const char *filename, uint64_t *size, int64_t *time);
+
+			/**
+			 * @brief Hashes a file.
+			 *
+			 * Hashes the contents of a file with 64 bit FNV-1a.
+			 *
+			 * @param filename The name of the file.
+			 * @param hash Outputs the hash.
+			 * @param size Outputs the size of the file in bytes.
+			 *
+			 * @returns True if the file could be read. False otherwise.
+			 */
+			static bool hashFile(const char *filename, uint64_t *hash, uint64_t *size);
+
+			/**
+			 * @brief Loads the meshes from a cache file.
+			 *
+			 * Loads the meshes from a cache file if it exists, it is valid, and it
+			 * was made from the same model file with the same flags. The model file
+			 * is only hashed if its time does not match. It does not touch OpenGL,
+			 * so it can be called from any thread.
+			 *
+			 * @param cache_filename The name of the cache file.
+			 * @param source_filename The name of the model file.
+			 * @param source_size The size of the model file in bytes.
+			 * @param source_time The time the model file was last written.
+			 * @param loader_flags The flags the model is imported with.
+			 * @param meshes Outputs the meshes, which view the mapped file.
+			 *
+			 * @returns True if the cache was used. False otherwise.
+			 */
+			static bool load(const std::string &cache_filename, const char *source_filename, uint64_t source_size, int64_t source_time, uint32_t loader_flags, std::vector<MeshData> *meshes);
+
+			/**
+			 * @brief Stores the meshes in a cache file.
+			 *
+			 * Stores the meshes in a cache file, creating its directory if
+			 * needed. The file is written under a temporary name and renamed, so a
+			 * half written file is never loaded.
+			 *
+			 * @param cache_filename The name of the cache file.
+			 * @param source_hash The hash of the model file.
+			 * @param source_size The size of the model file in bytes.
+			 * @param source_time The time the model file was last written.
+			 * @param loader_flags The flags the model was imported with.
+			 * @param meshes The meshes. Their vertices and indices have to be owned.
+			 *
+			 * @returns True if the file was written. False otherwise.
+			 */
+			static bool store(const std::string &cache_filename, uint64_t source_hash, uint64_t source_size, int64_t source_time, uint32_t loader_flags, std::span<const MeshData> meshes);
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_MESHCACHE_H_
@@ -16,16 +16,34 @@
 #include "object.h"
 
 #include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <span>
+#include <utility>
+#include <vector>
 
+#include "classes/cubemap/cubemap.h"
+#include "classes/draw_counter/draw_counter.h"
+#include "classes/frustum/frustum.h"
 #include "classes/loader/loader.h"
 #include "classes/loader_assimp/loader_assimp.h"
+#include "classes/render_queue/render_queue.h"
+#include "classes/thread_pool/thread_pool.h"
+#include "classes/ubo/ubo.h"
+#include "structs/ray/ray.h"
+#include "structs/ray_hit/ray_hit.h"
 #include "structs/vertex/vertex.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/bounding_sphere/bounding_sphere.h"
+#include "structs/bounds_batch/bounds_batch.h"
 
 namespace bgq_opengl {
 
-	Object::Object(const char *filename, const char* filetype) {
+	bool Object::culling = true;
+
+	Object::Object(const char *filename, const char* filetype, const char *cache_directory) {
 
 		// Build the loader for this file type.
 		Loader *model_loader;
@@ -35,7 +53,7 @@ namespace bgq_opengl {
             
             std::cerr << "assimp" << std::endl;
 
-            model_loader = new LoaderAssimp(filename);
+            model_loader = new LoaderAssimp(filename, cache_directory);
 
         } else {
 
@@ -47,16 +65,29 @@ namespace bgq_opengl {
         (*model_loader).loadModel();
 
 		(*model_loader).getGeometries(&this->geoms, &this->matrices_geoms);
+		delete model_loader;
+
+		this->computeBounds();
+
+	}
+
+	Object::Object(Loader &model_loader) {
+
+		model_loader.getGeometries(&this->geoms, &this->matrices_geoms);
+
+		this->computeBounds();
 
 	}
 
 	Object::Object(std::vector<Geometry> geometries) {
 
-		// Copy the geometries.
-		this->geoms = geometries;
+		// Take the geometries over.
+		this->geoms = std::move(geometries);
 
 		// Get an identity matrix for each.
-		this->matrices_geoms = std::vector<glm::mat4>(geometries.size(), glm::mat4(1.0f));
+		this->matrices_geoms = std::vector<glm::mat4>(this->geoms.size(), glm::mat4(1.0f));
+
+		this->computeBounds();
 
 	}
 
@@ -81,42 +112,116 @@ namespace bgq_opengl {
 
 	void Object::draw(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera) {
         
+		// Test all the geometries against the view at once.
+		if (culling)
+			this->cullGeometries(camera);
+
 		// Go over all meshes and draw each one
 		for (unsigned int i = 0; i < this->geoms.size(); i++)
 		{
+			if (culling && !this->visible[i]) {
+
+				DrawCounter::recordCulled(1);
+				continue;
+
+			}
+
 			geoms[i].draw(shader, camera);
 		}
         
 	}
 
-	BoundingBox Object::getBoundingBox() {
+	void Object::drawInstanced(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera, std::span<const Instance> instances) {
 
-		// Create the bb.
-		BoundingBox global_bb = this->geoms[0].getBoundingBox();
+		// Upload the copies once for all the geometries.
+		this->instances.update(instances.data(), instances.size() * sizeof(Instance));
+		this->instances.unbind();
 
-		// Loop through the vertices and get tge min and max values.
-		for (int i = 1; i < this->geoms.size(); i++) {
+		// Link the instance buffer to the geometries the first time.
+		if (!this->instances_linked) {
 
-			// Get the current bb.
-			BoundingBox bb = this->geoms[i].getBoundingBox();
+			for (size_t i = 0; i < this->geoms.size(); i++)
+				this->geoms[i].linkInstances(this->instances);
+			this->instances_linked = true;
 
-			if (global_bb.min.x > bb.min.x)
-				global_bb.min.x = bb.min.x;
+		}
+
+		// Test every copy of every geometry against the view at once.
+		if (culling) {
 
-			if (global_bb.min.y > bb.min.y)
-				global_bb.min.y = bb.min.y;
+			Frustum::clear(&this->bounds);
+			for (size_t i = 0; i < this->geoms.size(); i++)
+				for (const Instance &instance : instances)
+					Frustum::addBounds(&this->bounds, geoms[i].getBoundingBox(), geoms[i].getBoundingSphere(), instance.model);
 
-			if (global_bb.min.z > bb.min.z)
-				global_bb.min.z = bb.min.z;
+			Frustum(camera.getCameraMatrix()).cull(this->bounds, &this->visible);
+
+		}
 
-			if (global_bb.max.x < bb.max.x)
-				global_bb.max.x = bb.max.x;
+		// Go over all meshes and draw all the copies of each one, unless none of them is in view.
+		for (size_t i = 0; i < this->geoms.size(); i++) {
 
-			if (global_bb.max.y < bb.max.y)
-				global_bb.max.y = bb.max.y;
+			if (culling && std::none_of(this->visible.begin() + i * instances.size(), this->visible.begin() + (i + 1) * instances.size(), [](unsigned char flag) { return flag != 0; })) {
 
-			if (global_bb.max.z < bb.max.z)
-				global_bb.max.z = bb.max.z;
+				DrawCounter::recordCulled(1);
+				continue;
+
+			}
+
+			geoms[i].drawInstanced(shader, (GLsizei) instances.size());
+
+		}
+
+	}
+
+	void Object::setCulling(bool enabled) {
+
+		culling = enabled;
+
+	}
+
+	void Object::submit(RenderQueue *queue, Shader &shader, Camera &camera, std::span<UBO* const> materials, Cubemap *environment) {
+
+		if (culling)
+			this->cullGeometries(camera);
+
+		for (size_t i = 0; i < this->geoms.size(); i++) {
+
+			if (culling && !this->visible[i]) {
+
+				DrawCounter::recordCulled(1);
+				continue;
+
+			}
+
+			UBO *material = materials.size() == 1 ? materials[0] : materials[i];
+			queue->submit(shader, this->geoms[i], material, this->geoms[i].getTransformMat(), environment);
+
+		}
+
+	}
+
+	BoundingBox Object::getBoundingBox() {
+
+		return this->bounding_box;
+
+	}
+
+	BoundingSphere Object::getBoundingSphere() {
+
+		return this->bounding_sphere;
+
+	}
+
+	BoundingBox Object::getWorldBoundingBox() {
+
+		// The geometries only recompute their boxes if they moved.
+		BoundingBox global_bb = this->geoms[0].getWorldBoundingBox();
+		for (size_t i = 1; i < this->geoms.size(); i++) {
+
+			BoundingBox bb = this->geoms[i].getWorldBoundingBox();
+			global_bb.min = glm::min(global_bb.min, bb.min);
+			global_bb.max = glm::max(global_bb.max, bb.max);
 
 		}
 
@@ -124,13 +229,126 @@ namespace bgq_opengl {
 
 	}
 
-	std::vector<Geometry> Object::getGeometries() {
+	void Object::buildBvh(ThreadPool *pool) {
+
+		for (Geometry &geometry : this->geoms)
+			geometry.buildBvh(pool);
+
+	}
+
+	bool Object::intersect(const Ray &ray, RayHit *hit) {
+
+		// Every geometry shortens the ray for the next ones.
+		Ray shortened = ray;
+		bool found = false;
+		for (size_t i = 0; i < this->geoms.size(); i++) {
+
+			if (this->geoms[i].intersect(shortened, hit)) {
+
+				shortened.max_t = (*hit).t;
+				(*hit).instance = (int) i;
+				found = true;
+
+			}
+
+		}
+
+		return found;
+
+	}
+
+	size_t Object::intersect(std::span<const Ray> rays, std::span<RayHit> hits, ThreadPool *pool) {
+
+		if (this->geoms.empty())
+			return 0;
+
+		size_t num_hits = this->geoms[0].intersect(rays, hits, pool);
+		for (RayHit &hit : hits)
+			hit.instance = std::isinf(hit.t) ? -1 : 0;
+
+		// Keep the closest hit of every ray over the rest of the geometries.
+		std::vector<RayHit> geometry_hits(rays.size());
+		for (size_t i = 1; i < this->geoms.size(); i++) {
+
+			this->geoms[i].intersect(rays, geometry_hits, pool);
+			for (size_t j = 0; j < rays.size(); j++) {
+
+				if (geometry_hits[j].t < hits[j].t) {
+
+					num_hits += std::isinf(hits[j].t) ? 1 : 0;
+					hits[j] = geometry_hits[j];
+					hits[j].instance = (int) i;
+
+				}
+
+			}
+
+		}
+
+		return num_hits;
+
+	}
+
+	glm::vec3 Object::getCentre() {
+
+		return this->bounding_sphere.centre;
+
+	}
+
+	float Object::getNormalizationScale(float size) {
+
+		return size / this->max_dimension;
+
+	}
+
+	void Object::computeBounds() {
+
+		// Merge the boxes of the geometries.
+		this->bounding_box = this->geoms[0].getBoundingBox();
+		for (size_t i = 1; i < this->geoms.size(); i++) {
+
+			BoundingBox bb = this->geoms[i].getBoundingBox();
+			this->bounding_box.min = glm::min(this->bounding_box.min, bb.min);
+			this->bounding_box.max = glm::max(this->bounding_box.max, bb.max);
+
+		}
+
+		// Get the normalization data.
+		glm::vec3 size = this->bounding_box.max - this->bounding_box.min;
+		this->max_dimension = std::max(size.x, std::max(size.y, size.z));
+
+		// Enclose the spheres of all the geometries in one centred in the box.
+		glm::vec3 centre = (this->bounding_box.min + this->bounding_box.max) / 2.0f;
+		float radius = 0.0f;
+		for (size_t i = 0; i < this->geoms.size(); i++) {
+
+			BoundingSphere sphere = this->geoms[i].getBoundingSphere();
+			radius = std::max(radius, glm::length(sphere.centre - centre) + sphere.radius);
+
+		}
+
+		this->bounding_sphere.centre = centre;
+		this->bounding_sphere.radius = radius;
+
+	}
+
+	void Object::cullGeometries(Camera &camera) {
+
+		Frustum::clear(&this->bounds);
+		for (size_t i = 0; i < this->geoms.size(); i++)
+			Frustum::addBounds(&this->bounds, geoms[i].getBoundingBox(), geoms[i].getBoundingSphere(), geoms[i].getTransformMat());
+
+		Frustum(camera.getCameraMatrix()).cull(this->bounds, &this->visible);
+
+	}
+
+	std::span<Geometry> Object::getGeometries() {
 
 		return this->geoms;
 
 	}
 
-	std::vector<glm::mat4> Object::getGeometryMatrices() {
+	std::span<const glm::mat4> Object::getGeometryMatrices() {
 
 		return this->matrices_geoms;
 
@@ -16,10 +16,23 @@
 #ifndef BGQ_OPENGL_CLASSES_OBJECT_H_
 #define BGQ_OPENGL_CLASSES_OBJECT_H_
 
+#include <span>
 #include <vector>
 
+#include "classes/cubemap/cubemap.h"
+#include "classes/frustum/frustum.h"
 #include "classes/geometry/geometry.h"
+#include "classes/loader/loader.h"
+#include "classes/render_queue/render_queue.h"
+#include "classes/thread_pool/thread_pool.h"
+#include "classes/ubo/ubo.h"
+#include "classes/vbo/vbo.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/bounding_sphere/bounding_sphere.h"
+#include "structs/bounds_batch/bounds_batch.h"
+#include "structs/instance/instance.h"
+#include "structs/ray/ray.h"
+#include "structs/ray_hit/ray_hit.h"
 
 namespace bgq_opengl {
 
@@ -34,13 +47,24 @@ namespace bgq_opengl {
 			 * 
 			 * @param filename The name of the model file.
 			 * @param filetype The type of the model file.
+			 * @param cache_directory The directory of the mesh cache, or nullptr to always import the file.
 			 */
-			Object(const char* filename, const char *filetype);
+			Object(const char* filename, const char *filetype, const char *cache_directory = nullptr);
+
+			/**
+			 * @brief Builds the object from a loader.
+			 *
+			 * Builds the object from a loader that has already loaded its model,
+			 * maybe on another thread, uploading its geometries.
+			 *
+			 * @param model_loader The loader, after loadModel.
+			 */
+			Object(Loader &model_loader);
 
 			/**
 			 * @brief Loads the object from specified geometries.
 			 * 
-			 * Loads the object from specified geometries.
+			 * Loads the object from specified geometries, which are moved into it.
 			 * 
 			 * @param geometries The geometries that will be part of the object.
 			 */
@@ -70,32 +94,150 @@ namespace bgq_opengl {
 			/**
 			 * @brief Draws this object.
 			 *
-			 * Draws this object.
+			 * Draws this object. With culling on, the geometries outside the view
+			 * of the camera are skipped.
 			 */
 			void draw(Shader &shader, Camera &camera);
 
+			/**
+			 * @brief Draws several copies of this object.
+			 *
+			 * Draws several copies of this object with one instanced draw call per
+			 * geometry. The transforms of the geometries are ignored and the model
+			 * matrices of the instances are used instead. With culling on, the
+			 * geometries with every copy outside the view of the camera are skipped.
+			 *
+			 * @param shader The shader that reads the per-instance attributes.
+			 * @param camera The camera.
+			 * @param instances The copies that will be drawn.
+			 */
+			void drawInstanced(Shader &shader, Camera &camera, std::span<const Instance> instances);
+
+			/**
+			 * @brief Sets whether the objects are culled.
+			 *
+			 * Sets whether the geometries of all the objects are tested against the
+			 * view of the camera before they are drawn, which is the default.
+			 *
+			 * @param enabled True to cull the geometries.
+			 */
+			static void setCulling(bool enabled);
+
+			/**
+			 * @brief Adds this object to a render queue.
+			 *
+			 * Adds a packet to the queue for every geometry of this object, with
+			 * its current transform. With culling on, the geometries outside the
+			 * view of the camera are left out.
+			 *
+			 * @param queue The render queue, already begun with the same camera.
+			 * @param shader The shader.
+			 * @param camera The camera.
+			 * @param materials The material block of each geometry, or a single one for all of them.
+			 * @param environment The environment cube map, or nullptr to keep the one that is bound.
+			 */
+			void submit(RenderQueue *queue, Shader &shader, Camera &camera, std::span<UBO* const> materials, Cubemap *environment = nullptr);
+
 			/**
 			 * @brief Gets the bounding box.
 			 *
-			 * Gets the bounding box of all the geometries.
+			 * Gets the bounding box of all the geometries. It is computed once when
+			 * the object is loaded.
 			 *
 			 * @returns The bounding box struct.
 			 */
 			BoundingBox getBoundingBox();
 
+			/**
+			 * @brief Gets the bounding sphere.
+			 *
+			 * Gets a bounding sphere of all the geometries, centred in the bounding box.
+			 *
+			 * @returns The bounding sphere struct.
+			 */
+			BoundingSphere getBoundingSphere();
+
+			/**
+			 * @brief Gets the bounding box in world space.
+			 *
+			 * Gets the bounding box of all the geometries after their transforms.
+			 *
+			 * @returns The bounding box struct.
+			 */
+			BoundingBox getWorldBoundingBox();
+
+			/**
+			 * @brief Builds the Bvhs.
+			 *
+			 * Builds the hierarchies of all the geometries, which are otherwise
+			 * built the first time a ray is cast against them.
+			 *
+			 * @param pool The workers to build with, or nullptr to build on this thread.
+			 */
+			void buildBvh(ThreadPool *pool = nullptr);
+
+			/**
+			 * @brief Casts a ray.
+			 *
+			 * Finds the closest triangle of any geometry a ray in world space hits.
+			 * The instance of the hit is the index of the geometry.
+			 *
+			 * @param ray The ray, in world space.
+			 * @param hit Outputs the closest hit, if there is one.
+			 *
+			 * @returns True if the ray hit a triangle. False otherwise.
+			 */
+			bool intersect(const Ray &ray, RayHit *hit);
+
+			/**
+			 * @brief Casts a batch of rays.
+			 *
+			 * Finds the closest triangle of any geometry every ray in world space
+			 * hits. The instance of every hit is the index of the geometry, and the
+			 * rays that miss get a hit at an infinite distance.
+			 *
+			 * @param rays The rays, in world space.
+			 * @param hits Outputs the hit of every ray.
+			 * @param pool The workers to cast with, or nullptr to cast on this thread.
+			 *
+			 * @returns The number of rays that hit a triangle.
+			 */
+			size_t intersect(std::span<const Ray> rays, std::span<RayHit> hits, ThreadPool *pool = nullptr);
+
+			/**
+			 * @brief Gets the centre of the object.
+			 *
+			 * Gets the centre of the bounding box of the object.
+			 *
+			 * @returns The centre of the object.
+			 */
+			glm::vec3 getCentre();
+
+			/**
+			 * @brief Gets the normalization scale.
+			 *
+			 * Gets the uniform scale that makes the largest side of the bounding box
+			 * of the object measure the given size.
+			 *
+			 * @param size The size of the largest side after scaling.
+			 *
+			 * @returns The scale ratio.
+			 */
+			float getNormalizationScale(float size);
+
 			/**
 			 * @brief Get the geometries of the object.
 			 * 
-			 * Get the geometries of the object.
+			 * Get a view of the geometries of the object, without copying them.
 			 */
-			std::vector<Geometry> getGeometries();
+			std::span<Geometry> getGeometries();
 
 			/**
 			 * @brief Get the matrices of the geometries.
 			 * 
-			 * Get the matrices of the geometries.
+			 * Get a view of the matrices of the geometries, without copying them.
 			 */
-			std::vector<glm::mat4> getGeometryMatrices();
+			std::span<const glm::mat4> getGeometryMatrices();
         
             /**
              * @brief Set the object shininess.
@@ -214,9 +356,34 @@ namespace bgq_opengl {
 
 		private:
 
+			/**
+			 * @brief Computes the bounding volumes.
+			 *
+			 * Merges the bounding volumes of the geometries once they are loaded.
+			 */
+			void computeBounds();
+
+			/**
+			 * @brief Culls the geometries.
+			 *
+			 * Tests the geometries, with their current transforms, against the view
+			 * of a camera, and leaves the result in visible.
+			 *
+			 * @param camera The camera.
+			 */
+			void cullGeometries(Camera &camera);
+
 			// All the geometries and transformations
 			std::vector<Geometry> geoms;
 			std::vector<glm::mat4> matrices_geoms;
+			BoundingBox bounding_box;			/// Bounding box of all the geometries.
+			BoundingSphere bounding_sphere;		/// Bounding sphere of all the geometries.
+			float max_dimension = 0.0f;			/// Largest side of the bounding box.
+			VBO instances;				/// Per-instance attributes, filled the first time they are needed.
+			bool instances_linked = false;	/// Whether the geometries read the per-instance attributes.
+			BoundsBatch bounds;				/// World bounds of the geometries being culled, kept between frames.
+			std::vector<unsigned char> visible;	/// Whether each of those bounds may be visible.
+			static bool culling;			/// Whether the geometries outside the view are skipped.
 
 	};
 
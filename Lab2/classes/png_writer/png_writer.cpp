@@ -0,0 +1,146 @@
+/**
+ * @file png_writer.cpp
+ * @brief PngWriter class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "png_writer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace bgq_opengl {
+
+	namespace {
+
+		const size_t MAX_STORED_BLOCK = 65535;
+
+		uint32_t crc32(const unsigned char *data, size_t size, uint32_t crc) {
+
+			static const std::array<uint32_t, 256> table = [] {
+
+				std::array<uint32_t, 256> values;
+				for (uint32_t i = 0; i < 256; i++) {
+
+					uint32_t value = i;
+					for (int bit = 0; bit < 8; bit++)
+						value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+					values[i] = value;
+
+				}
+
+				return values;
+
+			}();
+
+			crc = ~crc;
+			for (size_t i = 0; i < size; i++)
+				crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+			return ~crc;
+
+		}
+
+		void putBigEndian(std::vector<unsigned char> *out, uint32_t value) {
+
+			out->push_back((unsigned char) (value >> 24));
+			out->push_back((unsigned char) (value >> 16));
+			out->push_back((unsigned char) (value >> 8));
+			out->push_back((unsigned char) value);
+
+		}
+
+		void writeChunk(std::ofstream &file, const char type[4], const std::vector<unsigned char> &data) {
+
+			// Length, type, data and the CRC of the type and data.
+			std::vector<unsigned char> chunk;
+			chunk.reserve(data.size() + 12);
+			putBigEndian(&chunk, (uint32_t) data.size());
+			chunk.insert(chunk.end(), type, type + 4);
+			chunk.insert(chunk.end(), data.begin(), data.end());
+			putBigEndian(&chunk, crc32(chunk.data() + 4, data.size() + 4, 0));
+
+			file.write((const char*) chunk.data(), (std::streamsize) chunk.size());
+
+		}
+
+	}
+
+	bool PngWriter::write(const std::string &filename, int width, int height, const unsigned char *rgba, bool bottom_up) {
+
+		std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return false;
+
+		static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+		file.write((const char*) signature, sizeof(signature));
+
+		// 8 bits per channel, RGBA, no interlacing.
+		std::vector<unsigned char> header;
+		putBigEndian(&header, (uint32_t) width);
+		putBigEndian(&header, (uint32_t) height);
+		header.insert(header.end(), {8, 6, 0, 0, 0});
+		writeChunk(file, "IHDR", header);
+
+		// Every row starts with its filter, which is none.
+		size_t row_size = (size_t) width * 4;
+		std::vector<unsigned char> rows(((size_t) row_size + 1) * height);
+		for (int y = 0; y < height; y++) {
+
+			int source = bottom_up ? height - 1 - y : y;
+			rows[y * (row_size + 1)] = 0;
+			memcpy(&rows[y * (row_size + 1) + 1], rgba + source * row_size, row_size);
+
+		}
+
+		// A zlib stream made of stored deflate blocks, with its Adler-32 at the end.
+		std::vector<unsigned char> data;
+		data.reserve(rows.size() + rows.size() / MAX_STORED_BLOCK * 5 + 16);
+		data.push_back(0x78);
+		data.push_back(0x01);
+		for (size_t offset = 0; ; offset += MAX_STORED_BLOCK) {
+
+			size_t size = std::min(MAX_STORED_BLOCK, rows.size() - offset);
+			bool last = offset + size >= rows.size();
+			data.push_back(last ? 1 : 0);
+			data.push_back((unsigned char) (size & 0xFF));
+			data.push_back((unsigned char) (size >> 8));
+			data.push_back((unsigned char) (~size & 0xFF));
+			data.push_back((unsigned char) ((~size >> 8) & 0xFF));
+			data.insert(data.end(), rows.begin() + offset, rows.begin() + offset + size);
+			if (last)
+				break;
+
+		}
+
+		uint32_t a = 1, b = 0;
+		for (unsigned char value : rows) {
+
+			a = (a + value) % 65521;
+			b = (b + a) % 65521;
+
+		}
+		putBigEndian(&data, (b << 16) | a);
+
+		writeChunk(file, "IDAT", data);
+		writeChunk(file, "IEND", std::vector<unsigned char>());
+
+		return (bool) file;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,55 @@
+/**
+ * @file png_writer.h
+ * @brief PngWriter class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_PNGWRITER_H_
+#define BGQ_OPENGL_CLASSES_PNGWRITER_H_
+
+#include <string>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a PngWriter class.
+	 *
+	 * Writes RGBA images as PNG files. The image data is stored without
+	 * compression, which every reader accepts, so that no zlib is needed and
+	 * writing a frame costs little more than copying it.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class PngWriter {
+
+		public:
+
+			/**
+			 * @brief Writes a PNG file.
+			 *
+			 * Writes an RGBA image as a PNG file.
+			 *
+			 * @param filename The name of the file.
+			 * @param width The width of the image in pixels.
+			 * @param height The height of the image in pixels.
+			 * @param rgba The pixels, 4 bytes each.
+			 * @param bottom_up Whether the first row is the bottom one, as OpenGL reads them.
+			 *
+			 * @returns True if the file was written. False otherwise.
+			 */
+			static bool write(const std::string &filename, int width, int height, const unsigned char *rgba, bool bottom_up);
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_PNGWRITER_H_
@@ -0,0 +1,190 @@
+/**
+ * @file program_cache.cpp
+ * @brief ProgramCache class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "program_cache.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/program_cache_header/program_cache_header.h"
+#include "structs/program_cache_stats/program_cache_stats.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		const char MAGIC[8] = "BGQPROG";
+
+		void hashBytes(const void *bytes, size_t size, uint64_t *hash) {
+
+			// 64 bit FNV-1a, with a 0 after every string so that they cannot run into each other.
+			const unsigned char *data = (const unsigned char*) bytes;
+			for (size_t i = 0; i <= size; i++) {
+
+				*hash ^= i < size ? (uint64_t) data[i] : 0;
+				*hash *= 1099511628211ull;
+
+			}
+
+		}
+
+	}
+
+	ProgramCacheStats ProgramCache::stats = {0, 0, 0, 0.0, 0.0};
+
+	std::string ProgramCache::getCacheFilename(const char *directory, uint64_t key) {
+
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.program", (unsigned long long) key);
+
+		return (std::filesystem::path(directory) / name).string();
+
+	}
+
+	uint64_t ProgramCache::getKey(const std::string &vertex_source, const std::string &fragment_source) {
+
+		const char *renderer = (const char*) glGetString(GL_RENDERER);
+		const char *version = (const char*) glGetString(GL_VERSION);
+
+		uint64_t hash = 14695981039346656037ull;
+		hashBytes(vertex_source.data(), vertex_source.size(), &hash);
+		hashBytes(fragment_source.data(), fragment_source.size(), &hash);
+		hashBytes(renderer, renderer ? strlen(renderer) : 0, &hash);
+		hashBytes(version, version ? strlen(version) : 0, &hash);
+
+		return hash;
+
+	}
+
+	ProgramCacheStats ProgramCache::getStats() {
+
+		return stats;
+
+	}
+
+	bool ProgramCache::isSupported() {
+
+		if (!GLEW_ARB_get_program_binary)
+			return false;
+
+		GLint num_formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+
+		return num_formats > 0;
+
+	}
+
+	bool ProgramCache::load(const std::string &cache_filename, uint64_t key, GLuint program) {
+
+		auto start = std::chrono::steady_clock::now();
+
+		MappedFile file(cache_filename.c_str());
+		ProgramCacheHeader header;
+		bool valid = file.isOpen() && file.getSize() >= sizeof(ProgramCacheHeader);
+		if (valid) {
+
+			memcpy(&header, file.getData(), sizeof(ProgramCacheHeader));
+			valid = memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION && header.key == key
+				&& header.binary_size == file.getSize() - sizeof(ProgramCacheHeader);
+
+		}
+
+		if (!valid) {
+
+			stats.misses++;
+			return false;
+
+		}
+
+		// The driver checks the binary itself, and refuses it if it does not match.
+		glProgramBinary(program, header.binary_format, file.getData() + sizeof(ProgramCacheHeader), (GLsizei) header.binary_size);
+		GLint linked = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		if (!linked) {
+
+			stats.rejected++;
+			return false;
+
+		}
+
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		stats.hits++;
+		stats.load_time += elapsed.count();
+		stats.saved_time += header.compile_time - elapsed.count();
+
+		return true;
+
+	}
+
+	bool ProgramCache::store(const std::string &cache_filename, uint64_t key, GLuint program, double compile_time) {
+
+		GLint binary_size = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+		if (binary_size <= 0)
+			return false;
+
+		std::vector<char> binary(binary_size);
+		GLenum binary_format = 0;
+		GLsizei length = 0;
+		glGetProgramBinary(program, binary_size, &length, &binary_format, binary.data());
+		if (length <= 0)
+			return false;
+
+		// Create the directory the first time.
+		std::error_code error;
+		std::filesystem::path path(cache_filename);
+		if (path.has_parent_path())
+			std::filesystem::create_directories(path.parent_path(), error);
+
+		std::string temporary_filename = cache_filename + ".tmp";
+		std::ofstream file(temporary_filename, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return false;
+
+		ProgramCacheHeader header;
+		memset(&header, 0, sizeof(ProgramCacheHeader));
+		memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.binary_format = binary_format;
+		header.key = key;
+		header.binary_size = (uint64_t) length;
+		header.compile_time = compile_time;
+
+		file.write((const char*) &header, sizeof(ProgramCacheHeader));
+		file.write(binary.data(), length);
+		file.close();
+		if (!file) {
+
+			std::filesystem::remove(temporary_filename, error);
+			return false;
+
+		}
+
+		std::filesystem::rename(temporary_filename, cache_filename, error);
+
+		return !error;
+
+	}
+
+}  // namespace bgq_opengl
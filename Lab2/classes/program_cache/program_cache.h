@@ -0,0 +1,128 @@
+/**
+ * @file program_cache.h
+ * @brief ProgramCache class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_PROGRAMCACHE_H_
+#define BGQ_OPENGL_CLASSES_PROGRAMCACHE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "GL/glew.h"
+
+#include "structs/program_cache_stats/program_cache_stats.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a ProgramCache class.
+	 *
+	 * Stores linked shader programs on disk as the binaries the driver returns,
+	 * so that later runs do not have to compile and link them again. Every
+	 * cache file is named after a hash of the sources of its program, the
+	 * renderer and the version of OpenGL, so that a change to any of them
+	 * just misses the cache. Drivers can still reject a binary, for instance
+	 * after an update, and then the program is built from its sources again.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ProgramCache {
+
+		public:
+
+			static const uint32_t VERSION = 1;	/// Version of the file format. Older files are ignored.
+
+			/**
+			 * @brief Gets the cache file of a program.
+			 *
+			 * Gets the name of the cache file of a program inside a directory.
+			 *
+			 * @param directory The cache directory.
+			 * @param key The key of the program, as returned by getKey.
+			 *
+			 * @returns The name of the cache file.
+			 */
+			static std::string getCacheFilename(const char *directory, uint64_t key);
+
+			/**
+			 * @brief Gets the key of a program.
+			 *
+			 * Hashes the sources of a program, along with the renderer and the
+			 * version of the current context, with 64 bit FNV-1a.
+			 *
+			 * @param vertex_source The source of the vertex shader.
+			 * @param fragment_source The source of the fragment shader.
+			 *
+			 * @returns The key.
+			 */
+			static uint64_t getKey(const std::string &vertex_source, const std::string &fragment_source);
+
+			/**
+			 * @brief Get the cache counters.
+			 *
+			 * Get the counters of every program loaded or stored so far.
+			 *
+			 * @returns The counters struct.
+			 */
+			static ProgramCacheStats getStats();
+
+			/**
+			 * @brief Whether the context can cache programs.
+			 *
+			 * Whether the context can get and load program binaries, in at least
+			 * one format.
+			 *
+			 * @returns True if the programs can be cached. False otherwise.
+			 */
+			static bool isSupported();
+
+			/**
+			 * @brief Loads a program from a cache file.
+			 *
+			 * Loads the binary of a program from a cache file, if it exists, it is
+			 * valid, it has the same key and the driver takes it.
+			 *
+			 * @param cache_filename The name of the cache file.
+			 * @param key The key of the program.
+			 * @param program The program to load the binary into, which is left unlinked if it fails.
+			 *
+			 * @returns True if the program was loaded and is linked. False otherwise.
+			 */
+			static bool load(const std::string &cache_filename, uint64_t key, GLuint program);
+
+			/**
+			 * @brief Stores a program in a cache file.
+			 *
+			 * Stores the binary of a linked program in a cache file, creating its
+			 * directory if needed. The file is written under a temporary name and
+			 * renamed, so a half written file is never loaded.
+			 *
+			 * @param cache_filename The name of the cache file.
+			 * @param key The key of the program.
+			 * @param program The linked program, which should have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT.
+			 * @param compile_time Milliseconds it took to build the program from its sources.
+			 *
+			 * @returns True if the file was written. False otherwise.
+			 */
+			static bool store(const std::string &cache_filename, uint64_t key, GLuint program, double compile_time);
+
+		private:
+
+			static ProgramCacheStats stats;	/// Counters of every program loaded so far.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_PROGRAMCACHE_H_
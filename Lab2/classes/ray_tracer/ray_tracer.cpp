@@ -0,0 +1,315 @@
+/**
+ * @file ray_tracer.cpp
+ * @brief RayTracer class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "ray_tracer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/bvh/bvh.h"
+#include "classes/spherical_harmonics/spherical_harmonics.h"
+#include "classes/thread_pool/thread_pool.h"
+#include "structs/image_data/image_data.h"
+#include "structs/ray_hit/ray_hit.h"
+#include "structs/ray_instance/ray_instance.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		// Secondary rays start a bit away from the surface, so they do not hit it again.
+		const float RAY_OFFSET = 1e-4f;
+
+		glm::vec3 refractOrReflect(const glm::vec3 &incident, const glm::vec3 &normal, float eta, bool *reflected) {
+
+			// Same as GLSL refract, which gives 0 on total internal reflection. Reflect then instead.
+			glm::vec3 refracted = glm::refract(incident, normal, eta);
+			*reflected = refracted == glm::vec3(0.0f);
+
+			return *reflected ? glm::reflect(incident, normal) : glm::normalize(refracted);
+
+		}
+
+		float getFresnelRatio(const glm::vec3 &incident, const glm::vec3 &normal, float eta, float power) {
+
+			// Schlick's approximation, with the power as a parameter like in the shaders.
+			float f = ((1.0f - eta) * (1.0f - eta)) / ((1.0f + eta) * (1.0f + eta));
+			float cosine = std::clamp(glm::dot(-incident, normal), 0.0f, 1.0f);
+
+			return f + (1.0f - f) * std::pow(1.0f - cosine, power);
+
+		}
+
+	}
+
+	RayTracer::RayTracer(std::span<const ImageData> environment) : environment(environment.begin(), environment.end()) {
+
+		if (!SphericalHarmonics::project(environment, 0, &this->irradiance))
+			this->irradiance = SphericalHarmonics::getFlat();
+
+	}
+
+	void RayTracer::addInstance(int mesh, const glm::mat4 &model, const MaterialBlock &material, ShadingModels shading_model) {
+
+		RayInstance instance;
+		instance.mesh = mesh;
+		instance.model = model;
+		instance.inverse = glm::inverse(model);
+		instance.normal_matrix = glm::transpose(glm::mat3(instance.inverse));
+		instance.material = material;
+		instance.shading_model = shading_model;
+
+		this->instances.push_back(instance);
+
+	}
+
+	int RayTracer::addMesh(std::span<const Vertex> vertices, std::span<const GLuint> indices) {
+
+		this->meshes.emplace_back(vertices, indices);
+
+		return (int) this->meshes.size() - 1;
+
+	}
+
+	glm::vec3 RayTracer::follow(const glm::vec3 &origin, const glm::vec3 &direction, int depth, float inside_eta) const {
+
+		if (depth > this->max_depth)
+			return this->sampleEnvironment(direction);
+
+		return this->trace(origin + RAY_OFFSET * direction, direction, depth, inside_eta);
+
+	}
+
+	bool RayTracer::intersect(const glm::vec3 &origin, const glm::vec3 &direction, RayHit *hit) const {
+
+		bool found = false;
+		float max_t = INFINITY;
+		for (size_t i = 0; i < this->instances.size(); i++) {
+
+			// Cast the ray in the space of the mesh. The distances are the same, as the direction is not normalized again.
+			const RayInstance &instance = this->instances[i];
+			glm::vec3 local_origin = glm::vec3(instance.inverse * glm::vec4(origin, 1.0f));
+			glm::vec3 local_direction = glm::mat3(instance.inverse) * direction;
+
+			if (this->meshes[instance.mesh].intersect(local_origin, local_direction, max_t, hit)) {
+
+				max_t = (*hit).t;
+				(*hit).instance = (int) i;
+				found = true;
+
+			}
+
+		}
+
+		return found;
+
+	}
+
+	void RayTracer::render(const glm::mat4 &view, const glm::mat4 &projection, int width, int height, ThreadPool &pool, std::vector<unsigned char> *pixels) const {
+
+		pixels->resize((size_t) width * height * 4);
+
+		glm::mat4 inverse_view = glm::inverse(view);
+		glm::mat4 inverse_view_projection = glm::inverse(projection * view);
+		glm::vec3 camera_position = glm::vec3(inverse_view[3]);
+		unsigned char *output = pixels->data();
+
+		for (int tile_y = 0; tile_y < height; tile_y += TILE_SIZE) {
+
+			for (int tile_x = 0; tile_x < width; tile_x += TILE_SIZE) {
+
+				pool.submit([this, tile_x, tile_y, width, height, inverse_view_projection, camera_position, output]() {
+
+					for (int y = tile_y; y < std::min(tile_y + TILE_SIZE, height); y++) {
+
+						for (int x = tile_x; x < std::min(tile_x + TILE_SIZE, width); x++) {
+
+							// Go through the centre of the pixel, from the near plane to the far one.
+							glm::vec2 ndc((x + 0.5f) / width * 2.0f - 1.0f, 1.0f - (y + 0.5f) / height * 2.0f);
+							glm::vec4 far = inverse_view_projection * glm::vec4(ndc.x, ndc.y, 1.0f, 1.0f);
+							glm::vec3 direction = glm::normalize(glm::vec3(far) / far.w - camera_position);
+
+							glm::vec3 color = glm::clamp(this->trace(camera_position, direction, 0, 0.0f), 0.0f, 1.0f);
+
+							unsigned char *pixel = output + ((size_t) y * width + x) * 4;
+							pixel[0] = (unsigned char) std::lround(color.r * 255.0f);
+							pixel[1] = (unsigned char) std::lround(color.g * 255.0f);
+							pixel[2] = (unsigned char) std::lround(color.b * 255.0f);
+							pixel[3] = 255;
+
+						}
+
+					}
+
+				});
+
+			}
+
+		}
+
+		pool.wait();
+
+	}
+
+	glm::vec3 RayTracer::sampleEnvironment(const glm::vec3 &direction) const {
+
+		// The skybox flips z when it samples the cubemap.
+		glm::vec3 d(direction.x, direction.y, -direction.z);
+		glm::vec3 a = glm::abs(d);
+
+		// Pick the face and its coordinates like OpenGL does.
+		int face;
+		float sc, tc, ma;
+		if (a.x >= a.y && a.x >= a.z) {
+
+			face = d.x > 0.0f ? 0 : 1;
+			sc = d.x > 0.0f ? -d.z : d.z;
+			tc = -d.y;
+			ma = a.x;
+
+		} else if (a.y >= a.z) {
+
+			face = d.y > 0.0f ? 2 : 3;
+			sc = d.x;
+			tc = d.y > 0.0f ? d.z : -d.z;
+			ma = a.y;
+
+		} else {
+
+			face = d.z > 0.0f ? 4 : 5;
+			sc = d.z > 0.0f ? d.x : -d.x;
+			tc = -d.y;
+			ma = a.z;
+
+		}
+
+		if (ma <= 0.0f || face >= (int) this->environment.size())
+			return glm::vec3(0.0f);
+
+		const ImageData &image = this->environment[face];
+		float s = (sc / ma + 1.0f) * 0.5f * image.width - 0.5f;
+		float t = (tc / ma + 1.0f) * 0.5f * image.height - 0.5f;
+
+		// Bilinear filtering, clamped to the edges of the face.
+		int x0 = std::clamp((int) std::floor(s), 0, image.width - 1);
+		int y0 = std::clamp((int) std::floor(t), 0, image.height - 1);
+		int x1 = std::min(x0 + 1, image.width - 1);
+		int y1 = std::min(y0 + 1, image.height - 1);
+		float fx = std::clamp(s - std::floor(s), 0.0f, 1.0f);
+		float fy = std::clamp(t - std::floor(t), 0.0f, 1.0f);
+
+		auto texel = [&image](int x, int y) {
+
+			const unsigned char *pixel = image.pixels.get() + ((size_t) y * image.width + x) * image.channels;
+			if (image.channels < 3)
+				return glm::vec3(pixel[0] / 255.0f);
+
+			return glm::vec3(pixel[0], pixel[1], pixel[2]) / 255.0f;
+
+		};
+
+		glm::vec3 top = glm::mix(texel(x0, y0), texel(x1, y0), fx);
+		glm::vec3 bottom = glm::mix(texel(x0, y1), texel(x1, y1), fx);
+
+		return glm::mix(top, bottom, fy);
+
+	}
+
+	void RayTracer::setMaxDepth(int depth) {
+
+		this->max_depth = std::max(depth, 0);
+
+	}
+
+	void RayTracer::setTwoInterface(bool two_interface) {
+
+		this->two_interface = two_interface;
+
+	}
+
+	glm::vec3 RayTracer::trace(const glm::vec3 &origin, const glm::vec3 &direction, int depth, float inside_eta) const {
+
+		RayHit hit;
+		if (!this->intersect(origin, direction, &hit))
+			return this->sampleEnvironment(direction);
+
+		const RayInstance &instance = this->instances[hit.instance];
+		glm::vec3 position = origin + hit.t * direction;
+		glm::vec3 normal = glm::normalize(instance.normal_matrix * this->meshes[instance.mesh].getNormal(hit));
+
+		// Always shade the side the ray comes from.
+		if (glm::dot(direction, normal) > 0.0f)
+			normal = -normal;
+
+		bool reflected;
+
+		// Leaving an object, the ratio is the other way around. Total internal reflection keeps the ray inside.
+		if (inside_eta > 0.0f) {
+
+			glm::vec3 next = refractOrReflect(direction, normal, 1.0f / inside_eta, &reflected);
+
+			return this->follow(position, next, depth + 1, reflected ? inside_eta : 0.0f);
+
+		}
+
+		const MaterialBlock &material = instance.material;
+		int model = instance.shading_model;
+
+		// Refracted rays only go through the object with two interfaces, otherwise they look the environment up.
+		auto refracted = [&](float eta) {
+
+			glm::vec3 next = refractOrReflect(direction, normal, eta, &reflected);
+			if (!this->two_interface && !reflected)
+				return this->sampleEnvironment(next);
+
+			return this->follow(position, next, depth + 1, reflected ? 0.0f : eta);
+
+		};
+
+		if (model == REFRACTION)
+			return refracted(material.eta);
+
+		glm::vec3 reflect_color = this->follow(position, glm::reflect(direction, normal), depth + 1, 0.0f);
+
+		if (model == REFLECTION)
+			return reflect_color;
+
+		if (model == FRESNEL)
+			return glm::mix(refracted(material.eta), reflect_color, getFresnelRatio(direction, normal, material.eta, material.fresnel_power));
+
+		// Every channel bends with its own ratio, and the green one gives the reflectance.
+		glm::vec3 refract_color(refracted(material.eta_r).r, refracted(material.eta_g).g, refracted(material.eta_b).b);
+		glm::vec3 color = glm::mix(refract_color, reflect_color, getFresnelRatio(direction, normal, material.eta_g, material.fresnel_power));
+
+		// The tint is lit by the environment, which is looked up with z flipped.
+		if (model == TINTED_CHROMATIC) {
+
+			glm::vec3 irradiance = SphericalHarmonics::evaluate(this->irradiance, glm::vec3(normal.x, normal.y, -normal.z));
+			color = glm::mix(material.object_color * irradiance, color, material.mix_color);
+
+		}
+
+		return color;
+
+	}
+
+}  // namespace bgq_opengl
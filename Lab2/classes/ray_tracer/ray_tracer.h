@@ -0,0 +1,208 @@
+/**
+ * @file ray_tracer.h
+ * @brief RayTracer class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_RAYTRACER_H_
+#define BGQ_OPENGL_CLASSES_RAYTRACER_H_
+
+#include <span>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/bvh/bvh.h"
+#include "classes/thread_pool/thread_pool.h"
+#include "structs/image_data/image_data.h"
+#include "structs/ray_hit/ray_hit.h"
+#include "structs/ray_instance/ray_instance.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a RayTracer class.
+	 *
+	 * Renders a scene on the CPU with the same reflection, refraction, Fresnel
+	 * and chromatic dispersion models as the shaders, so that it can be used
+	 * as the reference of the GPU images, or to render them without a GPU. It
+	 * never touches OpenGL.
+	 *
+	 * Every mesh gets a Bvh and the image is split in tiles that the workers
+	 * of a ThreadPool render. With a depth of 0 the reflected and refracted
+	 * directions are looked up in the environment, like the shaders do. Higher
+	 * depths trace the reflections against the scene, and with two interfaces
+	 * the refracted rays go through the objects and leave them on the other
+	 * side, which the shaders cannot do.
+	 *
+	 * Everything is done in world space, and the environment is sampled the way
+	 * the skybox is drawn, with z flipped. The shaders sample it with vectors
+	 * in view space, so their reflections turn with the camera and the
+	 * reference ones do not.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class RayTracer {
+
+		public:
+
+			/**
+			 * @brief Declares the shading models.
+			 *
+			 * The models of the basic scene, and the tinted chromatic one of
+			 * the fancy scene. The point light highlights are not traced.
+			 */
+			enum ShadingModels { REFLECTION, REFRACTION, FRESNEL, CHROMATIC, TINTED_CHROMATIC };
+
+			static const int TILE_SIZE = 32;	/// Width and height of the tiles the workers take.
+
+			/**
+			 * @brief Constructs a RayTracer.
+			 *
+			 * Constructs an empty scene lit by an environment, and projects the
+			 * diffuse light of the environment like the cubemaps do.
+			 *
+			 * @param environment The faces of the environment cubemap, in the order of the OpenGL faces.
+			 */
+			RayTracer(std::span<const ImageData> environment);
+
+			/**
+			 * @brief Adds an instance.
+			 *
+			 * Places a mesh in the scene.
+			 *
+			 * @param mesh The index of the mesh, from addMesh.
+			 * @param model The model matrix.
+			 * @param material The parameters of the shading model.
+			 * @param shading_model The shading model.
+			 */
+			void addInstance(int mesh, const glm::mat4 &model, const MaterialBlock &material, ShadingModels shading_model);
+
+			/**
+			 * @brief Adds a mesh.
+			 *
+			 * Builds the Bvh of a mesh, which can then be placed any number of
+			 * times. The vertices are copied, so they can be freed afterwards.
+			 *
+			 * @param vertices The vertices of the mesh.
+			 * @param indices The indices of the triangles.
+			 *
+			 * @returns The index of the mesh.
+			 */
+			int addMesh(std::span<const Vertex> vertices, std::span<const GLuint> indices);
+
+			/**
+			 * @brief Casts a ray against the scene.
+			 *
+			 * Finds the closest triangle of any instance a ray hits.
+			 *
+			 * @param origin The origin of the ray.
+			 * @param direction The direction of the ray.
+			 * @param hit Outputs the closest hit, if there is one.
+			 *
+			 * @returns True if the ray hit something. False otherwise.
+			 */
+			bool intersect(const glm::vec3 &origin, const glm::vec3 &direction, RayHit *hit) const;
+
+			/**
+			 * @brief Renders the scene.
+			 *
+			 * Renders the scene as seen by a camera, splitting the image in tiles
+			 * between the workers of a pool.
+			 *
+			 * @param view The view matrix of the camera.
+			 * @param projection The projection matrix of the camera.
+			 * @param width The width in pixels.
+			 * @param height The height in pixels.
+			 * @param pool The workers.
+			 * @param pixels Outputs the pixels, 4 bytes each, top row first.
+			 */
+			void render(const glm::mat4 &view, const glm::mat4 &projection, int width, int height, ThreadPool &pool, std::vector<unsigned char> *pixels) const;
+
+			/**
+			 * @brief Sets the depth.
+			 *
+			 * Sets how many times the secondary rays are traced before the
+			 * environment is looked up instead.
+			 *
+			 * @param depth The depth, 0 to shade like the GPU.
+			 */
+			void setMaxDepth(int depth);
+
+			/**
+			 * @brief Sets whether the refractions have two interfaces.
+			 *
+			 * Sets whether the refracted rays go through the objects, bending
+			 * again as they leave them, or look the environment up right away
+			 * like the shaders.
+			 *
+			 * @param two_interface True to trace the rays through the objects.
+			 */
+			void setTwoInterface(bool two_interface);
+
+		private:
+
+			/**
+			 * @brief Follows a secondary ray.
+			 *
+			 * Traces a secondary ray if the depth allows it, or looks its
+			 * direction up in the environment.
+			 *
+			 * @param origin The origin of the ray.
+			 * @param direction The normalized direction of the ray.
+			 * @param depth The depth of the ray.
+			 * @param inside_eta The ratio of the medium the ray goes through, or 0 outside the objects.
+			 *
+			 * @returns The colour the ray sees.
+			 */
+			glm::vec3 follow(const glm::vec3 &origin, const glm::vec3 &direction, int depth, float inside_eta) const;
+
+			/**
+			 * @brief Samples the environment.
+			 *
+			 * Samples the environment in a direction, with bilinear filtering.
+			 *
+			 * @param direction The direction, in world space.
+			 *
+			 * @returns The colour of the environment.
+			 */
+			glm::vec3 sampleEnvironment(const glm::vec3 &direction) const;
+
+			/**
+			 * @brief Traces a ray.
+			 *
+			 * Finds what a ray hits and shades it.
+			 *
+			 * @param origin The origin of the ray.
+			 * @param direction The normalized direction of the ray.
+			 * @param depth The depth of the ray, 0 for the camera rays.
+			 * @param inside_eta The ratio of the medium the ray goes through, or 0 outside the objects.
+			 *
+			 * @returns The colour the ray sees.
+			 */
+			glm::vec3 trace(const glm::vec3 &origin, const glm::vec3 &direction, int depth, float inside_eta) const;
+
+			std::vector<Bvh> meshes;				/// Hierarchies of the meshes.
+			std::vector<RayInstance> instances;		/// Instances in the scene.
+			std::vector<ImageData> environment;		/// Faces of the environment.
+			IrradianceBlock irradiance;				/// Diffuse light of the environment, which lights the tints.
+			int max_depth = 0;						/// Depth of the secondary rays.
+			bool two_interface = false;				/// Whether the refracted rays go through the objects.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_RAYTRACER_H_
@@ -0,0 +1,204 @@
+/**
+ * @file reflection_probe.cpp
+ * @brief ReflectionProbe class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "reflection_probe.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/camera/camera.h"
+#include "classes/cubemap/cubemap.h"
+#include "classes/fbo/fbo.h"
+#include "classes/gl_state/gl_state.h"
+#include "structs/bounding_box/bounding_box.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		// Directions and up vectors of the faces, in the order of the cube map targets.
+		const glm::vec3 FACE_DIRECTIONS[ReflectionProbe::NUM_FACES] = {
+			glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+			glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+			glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)
+		};
+		const glm::vec3 FACE_UPS[ReflectionProbe::NUM_FACES] = {
+			glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+			glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f),
+			glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)
+		};
+
+		// A coarser level is only taken once the object needs this much of it.
+		const float SHRINK_MARGIN = 0.7f;
+
+		const uint64_t FNV_OFFSET = 14695981039346656037ull;
+		const uint64_t FNV_PRIME = 1099511628211ull;
+
+	}
+
+	ReflectionProbe::ReflectionProbe(float range, GLuint slot) : cubemap(createTexture(slot), "skybox", slot), fbo(MAX_SIZE, MAX_SIZE, false), range(range) {
+
+		for (int face = 0; face < NUM_FACES; face++) {
+
+			this->face_hashes[face] = 0;
+			this->face_levels[face] = -1;
+
+		}
+
+	}
+
+	void ReflectionProbe::begin(const glm::vec3 &centre, float screen_size) {
+
+		this->centre = centre;
+
+		// A face covers a quarter turn, so about half of the object.
+		float needed = screen_size / 2.0f;
+		int desired = NUM_LEVELS - 1;
+		while (desired > 0 && (MAX_SIZE >> desired) < needed)
+			desired--;
+
+		if (desired < this->target_level || (desired > this->target_level && needed < SHRINK_MARGIN * (MAX_SIZE >> desired)))
+			this->target_level = desired;
+
+		this->hash = FNV_OFFSET;
+		this->watch(&this->centre, sizeof(this->centre));
+
+	}
+
+	Camera ReflectionProbe::beginFace(float near, float far) {
+
+		for (int i = 0; i < NUM_FACES; i++) {
+
+			int face = (this->next_face + i) % NUM_FACES;
+			if (this->isStale(face)) {
+
+				this->current_face = face;
+				break;
+
+			}
+
+		}
+
+		int size = MAX_SIZE >> this->target_level;
+		this->fbo.attach(GL_TEXTURE_CUBE_MAP_POSITIVE_X + this->current_face, this->cubemap.getID(), this->target_level);
+		glViewport(0, 0, size, size);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		Camera camera(this->centre, FACE_DIRECTIONS[this->current_face], 90.0f, near, far, size, size);
+		camera.setUp(FACE_UPS[this->current_face]);
+		camera.setMirrored(true);
+		camera.update();
+
+		return camera;
+
+	}
+
+	GLuint ReflectionProbe::createTexture(GLuint slot) {
+
+		GLuint texture;
+		glGenTextures(1, &texture);
+		GlState::bindTexture(slot, GL_TEXTURE_CUBE_MAP, texture);
+
+		for (int level = 0; level < NUM_LEVELS; level++)
+			for (int face = 0; face < NUM_FACES; face++)
+				glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, GL_RGBA8, MAX_SIZE >> level, MAX_SIZE >> level, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+		// Only the level that is complete is ever sampled, with no filtering between levels.
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+		return texture;
+
+	}
+
+	void ReflectionProbe::endFace() {
+
+		this->face_hashes[this->current_face] = this->hash;
+		this->face_levels[this->current_face] = this->target_level;
+		this->next_face = (this->current_face + 1) % NUM_FACES;
+
+		if (this->level == this->target_level)
+			return;
+
+		for (int face = 0; face < NUM_FACES; face++)
+			if (this->face_levels[face] != this->target_level)
+				return;
+
+		// Every face of the new level is done, so sample it.
+		this->level = this->target_level;
+		GlState::bindTexture(this->cubemap.getSlot(), GL_TEXTURE_CUBE_MAP, this->cubemap.getID());
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, this->level);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, this->level);
+
+	}
+
+	Cubemap& ReflectionProbe::getCubemap() {
+
+		return this->cubemap;
+
+	}
+
+	int ReflectionProbe::getSize() const {
+
+		return this->level < 0 ? 0 : MAX_SIZE >> this->level;
+
+	}
+
+	bool ReflectionProbe::isInRange(const BoundingBox &world_box) const {
+
+		// Distance from the centre to the closest point of the box.
+		glm::vec3 closest = glm::max(world_box.min, glm::min(this->centre, world_box.max));
+		return glm::length(closest - this->centre) <= this->range;
+
+	}
+
+	bool ReflectionProbe::isReady() const {
+
+		return this->level >= 0;
+
+	}
+
+	bool ReflectionProbe::isStale() const {
+
+		for (int face = 0; face < NUM_FACES; face++)
+			if (this->isStale(face))
+				return true;
+
+		return false;
+
+	}
+
+	bool ReflectionProbe::isStale(int face) const {
+
+		return this->face_levels[face] != this->target_level || this->face_hashes[face] != this->hash;
+
+	}
+
+	void ReflectionProbe::watch(const void *state, size_t size) {
+
+		const unsigned char *bytes = (const unsigned char*) state;
+		for (size_t i = 0; i < size; i++)
+			this->hash = (this->hash ^ bytes[i]) * FNV_PRIME;
+
+	}
+
+}  // namespace bgq_opengl
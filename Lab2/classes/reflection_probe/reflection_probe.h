@@ -0,0 +1,200 @@
+/**
+ * @file reflection_probe.h
+ * @brief ReflectionProbe class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_REFLECTIONPROBE_H_
+#define BGQ_OPENGL_CLASSES_REFLECTIONPROBE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/camera/camera.h"
+#include "classes/cubemap/cubemap.h"
+#include "classes/fbo/fbo.h"
+#include "structs/bounding_box/bounding_box.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a ReflectionProbe class.
+	 *
+	 * A cube map of the scene as seen from the centre of an object, so that the
+	 * object can reflect what is around it instead of only the skybox. The
+	 * faces are rendered one at a time into an FBO, so that their cost can be
+	 * spread over several frames. They are mirrored along z like the ones of
+	 * the skyboxes, so that both are looked up the same way.
+	 *
+	 * The cube map keeps a mip level per resolution, and the faces are only
+	 * rendered at the level that suits the size of the object on the screen.
+	 * The probe keeps sampling the previous level until the six faces of a
+	 * new one are done. Every face remembers a hash of what was in range when
+	 * it was rendered, and it is only rendered again when that changes.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ReflectionProbe {
+
+		public:
+
+			static const int MAX_SIZE = 256;	/// Side of the faces at the finest level, in pixels.
+			static const int NUM_LEVELS = 4;	/// Resolutions, each one half the previous one.
+			static const int NUM_FACES = 6;		/// Faces of the cube map.
+
+			/**
+			 * @brief Creates a ReflectionProbe.
+			 *
+			 * Creates the cube map, with every level allocated, and the FBO with the
+			 * depth buffer its faces are rendered with.
+			 *
+			 * @param range The distance up to which moving objects make the probe out of date.
+			 * @param slot The slot of the cube map, which is the one of the environment it replaces.
+			 */
+			ReflectionProbe(float range, GLuint slot);
+
+			/**
+			 * @brief Starts a new frame.
+			 *
+			 * Places the probe and picks the resolution for the size of its object
+			 * on the screen, then starts the hash of what it sees with the centre.
+			 * The resolution goes down with some margin, so that it does not flip
+			 * back and forth.
+			 *
+			 * @param centre The centre of the object, in world space.
+			 * @param screen_size The size of the object on the screen, in pixels.
+			 */
+			void begin(const glm::vec3 &centre, float screen_size);
+
+			/**
+			 * @brief Starts rendering a face.
+			 *
+			 * Attaches the next out of date face to the FBO, binds it, sets the
+			 * viewport and clears it. Must only be called if isStale.
+			 *
+			 * @param near The near clipping distance.
+			 * @param far The far clipping distance.
+			 *
+			 * @returns The camera that sees the face from the centre.
+			 */
+			Camera beginFace(float near, float far);
+
+			/**
+			 * @brief Finishes rendering a face.
+			 *
+			 * Marks the face as up to date, and samples the new level once its six
+			 * faces are done.
+			 */
+			void endFace();
+
+			/**
+			 * @brief Get the cube map.
+			 *
+			 * Get the cube map, which holds nothing until isReady.
+			 *
+			 * @returns The cube map.
+			 */
+			Cubemap& getCubemap();
+
+			/**
+			 * @brief Get the size of the faces.
+			 *
+			 * Get the side of the faces that are sampled.
+			 *
+			 * @returns The size in pixels, or 0 if it is not ready.
+			 */
+			int getSize() const;
+
+			/**
+			 * @brief Whether something is within range.
+			 *
+			 * Whether a box is close enough to the centre for its movements to
+			 * make the probe out of date.
+			 *
+			 * @param world_box The box, in world space.
+			 *
+			 * @returns True if the box is within range.
+			 */
+			bool isInRange(const BoundingBox &world_box) const;
+
+			/**
+			 * @brief Whether the probe can be sampled.
+			 *
+			 * Whether the six faces of some level have been rendered.
+			 *
+			 * @returns True if the probe can be sampled.
+			 */
+			bool isReady() const;
+
+			/**
+			 * @brief Whether a face is out of date.
+			 *
+			 * Whether a face was rendered with a different hash or at another
+			 * level, or never.
+			 *
+			 * @returns True if a face has to be rendered.
+			 */
+			bool isStale() const;
+
+			/**
+			 * @brief Adds state to the hash.
+			 *
+			 * Adds something the probe sees, like the transform of an object in
+			 * range, to the hash of this frame.
+			 *
+			 * @param state The state.
+			 * @param size The size of the state in bytes.
+			 */
+			void watch(const void *state, size_t size);
+
+		private:
+
+			/**
+			 * @brief Creates the cube map texture.
+			 *
+			 * Creates a cube map with every level allocated and nothing in it.
+			 *
+			 * @param slot The slot of the cube map.
+			 *
+			 * @returns The texture.
+			 */
+			static GLuint createTexture(GLuint slot);
+
+			/**
+			 * @brief Whether a face is out of date.
+			 *
+			 * @param face The face.
+			 *
+			 * @returns True if the face has to be rendered.
+			 */
+			bool isStale(int face) const;
+
+			Cubemap cubemap;						/// Cube map with every level.
+			FBO fbo;								/// Depth buffer the faces are rendered with.
+			glm::vec3 centre = glm::vec3(0.0f);		/// Centre of the probe, in world space.
+			float range;							/// Distance up to which moving objects matter.
+			uint64_t hash = 0;						/// Hash of what the probe sees this frame.
+			uint64_t face_hashes[NUM_FACES];		/// Hash each face was rendered with.
+			int face_levels[NUM_FACES];				/// Level each face was rendered at, or -1 if it never was.
+			int level = -1;							/// Level that is sampled, or -1 if none is complete.
+			int target_level = NUM_LEVELS - 1;		/// Level the faces are rendered at.
+			int next_face = 0;						/// Face that is looked at first for the next update.
+			int current_face = -1;					/// Face being rendered.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_REFLECTIONPROBE_H_
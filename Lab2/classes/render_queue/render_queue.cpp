@@ -0,0 +1,221 @@
+/**
+ * @file render_queue.cpp
+ * @brief RenderQueue class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "render_queue.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/camera/camera.h"
+#include "classes/cubemap/cubemap.h"
+#include "classes/draw_counter/draw_counter.h"
+#include "classes/geometry/geometry.h"
+#include "classes/shader/shader.h"
+#include "classes/texture/texture.h"
+#include "classes/ubo/ubo.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/draw_packet/draw_packet.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		// Bits of each field of the keys, from the top.
+		const int PROGRAM_BITS = 8;
+		const int GEOMETRY_BITS = 16;
+		const int MATERIAL_BITS = 8;
+
+		const int RADIX_BITS = 8;
+		const int RADIX_SIZE = 1 << RADIX_BITS;
+
+	}
+
+	void RenderQueue::begin(Camera &camera) {
+
+		this->packets.clear();
+		this->transforms.clear();
+		this->keys.clear();
+		this->programs.clear();
+		this->geometries.clear();
+		this->materials.clear();
+
+		this->view = camera.getView();
+
+	}
+
+	void RenderQueue::execute() {
+
+		this->sort();
+
+		Shader *shader = nullptr;
+		Geometry *geometry = nullptr;
+		UBO *material = nullptr;
+		Cubemap *environment = nullptr;
+
+		for (uint32_t index : this->order) {
+
+			const DrawPacket &packet = this->packets[index];
+			bool new_program = packet.shader != shader;
+			bool new_geometry = packet.geometry != geometry;
+
+			if (new_program) {
+
+				shader = packet.shader;
+				shader->activate();
+
+			}
+
+			// The textures stay bound to their slots until another geometry needs them.
+			if (new_geometry) {
+
+				geometry = packet.geometry;
+				geometry->getVAO().bind();
+				for (Texture &texture : geometry->getTextures())
+					texture.bind();
+
+			}
+
+			// A new program has not seen the slots or the shininess of this geometry yet.
+			if (new_program || new_geometry) {
+
+				for (Texture &texture : geometry->getTextures())
+					shader->passInt(shader->getSampler(texture.getName()), (int) texture.getSlot());
+				shader->passFloat(shader->getUniform(Shader::MATERIAL_SHININESS), geometry->getShininess());
+
+			}
+
+			if (packet.material != nullptr && packet.material != material) {
+
+				material = packet.material;
+				material->bind();
+
+			}
+
+			if (packet.environment != nullptr && packet.environment != environment) {
+
+				environment = packet.environment;
+				environment->bind();
+
+			}
+
+			// Pass the model matrix and the ones derived from it.
+			shader->passModel(this->transforms[packet.transform], this->view);
+
+			glDrawElements(GL_TRIANGLES, packet.count, GL_UNSIGNED_INT, 0);
+			DrawCounter::recordDraw(1);
+
+		}
+
+	}
+
+	uint64_t RenderQueue::getID(std::vector<const void*> *table, const void *state, int bits) {
+
+		auto found = std::find(table->begin(), table->end(), state);
+		if (found != table->end())
+			return (uint64_t) (found - table->begin());
+
+		uint64_t last = ((uint64_t) 1 << bits) - 1;
+		if (table->size() >= last)
+			return last;
+
+		table->push_back(state);
+		return (uint64_t) table->size() - 1;
+
+	}
+
+	size_t RenderQueue::size() const {
+
+		return this->packets.size();
+
+	}
+
+	void RenderQueue::sort() {
+
+		size_t count = this->packets.size();
+		this->order.resize(count);
+		this->scratch.resize(count);
+		for (size_t i = 0; i < count; i++)
+			this->order[i] = (uint32_t) i;
+
+		for (int shift = 0; shift < 64; shift += RADIX_BITS) {
+
+			size_t offsets[RADIX_SIZE] = {};
+			for (uint64_t key : this->keys)
+				offsets[(key >> shift) & (RADIX_SIZE - 1)]++;
+
+			// Every key has the same digit, so this pass would not move anything.
+			if (count == 0 || offsets[(this->keys[0] >> shift) & (RADIX_SIZE - 1)] == count)
+				continue;
+
+			size_t start = 0;
+			for (int digit = 0; digit < RADIX_SIZE; digit++) {
+
+				size_t digit_count = offsets[digit];
+				offsets[digit] = start;
+				start += digit_count;
+
+			}
+
+			for (size_t i = 0; i < count; i++) {
+
+				uint32_t index = this->order[i];
+				this->scratch[offsets[(this->keys[index] >> shift) & (RADIX_SIZE - 1)]++] = index;
+
+			}
+
+			this->order.swap(this->scratch);
+
+		}
+
+	}
+
+	void RenderQueue::submit(Shader &shader, Geometry &geometry, UBO *material, const glm::mat4 &model, Cubemap *environment) {
+
+		// The depth is the one of the centre of the box.
+		BoundingBox box = geometry.getBoundingBox();
+		glm::vec4 centre = this->view * model * glm::vec4((box.min + box.max) * 0.5f, 1.0f);
+		float depth = std::max(-centre.z, 0.0f);
+
+		DrawPacket packet;
+		packet.shader = &shader;
+		packet.geometry = &geometry;
+		packet.material = material;
+		packet.environment = environment;
+		packet.transform = (uint32_t) this->transforms.size();
+		packet.count = (GLsizei) geometry.getIndices().size();
+		packet.depth = depth;
+
+		// Positive floats sort the same as their bits, so nearer draws go first.
+		uint32_t depth_bits;
+		memcpy(&depth_bits, &depth, sizeof(depth_bits));
+
+		uint64_t key = getID(&this->programs, &shader, PROGRAM_BITS);
+		key = (key << GEOMETRY_BITS) | getID(&this->geometries, &geometry, GEOMETRY_BITS);
+		key = (key << MATERIAL_BITS) | getID(&this->materials, material, MATERIAL_BITS);
+		key = (key << 32) | depth_bits;
+
+		this->packets.push_back(packet);
+		this->transforms.push_back(model);
+		this->keys.push_back(key);
+
+	}
+
+}  // namespace bgq_opengl
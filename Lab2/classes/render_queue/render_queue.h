@@ -0,0 +1,135 @@
+/**
+ * @file render_queue.h
+ * @brief RenderQueue class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_RENDERQUEUE_H_
+#define BGQ_OPENGL_CLASSES_RENDERQUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "classes/camera/camera.h"
+#include "classes/cubemap/cubemap.h"
+#include "classes/geometry/geometry.h"
+#include "classes/shader/shader.h"
+#include "classes/ubo/ubo.h"
+#include "structs/draw_packet/draw_packet.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a RenderQueue class.
+	 *
+	 * Collects the draw calls of a frame as packets instead of issuing them
+	 * right away. Every packet gets a 64 bit key with its program in the top
+	 * bits, then its geometry, then its material and then its depth, so that
+	 * sorting the keys groups the draws that share state. The keys are radix
+	 * sorted and the packets are drawn in one loop that only changes the
+	 * state that differs from the previous packet.
+	 *
+	 * The memory of the queue is kept from one frame to the next.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class RenderQueue {
+
+		public:
+
+			/**
+			 * @brief Starts a new frame.
+			 *
+			 * Removes the packets of the previous frame and takes the view of the
+			 * camera, which the depths and the model view matrices come from.
+			 *
+			 * @param camera The camera the packets are drawn for.
+			 */
+			void begin(Camera &camera);
+
+			/**
+			 * @brief Draws the queue.
+			 *
+			 * Sorts the packets by their keys and draws them in that order,
+			 * binding programs, VAOs, textures, materials and environments only
+			 * when they change.
+			 */
+			void execute();
+
+			/**
+			 * @brief Get the number of packets.
+			 *
+			 * Get the number of packets submitted since the frame began.
+			 *
+			 * @returns The number of packets.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Adds a draw to the queue.
+			 *
+			 * Adds a packet that draws a geometry with a program, a material, an
+			 * environment and a model matrix.
+			 *
+			 * @param shader The program.
+			 * @param geometry The geometry.
+			 * @param material The material block, or nullptr to keep the one that is bound.
+			 * @param model The model matrix.
+			 * @param environment The environment cube map, or nullptr to keep the one that is bound.
+			 */
+			void submit(Shader &shader, Geometry &geometry, UBO *material, const glm::mat4 &model, Cubemap *environment = nullptr);
+
+		private:
+
+			/**
+			 * @brief Get the small id of some state.
+			 *
+			 * Get the position of a program, a geometry or a material in the
+			 * table of the ones seen this frame, adding it if it is new. Once the
+			 * ids run out of bits every new one shares the last id, which only
+			 * makes the order less tight.
+			 *
+			 * @param table The table of the ones seen this frame.
+			 * @param state The program, geometry or material.
+			 * @param bits The number of bits of the id in the key.
+			 *
+			 * @returns The id.
+			 */
+			static uint64_t getID(std::vector<const void*> *table, const void *state, int bits);
+
+			/**
+			 * @brief Sorts the packets.
+			 *
+			 * Sorts the indices of the packets by their keys, eight bits at a time
+			 * from the lowest ones. The passes in which every key has the same
+			 * digit are skipped.
+			 */
+			void sort();
+
+			std::vector<DrawPacket> packets;		/// Packets of the frame, in the order they came.
+			std::vector<glm::mat4> transforms;		/// Model matrices of the packets.
+			std::vector<uint64_t> keys;				/// Sort key of each packet.
+			std::vector<uint32_t> order;			/// Indices of the packets, sorted by their keys.
+			std::vector<uint32_t> scratch;			/// Second buffer of the radix sort.
+			std::vector<const void*> programs;		/// Programs seen this frame, by id.
+			std::vector<const void*> geometries;	/// Geometries seen this frame, by id.
+			std::vector<const void*> materials;		/// Materials seen this frame, by id.
+			glm::mat4 view = glm::mat4(1.0f);		/// View matrix of the frame.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_RENDERQUEUE_H_
@@ -15,7 +15,12 @@
 
 #include "shader.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <utility>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -26,22 +31,64 @@
 #include "glm/gtc/type_ptr.hpp"
 
 #include "classes/camera/camera.h"
+#include "classes/draw_counter/draw_counter.h"
+#include "classes/gl_state/gl_state.h"
 #include "classes/light/light.h"
+#include "classes/program_cache/program_cache.h"
+#include "classes/shader_compiler/shader_compiler.h"
 #include "classes/texture/texture.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
 
 namespace bgq_opengl {
 
+    namespace {
+
+        // Whether a uniform of this type is bound to a texture unit.
+        bool isSampler(GLenum type) {
+
+            switch (type) {
+
+                case GL_SAMPLER_2D:
+                case GL_SAMPLER_3D:
+                case GL_SAMPLER_CUBE:
+                case GL_SAMPLER_2D_SHADOW:
+                case GL_SAMPLER_2D_ARRAY:
+                case GL_SAMPLER_BUFFER:
+                case GL_INT_SAMPLER_BUFFER:
+                case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+                    return true;
+
+                default:
+                    return false;
+
+            }
+
+        }
+
+    }
+
+    UniformStats Shader::stats = {0, 0, 0, 0};
+
     Shader::Shader() {
     
-        this->programID = NULL;
+        this->programID = 0;
+
+        for (int i = 0; i < NUM_BUILTINS; i++)
+            this->builtin_handles[i] = -1;
 
-        this->light = new Light(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+        this->light = Light(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
     
     }
     
-    Shader::Shader(const char* vertex_filename, const char* fragment_filename) {
+    Shader::Shader(const char* vertex_filename, const char* fragment_filename, const char* cache_directory, const char* defines) : vertex_filename(vertex_filename), fragment_filename(fragment_filename) {
 
-        this->light = new Light(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+        // Keep where everything comes from, so the program can be built again.
+        if (cache_directory != nullptr)
+            this->cache_directory = cache_directory;
+        if (defines != nullptr)
+            this->defines = defines;
+
+        this->light = Light(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
 
         // Init the strings to store the source code in.
         std::string vertex_source_code = "";
@@ -69,7 +116,33 @@ namespace bgq_opengl {
 
         }
 
+        addDefines(this->defines, &vertex_source_code);
+        addDefines(this->defines, &fragment_source_code);
+
+        // Try the binary of the program first. It is keyed by the sources and the driver, so changing either misses it.
+        this->programID = glCreateProgram();
+        uint64_t cache_key = 0;
+        std::string cache_filename;
+        bool cacheable = cache_directory != nullptr && ProgramCache::isSupported();
+        if (cacheable) {
+
+            cache_key = ProgramCache::getKey(vertex_source_code, fragment_source_code);
+            cache_filename = ProgramCache::getCacheFilename(cache_directory, cache_key);
+            if (ProgramCache::load(cache_filename, cache_key, this->programID)) {
+
+                GlState::useProgram(this->programID);
+                this->loadUniforms();
+                return;
+
+            }
+
+            // Ask the driver to keep the binary of the program built below.
+            glProgramParameteri(this->programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        }
+
         // Convert it to char.
+        auto start = std::chrono::steady_clock::now();
         const char* vertex_code_char = vertex_source_code.c_str();
         const char* fragment_code_char = fragment_source_code.c_str();
 
@@ -101,8 +174,7 @@ namespace bgq_opengl {
 
         }
 
-        // Create the program and add the vertex and fragment shaders.
-        this->programID = glCreateProgram();
+        // Add the vertex and fragment shaders to the program.
         glAttachShader(this->programID, vertex);
         glAttachShader(this->programID, fragment);
 
@@ -121,6 +193,15 @@ namespace bgq_opengl {
         glDeleteShader(vertex);
         glDeleteShader(fragment);
 
+        // Store the binary for the next run.
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (cacheable && !ProgramCache::store(cache_filename, cache_key, this->programID, elapsed.count()))
+            std::cerr << "Shader warning - Could not write the program cache " << cache_filename << std::endl;
+
+        // Build the table of uniforms now that the program is linked.
+        GlState::useProgram(this->programID);
+        this->loadUniforms();
+
         /*
         // Validate the program.
         glValidateProgram(this->programID);
@@ -135,6 +216,120 @@ namespace bgq_opengl {
 
     }
 
+    int Shader::getUniform(const std::string& name) {
+
+        stats.name_lookups++;
+
+        // Look it up in the table.
+        auto it = this->uniform_handles.find(name);
+        if (it == this->uniform_handles.end())
+            return -1;
+
+        return it->second;
+
+    }
+
+    int Shader::getUniform(BuiltinUniform uniform) {
+
+        return this->builtin_handles[uniform];
+
+    }
+
+    int Shader::getSampler(const std::string& name) const {
+
+        // Programs only have a few samplers, resolved when they were linked.
+        auto it = this->sampler_handles.find(name);
+        if (it == this->sampler_handles.end())
+            return -1;
+
+        return it->second;
+
+    }
+
+    const std::string& Shader::getVertexFilename() const {
+
+        return this->vertex_filename;
+
+    }
+
+    UniformStats Shader::getStats() {
+
+        return stats;
+
+    }
+
+    void Shader::resetStats() {
+
+        stats = {0, 0, 0, 0};
+
+    }
+
+    Shader::Shader(Shader&& other) noexcept : light(other.light), programID(other.programID), uniforms(std::move(other.uniforms)), uniform_handles(std::move(other.uniform_handles)), sampler_handles(std::move(other.sampler_handles)),
+        vertex_filename(std::move(other.vertex_filename)), fragment_filename(std::move(other.fragment_filename)), cache_directory(std::move(other.cache_directory)), defines(std::move(other.defines)),
+        pending_program(other.pending_program), pending_start(other.pending_start), pending_job(std::move(other.pending_job)) {
+
+        // Leave the other one empty so it does not delete the program.
+        std::memcpy(this->builtin_handles, other.builtin_handles, sizeof(this->builtin_handles));
+        for (int i = 0; i < 2; i++) {
+
+            this->pending_shaders[i] = other.pending_shaders[i];
+            this->pending_sources[i] = std::move(other.pending_sources[i]);
+            other.pending_shaders[i] = 0;
+
+        }
+        other.programID = 0;
+        other.pending_program = 0;
+
+    }
+
+    Shader& Shader::operator=(Shader&& other) noexcept {
+
+        if (this != &other) {
+
+            // Release the current program before taking the other one.
+            this->remove();
+
+            this->light = other.light;
+            this->programID = other.programID;
+            this->uniforms = std::move(other.uniforms);
+            this->uniform_handles = std::move(other.uniform_handles);
+            this->sampler_handles = std::move(other.sampler_handles);
+            std::memcpy(this->builtin_handles, other.builtin_handles, sizeof(this->builtin_handles));
+            this->vertex_filename = std::move(other.vertex_filename);
+            this->fragment_filename = std::move(other.fragment_filename);
+            this->cache_directory = std::move(other.cache_directory);
+            this->defines = std::move(other.defines);
+            this->pending_program = other.pending_program;
+            this->pending_start = other.pending_start;
+            this->pending_job = std::move(other.pending_job);
+            for (int i = 0; i < 2; i++) {
+
+                this->pending_shaders[i] = other.pending_shaders[i];
+                this->pending_sources[i] = std::move(other.pending_sources[i]);
+                other.pending_shaders[i] = 0;
+
+            }
+            other.programID = 0;
+            other.pending_program = 0;
+
+        }
+
+        return *this;
+
+    }
+
+    Shader::~Shader() {
+
+        this->remove();
+
+    }
+
+    const std::string& Shader::getFragmentFilename() const {
+
+        return this->fragment_filename;
+
+    }
+
     unsigned int Shader::getProgramID() {
 
         return this->programID;
@@ -146,146 +341,396 @@ namespace bgq_opengl {
         if (this->programID == -1)
             throw std::runtime_error("Shader was not initialized.");
 
-        glUseProgram(this->programID);
+        // Only reach the driver if another program is in use.
+        if (GlState::useProgram(this->programID))
+            DrawCounter::recordProgramBind();
 
     }
 
     void Shader::passBool(const std::string& name, bool value) {
 
-        glUniform1i(glGetUniformLocation(this->programID, name.c_str()), (int)value);
+        this->passInt(this->getUniform(name), (int)value);
 
     }
 
-    void Shader::passCamera(Camera camera) {
+    void Shader::passCamera(Camera &camera) {
 
-        // Pass the View matrix to the shader.
+        // Pass the View and Projection matrices to the shader.
         glm::mat4 view_matrix = camera.getView();
-        GLint location = glGetUniformLocation(this->programID, "View");
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(view_matrix));
-
-        // Pass the Projection matrix to the shader.
-        glm::mat4 projection_matrix = camera.getProjection();
-        location = glGetUniformLocation(this->programID, "Projection");
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+        this->passMat(this->builtin_handles[VIEW], view_matrix);
+        this->passMat(this->builtin_handles[PROJECTION], camera.getProjection());
 
         // Get the camera info and pass it to the shader.
-        glm::vec4 color = (*this->light).getColor();
-        glm::vec3 position = (*this->light).getPosition();
+        glm::vec4 color = this->light.getColor();
+        glm::vec3 position = this->light.getPosition();
 
         // Transform the camera position to view.
         position = glm::vec3(view_matrix * glm::vec4(position, 1.0f));
 
         // Pass it to the shader.
-        glUniform4f(glGetUniformLocation(this->programID, "lightColor"), color.x, color.y, color.z, color.w);
-        glUniform3f(glGetUniformLocation(this->programID, "lightPos"), position.x, position.y, position.z);
+        this->passVec(this->builtin_handles[LIGHT_COLOR], color);
+        this->passVec(this->builtin_handles[LIGHT_POS], position);
 
     }
 
-    void Shader::passCubemap(Cubemap cubemap) {
-        
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, cubemap.getName().c_str());
+    void Shader::passCubemap(Cubemap &cubemap) {
 
         // Activate the shader.
         this->activate();
 
         // Sets the value of the texture uniform.
-        glUniform1i(location, cubemap.getSlot());
+        this->passInt(this->getSampler(cubemap.getName()), cubemap.getSlot());
         
     }
 
-    void Shader::passLight(Light lightParam) {
+    void Shader::passLight(const Light &lightParam) {
 
         // Store the light.
-        this->light = new Light(lightParam.getPosition(), lightParam.getColor());
+        this->light = lightParam;
 
     }
 
     void Shader::passInt(const std::string& name, int value) {
 
-        glUniform1i(glGetUniformLocation(this->programID, name.c_str()), value);
+        this->passInt(this->getUniform(name), value);
+
+    }
+
+    void Shader::passInt(int handle, int value) {
+
+        if (!this->updateShadow(handle, &value, sizeof(value)))
+            return;
+
+        glUniform1i(this->uniforms[handle].location, value);
 
     }
 
     void Shader::passFloat(const std::string& name, float value) {
 
-        glUniform1f(glGetUniformLocation(this->programID, name.c_str()), value);
+        this->passFloat(this->getUniform(name), value);
+
+    }
+
+    void Shader::passFloat(int handle, float value) {
+
+        if (!this->updateShadow(handle, &value, sizeof(value)))
+            return;
+
+        glUniform1f(this->uniforms[handle].location, value);
 
     }
 
-    void Shader::passTexture(Texture texture) {
+    void Shader::passModel(const glm::mat4& model, const glm::mat4& view) {
 
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, texture.getName().c_str());
+        // Pass the model matrix.
+        this->passMat(this->builtin_handles[MODEL], model);
+
+        // Compute the modelView and pass it.
+        glm::mat4 model_view = view * model;
+        this->passMat(this->builtin_handles[MODEL_VIEW], model_view);
+
+        // Get the normal matrix and pass it.
+        // Skip the inverse altogether if the program does not use it.
+        if (this->builtin_handles[NORMAL_MATRIX] != -1)
+            this->passMat(this->builtin_handles[NORMAL_MATRIX], glm::transpose(glm::inverse(model_view)));
+
+    }
+
+    void Shader::passTexture(Texture &texture) {
 
         // Activate the shader.
         this->activate();
 
         // Sets the value of the texture uniform.
-        glUniform1i(location, texture.getSlot());
+        this->passInt(this->getSampler(texture.getName()), texture.getSlot());
 
     }
 
     void Shader::passVec(const std::string& name, glm::vec2 value) {
-        
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
 
-        // Sets the value of the texture uniform.
-        glUniform2f(location, value.x, value.y);
+        int handle = this->getUniform(name);
+        if (!this->updateShadow(handle, &value, sizeof(value)))
+            return;
+
+        glUniform2f(this->uniforms[handle].location, value.x, value.y);
 
     }
 
     void Shader::passVec(const std::string& name, glm::vec3 value) {
-        
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
 
-        // Sets the value of the texture uniform.
-        glUniform3f(location, value.x, value.y, value.z);
+        this->passVec(this->getUniform(name), value);
+
+    }
+
+    void Shader::passVec(int handle, glm::vec3 value) {
+
+        if (!this->updateShadow(handle, &value, sizeof(value)))
+            return;
+
+        glUniform3f(this->uniforms[handle].location, value.x, value.y, value.z);
 
     }
 
     void Shader::passVec(const std::string& name, glm::vec4 value) {
-        
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
 
-        // Sets the value of the texture uniform.
-        glUniform4f(location, value.x, value.y, value.z, value.w);
+        this->passVec(this->getUniform(name), value);
+
+    }
+
+    void Shader::passVec(int handle, glm::vec4 value) {
+
+        if (!this->updateShadow(handle, &value, sizeof(value)))
+            return;
+
+        glUniform4f(this->uniforms[handle].location, value.x, value.y, value.z, value.w);
 
     }
 
     void Shader::passMat(const std::string& name, glm::mat2 value) {
 
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        int handle = this->getUniform(name);
+        if (!this->updateShadow(handle, &value, sizeof(value)))
+            return;
 
-        glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(value));
+        glUniformMatrix2fv(this->uniforms[handle].location, 1, GL_FALSE, glm::value_ptr(value));
 
     }
 
     void Shader::passMat(const std::string& name, glm::mat3 value) {
 
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        int handle = this->getUniform(name);
+        if (!this->updateShadow(handle, &value, sizeof(value)))
+            return;
 
-        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+        glUniformMatrix3fv(this->uniforms[handle].location, 1, GL_FALSE, glm::value_ptr(value));
 
     }
 
     void Shader::passMat(const std::string& name, glm::mat4 value) {
 
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        this->passMat(this->getUniform(name), value);
+
+    }
+
+    void Shader::passMat(int handle, const glm::mat4& value) {
+
+        if (!this->updateShadow(handle, &value, sizeof(value)))
+            return;
+
+        glUniformMatrix4fv(this->uniforms[handle].location, 1, GL_FALSE, glm::value_ptr(value));
+
+    }
+
+    bool Shader::pollReload() {
+
+        if (this->pending_job) {
+
+            // The compiler already waited for the driver on its own thread, so nothing below waits.
+            if (!ShaderCompiler::poll(*this->pending_job))
+                return false;
+
+            this->pending_program = this->pending_job->program;
+            this->pending_shaders[0] = this->pending_job->shaders[0];
+            this->pending_shaders[1] = this->pending_job->shaders[1];
+            this->pending_job.reset();
+
+        } else if (this->pending_program == 0) {
+
+            return false;
+
+        } else {
+
+            // With parallel compilation the driver can be asked without waiting.
+            GLint done = GL_FALSE;
+            glGetProgramiv(this->pending_program, GL_COMPLETION_STATUS_KHR, &done);
+            if (!done)
+                return false;
+
+        }
+
+        // Check for errors, and keep the current program if there are any.
+        std::string error_msg = "";
+        if (!Shader::checkShader(this->pending_shaders[0], "VERTEX", &error_msg)) {
+
+            std::cerr << "Vertex shader error - Could not compile " << this->vertex_filename << ", keeping the previous program: " << error_msg << std::endl;
+            this->cancelReload();
+            return false;
+
+        }
+
+        if (!Shader::checkShader(this->pending_shaders[1], "FRAGMENT", &error_msg)) {
+
+            std::cerr << "Fragment shader error - Could not compile " << this->fragment_filename << ", keeping the previous program: " << error_msg << std::endl;
+            this->cancelReload();
+            return false;
+
+        }
+
+        if (!Shader::checkShader(this->pending_program, "PROGRAM", &error_msg)) {
+
+            std::cerr << "Shader program error - Could not link " << this->vertex_filename << " and " << this->fragment_filename << ", keeping the previous program: " << error_msg << std::endl;
+            this->cancelReload();
+            return false;
+
+        }
+
+        // Swap the programs. Every handle is looked up again, and every uniform is uploaded again on the next draw.
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - this->pending_start;
+        GLuint previous = this->programID;
+        this->programID = this->pending_program;
+        this->pending_program = 0;
+        for (int i = 0; i < 2; i++) {
+
+            glDeleteShader(this->pending_shaders[i]);
+            this->pending_shaders[i] = 0;
+
+        }
+
+        if (previous != 0)
+            GlState::deleteProgram(previous);
+        GlState::useProgram(this->programID);
+        this->loadUniforms();
+
+        // Store the binary for the next run, like the first build does.
+        if (!this->cache_directory.empty() && ProgramCache::isSupported()) {
 
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+            uint64_t cache_key = ProgramCache::getKey(this->pending_sources[0], this->pending_sources[1]);
+            std::string cache_filename = ProgramCache::getCacheFilename(this->cache_directory.c_str(), cache_key);
+            if (!ProgramCache::store(cache_filename, cache_key, this->programID, elapsed.count()))
+                std::cerr << "Shader warning - Could not write the program cache " << cache_filename << std::endl;
+
+        }
+
+        this->pending_sources[0].clear();
+        this->pending_sources[1].clear();
+
+        std::cerr << "Shader reloaded " << this->vertex_filename << " and " << this->fragment_filename << " in " << elapsed.count() << " ms." << std::endl;
+
+        return true;
+
+    }
+
+    void Shader::reload() {
+
+        // Only the latest sources matter.
+        this->cancelReload();
+
+        // Read the sources again. The current program is kept if they cannot be read.
+        std::string sources[2];
+        try {
+
+            readFileContents(this->vertex_filename.c_str(), &sources[0]);
+            readFileContents(this->fragment_filename.c_str(), &sources[1]);
+
+        } catch (std::ifstream::failure& e) {
+
+            std::cerr << "Shader error - Could not read the shader files, keeping the previous program: " << e.what() << std::endl;
+            return;
+
+        }
+
+        // Editors may leave the file empty for a moment while saving, and another change will follow.
+        if (sources[0].empty() || sources[1].empty())
+            return;
+
+        addDefines(this->defines, &sources[0]);
+        addDefines(this->defines, &sources[1]);
+
+        // Checking a program is only free with parallel compilation. Otherwise it is built on the thread of the compiler.
+        bool parallel = GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+        if (!parallel && !ShaderCompiler::isRunning()) {
+
+            std::cerr << "Shader warning - Cannot reload " << this->vertex_filename << " and " << this->fragment_filename << " without blocking the frame, keeping the previous program." << std::endl;
+            return;
+
+        }
+
+        this->pending_start = std::chrono::steady_clock::now();
+        bool retrievable = !this->cache_directory.empty() && ProgramCache::isSupported();
+        if (!parallel) {
+
+            this->pending_job = ShaderCompiler::submit(sources[0], sources[1], retrievable);
+            this->pending_sources[0] = std::move(sources[0]);
+            this->pending_sources[1] = std::move(sources[1]);
+            return;
+
+        }
+
+        this->pending_program = glCreateProgram();
+        if (retrievable)
+            glProgramParameteri(this->pending_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        // Compile and link without checking anything, since that would wait for the driver.
+        const GLenum types[2] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER};
+        for (int i = 0; i < 2; i++) {
+
+            const char* code = sources[i].c_str();
+            this->pending_shaders[i] = glCreateShader(types[i]);
+            glShaderSource(this->pending_shaders[i], 1, &code, NULL);
+            glCompileShader(this->pending_shaders[i]);
+            glAttachShader(this->pending_program, this->pending_shaders[i]);
+            this->pending_sources[i] = std::move(sources[i]);
+
+        }
+
+        glLinkProgram(this->pending_program);
 
     }
 
     void Shader::remove() {
 
-        glDeleteProgram(this->programID);
+        // Drop any reload on the way.
+        this->cancelReload();
+
+        // Delete the program in OpenGL, if there is one.
+        if (this->programID != 0)
+            GlState::deleteProgram(this->programID);
+        this->programID = 0;
+
+    }
+
+    void Shader::cancelReload() {
+
+        if (this->pending_job) {
+
+            ShaderCompiler::cancel(*this->pending_job);
+            this->pending_job.reset();
+
+        }
+
+        for (int i = 0; i < 2; i++) {
+
+            if (this->pending_shaders[i] != 0)
+                glDeleteShader(this->pending_shaders[i]);
+            this->pending_shaders[i] = 0;
+            this->pending_sources[i].clear();
+
+        }
+
+        if (this->pending_program != 0)
+            glDeleteProgram(this->pending_program);
+        this->pending_program = 0;
+
+    }
+
+    void Shader::addDefines(const std::string& defines, std::string *source) {
+
+        if (defines.empty())
+            return;
+
+        // The version has to be the first thing in the source, so the defines go right after it.
+        size_t position = 0;
+        size_t version = source->find("#version");
+        if (version != std::string::npos) {
+
+            size_t end = source->find('\n', version);
+            position = end == std::string::npos ? source->size() : end + 1;
+
+        }
+
+        // The errors report the lines of the file, as if nothing was added.
+        long line = std::count(source->begin(), source->begin() + position, '\n') + 1;
+        source->insert(position, defines + "#line " + std::to_string(line) + "\n");
 
     }
 
@@ -325,6 +770,111 @@ namespace bgq_opengl {
 
     }
 
+    void Shader::loadUniforms() {
+
+        // Names of the builtin uniforms, in the same order as the enum.
+        static const char* builtin_names[NUM_BUILTINS] = {
+            "Model", "View", "Projection", "modelView", "normalMatrix", "lightColor", "lightPos", "materialShininess"
+        };
+
+        this->uniforms.clear();
+        this->uniform_handles.clear();
+        this->sampler_handles.clear();
+
+        // Get how many uniforms are active in the program.
+        GLint num_uniforms = 0;
+        glGetProgramiv(this->programID, GL_ACTIVE_UNIFORMS, &num_uniforms);
+
+        for (GLint i = 0; i < num_uniforms; i++) {
+
+            // Get the name, type and size of the uniform.
+            char name[256] = "";
+            GLsizei length = 0;
+            Uniform uniform;
+            glGetActiveUniform(this->programID, (GLuint) i, sizeof(name), &length, &uniform.size, &uniform.type, name);
+
+            // Arrays are reported as "name[0]", but are referenced as "name".
+            std::string uniform_name(name, length);
+            size_t bracket = uniform_name.find('[');
+            if (bracket != std::string::npos)
+                uniform_name = uniform_name.substr(0, bracket);
+
+            // Members of uniform blocks have no location, so skip them.
+            uniform.location = glGetUniformLocation(this->programID, name);
+            stats.gl_lookups++;
+            if (uniform.location == -1)
+                continue;
+
+            uniform.name = uniform_name;
+            uniform.uploaded = false;
+            std::memset(uniform.value, 0, sizeof(uniform.value));
+
+            // Store it in the table.
+            this->uniform_handles[uniform_name] = (int) this->uniforms.size();
+            if (isSampler(uniform.type))
+                this->sampler_handles[uniform_name] = (int) this->uniforms.size();
+            this->uniforms.push_back(uniform);
+
+        }
+
+        // Resolve the builtin handles once.
+        for (int i = 0; i < NUM_BUILTINS; i++) {
+
+            auto it = this->uniform_handles.find(builtin_names[i]);
+            this->builtin_handles[i] = it == this->uniform_handles.end() ? -1 : it->second;
+
+        }
+
+        // Attach the uniform blocks to the binding points shared by all programs.
+        GLuint block_index = glGetUniformBlockIndex(this->programID, "FrameBlock");
+        if (block_index != GL_INVALID_INDEX)
+            glUniformBlockBinding(this->programID, block_index, FRAME_BLOCK_BINDING);
+
+        block_index = glGetUniformBlockIndex(this->programID, "MaterialBlock");
+        if (block_index != GL_INVALID_INDEX)
+            glUniformBlockBinding(this->programID, block_index, MATERIAL_BLOCK_BINDING);
+
+        block_index = glGetUniformBlockIndex(this->programID, "ClusterBlock");
+        if (block_index != GL_INVALID_INDEX)
+            glUniformBlockBinding(this->programID, block_index, CLUSTER_BLOCK_BINDING);
+
+        block_index = glGetUniformBlockIndex(this->programID, "IrradianceBlock");
+        if (block_index != GL_INVALID_INDEX)
+            glUniformBlockBinding(this->programID, block_index, IRRADIANCE_BLOCK_BINDING);
+
+        // Point the shared buffer textures to their units, which never change.
+        const char* buffer_names[] = { "lightData", "clusterRanges", "lightIndices" };
+        const int buffer_units[] = { LIGHT_DATA_UNIT, CLUSTER_RANGES_UNIT, LIGHT_INDICES_UNIT };
+        for (int i = 0; i < 3; i++)
+            this->passInt(this->getSampler(buffer_names[i]), buffer_units[i]);
+
+    }
+
+    bool Shader::updateShadow(int handle, const void* value, size_t size) {
+
+        // Uniforms that are not active are silently ignored, like OpenGL does with location -1.
+        if (handle < 0)
+            return false;
+
+        Uniform &uniform = this->uniforms[handle];
+
+        // Skip the upload if the value is the same we uploaded last time.
+        if (uniform.uploaded && std::memcmp(uniform.value, value, size) == 0) {
+
+            stats.skipped++;
+            return false;
+
+        }
+
+        // Store the new value.
+        std::memcpy(uniform.value, value, size);
+        uniform.uploaded = true;
+        stats.uploads++;
+
+        return true;
+
+    }
+
     void Shader::readFileContents(const char* filename, std::string *file_contents) {
 
         try {
@@ -16,7 +16,11 @@
 #ifndef BGQ_OPENGL_SHADER_H_
 #define BGQ_OPENGL_SHADER_H_
 
+#include <chrono>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "glm/glm.hpp"
 
@@ -24,6 +28,8 @@
 #include "classes/cubemap/cubemap.h"
 #include "classes/light/light.h"
 #include "classes/texture/texture.h"
+#include "structs/compile_job/compile_job.h"
+#include "structs/uniform/uniform.h"
 
 namespace bgq_opengl {
     
@@ -39,6 +45,14 @@ namespace bgq_opengl {
 
     public:
 
+        /**
+         * @brief Uniforms that are set by the classes themselves.
+         *
+         * Uniforms that are set every draw by the classes themselves. Their handles
+         * are resolved once at link time so drawing never looks them up by name.
+         */
+        enum BuiltinUniform { MODEL, VIEW, PROJECTION, MODEL_VIEW, NORMAL_MATRIX, LIGHT_COLOR, LIGHT_POS, MATERIAL_SHININESS, NUM_BUILTINS };
+
         /**
          * @brief Construct the shader instance.
          *
@@ -49,12 +63,64 @@ namespace bgq_opengl {
         /**
          * @brief Construct the shader instance.
          *
-         * Construct the shader instance by passing the shaders' files.
+         * Construct the shader instance by passing the shaders' files. With a
+         * cache directory, the linked program is loaded from its binary there,
+         * and stored there when it has to be built from the sources.
+         *
+         * The defines are added right after the version of both shaders, so
+         * that one source can be built into several programs.
          *
          * @param vertex_filename Vertex shader filename.
          * @param fragment_filename Fragment shader filename.
+         * @param cache_directory Directory of the program cache, or nullptr to always build the program.
+         * @param defines Lines of preprocessor defines, or nullptr for none.
+         */
+        Shader(const char* vertex_filename, const char* fragment_filename, const char* cache_directory = nullptr, const char* defines = nullptr);
+
+        /**
+         * @brief Shader objects cannot be copied.
+         *
+         * Shader objects own their program, so they cannot be copied.
          */
-        Shader(const char* vertex_filename, const char* fragment_filename);
+        Shader(const Shader&) = delete;
+        Shader& operator=(const Shader&) = delete;
+
+        /**
+         * @brief Moves a Shader.
+         *
+         * Takes the program from another Shader, which is left empty.
+         *
+         * @param other The Shader to move from.
+         */
+        Shader(Shader&& other) noexcept;
+
+        /**
+         * @brief Moves a Shader.
+         *
+         * Removes the current program and takes the one of another Shader, which
+         * is left empty.
+         *
+         * @param other The Shader to move from.
+         *
+         * @returns This Shader.
+         */
+        Shader& operator=(Shader&& other) noexcept;
+
+        /**
+         * @brief Destroys the Shader.
+         *
+         * Removes the program from OpenGL.
+         */
+        ~Shader();
+
+        /**
+         * @brief Get the name of the fragment shader file.
+         *
+         * Get the name of the fragment shader file, as it was given.
+         *
+         * @returns The name of the file.
+         */
+        const std::string& getFragmentFilename() const;
 
         /**
          *@brief Returns the program ID.
@@ -65,6 +131,67 @@ namespace bgq_opengl {
          */
         unsigned int getProgramID();
 
+        /**
+         * @brief Get the handle of a uniform.
+         *
+         * Get the handle of an active uniform from the table built at link time.
+         * The handle can be stored and used with the pass functions so that no
+         * name has to be looked up again.
+         *
+         * @param name The name of the uniform within the shaders.
+         *
+         * @returns The handle of the uniform or -1 if it is not active.
+         */
+        int getUniform(const std::string& name);
+
+        /**
+         * @brief Get the handle of a builtin uniform.
+         *
+         * Get the handle of a builtin uniform. This does not look anything up.
+         *
+         * @param uniform The builtin uniform.
+         *
+         * @returns The handle of the uniform or -1 if it is not active.
+         */
+        int getUniform(BuiltinUniform uniform);
+
+        /**
+         * @brief Get the handle of a sampler uniform.
+         *
+         * Get the handle of a sampler from the ones resolved at link time, so that
+         * binding a texture by its name does not go through the whole table.
+         *
+         * @param name The name of the sampler, which is the name of its texture.
+         *
+         * @returns The handle of the sampler or -1 if it is not active.
+         */
+        int getSampler(const std::string& name) const;
+
+        /**
+         * @brief Get the name of the vertex shader file.
+         *
+         * Get the name of the vertex shader file, as it was given.
+         *
+         * @returns The name of the file.
+         */
+        const std::string& getVertexFilename() const;
+
+        /**
+         * @brief Get the uniform upload counters.
+         *
+         * Get the counters shared by all the shader programs.
+         *
+         * @returns The counters struct.
+         */
+        static UniformStats getStats();
+
+        /**
+         * @brief Reset the uniform upload counters.
+         *
+         * Reset the counters, typically at the beginning of every frame.
+         */
+        static void resetStats();
+
         /**
          * @brief Activate this shader program.
          * 
@@ -89,7 +216,7 @@ namespace bgq_opengl {
          *
          * @param camera The camera.
          */
-        void passCamera(Camera camera);
+        void passCamera(Camera &camera);
         
         /**
          * @brief Pass a cubemap to the shader.
@@ -98,7 +225,7 @@ namespace bgq_opengl {
          *
          * @param cubemap The cubemap that will be passed.
          */
-        void passCubemap(Cubemap cubemap);
+        void passCubemap(Cubemap &cubemap);
 
         /**
          * @brief Pass a light to the shader.
@@ -107,7 +234,7 @@ namespace bgq_opengl {
          * 
          * @param light the light that will be passed to tha shader.
          */
-        void passLight(Light light);
+        void passLight(const Light &light);
 
         /**
          * @brief Pass a given integer to the shaders.
@@ -129,6 +256,36 @@ namespace bgq_opengl {
          */
         void passFloat(const std::string& name, float value);
 
+        /**
+         * @brief Pass a given integer to the shaders.
+         *
+         * Pass a given integer to the uniform with the given handle.
+         *
+         * @param handle The handle of the uniform as returned by getUniform.
+         * @param value The int to be passed to the program.
+         */
+        void passInt(int handle, int value);
+
+        /**
+         * @brief Pass a given float to the shaders.
+         *
+         * Pass a given float to the uniform with the given handle.
+         *
+         * @param handle The handle of the uniform as returned by getUniform.
+         * @param value The float to be passed to the program.
+         */
+        void passFloat(int handle, float value);
+
+        /**
+         * @brief Pass the model matrices to the shader.
+         *
+         * Pass the model matrix and the derived modelView and normal matrices.
+         *
+         * @param model The model matrix.
+         * @param view The view matrix of the camera.
+         */
+        void passModel(const glm::mat4& model, const glm::mat4& view);
+
         /**
          * @brief Pass a texture to the shader.
          * 
@@ -136,7 +293,7 @@ namespace bgq_opengl {
          * 
          * @param texture The texture itself.
          */
-        void passTexture(Texture texture);
+        void passTexture(Texture &texture);
         
         /**
          * @brief Pass a vector of size 2 to the shader.
@@ -168,6 +325,26 @@ namespace bgq_opengl {
          */
         void passVec(const std::string& name, glm::vec4 value);
 
+        /**
+         * @brief Pass a vector of size 3 to the shader.
+         *
+         * Pass a vector of size 3 to the uniform with the given handle.
+         *
+         * @param handle The handle of the uniform as returned by getUniform.
+         * @param value The vector that will be passed.
+         */
+        void passVec(int handle, glm::vec3 value);
+
+        /**
+         * @brief Pass a vector of size 4 to the shader.
+         *
+         * Pass a vector of size 4 to the uniform with the given handle.
+         *
+         * @param handle The handle of the uniform as returned by getUniform.
+         * @param value The vector that will be passed.
+         */
+        void passVec(int handle, glm::vec4 value);
+
         /**
          * @brief Pass a matrix of size 2 to the shader.
          *
@@ -198,6 +375,44 @@ namespace bgq_opengl {
          */
         void passMat(const std::string& name, glm::mat4 value);
 
+        /**
+         * @brief Pass a matrix of size 4 to the shader.
+         *
+         * Pass a matrix of size 4 to the uniform with the given handle.
+         *
+         * @param handle The handle of the uniform as returned by getUniform.
+         * @param value The matrix that will be passed.
+         */
+        void passMat(int handle, const glm::mat4& value);
+
+        /**
+         * @brief Finish a reload.
+         *
+         * Checks the program started by reload. Once the driver is done with it,
+         * it replaces the current program if it linked, or is thrown away with
+         * its log printed if it did not. Either way, the previous program is
+         * used until then.
+         *
+         * With parallel shader compilation the driver is asked without waiting.
+         * Without it the program is built by the ShaderCompiler, which waits for
+         * the driver on its own thread, so this never blocks either.
+         *
+         * @returns True if the program was replaced. False otherwise.
+         */
+        bool pollReload();
+
+        /**
+         * @brief Reload the shader files.
+         *
+         * Reads the shader files again and starts building a new program from
+         * them, but does not wait for it, so that drawing goes on with the
+         * current one. A reload that was not finished yet is discarded.
+         *
+         * Without parallel shader compilation the ShaderCompiler has to be
+         * running, or the current program is kept.
+         */
+        void reload();
+
         /**
          * @brief Remove the shader from OpenGL.
          * 
@@ -207,6 +422,18 @@ namespace bgq_opengl {
 
     private:
 
+        /**
+         * @brief Add the defines to a source.
+         *
+         * Inserts the defines after the version line, which has to come first,
+         * followed by a line directive so that the errors keep the line numbers
+         * of the file.
+         *
+         * @param defines The lines of defines.
+         * @param source The source code, which is modified.
+         */
+        static void addDefines(const std::string& defines, std::string *source);
+
         /**
          * @brief Check for errors in the program or shader.
          * 
@@ -220,6 +447,37 @@ namespace bgq_opengl {
          */
         static bool checkShader(unsigned int shader, std::string type, std::string* log_str);
 
+        /**
+         * @brief Discard the program of a reload.
+         *
+         * Deletes the shaders and program of a reload that was not finished.
+         */
+        void cancelReload();
+
+        /**
+         * @brief Builds the table of active uniforms.
+         *
+         * Enumerates the active uniforms of the linked program and stores their
+         * locations and types, so that they never have to be looked up again.
+         * It also resolves the samplers and attaches the uniform blocks to their
+         * shared binding points. The program has to be in use, because the
+         * samplers of the shared buffers are set here.
+         */
+        void loadUniforms();
+
+        /**
+         * @brief Updates the shadow copy of a uniform.
+         *
+         * Compares the value with the last one uploaded to the uniform and stores it.
+         *
+         * @param handle The handle of the uniform.
+         * @param value The new value.
+         * @param size The size of the value in bytes.
+         *
+         * @returns True if the value has to be uploaded. False if it did not change.
+         */
+        bool updateShadow(int handle, const void* value, size_t size);
+
         /**
          * @brief Gets the content of a file as a string.
          *
@@ -232,8 +490,23 @@ namespace bgq_opengl {
          */
         static void readFileContents(const char* filename, std::string *file_contents);
 
-        Light* light; /// The light that will be used in the shader.
-        unsigned int programID = -1; /// OpenGL ID for this shader program.
+        Light light; /// The light that will be used in the shader.
+        unsigned int programID = 0; /// OpenGL ID for this shader program.
+        std::vector<Uniform> uniforms;                          /// Active uniforms of the program.
+        std::unordered_map<std::string, int> uniform_handles;   /// Handles of the uniforms by name.
+        std::unordered_map<std::string, int> sampler_handles;   /// Handles of the samplers by name.
+        int builtin_handles[NUM_BUILTINS];                      /// Handles of the builtin uniforms.
+        std::string vertex_filename;                            /// Vertex shader filename.
+        std::string fragment_filename;                          /// Fragment shader filename.
+        std::string cache_directory;                            /// Directory of the program cache, or empty for none.
+        std::string defines;                                    /// Defines added to both sources.
+        unsigned int pending_program = 0;                       /// Program being built by a reload, or 0.
+        unsigned int pending_shaders[2] = {0, 0};               /// Vertex and fragment shaders of the reload.
+        std::string pending_sources[2];                         /// Sources of the reload, for its cache key.
+        std::chrono::steady_clock::time_point pending_start;    /// When the reload started.
+        std::shared_ptr<CompileJob> pending_job;                /// Reload built by the shader compiler, or null.
+
+        static UniformStats stats;  /// Upload counters shared by all programs.
 
     };
 
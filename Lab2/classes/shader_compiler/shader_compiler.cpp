@@ -0,0 +1,200 @@
+/**
+ * @file shader_compiler.cpp
+ * @brief ShaderCompiler class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "shader_compiler.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "GL/glew.h"
+
+#include "structs/compile_job/compile_job.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		std::thread worker;
+		std::deque<std::shared_ptr<CompileJob>> jobs;
+		std::mutex mutex;
+		std::condition_variable job_available;
+		bool running = false;
+		bool stopping = false;
+
+		void deleteObjects(CompileJob &job) {
+
+			for (int i = 0; i < 2; i++) {
+
+				if (job.shaders[i] != 0)
+					glDeleteShader(job.shaders[i]);
+				job.shaders[i] = 0;
+
+			}
+
+			if (job.program != 0)
+				glDeleteProgram(job.program);
+			job.program = 0;
+
+		}
+
+		void build(CompileJob &job) {
+
+			job.program = glCreateProgram();
+			if (job.retrievable)
+				glProgramParameteri(job.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+			const GLenum types[2] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER};
+			for (int i = 0; i < 2; i++) {
+
+				const char* code = job.sources[i].c_str();
+				job.shaders[i] = glCreateShader(types[i]);
+				glShaderSource(job.shaders[i], 1, &code, NULL);
+				glCompileShader(job.shaders[i]);
+				glAttachShader(job.program, job.shaders[i]);
+
+			}
+
+			glLinkProgram(job.program);
+
+			// Asking for the status waits for the driver, which is what this thread is for.
+			GLint status = GL_FALSE;
+			glGetProgramiv(job.program, GL_LINK_STATUS, &status);
+
+			// The other context only sees the objects complete once this one is done with them.
+			glFinish();
+
+		}
+
+		void work(std::function<void()> make_current, std::function<void()> release_current) {
+
+			make_current();
+
+			while (true) {
+
+				std::shared_ptr<CompileJob> job;
+				{
+
+					std::unique_lock<std::mutex> lock(mutex);
+					job_available.wait(lock, []() { return stopping || !jobs.empty(); });
+					if (stopping)
+						break;
+
+					job = jobs.front();
+					jobs.pop_front();
+					if (job->cancelled)
+						continue;
+
+				}
+
+				build(*job);
+
+				// Nobody takes the objects of a job cancelled while it was built.
+				std::lock_guard<std::mutex> lock(mutex);
+				if (job->cancelled)
+					deleteObjects(*job);
+				else
+					job->done = true;
+
+			}
+
+			release_current();
+
+		}
+
+	}
+
+	void ShaderCompiler::cancel(CompileJob &job) {
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (job.done)
+			deleteObjects(job);
+		job.cancelled = true;
+
+	}
+
+	bool ShaderCompiler::isRunning() {
+
+		return running;
+
+	}
+
+	bool ShaderCompiler::poll(CompileJob &job) {
+
+		std::lock_guard<std::mutex> lock(mutex);
+		return job.done;
+
+	}
+
+	void ShaderCompiler::start(std::function<void()> make_current, std::function<void()> release_current) {
+
+		if (running)
+			return;
+
+		stopping = false;
+		running = true;
+		worker = std::thread(work, std::move(make_current), std::move(release_current));
+
+	}
+
+	void ShaderCompiler::stop() {
+
+		if (!running)
+			return;
+
+		{
+
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+
+		}
+
+		job_available.notify_all();
+		worker.join();
+		jobs.clear();
+		running = false;
+
+	}
+
+	std::shared_ptr<CompileJob> ShaderCompiler::submit(const std::string &vertex, const std::string &fragment, bool retrievable) {
+
+		std::shared_ptr<CompileJob> job = std::make_shared<CompileJob>();
+		job->sources[0] = vertex;
+		job->sources[1] = fragment;
+		job->retrievable = retrievable;
+		job->program = 0;
+		job->shaders[0] = 0;
+		job->shaders[1] = 0;
+		job->done = false;
+		job->cancelled = false;
+
+		{
+
+			std::lock_guard<std::mutex> lock(mutex);
+			jobs.push_back(job);
+
+		}
+
+		job_available.notify_one();
+
+		return job;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,109 @@
+/**
+ * @file shader_compiler.h
+ * @brief ShaderCompiler class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_SHADERCOMPILER_H_
+#define BGQ_OPENGL_CLASSES_SHADERCOMPILER_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "structs/compile_job/compile_job.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a ShaderCompiler class.
+	 *
+	 * Builds programs on a thread of its own, with a context that shares its
+	 * objects with the one of the main thread. It waits for the driver there,
+	 * so that drivers without parallel shader compilation never block a frame
+	 * to build a program.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ShaderCompiler {
+
+		public:
+
+			/**
+			 * @brief Cancels a job.
+			 *
+			 * Throws a job away. Its objects are deleted now if it is done, or by
+			 * the compiler once it is.
+			 *
+			 * @param job The job.
+			 */
+			static void cancel(CompileJob &job);
+
+			/**
+			 * @brief Whether the compiler is running.
+			 *
+			 * Whether the thread of the compiler was started.
+			 *
+			 * @returns True if it is running. False otherwise.
+			 */
+			static bool isRunning();
+
+			/**
+			 * @brief Checks a job.
+			 *
+			 * Checks whether a job is done, without waiting for it. Once it is,
+			 * its status and logs can be asked for without waiting for the driver.
+			 *
+			 * @param job The job.
+			 *
+			 * @returns True if it is done. False otherwise.
+			 */
+			static bool poll(CompileJob &job);
+
+			/**
+			 * @brief Starts the compiler.
+			 *
+			 * Starts the thread of the compiler. Its context has to share its
+			 * objects with the one of the main thread.
+			 *
+			 * @param make_current Makes the context of the compiler current on the calling thread.
+			 * @param release_current Releases it from the calling thread.
+			 */
+			static void start(std::function<void()> make_current, std::function<void()> release_current);
+
+			/**
+			 * @brief Stops the compiler.
+			 *
+			 * Waits for the job being built and joins the thread. The jobs not
+			 * started yet are never built.
+			 */
+			static void stop();
+
+			/**
+			 * @brief Submits a program.
+			 *
+			 * Queues a program to be compiled and linked on the thread of the
+			 * compiler.
+			 *
+			 * @param vertex The source of the vertex shader.
+			 * @param fragment The source of the fragment shader.
+			 * @param retrievable Whether the driver should keep the binary of the program.
+			 *
+			 * @returns The job, to check it with poll.
+			 */
+			static std::shared_ptr<CompileJob> submit(const std::string &vertex, const std::string &fragment, bool retrievable);
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_SHADERCOMPILER_H_
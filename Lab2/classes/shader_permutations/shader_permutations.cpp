@@ -0,0 +1,97 @@
+/**
+ * @file shader_permutations.cpp
+ * @brief ShaderPermutations class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "shader_permutations.h"
+
+#include <string>
+#include <unordered_map>
+
+#include "classes/shader/shader.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		// Names of the macros, in the same order as the bits of the features.
+		const char *FEATURE_NAMES[ShaderPermutations::NUM_FEATURES] = {"REFLECT", "REFRACT", "FRESNEL", "DISPERSION", "TINT", "INSTANCED"};
+
+	}
+
+	ShaderPermutations::ShaderPermutations(const char *vertex_filename, const char *fragment_filename, const char *cache_directory) : vertex_filename(vertex_filename), fragment_filename(fragment_filename) {
+
+		if (cache_directory != nullptr)
+			this->cache_directory = cache_directory;
+
+	}
+
+	Shader& ShaderPermutations::get(unsigned int features) {
+
+		auto it = this->permutations.find(features);
+		if (it != this->permutations.end())
+			return it->second;
+
+		// Build it the first time. The map never moves its elements, so the reference stays valid.
+		std::string defines = getDefines(features);
+		const char *cache_directory = this->cache_directory.empty() ? nullptr : this->cache_directory.c_str();
+		auto inserted = this->permutations.try_emplace(features, this->vertex_filename.c_str(), this->fragment_filename.c_str(), cache_directory, defines.c_str());
+
+		return inserted.first->second;
+
+	}
+
+	std::string ShaderPermutations::getDefines(unsigned int features) {
+
+		std::string defines;
+		for (int i = 0; i < NUM_FEATURES; i++)
+			if (features & (1u << i))
+				defines += std::string("#define ") + FEATURE_NAMES[i] + "\n";
+
+		return defines;
+
+	}
+
+	const std::string& ShaderPermutations::getFragmentFilename() const {
+
+		return this->fragment_filename;
+
+	}
+
+	int ShaderPermutations::getNumBuilt() const {
+
+		return (int) this->permutations.size();
+
+	}
+
+	const std::string& ShaderPermutations::getVertexFilename() const {
+
+		return this->vertex_filename;
+
+	}
+
+	void ShaderPermutations::pollReload() {
+
+		for (auto &permutation : this->permutations)
+			permutation.second.pollReload();
+
+	}
+
+	void ShaderPermutations::reload() {
+
+		for (auto &permutation : this->permutations)
+			permutation.second.reload();
+
+	}
+
+}  // namespace bgq_opengl
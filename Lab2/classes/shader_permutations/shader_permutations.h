@@ -0,0 +1,147 @@
+/**
+ * @file shader_permutations.h
+ * @brief ShaderPermutations class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_SHADERPERMUTATIONS_H_
+#define BGQ_OPENGL_CLASSES_SHADERPERMUTATIONS_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "classes/shader/shader.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a ShaderPermutations class.
+	 *
+	 * Builds the programs of a pair of shader files that have features which
+	 * are turned on by defines. Every combination of features is a separate
+	 * program, which is only built the first time it is asked for and then
+	 * kept, so only the variants that are drawn cost anything.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ShaderPermutations {
+
+		public:
+
+			/**
+			 * @brief Features of the environment shaders.
+			 *
+			 * Features of the environment shaders, as bits of a mask. Each one
+			 * defines the macro of the same name.
+			 */
+			enum Feature { REFLECT = 1 << 0, REFRACT = 1 << 1, FRESNEL = 1 << 2, DISPERSION = 1 << 3, TINT = 1 << 4, INSTANCED = 1 << 5 };
+
+			static const int NUM_FEATURES = 6;	/// Number of features.
+
+			/**
+			 * @brief Creates the permutations of a pair of shaders.
+			 *
+			 * Creates the permutations of a pair of shader files, without building
+			 * any of them yet.
+			 *
+			 * @param vertex_filename Vertex shader filename.
+			 * @param fragment_filename Fragment shader filename.
+			 * @param cache_directory Directory of the program cache, or nullptr to always build the programs.
+			 */
+			ShaderPermutations(const char *vertex_filename, const char *fragment_filename, const char *cache_directory = nullptr);
+
+			/**
+			 * @brief ShaderPermutations objects cannot be copied.
+			 *
+			 * ShaderPermutations objects own their programs, so they cannot be copied.
+			 */
+			ShaderPermutations(const ShaderPermutations&) = delete;
+			ShaderPermutations& operator=(const ShaderPermutations&) = delete;
+
+			/**
+			 * @brief Get a permutation.
+			 *
+			 * Get the program with the given features, building it if it is the
+			 * first time it is asked for. The reference stays valid as long as
+			 * this object does.
+			 *
+			 * @param features The mask of features.
+			 *
+			 * @returns The program.
+			 */
+			Shader& get(unsigned int features);
+
+			/**
+			 * @brief Get the defines of some features.
+			 *
+			 * Get the lines that define the macros of the features in a mask.
+			 *
+			 * @param features The mask of features.
+			 *
+			 * @returns The defines, one per line.
+			 */
+			static std::string getDefines(unsigned int features);
+
+			/**
+			 * @brief Get the name of the fragment shader file.
+			 *
+			 * Get the name of the fragment shader file, as it was given.
+			 *
+			 * @returns The name of the file.
+			 */
+			const std::string& getFragmentFilename() const;
+
+			/**
+			 * @brief Get the number of permutations built.
+			 *
+			 * Get how many permutations have been asked for so far.
+			 *
+			 * @returns The number of programs.
+			 */
+			int getNumBuilt() const;
+
+			/**
+			 * @brief Get the name of the vertex shader file.
+			 *
+			 * Get the name of the vertex shader file, as it was given.
+			 *
+			 * @returns The name of the file.
+			 */
+			const std::string& getVertexFilename() const;
+
+			/**
+			 * @brief Finish the reloads.
+			 *
+			 * Swaps in the programs of the permutations whose reload is done.
+			 */
+			void pollReload();
+
+			/**
+			 * @brief Reload the shader files.
+			 *
+			 * Starts building every permutation that was built so far again from
+			 * the files, without waiting for them.
+			 */
+			void reload();
+
+		private:
+
+			std::string vertex_filename;							/// Vertex shader filename.
+			std::string fragment_filename;							/// Fragment shader filename.
+			std::string cache_directory;							/// Directory of the program cache, or empty for none.
+			std::unordered_map<unsigned int, Shader> permutations;	/// The programs built so far, by their mask of features.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_SHADERPERMUTATIONS_H_
@@ -0,0 +1,163 @@
+/**
+ * @file shader_watcher.cpp
+ * @brief ShaderWatcher class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "shader_watcher.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace bgq_opengl {
+
+	namespace {
+
+		// How often the modification times are checked without inotify.
+		const std::chrono::milliseconds CHECK_INTERVAL(250);
+
+	}
+
+	ShaderWatcher::ShaderWatcher() {
+
+#ifdef __linux__
+		this->inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+
+		this->last_check = std::chrono::steady_clock::now();
+
+	}
+
+	ShaderWatcher::~ShaderWatcher() {
+
+		// Closing the descriptor removes all its watches.
+		if (this->inotify >= 0)
+			close(this->inotify);
+
+	}
+
+	bool ShaderWatcher::poll(std::vector<std::string> *changed) {
+
+		size_t before = changed->size();
+
+		// The files inotify could not watch are checked by their times.
+		this->pollTimes(changed);
+
+#ifdef __linux__
+		// The buffer is aligned for the events, which are read until there are none left.
+		alignas(struct inotify_event) char buffer[4096];
+		while (this->inotify >= 0) {
+
+			ssize_t length = read(this->inotify, buffer, sizeof(buffer));
+			if (length <= 0)
+				break;
+
+			for (ssize_t offset = 0; offset < length; ) {
+
+				const struct inotify_event *event = (const struct inotify_event*) (buffer + offset);
+				offset += sizeof(struct inotify_event) + event->len;
+
+				if (event->len == 0)
+					continue;
+
+				for (const WatchedFile &file : this->files)
+					if (file.descriptor == event->wd && file.name == event->name)
+						addChanged(file.filename, changed);
+
+			}
+
+		}
+#endif
+
+		return changed->size() > before;
+
+	}
+
+	void ShaderWatcher::watch(const std::string &filename) {
+
+		for (const WatchedFile &file : this->files)
+			if (file.filename == filename)
+				return;
+
+		// Split the name, since the directory is what is watched.
+		size_t slash = filename.find_last_of('/');
+		std::string directory = slash == std::string::npos ? "." : filename.substr(0, slash);
+		std::string name = slash == std::string::npos ? filename : filename.substr(slash + 1);
+
+		WatchedFile file = {filename, name, -1, 0, 0};
+
+		struct stat info;
+		if (stat(filename.c_str(), &info) == 0) {
+
+			file.modified = (long long) info.st_mtime;
+			file.size = (long long) info.st_size;
+
+		}
+
+#ifdef __linux__
+		// Editors often save by renaming a new file over the old one, which a watch on the file itself would lose.
+		if (this->inotify >= 0)
+			file.descriptor = inotify_add_watch(this->inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+#endif
+
+		this->files.push_back(file);
+
+	}
+
+	void ShaderWatcher::addChanged(const std::string &filename, std::vector<std::string> *changed) {
+
+		for (const std::string &other : *changed)
+			if (other == filename)
+				return;
+
+		changed->push_back(filename);
+
+	}
+
+	void ShaderWatcher::pollTimes(std::vector<std::string> *changed) {
+
+		auto now = std::chrono::steady_clock::now();
+		if (now - this->last_check < CHECK_INTERVAL)
+			return;
+		this->last_check = now;
+
+		for (WatchedFile &file : this->files) {
+
+			if (file.descriptor >= 0)
+				continue;
+
+			// Files that are being replaced may be missing for a moment, so they are checked again later.
+			struct stat info;
+			if (stat(file.filename.c_str(), &info) != 0)
+				continue;
+
+			if ((long long) info.st_mtime != file.modified || (long long) info.st_size != file.size) {
+
+				file.modified = (long long) info.st_mtime;
+				file.size = (long long) info.st_size;
+				addChanged(file.filename, changed);
+
+			}
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
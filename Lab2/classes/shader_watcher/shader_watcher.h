@@ -0,0 +1,130 @@
+/**
+ * @file shader_watcher.h
+ * @brief ShaderWatcher class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_SHADERWATCHER_H_
+#define BGQ_OPENGL_CLASSES_SHADERWATCHER_H_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a ShaderWatcher class.
+	 *
+	 * Watches the source files of the shaders and reports the ones that were
+	 * saved since the last time it was asked. On Linux it is told by inotify,
+	 * so asking costs a single read that does not block. Elsewhere it looks at
+	 * the modification time of every file, a few times per second at most.
+	 *
+	 * Nothing is allocated while nothing changes, so it can be asked every frame.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ShaderWatcher {
+
+		public:
+
+			/**
+			 * @brief Creates a ShaderWatcher.
+			 *
+			 * Creates a watcher with no files. If inotify cannot be used, the
+			 * files are checked by their modification time instead.
+			 */
+			ShaderWatcher();
+
+			/**
+			 * @brief ShaderWatcher objects cannot be copied.
+			 *
+			 * ShaderWatcher objects own their inotify descriptor, so they cannot be copied.
+			 */
+			ShaderWatcher(const ShaderWatcher&) = delete;
+			ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+
+			/**
+			 * @brief Destroys the ShaderWatcher.
+			 *
+			 * Stops watching and closes the inotify descriptor.
+			 */
+			~ShaderWatcher();
+
+			/**
+			 * @brief Get the changed files.
+			 *
+			 * Adds the files that were saved since the last call to the list, once
+			 * each. It never blocks.
+			 *
+			 * @param changed Outputs the changed files, as they were given to watch.
+			 *
+			 * @returns True if any file changed. False otherwise.
+			 */
+			bool poll(std::vector<std::string> *changed);
+
+			/**
+			 * @brief Watch a file.
+			 *
+			 * Starts watching a file. Watching the same file twice does nothing.
+			 *
+			 * @param filename The name of the file.
+			 */
+			void watch(const std::string &filename);
+
+		private:
+
+			/**
+			 * @brief A watched file.
+			 *
+			 * A watched file, with what is needed to tell when it changes.
+			 */
+			struct WatchedFile {
+
+				std::string filename;	/// The name of the file, as it was given.
+				std::string name;		/// The name of the file within its directory.
+				int descriptor;			/// The inotify watch of its directory, or -1.
+				long long modified;		/// The last modification time seen, in seconds.
+				long long size;			/// The last size seen, in bytes.
+
+			};
+
+			/**
+			 * @brief Add a file to the list once.
+			 *
+			 * Adds the file to the list unless it is in it already.
+			 *
+			 * @param filename The name of the file.
+			 * @param changed The list of changed files.
+			 */
+			static void addChanged(const std::string &filename, std::vector<std::string> *changed);
+
+			/**
+			 * @brief Check the modification times.
+			 *
+			 * Compares the modification time and size of every file that inotify
+			 * does not watch with the last ones seen.
+			 *
+			 * @param changed Outputs the changed files.
+			 */
+			void pollTimes(std::vector<std::string> *changed);
+
+			int inotify = -1;									/// The inotify descriptor, or -1 to check the times.
+			std::vector<WatchedFile> files;						/// The watched files.
+			std::chrono::steady_clock::time_point last_check;	/// The last time the times were checked.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_SHADERWATCHER_H_
@@ -15,6 +15,7 @@
 
 #include "skybox.h"
 
+#include <utility>
 #include <vector>
 #include <stdexcept>
 
@@ -23,15 +24,21 @@
 #include "glm/gtc/type_ptr.hpp"
 
 #include "classes/camera/camera.h"
+#include "classes/draw_counter/draw_counter.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_profiler/gpu_profiler.h"
 #include "classes/shader/shader.h"
 #include "classes/cubemap/cubemap.h"
+#include "classes/ebo/ebo.h"
+#include "classes/vao/vao.h"
+#include "classes/vbo/vbo.h"
 
 namespace bgq_opengl {
 
     Skybox::Skybox(Cubemap cubemap) {
         
-        // Store the cubemap.
-        this->cubemap = cubemap;
+        // Take the cubemap over.
+        this->cubemap = std::move(cubemap);
         
         float vertices[] = {
             -1.0f, -1.0f,  1.0f,
@@ -44,7 +51,7 @@ namespace bgq_opengl {
             -1.0f,  1.0f, -1.0f
         };
 
-        unsigned int indices[] = {
+        std::vector<GLuint> indices = {
             1, 2, 6,
             6, 5, 1,
             0, 4, 7,
@@ -59,34 +66,21 @@ namespace bgq_opengl {
             6, 2, 3
         };
         
-        // Create VAO, VBO, and EBO for the skybox.
-        glGenVertexArrays(1, &this->vao);
-        glGenBuffers(1, &this->vbo);
-        glGenBuffers(1, &this->ebo);
-        
-        // Bind them.
-        glBindVertexArray(this->vao);
-        
-        // Fill the VBo with the vertices.
-        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
-        
-        // Fill the indices into the EBO.
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), &indices, GL_STATIC_DRAW);
+        // Create VAO, VBO, and EBO for the skybox and fill them.
+        this->vao.bind();
+        this->vbo = VBO(vertices, sizeof(vertices));
+        this->ebo = EBO(indices);
         
         // Pass the data to the layout.
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        this->vao.link_attribute(this->vbo, 0, 3, GL_FLOAT, 3 * sizeof(float), (void*)0);
         
         // Unbind everything.
-        glEnableVertexAttribArray(0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        this->vao.unbind();
+        this->ebo.unbind();
 
     }
 
-    Cubemap Skybox::getCubemap() {
+    Cubemap& Skybox::getCubemap() {
         
         return this->cubemap;
         
@@ -94,14 +88,17 @@ namespace bgq_opengl {
 
     void Skybox::setCubemap(Cubemap cubemap) {
         
-        this->cubemap = cubemap;
+        this->cubemap = std::move(cubemap);
         
     }
 
     void Skybox::draw(Shader &shader, Camera &camera) {
         
+        // Measure the pass on the GPU.
+        GpuZone gpu_zone("skybox");
+        
         // We do this so that OpenGL does not discard the object.
-        glDepthFunc(GL_LEQUAL);
+        GlState::setDepthFunc(GL_LEQUAL);
 
         // Activate the shader.
         shader.activate();
@@ -111,19 +108,20 @@ namespace bgq_opengl {
         glm::mat4 projection = camera.getProjection();
 
         // Pass these matrices to the shaders.
-        glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "View"), 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "Projection"), 1, GL_FALSE, glm::value_ptr(projection));
+        shader.passMat(shader.getUniform(Shader::VIEW), view);
+        shader.passMat(shader.getUniform(Shader::PROJECTION), projection);
 
         // Draws the cubemap as the last object so we can save a bit of performance by discarding all fragments
         // where an object is present (a depth of 1.0f will always fail against any object's depth value)
-        glBindVertexArray(this->vao);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.getID());
+        this->vao.bind();
+        if (GlState::bindTexture(0, GL_TEXTURE_CUBE_MAP, cubemap.getID()))
+            DrawCounter::recordTextureBind();
         glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        DrawCounter::recordDraw(1);
+        this->vao.unbind();
 
         // Switch back to the normal depth function
-        glDepthFunc(GL_LESS);
+        GlState::setDepthFunc(GL_LESS);
 
 	}
 
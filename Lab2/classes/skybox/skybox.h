@@ -47,7 +47,8 @@ namespace bgq_opengl {
 			/**
 			 * @brief Initializes the Skybox.
 			 * 
-			 * Initializes the geometry and stores it.
+			 * Initializes the geometry and stores it. The cubemap is moved into the
+			 * skybox.
 			 *
 			 * @param cubemap Textures in connection with this geometry.
 			 */
@@ -58,9 +59,9 @@ namespace bgq_opengl {
 			 *
 			 * Get the textures.
              *
-             * @returns The cubemap.
+             * @returns A reference to the cubemap.
 			 */
-			Cubemap getCubemap();
+			Cubemap& getCubemap();
         
             /**
              * @brief Get the textures.
@@ -81,7 +82,9 @@ namespace bgq_opengl {
 		private:
 
             Cubemap cubemap = Cubemap(0, "", 0);    /// The cubemap texture that will color this skybox.
-            unsigned int vao, vbo, ebo;             /// The IDs of the buffers of OpenGL.
+            VAO vao;                                /// VAO of the cube.
+            VBO vbo;                                /// VBO holding the vertices of the cube.
+            EBO ebo;                                /// EBO holding the indices of the cube.
 
 	};
 
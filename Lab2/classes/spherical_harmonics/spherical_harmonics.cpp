@@ -0,0 +1,355 @@
+/**
+ * @file spherical_harmonics.cpp
+ * @brief SphericalHarmonics class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "spherical_harmonics.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "classes/texture_file/texture_file.h"
+#include "classes/thread_pool/thread_pool.h"
+#include "structs/image_data/image_data.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BGQ_SH_AVX2
+#include <immintrin.h>
+#endif
+
+namespace bgq_opengl {
+
+	namespace {
+
+		const float PI = 3.14159265358979f;
+		const int ROWS_PER_JOB = 16;
+		const char MAGIC[8] = "BGQSH";
+		const uint32_t VERSION = 1;
+
+		// Running sums of every harmonic times every channel, and then the total weight.
+		const int NUM_SUMS = SphericalHarmonics::NUM_COEFFICIENTS * 3 + 1;
+		typedef std::array<double, NUM_SUMS> Sums;
+
+		// The constants of the harmonics, whose polynomials are 1, y, z, x, xy, yz, 3z² - 1, xz and x² - y².
+		const float BASIS[SphericalHarmonics::NUM_COEFFICIENTS] = {0.282095f, 0.488603f, 0.488603f, 0.488603f, 1.092548f, 1.092548f, 0.315392f, 1.092548f, 0.546274f};
+
+		// How much of every band goes through the cosine of a diffuse surface, divided by pi.
+		const float BAND_SCALE[SphericalHarmonics::NUM_COEFFICIENTS] = {1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f};
+
+		// Every face maps its texel coordinates to a direction as the first vector plus sc and tc times the other two.
+		const glm::vec3 FACE_AXES[6][3] = {
+			{glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, -1.0f, 0.0f)},
+			{glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, -1.0f, 0.0f)},
+			{glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f)},
+			{glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f)},
+			{glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)},
+			{glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)}
+		};
+
+		// The cache file, as it is stored.
+		struct CacheFile {
+
+			char magic[8];
+			uint32_t version;
+			uint32_t size;
+			IrradianceBlock irradiance;
+
+		};
+
+		typedef void (*RowSum)(const float *red, const float *green, const float *blue, int size, const glm::vec3 &origin, const glm::vec3 &step, float *sums);
+
+		void getBasis(const glm::vec3 &d, float basis[SphericalHarmonics::NUM_COEFFICIENTS]) {
+
+			basis[0] = 1.0f;
+			basis[1] = d.y;
+			basis[2] = d.z;
+			basis[3] = d.x;
+			basis[4] = d.x * d.y;
+			basis[5] = d.y * d.z;
+			basis[6] = 3.0f * d.z * d.z - 1.0f;
+			basis[7] = d.x * d.z;
+			basis[8] = d.x * d.x - d.y * d.y;
+
+		}
+
+		void addTexel(const glm::vec3 &position, float red, float green, float blue, float *sums) {
+
+			// The texel is on the face of a cube of side 2, so it covers less of the sphere the further it is from the centre.
+			float inverse = 1.0f / std::sqrt(glm::dot(position, position));
+			float weight = inverse * inverse * inverse;
+
+			float basis[SphericalHarmonics::NUM_COEFFICIENTS];
+			getBasis(position * inverse, basis);
+			for (int i = 0; i < SphericalHarmonics::NUM_COEFFICIENTS; i++) {
+
+				sums[i * 3] += basis[i] * weight * red;
+				sums[i * 3 + 1] += basis[i] * weight * green;
+				sums[i * 3 + 2] += basis[i] * weight * blue;
+
+			}
+			sums[NUM_SUMS - 1] += weight;
+
+		}
+
+		void sumRowScalar(const float *red, const float *green, const float *blue, int size, const glm::vec3 &origin, const glm::vec3 &step, float *sums) {
+
+			for (int x = 0; x < size; x++)
+				addTexel(origin + step * (float) x, red[x], green[x], blue[x], sums);
+
+		}
+
+#ifdef BGQ_SH_AVX2
+
+		__attribute__((target("avx2"))) void sumRowAvx2(const float *red, const float *green, const float *blue, int size, const glm::vec3 &origin, const glm::vec3 &step, float *sums) {
+
+			// The same sums, on 8 texels of the row at once.
+			__m256 accumulators[NUM_SUMS];
+			for (int i = 0; i < NUM_SUMS; i++)
+				accumulators[i] = _mm256_setzero_ps();
+
+			__m256 lanes = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+			__m256 one = _mm256_set1_ps(1.0f);
+			int x = 0;
+			for (; x + 8 <= size; x += 8) {
+
+				__m256 index = _mm256_add_ps(_mm256_set1_ps((float) x), lanes);
+				__m256 px = _mm256_add_ps(_mm256_set1_ps(origin.x), _mm256_mul_ps(index, _mm256_set1_ps(step.x)));
+				__m256 py = _mm256_add_ps(_mm256_set1_ps(origin.y), _mm256_mul_ps(index, _mm256_set1_ps(step.y)));
+				__m256 pz = _mm256_add_ps(_mm256_set1_ps(origin.z), _mm256_mul_ps(index, _mm256_set1_ps(step.z)));
+
+				__m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, px), _mm256_mul_ps(py, py)), _mm256_mul_ps(pz, pz)));
+				__m256 inverse = _mm256_div_ps(one, length);
+				__m256 weight = _mm256_mul_ps(_mm256_mul_ps(inverse, inverse), inverse);
+				__m256 dx = _mm256_mul_ps(px, inverse), dy = _mm256_mul_ps(py, inverse), dz = _mm256_mul_ps(pz, inverse);
+
+				__m256 basis[SphericalHarmonics::NUM_COEFFICIENTS] = {
+					one, dy, dz, dx, _mm256_mul_ps(dx, dy), _mm256_mul_ps(dy, dz),
+					_mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(dz, dz)), one),
+					_mm256_mul_ps(dx, dz), _mm256_sub_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy))
+				};
+
+				__m256 weighted[3] = {
+					_mm256_mul_ps(weight, _mm256_loadu_ps(red + x)),
+					_mm256_mul_ps(weight, _mm256_loadu_ps(green + x)),
+					_mm256_mul_ps(weight, _mm256_loadu_ps(blue + x))
+				};
+
+				for (int i = 0; i < SphericalHarmonics::NUM_COEFFICIENTS; i++)
+					for (int c = 0; c < 3; c++)
+						accumulators[i * 3 + c] = _mm256_add_ps(accumulators[i * 3 + c], _mm256_mul_ps(basis[i], weighted[c]));
+				accumulators[NUM_SUMS - 1] = _mm256_add_ps(accumulators[NUM_SUMS - 1], weight);
+
+			}
+
+			alignas(32) float lanes_sum[8];
+			for (int i = 0; i < NUM_SUMS; i++) {
+
+				_mm256_store_ps(lanes_sum, accumulators[i]);
+				for (int lane = 0; lane < 8; lane++)
+					sums[i] += lanes_sum[lane];
+
+			}
+
+			// The texels left over, one by one.
+			for (; x < size; x++)
+				addTexel(origin + step * (float) x, red[x], green[x], blue[x], sums);
+
+		}
+
+#endif  // BGQ_SH_AVX2
+
+		RowSum getRowSum(bool simd) {
+
+#ifdef BGQ_SH_AVX2
+			if (simd && __builtin_cpu_supports("avx2"))
+				return sumRowAvx2;
+#endif  // BGQ_SH_AVX2
+
+			return sumRowScalar;
+
+		}
+
+		RowSum row_sum = getRowSum(true);
+
+		void sumRows(const ImageData &image, int face, int first_row, Sums *sums) {
+
+			int size = image.width;
+			std::vector<float> red(size), green(size), blue(size);
+			const glm::vec3 *axes = FACE_AXES[face];
+			glm::vec3 step = axes[1] * (2.0f / size);
+			for (int y = first_row; y < std::min(first_row + ROWS_PER_JOB, size); y++) {
+
+				// Grey images only have one channel for the three.
+				const unsigned char *row = image.pixels.get() + (size_t) y * size * image.channels;
+				for (int x = 0; x < size; x++) {
+
+					const unsigned char *texel = row + (size_t) x * image.channels;
+					red[x] = texel[0] / 255.0f;
+					green[x] = texel[image.channels < 3 ? 0 : 1] / 255.0f;
+					blue[x] = texel[image.channels < 3 ? 0 : 2] / 255.0f;
+
+				}
+
+				// Rows are summed in single precision, and then added up in double precision.
+				float tc = 2.0f * (y + 0.5f) / size - 1.0f;
+				glm::vec3 origin = axes[0] + axes[2] * tc + axes[1] * (1.0f / size - 1.0f);
+				float row_sums[NUM_SUMS] = {};
+				row_sum(red.data(), green.data(), blue.data(), size, origin, step, row_sums);
+				for (int i = 0; i < NUM_SUMS; i++)
+					(*sums)[i] += row_sums[i];
+
+			}
+
+		}
+
+	}
+
+	glm::vec3 SphericalHarmonics::evaluate(const IrradianceBlock &irradiance, const glm::vec3 &direction) {
+
+		float basis[NUM_COEFFICIENTS];
+		getBasis(direction, basis);
+
+		glm::vec3 color(0.0f);
+		for (int i = 0; i < NUM_COEFFICIENTS; i++)
+			color += glm::vec3(irradiance.coefficients[i]) * basis[i];
+
+		return glm::max(color, glm::vec3(0.0f));
+
+	}
+
+	std::string SphericalHarmonics::getCacheFilename(const std::string &first_face) {
+
+		return TextureFile::getBakedFilename(first_face, ".sh");
+
+	}
+
+	IrradianceBlock SphericalHarmonics::getFlat() {
+
+		IrradianceBlock irradiance = {};
+		irradiance.coefficients[0] = glm::vec4(1.0f);
+
+		return irradiance;
+
+	}
+
+	bool SphericalHarmonics::isSimdSupported() {
+
+		return row_sum != sumRowScalar;
+
+	}
+
+	bool SphericalHarmonics::load(const std::string &filename, int size, IrradianceBlock *irradiance) {
+
+		std::ifstream file(filename, std::ios::binary);
+		if (!file)
+			return false;
+
+		CacheFile cache;
+		file.read((char*) &cache, sizeof(CacheFile));
+		if (!file || memcmp(cache.magic, MAGIC, sizeof(MAGIC)) != 0 || cache.version != VERSION || cache.size != (uint32_t) size)
+			return false;
+
+		*irradiance = cache.irradiance;
+
+		return true;
+
+	}
+
+	bool SphericalHarmonics::project(std::span<const ImageData> faces, unsigned int num_threads, IrradianceBlock *irradiance) {
+
+		if (faces.size() != 6)
+			return false;
+
+		int size = faces[0].width;
+		for (const ImageData &face : faces)
+			if (face.width != size || face.height != size || !face.pixels || size == 0)
+				return false;
+
+		// Every face is split in bands of rows, each with its own sums, so that the result does not depend on the threads.
+		int bands = (size + ROWS_PER_JOB - 1) / ROWS_PER_JOB;
+		std::vector<Sums> sums(6 * bands, Sums{});
+		{
+			ThreadPool pool(num_threads);
+			for (int face = 0; face < 6; face++)
+				for (int band = 0; band < bands; band++)
+					pool.submit([&, face, band] { sumRows(faces[face], face, band * ROWS_PER_JOB, &sums[face * bands + band]); });
+			pool.wait();
+		}
+
+		Sums total = {};
+		for (const Sums &band_sums : sums)
+			for (int i = 0; i < NUM_SUMS; i++)
+				total[i] += band_sums[i];
+
+		// The weights only add up to the whole sphere approximately, so they are normalized to it.
+		double scale = 4.0 * PI / total[NUM_SUMS - 1];
+		for (int i = 0; i < NUM_COEFFICIENTS; i++) {
+
+			// Project, convolve and fold in the constant of the harmonic again, which the shaders leave out.
+			float factor = (float) (scale * BASIS[i] * BASIS[i] * BAND_SCALE[i]);
+			(*irradiance).coefficients[i] = glm::vec4(total[i * 3] * factor, total[i * 3 + 1] * factor, total[i * 3 + 2] * factor, 0.0f);
+
+		}
+
+		return true;
+
+	}
+
+	bool SphericalHarmonics::save(const std::string &filename, int size, const IrradianceBlock &irradiance) {
+
+		CacheFile cache{};
+		memcpy(cache.magic, MAGIC, sizeof(MAGIC));
+		cache.version = VERSION;
+		cache.size = (uint32_t) size;
+		cache.irradiance = irradiance;
+
+		// Write it aside and move it in place, so that a reader never finds half a file.
+		std::string temporary_filename = filename + ".tmp";
+		std::ofstream file(temporary_filename, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return false;
+
+		file.write((const char*) &cache, sizeof(CacheFile));
+		file.close();
+		std::error_code error;
+		if (!file) {
+
+			std::filesystem::remove(temporary_filename, error);
+			return false;
+
+		}
+
+		std::filesystem::rename(temporary_filename, filename, error);
+
+		return !error;
+
+	}
+
+	void SphericalHarmonics::setSimd(bool enabled) {
+
+		row_sum = getRowSum(enabled);
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,150 @@
+/**
+ * @file spherical_harmonics.h
+ * @brief SphericalHarmonics class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_SPHERICALHARMONICS_H_
+#define BGQ_OPENGL_CLASSES_SPHERICALHARMONICS_H_
+
+#include <span>
+#include <string>
+
+#include "glm/glm.hpp"
+
+#include "structs/image_data/image_data.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a SphericalHarmonics class.
+	 *
+	 * Projects an environment onto the first 9 spherical harmonics and turns
+	 * them into the diffuse light it casts, so that the shaders get the
+	 * irradiance in any direction with a few multiply-adds instead of many
+	 * fetches of the cubemap.
+	 *
+	 * Every texel of the faces is weighted by the solid angle it covers. The
+	 * rows are spread over a thread pool, and they are summed 8 texels at a
+	 * time with AVX2 when the CPU has it. The 9 coefficients are stored in a
+	 * small file next to the faces, so that baked cubemaps do not have to
+	 * decode them again.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class SphericalHarmonics {
+
+		public:
+
+			static const int NUM_COEFFICIENTS = 9;	/// Harmonics up to the second band.
+
+			/**
+			 * @brief Gets the irradiance in a direction.
+			 *
+			 * Evaluates the coefficients in a direction, like the shaders do.
+			 *
+			 * @param irradiance The coefficients.
+			 * @param direction The normalized direction, in the space the cubemap is sampled in.
+			 *
+			 * @returns The diffuse light in that direction, from 0 to 1.
+			 */
+			static glm::vec3 evaluate(const IrradianceBlock &irradiance, const glm::vec3 &direction);
+
+			/**
+			 * @brief Gets the cache file of a cubemap.
+			 *
+			 * Gets the name of the file that stores the coefficients of a cubemap,
+			 * which sits next to its first face.
+			 *
+			 * @param first_face The name of the first face.
+			 *
+			 * @returns The name of the cache file.
+			 */
+			static std::string getCacheFilename(const std::string &first_face);
+
+			/**
+			 * @brief Gets an even white light.
+			 *
+			 * Gets the coefficients of a white light that is the same in every
+			 * direction, which leaves the colours it lights as they are.
+			 *
+			 * @returns The coefficients.
+			 */
+			static IrradianceBlock getFlat();
+
+			/**
+			 * @brief Whether AVX2 is used.
+			 *
+			 * Whether the CPU supports AVX2 and the projection uses it.
+			 *
+			 * @returns True if AVX2 is used. False otherwise.
+			 */
+			static bool isSimdSupported();
+
+			/**
+			 * @brief Loads the coefficients of a cubemap.
+			 *
+			 * Reads the coefficients from a cache file, if it was projected from
+			 * faces of the given size.
+			 *
+			 * @param filename The name of the cache file.
+			 * @param size The size of the faces.
+			 * @param irradiance Outputs the coefficients.
+			 *
+			 * @returns True if the cache could be used. False otherwise.
+			 */
+			static bool load(const std::string &filename, int size, IrradianceBlock *irradiance);
+
+			/**
+			 * @brief Projects a cubemap.
+			 *
+			 * Projects the decoded faces onto the harmonics and convolves them with
+			 * the cosine of a diffuse surface. It does not touch OpenGL, so it can
+			 * be called from a worker thread.
+			 *
+			 * @param faces The decoded faces in the +X, -X, +Y, -Y, +Z, -Z order, all square and the same size.
+			 * @param num_threads The number of threads, or 0 for one per core.
+			 * @param irradiance Outputs the coefficients.
+			 *
+			 * @returns True if the faces could be projected. False otherwise.
+			 */
+			static bool project(std::span<const ImageData> faces, unsigned int num_threads, IrradianceBlock *irradiance);
+
+			/**
+			 * @brief Stores the coefficients of a cubemap.
+			 *
+			 * Writes the coefficients to a cache file.
+			 *
+			 * @param filename The name of the cache file.
+			 * @param size The size of the faces they were projected from.
+			 * @param irradiance The coefficients.
+			 *
+			 * @returns True if the file was written. False otherwise.
+			 */
+			static bool save(const std::string &filename, int size, const IrradianceBlock &irradiance);
+
+			/**
+			 * @brief Turns AVX2 on or off.
+			 *
+			 * Makes the projection use AVX2, when the CPU has it, or plain code, so
+			 * that both can be compared.
+			 *
+			 * @param enabled Whether to use AVX2.
+			 */
+			static void setSimd(bool enabled);
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_SPHERICALHARMONICS_H_
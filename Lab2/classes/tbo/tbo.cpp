@@ -0,0 +1,103 @@
+/**
+ * @file tbo.cpp
+ * @brief TBO class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "tbo.h"
+
+#include "GL/glew.h"
+
+#include "classes/gl_state/gl_state.h"
+
+namespace bgq_opengl {
+
+	TBO::TBO(GLsizeiptr size, GLenum format) {
+
+		// Generate the buffer and allocate it.
+		glGenBuffers(1, &this->ID);
+		GlState::bindBuffer(GL_TEXTURE_BUFFER, this->ID);
+		glBufferData(GL_TEXTURE_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+		GlState::bindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		// Generate the texture that reads it, on the first unit while it is set up.
+		glGenTextures(1, &this->texture);
+		GlState::bindTexture(0, GL_TEXTURE_BUFFER, this->texture);
+		glTexBuffer(GL_TEXTURE_BUFFER, format, this->ID);
+		GlState::bindTexture(0, GL_TEXTURE_BUFFER, 0);
+
+	}
+
+	TBO::TBO(TBO&& other) noexcept : ID(other.ID), texture(other.texture) {
+
+		// Leave the other one empty so it does not delete the objects.
+		other.ID = 0;
+		other.texture = 0;
+
+	}
+
+	TBO& TBO::operator=(TBO&& other) noexcept {
+
+		if (this != &other) {
+
+			// Release the current object before taking the other one.
+			this->remove();
+
+			this->ID = other.ID;
+			this->texture = other.texture;
+			other.ID = 0;
+			other.texture = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	TBO::~TBO() {
+
+		this->remove();
+
+	}
+
+	void TBO::bind(GLuint unit) {
+
+		// Bind the texture to its unit, unless it already is.
+		GlState::bindTexture(unit, GL_TEXTURE_BUFFER, this->texture);
+
+	}
+
+	void TBO::remove() {
+
+		// Delete the texture and the buffer in OpenGL, if there are any.
+		if (this->texture != 0)
+			GlState::deleteTexture(this->texture);
+		if (this->ID != 0)
+			GlState::deleteBuffer(this->ID);
+		this->texture = 0;
+		this->ID = 0;
+
+	}
+
+	void TBO::update(const void* data, GLsizeiptr size) {
+
+		// Nothing to upload.
+		if (size == 0)
+			return;
+
+		GlState::bindBuffer(GL_TEXTURE_BUFFER, this->ID);
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+		GlState::bindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,118 @@
+/**
+ * @file tbo.h
+ * @brief TBO class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASS_TBO_H_
+#define BGQ_OPENGL_CLASS_TBO_H_
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a TBO class.
+	 *
+	 * Implementation of a Texture Buffer Object class, a buffer that the shaders
+	 * read as a one dimensional texture with texelFetch. It allows arrays larger
+	 * than a uniform block in OpenGL 3.3.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class TBO {
+
+	public:
+
+		/**
+		 * @brief Constructs a Texture Buffer Object.
+		 *
+		 * Constructs a Texture Buffer Object of the given size. The storage is
+		 * allocated once and then updated in place.
+		 *
+		 * @param size The size of the buffer in bytes.
+		 * @param format The internal format of the texels, like GL_RGBA32F.
+		 */
+		TBO(GLsizeiptr size, GLenum format);
+
+		/**
+		 * @brief TBO objects cannot be copied.
+		 *
+		 * TBO objects own their buffer and texture, so they cannot be copied.
+		 */
+		TBO(const TBO&) = delete;
+		TBO& operator=(const TBO&) = delete;
+
+		/**
+		 * @brief Moves a TBO.
+		 *
+		 * Takes the buffer and texture from another TBO, which is left empty.
+		 *
+		 * @param other The TBO to move from.
+		 */
+		TBO(TBO&& other) noexcept;
+
+		/**
+		 * @brief Moves a TBO.
+		 *
+		 * Removes the current buffer and texture and takes the one of another TBO, which
+		 * is left empty.
+		 *
+		 * @param other The TBO to move from.
+		 *
+		 * @returns This TBO.
+		 */
+		TBO& operator=(TBO&& other) noexcept;
+
+		/**
+		 * @brief Destroys the TBO.
+		 *
+		 * Removes the buffer and texture from OpenGL.
+		 */
+		~TBO();
+
+		/**
+		 * @brief Binds the TBO.
+		 *
+		 * Binds the texture of the TBO to the given texture unit.
+		 *
+		 * @param unit The texture unit.
+		 */
+		void bind(GLuint unit);
+
+		/**
+		 * @brief Removes the TBO.
+		 *
+		 * Removes the buffer and the texture from OpenGL.
+		 */
+		void remove();
+
+		/**
+		 * @brief Updates the contents of the TBO.
+		 *
+		 * Replaces the beginning of the buffer with new data.
+		 *
+		 * @param data The new contents.
+		 * @param size The size of the new contents in bytes.
+		 */
+		void update(const void* data, GLsizeiptr size);
+
+	private:
+
+		GLuint ID = 0;			/// GL ID of the buffer.
+		GLuint texture = 0;		/// GL ID of the texture that reads the buffer.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_CLASS_TBO_H_
@@ -19,9 +19,20 @@
 
 #include <assert.h>
 
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+
 #include "GL/glew.h"
 #include "stb/stb_image.h"
 
+#include "classes/draw_counter/draw_counter.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/texture_file/texture_file.h"
+#include "structs/image_data/image_data.h"
+
 namespace bgq_opengl {
 
 	Texture::Texture(const char* image, const char* name, GLuint slot) {
@@ -31,17 +42,8 @@ namespace bgq_opengl {
 		this->name = std::string(name);
 		this->slot = slot;
 
-		// This function has to be used because OpenGL loads texture the opposite way
-		// than this library, so images appear upside down.
-		stbi_set_flip_vertically_on_load(true);
-
-		// Read the texture image and its information.
-		unsigned char* image_bytes = stbi_load(image, &this->texture_width,
-				&this->texture_height, &this->texture_channels, 0);
-
 		// Set the slot for the texture.
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_2D, this->ID);
+		GlState::bindTexture(slot, GL_TEXTURE_2D, this->ID);
 
 		// Configure the magnifying algorithm, minifying algorithm and repetition.
 		// This tells OpenGL how to apply intrpolation.
@@ -50,6 +52,24 @@ namespace bgq_opengl {
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
+		// Use the baked file if there is one this context can use.
+		TextureFile baked(TextureFile::getBakedFilename(image, ".texture"));
+		if (baked.isOpen() && baked.isSupported() && baked.getNumFaces() == 1) {
+
+			this->upload(baked);
+			GlState::bindTexture(slot, GL_TEXTURE_2D, 0);
+			return;
+
+		}
+
+		// This function has to be used because OpenGL loads texture the opposite way
+		// than this library, so images appear upside down.
+		stbi_set_flip_vertically_on_load(true);
+
+		// Read the texture image and its information.
+		unsigned char* image_bytes = stbi_load(image, &this->texture_width,
+				&this->texture_height, &this->texture_channels, 0);
+
 		// Get the color model for the image.
 		GLenum color_model = GL_RGBA;
 
@@ -71,7 +91,41 @@ namespace bgq_opengl {
 		stbi_image_free(image_bytes);
 
 		// Unbinds the OpenGL Texture.
-		glBindTexture(GL_TEXTURE_2D, 0);
+		GlState::bindTexture(slot, GL_TEXTURE_2D, 0);
+
+	}
+
+	Texture::Texture(Texture&& other) noexcept : ID(other.ID), slot(other.slot), texture_width(other.texture_width), texture_height(other.texture_height), texture_channels(other.texture_channels), name(std::move(other.name)) {
+
+		// Leave the other one empty so it does not delete the object.
+		other.ID = 0;
+
+	}
+
+	Texture& Texture::operator=(Texture&& other) noexcept {
+
+		if (this != &other) {
+
+			// Release the current object before taking the other one.
+			this->remove();
+
+			this->ID = other.ID;
+			this->slot = other.slot;
+			this->texture_width = other.texture_width;
+			this->texture_height = other.texture_height;
+			this->texture_channels = other.texture_channels;
+			this->name = std::move(other.name);
+			other.ID = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	Texture::~Texture() {
+
+		this->remove();
 
 	}
 
@@ -105,7 +159,7 @@ namespace bgq_opengl {
 
 	}
 
-	std::string Texture::getName() {
+	const std::string& Texture::getName() {
 
 		return this->name;
 
@@ -113,21 +167,63 @@ namespace bgq_opengl {
 
 	void Texture::bind() {
 
-		// Activate the texture and bind it.
-		glActiveTexture(GL_TEXTURE0 + this->slot);
-		glBindTexture(GL_TEXTURE_2D, this->ID);
+		// Activate the texture and bind it, unless it already is.
+		if (GlState::bindTexture(this->slot, GL_TEXTURE_2D, this->ID))
+			DrawCounter::recordTextureBind();
 
 	}
 
 	void Texture::remove() {
 
-		glDeleteTextures(1, &this->ID);
+		// Delete the texture in OpenGL, if there is one.
+		if (this->ID != 0)
+			GlState::deleteTexture(this->ID);
+		this->ID = 0;
 
 	}
 
 	void Texture::unbind() {
 
-		glBindTexture(GL_TEXTURE_2D, 0);
+		// Unbind it from its slot.
+		if (GlState::bindTexture(this->slot, GL_TEXTURE_2D, 0))
+			DrawCounter::recordTextureBind();
+
+	}
+
+	bool Texture::loadImage(const std::string &filename, ImageData *image) {
+
+		// Textures are flipped, like the ones the constructor loads.
+		stbi_set_flip_vertically_on_load_thread(true);
+
+		unsigned char *data = stbi_load(filename.c_str(), &image->width, &image->height, &image->channels, 0);
+		if (!data)
+			return false;
+
+		// The pixels are freed by stb when the last copy of the image is gone.
+		image->pixels = std::shared_ptr<unsigned char>(data, stbi_image_free);
+
+		return true;
+
+	}
+
+	void Texture::upload(const TextureFile &file) {
+
+		// Every level is handed over straight from the mapping.
+		for (int level = 0; level < file.getNumLevels(); level++) {
+
+			std::span<const std::byte> pixels = file.getFace(level, 0);
+			if (file.isCompressed())
+				glCompressedTexImage2D(GL_TEXTURE_2D, level, file.getInternalFormat(), file.getWidth(level), file.getHeight(level), 0, (GLsizei) pixels.size(), pixels.data());
+			else
+				glTexImage2D(GL_TEXTURE_2D, level, file.getInternalFormat(), file.getWidth(level), file.getHeight(level), 0, file.getFormat(), file.getType(), pixels.data());
+
+		}
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, file.getNumLevels() - 1);
+
+		this->texture_width = file.getWidth(0);
+		this->texture_height = file.getHeight(0);
+		this->texture_channels = 4;
 
 	}
 
@@ -20,6 +20,9 @@
 
 #include "GL/glew.h"
 
+#include "classes/texture_file/texture_file.h"
+#include "structs/image_data/image_data.h"
+
 namespace bgq_opengl {
 
 	/**
@@ -37,7 +40,9 @@ namespace bgq_opengl {
 			/**
 			 * @brief Creates a texture from an image.
 			 * 
-			 * Creates a textures and passes it to OpenGL.
+			 * Creates a textures and passes it to OpenGL. If the image has a baked
+			 * .texture file next to it, in a format the context supports, that is
+			 * loaded instead.
 			 * 
 			 * @param image Image containing the texture.
 			 * @param type Texture type.
@@ -45,6 +50,42 @@ namespace bgq_opengl {
 			 */
 			Texture(const char* image, const char* type, GLuint slot);
 
+			/**
+			 * @brief Texture objects cannot be copied.
+			 *
+			 * Texture objects own their texture, so they cannot be copied.
+			 */
+			Texture(const Texture&) = delete;
+			Texture& operator=(const Texture&) = delete;
+
+			/**
+			 * @brief Moves a Texture.
+			 *
+			 * Takes the texture from another Texture, which is left empty.
+			 *
+			 * @param other The Texture to move from.
+			 */
+			Texture(Texture&& other) noexcept;
+
+			/**
+			 * @brief Moves a Texture.
+			 *
+			 * Removes the current texture and takes the one of another Texture, which
+			 * is left empty.
+			 *
+			 * @param other The Texture to move from.
+			 *
+			 * @returns This Texture.
+			 */
+			Texture& operator=(Texture&& other) noexcept;
+
+			/**
+			 * @brief Destroys the Texture.
+			 *
+			 * Removes the texture from OpenGL.
+			 */
+			~Texture();
+
 			/**
 			 * @brief Get the ID of the texture.
 			 * 
@@ -97,7 +138,7 @@ namespace bgq_opengl {
 			 * 
 			 * @returns A char string containing the name name of the texture.
 			 */
-			std::string getName();
+			const std::string& getName();
 
 			/**
 			 * @brief Binds the texture.
@@ -120,9 +161,31 @@ namespace bgq_opengl {
 			 */
 			void unbind();
 
+			/**
+			 * @brief Decodes an image.
+			 *
+			 * Decodes an image flipped, the way textures are loaded. It does not
+			 * touch OpenGL, so it can be called from any thread.
+			 *
+			 * @param filename The name of the image file.
+			 * @param image Outputs the decoded image.
+			 *
+			 * @returns True if the image could be decoded. False otherwise.
+			 */
+			static bool loadImage(const std::string &filename, ImageData *image);
+
 		private:
 
-			GLuint ID;					/// Texture OpenGL ID.
+			/**
+			 * @brief Uploads a baked file.
+			 *
+			 * Uploads all the mip levels of a baked texture to the bound texture.
+			 *
+			 * @param file The baked texture.
+			 */
+			void upload(const TextureFile &file);
+
+			GLuint ID = 0;				/// Texture OpenGL ID.
 			GLuint slot;				/// Stores the texture slot number.
 			int texture_width = 0;		/// Width of the texture in pixels.
 			int texture_height = 0;		/// Height of the texture in pixels.
@@ -0,0 +1,369 @@
+/**
+ * @file texture_file.cpp
+ * @brief TextureFile class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "texture_file.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/block_compressor/block_compressor.h"
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/texture_header/texture_header.h"
+#include "structs/image_data/image_data.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		const char MAGIC[8] = "BGQTEX";
+		const uint64_t ALIGNMENT = 16;
+
+		uint64_t align(uint64_t offset) {
+
+			return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+		}
+
+		std::vector<unsigned char> toRGBA(const ImageData &image) {
+
+			// Grey, grey and alpha, RGB and RGBA pixels all become RGBA.
+			size_t num_pixels = (size_t) image.width * image.height;
+			std::vector<unsigned char> rgba(num_pixels * 4);
+			const unsigned char *pixels = image.pixels.get();
+			for (size_t i = 0; i < num_pixels; i++) {
+
+				const unsigned char *src = pixels + i * image.channels;
+				unsigned char *dst = &rgba[i * 4];
+				if (image.channels < 3) {
+
+					dst[0] = dst[1] = dst[2] = src[0];
+					dst[3] = image.channels == 2 ? src[1] : 255;
+
+				} else {
+
+					dst[0] = src[0];
+					dst[1] = src[1];
+					dst[2] = src[2];
+					dst[3] = image.channels == 4 ? src[3] : 255;
+
+				}
+
+			}
+
+			return rgba;
+
+		}
+
+		std::vector<unsigned char> downsample(const std::vector<unsigned char> &src, int width, int height) {
+
+			// Average every 2x2 block, repeating the last row and column of odd sizes.
+			int half_width = std::max(width / 2, 1), half_height = std::max(height / 2, 1);
+			std::vector<unsigned char> dst((size_t) half_width * half_height * 4);
+			for (int y = 0; y < half_height; y++) {
+
+				int y0 = std::min(2 * y, height - 1), y1 = std::min(2 * y + 1, height - 1);
+				for (int x = 0; x < half_width; x++) {
+
+					int x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+					for (int c = 0; c < 4; c++) {
+
+						int sum = src[((size_t) y0 * width + x0) * 4 + c] + src[((size_t) y0 * width + x1) * 4 + c]
+								+ src[((size_t) y1 * width + x0) * 4 + c] + src[((size_t) y1 * width + x1) * 4 + c];
+						dst[((size_t) y * half_width + x) * 4 + c] = (unsigned char) ((sum + 2) / 4);
+
+					}
+
+				}
+
+			}
+
+			return dst;
+
+		}
+
+		bool writeFile(const std::string &filename, GLenum internal_format, int width, int height, int num_faces, uint32_t num_levels, const std::function<const std::vector<unsigned char>&(uint32_t, int)> &get_pixels) {
+
+			bool compressed = internal_format != GL_RGBA8;
+			if (compressed && !BlockCompressor::isSupported(internal_format))
+				return false;
+
+			TextureHeader header;
+			memset(&header, 0, sizeof(TextureHeader));
+			memcpy(header.magic, MAGIC, sizeof(MAGIC));
+			header.version = TextureFile::VERSION;
+			header.internal_format = internal_format;
+			header.format = compressed ? 0 : GL_RGBA;
+			header.type = compressed ? 0 : GL_UNSIGNED_BYTE;
+			header.width = (uint32_t) width;
+			header.height = (uint32_t) height;
+			header.num_faces = (uint32_t) num_faces;
+			header.num_levels = num_levels;
+
+			std::vector<TextureLevel> levels(num_levels);
+			uint64_t offset = sizeof(TextureHeader) + num_levels * sizeof(TextureLevel);
+			for (uint32_t i = 0; i < num_levels; i++) {
+
+				int level_width = std::max(width >> i, 1), level_height = std::max(height >> i, 1);
+				levels[i].offset = align(offset);
+				levels[i].face_bytes = compressed ? BlockCompressor::getCompressedSize(internal_format, level_width, level_height) : (uint64_t) level_width * level_height * 4;
+				offset = levels[i].offset + num_faces * levels[i].face_bytes;
+
+			}
+
+			std::string temporary_filename = filename + ".tmp";
+			std::ofstream file(temporary_filename, std::ios::binary | std::ios::trunc);
+			if (!file)
+				return false;
+
+			file.write((const char*) &header, sizeof(TextureHeader));
+			file.write((const char*) levels.data(), (std::streamsize) (levels.size() * sizeof(TextureLevel)));
+
+			static const char zeros[ALIGNMENT] = {};
+			std::vector<std::byte> blocks;
+			offset = sizeof(TextureHeader) + num_levels * sizeof(TextureLevel);
+			for (uint32_t level = 0; level < num_levels; level++) {
+
+				int level_width = std::max(width >> level, 1), level_height = std::max(height >> level, 1);
+				file.write(zeros, (std::streamsize) (levels[level].offset - offset));
+				for (int i = 0; i < num_faces; i++) {
+
+					const std::vector<unsigned char> &pixels = get_pixels(level, i);
+					if (compressed) {
+
+						blocks.resize(levels[level].face_bytes);
+						BlockCompressor::compress(internal_format, pixels.data(), level_width, level_height, blocks.data());
+						file.write((const char*) blocks.data(), (std::streamsize) blocks.size());
+
+					} else {
+
+						file.write((const char*) pixels.data(), (std::streamsize) pixels.size());
+
+					}
+
+				}
+				offset = levels[level].offset + num_faces * levels[level].face_bytes;
+
+			}
+
+			file.close();
+			std::error_code error;
+			if (!file) {
+
+				std::filesystem::remove(temporary_filename, error);
+				return false;
+
+			}
+
+			std::filesystem::rename(temporary_filename, filename, error);
+
+			return !error;
+
+		}
+
+	}
+
+	TextureFile::TextureFile(const std::string &filename) : file(filename.c_str()) {
+
+		memset(&this->header, 0, sizeof(TextureHeader));
+		if (!this->file.isOpen() || this->file.getSize() < sizeof(TextureHeader)) {
+
+			this->file.remove();
+			return;
+
+		}
+
+		const std::byte *data = this->file.getData();
+		uint64_t file_size = this->file.getSize();
+		memcpy(&this->header, data, sizeof(TextureHeader));
+
+		// Check the header and that every face is inside the file.
+		bool valid = memcmp(this->header.magic, MAGIC, sizeof(MAGIC)) == 0 && this->header.version == VERSION;
+		valid = valid && this->header.num_levels > 0 && this->header.num_levels <= 32 && this->header.width > 0 && this->header.height > 0;
+		valid = valid && (this->header.num_faces == 1 || this->header.num_faces == 6);
+		valid = valid && sizeof(TextureHeader) + this->header.num_levels * sizeof(TextureLevel) <= file_size;
+		if (valid) {
+
+			this->levels = (const TextureLevel*) (data + sizeof(TextureHeader));
+			for (uint32_t i = 0; i < this->header.num_levels && valid; i++)
+				valid = this->levels[i].offset <= file_size && this->levels[i].face_bytes <= (file_size - this->levels[i].offset) / this->header.num_faces;
+
+		}
+
+		if (!valid) {
+
+			this->file.remove();
+			this->levels = nullptr;
+
+		}
+
+	}
+
+	std::span<const std::byte> TextureFile::getFace(int level, int face) const {
+
+		return std::span<const std::byte>(this->file.getData() + this->levels[level].offset + face * this->levels[level].face_bytes, this->levels[level].face_bytes);
+
+	}
+
+	GLenum TextureFile::getFormat() const {
+
+		return this->header.format;
+
+	}
+
+	GLenum TextureFile::getInternalFormat() const {
+
+		return this->header.internal_format;
+
+	}
+
+	int TextureFile::getHeight(int level) const {
+
+		return std::max((int) this->header.height >> level, 1);
+
+	}
+
+	size_t TextureFile::getMemorySize() const {
+
+		size_t size = 0;
+		for (uint32_t i = 0; i < this->header.num_levels; i++)
+			size += this->header.num_faces * this->levels[i].face_bytes;
+
+		return size;
+
+	}
+
+	int TextureFile::getNumFaces() const {
+
+		return (int) this->header.num_faces;
+
+	}
+
+	int TextureFile::getNumLevels() const {
+
+		return (int) this->header.num_levels;
+
+	}
+
+	GLenum TextureFile::getType() const {
+
+		return this->header.type;
+
+	}
+
+	int TextureFile::getWidth(int level) const {
+
+		return std::max((int) this->header.width >> level, 1);
+
+	}
+
+	bool TextureFile::isCompressed() const {
+
+		return this->header.format == 0;
+
+	}
+
+	bool TextureFile::isOpen() const {
+
+		return this->file.isOpen();
+
+	}
+
+	bool TextureFile::isSupported() const {
+
+		// Plain pixels are always fine, compressed ones need their extension.
+		if (!this->isCompressed())
+			return true;
+		if (this->header.internal_format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+			return GLEW_EXT_texture_compression_s3tc;
+		if (this->header.internal_format == GL_COMPRESSED_RGBA_BPTC_UNORM_ARB)
+			return GLEW_ARB_texture_compression_bptc;
+
+		return false;
+
+	}
+
+	void TextureFile::prefetch() const {
+
+		this->file.prefetch();
+
+	}
+
+	bool TextureFile::bake(std::span<const ImageData> faces, const std::string &filename, GLenum internal_format) {
+
+		int num_faces = (int) faces.size();
+		if (num_faces != 1 && num_faces != 6)
+			return false;
+
+		int width = faces[0].width, height = faces[0].height;
+		for (int i = 0; i < num_faces; i++)
+			if (faces[i].width != width || faces[i].height != height || !faces[i].pixels)
+				return false;
+
+		// The chain goes down to 1x1.
+		uint32_t num_levels = 1;
+		while ((width >> num_levels) > 0 || (height >> num_levels) > 0)
+			num_levels++;
+
+		// Every level holds all the faces, so keep the current level of every face.
+		std::vector<std::vector<unsigned char>> current(num_faces);
+		return writeFile(filename, internal_format, width, height, num_faces, num_levels, [&](uint32_t level, int face) -> const std::vector<unsigned char>& {
+
+			if (level == 0)
+				current[face] = toRGBA(faces[face]);
+			else
+				current[face] = downsample(current[face], std::max(width >> (level - 1), 1), std::max(height >> (level - 1), 1));
+
+			return current[face];
+
+		});
+
+	}
+
+	bool TextureFile::write(std::span<const std::vector<unsigned char>> levels, int num_faces, int width, int height, const std::string &filename, GLenum internal_format) {
+
+		if ((num_faces != 1 && num_faces != 6) || levels.empty() || levels.size() % num_faces != 0)
+			return false;
+
+		uint32_t num_levels = (uint32_t) (levels.size() / num_faces);
+		for (uint32_t level = 0; level < num_levels; level++)
+			for (int face = 0; face < num_faces; face++)
+				if (levels[level * num_faces + face].size() != (size_t) std::max(width >> level, 1) * std::max(height >> level, 1) * 4)
+					return false;
+
+		return writeFile(filename, internal_format, width, height, num_faces, num_levels, [&](uint32_t level, int face) -> const std::vector<unsigned char>& {
+
+			return levels[level * num_faces + face];
+
+		});
+
+	}
+
+	std::string TextureFile::getBakedFilename(const std::string &image, const char *extension) {
+
+		return std::filesystem::path(image).replace_extension(extension).string();
+
+	}
+
+}  // namespace bgq_opengl
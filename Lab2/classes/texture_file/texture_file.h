@@ -0,0 +1,243 @@
+/**
+ * @file texture_file.h
+ * @brief TextureFile class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_TEXTUREFILE_H_
+#define BGQ_OPENGL_CLASSES_TEXTUREFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/texture_header/texture_header.h"
+#include "structs/image_data/image_data.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a TextureFile class.
+	 *
+	 * A baked texture or cubemap, in the spirit of KTX2: every face and its whole
+	 * mip chain are stored in one file, already in the layout OpenGL takes, so
+	 * that loading it is only a matter of mapping it and handing every level
+	 * over. The pixels can be plain RGBA or block compressed.
+	 *
+	 * Baking is done offline with bake, from the decoded faces, or with write,
+	 * from levels that were already built.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class TextureFile {
+
+		public:
+
+			static const uint32_t VERSION = 1;	/// Version of the file format. Older files are ignored.
+
+			/**
+			 * @brief Maps a baked texture.
+			 *
+			 * Maps a baked texture and checks it. If it is missing or not valid,
+			 * the object is left empty, which can be checked with isOpen.
+			 *
+			 * @param filename The name of the baked file.
+			 */
+			TextureFile(const std::string &filename);
+
+			/**
+			 * @brief Gets a face.
+			 *
+			 * Gets the pixels of a face in a mip level, inside the mapping.
+			 *
+			 * @param level The mip level.
+			 * @param face The face, from 0 for +X to 5 for -Z, or 0 for a 2D texture.
+			 *
+			 * @returns The pixels of the face.
+			 */
+			std::span<const std::byte> getFace(int level, int face) const;
+
+			/**
+			 * @brief Gets the OpenGL format.
+			 *
+			 * Gets the OpenGL format of the pixels.
+			 *
+			 * @returns The format, or 0 if they are compressed.
+			 */
+			GLenum getFormat() const;
+
+			/**
+			 * @brief Gets the OpenGL internal format.
+			 *
+			 * Gets the OpenGL internal format of the texture.
+			 *
+			 * @returns The internal format.
+			 */
+			GLenum getInternalFormat() const;
+
+			/**
+			 * @brief Gets the number of mip levels.
+			 *
+			 * Gets the number of mip levels in the file.
+			 *
+			 * @returns The number of mip levels.
+			 */
+			int getNumLevels() const;
+
+			/**
+			 * @brief Gets the height of a mip level.
+			 *
+			 * Gets the height of the faces in a mip level.
+			 *
+			 * @param level The mip level.
+			 *
+			 * @returns The height in pixels.
+			 */
+			int getHeight(int level) const;
+
+			/**
+			 * @brief Gets the size of the pixels.
+			 *
+			 * Gets the size of every face of every level, which is what the texture
+			 * takes on the GPU.
+			 *
+			 * @returns The size in bytes.
+			 */
+			size_t getMemorySize() const;
+
+			/**
+			 * @brief Gets the number of faces.
+			 *
+			 * Gets the number of faces of every level.
+			 *
+			 * @returns 1 for a 2D texture and 6 for a cubemap.
+			 */
+			int getNumFaces() const;
+
+			/**
+			 * @brief Gets the OpenGL type.
+			 *
+			 * Gets the OpenGL type of the pixels.
+			 *
+			 * @returns The type, or 0 if they are compressed.
+			 */
+			GLenum getType() const;
+
+			/**
+			 * @brief Gets the width of a mip level.
+			 *
+			 * Gets the width of the faces in a mip level.
+			 *
+			 * @param level The mip level.
+			 *
+			 * @returns The width in pixels.
+			 */
+			int getWidth(int level) const;
+
+			/**
+			 * @brief Whether the pixels are compressed.
+			 *
+			 * Whether the pixels are block compressed.
+			 *
+			 * @returns True if they are compressed. False otherwise.
+			 */
+			bool isCompressed() const;
+
+			/**
+			 * @brief Whether the file is usable.
+			 *
+			 * Whether the file exists and is a valid baked texture.
+			 *
+			 * @returns True if it can be used. False otherwise.
+			 */
+			bool isOpen() const;
+
+			/**
+			 * @brief Whether OpenGL can use the file.
+			 *
+			 * Whether the context supports the compressed format of the file. It only
+			 * reads what GLEW found, so it can be called from a worker.
+			 *
+			 * @returns True if it can be uploaded. False otherwise.
+			 */
+			bool isSupported() const;
+
+			/**
+			 * @brief Reads the whole file in.
+			 *
+			 * Reads the whole file from disk now, so that uploading it does not wait
+			 * for it. It does not touch OpenGL, so it can be called from a worker.
+			 */
+			void prefetch() const;
+
+			/**
+			 * @brief Bakes a texture.
+			 *
+			 * Converts the decoded faces to RGBA, builds their whole mip chain,
+			 * compresses every level if asked to and stores everything in a baked
+			 * texture file.
+			 *
+			 * @param faces One face for a 2D texture, or six in the +X, -X, +Y, -Y, +Z, -Z order, all the same size.
+			 * @param filename The name of the baked file.
+			 * @param internal_format GL_RGBA8, or a format BlockCompressor supports.
+			 *
+			 * @returns True if the file was written. False otherwise.
+			 */
+			static bool bake(std::span<const ImageData> faces, const std::string &filename, GLenum internal_format = GL_RGBA8);
+
+			/**
+			 * @brief Gets the baked file of an image.
+			 *
+			 * Gets the name of the baked file of a texture, which sits next to its
+			 * image, or the first face of a cubemap, with the same name and another
+			 * extension.
+			 *
+			 * @param image The name of the image, or of the first face.
+			 * @param extension The extension of the baked file, .texture or .cubemap.
+			 *
+			 * @returns The name of the baked file.
+			 */
+			static std::string getBakedFilename(const std::string &image, const char *extension);
+
+			/**
+			 * @brief Writes a texture.
+			 *
+			 * Stores levels that were already built, like a prefiltered chain, in a
+			 * baked texture file, compressing them if asked to.
+			 *
+			 * @param levels The RGBA pixels of every face of every level, level after level.
+			 * @param num_faces 1 for a 2D texture, or 6 for a cubemap.
+			 * @param width The width of the first level.
+			 * @param height The height of the first level.
+			 * @param filename The name of the file.
+			 * @param internal_format GL_RGBA8, or a format BlockCompressor supports.
+			 *
+			 * @returns True if the file was written. False otherwise.
+			 */
+			static bool write(std::span<const std::vector<unsigned char>> levels, int num_faces, int width, int height, const std::string &filename, GLenum internal_format = GL_RGBA8);
+
+		private:
+
+			MappedFile file;						/// The mapped file.
+			TextureHeader header;					/// Header of the file.
+			const TextureLevel *levels = nullptr;	/// Mip levels, inside the mapping.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_TEXTUREFILE_H_
@@ -0,0 +1,115 @@
+/**
+ * @file thread_pool.cpp
+ * @brief ThreadPool class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bgq_opengl {
+
+	namespace {
+
+		thread_local int worker_index = -1;
+
+	}
+
+	ThreadPool::ThreadPool(unsigned int num_threads) {
+
+		if (num_threads == 0)
+			num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+		this->threads.reserve(num_threads);
+		for (unsigned int i = 0; i < num_threads; i++)
+			this->threads.emplace_back(&ThreadPool::work, this, i);
+
+	}
+
+	ThreadPool::~ThreadPool() {
+
+		// Let the workers finish what is queued and exit.
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->stopping = true;
+		}
+		this->job_available.notify_all();
+
+		for (size_t i = 0; i < this->threads.size(); i++)
+			this->threads[i].join();
+
+	}
+
+	unsigned int ThreadPool::getNumThreads() {
+
+		return (unsigned int) this->threads.size();
+
+	}
+
+	int ThreadPool::getWorkerIndex() {
+
+		return worker_index;
+
+	}
+
+	void ThreadPool::submit(std::function<void()> job) {
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->jobs.push_back(std::move(job));
+			this->unfinished++;
+		}
+		this->job_available.notify_one();
+
+	}
+
+	void ThreadPool::wait() {
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->jobs_finished.wait(lock, [this] { return this->unfinished == 0; });
+
+	}
+
+	void ThreadPool::work(unsigned int index) {
+
+		worker_index = (int) index;
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+		while (true) {
+
+			this->job_available.wait(lock, [this] { return this->stopping || !this->jobs.empty(); });
+			if (this->jobs.empty())
+				return;
+
+			std::function<void()> job = std::move(this->jobs.front());
+			this->jobs.pop_front();
+
+			// Run the job without holding the lock.
+			lock.unlock();
+			job();
+			lock.lock();
+
+			if (--this->unfinished == 0)
+				this->jobs_finished.notify_all();
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
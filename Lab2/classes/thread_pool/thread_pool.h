@@ -0,0 +1,123 @@
+/**
+ * @file thread_pool.h
+ * @brief ThreadPool class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_THREADPOOL_H_
+#define BGQ_OPENGL_CLASSES_THREADPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a ThreadPool class.
+	 *
+	 * Runs jobs on a fixed set of worker threads, in the order they were
+	 * submitted. The jobs must not touch OpenGL, as the context only belongs to
+	 * the main thread.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ThreadPool {
+
+		public:
+
+			/**
+			 * @brief Starts the workers.
+			 *
+			 * Starts the worker threads, which wait for jobs.
+			 *
+			 * @param num_threads The number of workers, or 0 for one per hardware thread.
+			 */
+			ThreadPool(unsigned int num_threads);
+
+			/**
+			 * @brief ThreadPool objects cannot be copied.
+			 *
+			 * ThreadPool objects own their threads, so they cannot be copied.
+			 */
+			ThreadPool(const ThreadPool&) = delete;
+			ThreadPool& operator=(const ThreadPool&) = delete;
+
+			/**
+			 * @brief Stops the workers.
+			 *
+			 * Waits for the jobs that were already submitted and joins the workers.
+			 */
+			~ThreadPool();
+
+			/**
+			 * @brief Gets the number of workers.
+			 *
+			 * Gets the number of worker threads.
+			 *
+			 * @returns The number of workers.
+			 */
+			unsigned int getNumThreads();
+
+			/**
+			 * @brief Gets the index of the current worker.
+			 *
+			 * Gets the index of the worker running the calling thread, in the pool
+			 * that owns it.
+			 *
+			 * @returns The index of the worker, or -1 if it is not a worker.
+			 */
+			static int getWorkerIndex();
+
+			/**
+			 * @brief Submits a job.
+			 *
+			 * Queues a job to be run by the next free worker.
+			 *
+			 * @param job The job.
+			 */
+			void submit(std::function<void()> job);
+
+			/**
+			 * @brief Waits for the jobs.
+			 *
+			 * Blocks until every job submitted so far has finished.
+			 */
+			void wait();
+
+		private:
+
+			/**
+			 * @brief Runs the jobs.
+			 *
+			 * Loop of every worker thread, which runs jobs until the pool stops.
+			 *
+			 * @param index The index of the worker.
+			 */
+			void work(unsigned int index);
+
+			std::vector<std::thread> threads;			/// Worker threads.
+			std::deque<std::function<void()>> jobs;		/// Jobs not started yet.
+			std::mutex mutex;							/// Guards the jobs and the counters.
+			std::condition_variable job_available;		/// Signals the workers when there are jobs or it stops.
+			std::condition_variable jobs_finished;		/// Signals wait when every job has finished.
+			size_t unfinished = 0;						/// Jobs submitted and not finished yet.
+			bool stopping = false;						/// Whether the workers should exit.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_THREADPOOL_H_
@@ -0,0 +1,130 @@
+/**
+ * @file ubo.cpp
+ * @brief UBO class implementation file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "ubo.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/gl_state/gl_state.h"
+
+namespace bgq_opengl {
+
+	unsigned long UBO::uploads = 0;
+
+	UBO::UBO(GLsizeiptr size, GLuint binding) {
+
+		this->binding = binding;
+		this->shadow = std::vector<unsigned char>(size, 0);
+
+		// Generate the buffer and allocate it.
+		glGenBuffers(1, &this->ID);
+		GlState::bindBuffer(GL_UNIFORM_BUFFER, this->ID);
+		glBufferData(GL_UNIFORM_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+		GlState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	}
+
+	UBO::UBO(UBO&& other) noexcept : ID(other.ID), binding(other.binding), shadow(std::move(other.shadow)), uploaded(other.uploaded) {
+
+		// Leave the other one empty so it does not delete the object.
+		other.ID = 0;
+
+	}
+
+	UBO& UBO::operator=(UBO&& other) noexcept {
+
+		if (this != &other) {
+
+			// Release the current object before taking the other one.
+			this->remove();
+
+			this->ID = other.ID;
+			this->binding = other.binding;
+			this->shadow = std::move(other.shadow);
+			this->uploaded = other.uploaded;
+			other.ID = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	UBO::~UBO() {
+
+		this->remove();
+
+	}
+
+	void UBO::bind() {
+
+		// Bind the whole buffer to the binding point of the block, unless it already is.
+		GlState::bindUniformBlock(this->binding, this->ID);
+
+	}
+
+	bool UBO::update(const void* data) {
+
+		// Skip the upload if nothing changed.
+		if (this->uploaded && std::memcmp(this->shadow.data(), data, this->shadow.size()) == 0)
+			return false;
+
+		// Keep a copy of what we upload.
+		std::memcpy(this->shadow.data(), data, this->shadow.size());
+		this->uploaded = true;
+		uploads++;
+
+		// Upload the whole block.
+		GlState::bindBuffer(GL_UNIFORM_BUFFER, this->ID);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, this->shadow.size(), this->shadow.data());
+		GlState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		return true;
+
+	}
+
+	void UBO::remove() {
+
+		// Delete the buffer in OpenGL, if there is one.
+		if (this->ID != 0)
+			GlState::deleteBuffer(this->ID);
+		this->ID = 0;
+
+	}
+
+	void UBO::unbind() {
+
+		// Unbind it by binding nothing to the binding point.
+		GlState::bindUniformBlock(this->binding, 0);
+
+	}
+
+	unsigned long UBO::getUploads() {
+
+		return uploads;
+
+	}
+
+	void UBO::resetUploads() {
+
+		uploads = 0;
+
+	}
+
+}  // namespace bgq_opengl
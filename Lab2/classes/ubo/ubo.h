@@ -0,0 +1,145 @@
+/**
+ * @file ubo.h
+ * @brief UBO class header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASS_UBO_H_
+#define BGQ_OPENGL_CLASS_UBO_H_
+
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a UBO class.
+	 *
+	 * Implementation of a Uniform Buffer Object class that holds a uniform block
+	 * shared by all the programs. It keeps a copy of the last contents uploaded so
+	 * that only actual changes reach the GPU.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class UBO {
+
+	public:
+
+		/**
+		 * @brief Constructs a Uniform Buffer Object.
+		 *
+		 * Constructs a Uniform Buffer Object of the given size.
+		 *
+		 * @param size The size of the block in bytes.
+		 * @param binding The binding point of the block.
+		 */
+		UBO(GLsizeiptr size, GLuint binding);
+
+		/**
+		 * @brief UBO objects cannot be copied.
+		 *
+		 * UBO objects own their buffer, so they cannot be copied.
+		 */
+		UBO(const UBO&) = delete;
+		UBO& operator=(const UBO&) = delete;
+
+		/**
+		 * @brief Moves a UBO.
+		 *
+		 * Takes the buffer from another UBO, which is left empty.
+		 *
+		 * @param other The UBO to move from.
+		 */
+		UBO(UBO&& other) noexcept;
+
+		/**
+		 * @brief Moves a UBO.
+		 *
+		 * Removes the current buffer and takes the one of another UBO, which
+		 * is left empty.
+		 *
+		 * @param other The UBO to move from.
+		 *
+		 * @returns This UBO.
+		 */
+		UBO& operator=(UBO&& other) noexcept;
+
+		/**
+		 * @brief Destroys the UBO.
+		 *
+		 * Removes the buffer from OpenGL.
+		 */
+		~UBO();
+
+		/**
+		 * @brief Binds the UBO.
+		 *
+		 * Binds the UBO to its binding point so the programs read from it.
+		 */
+		void bind();
+
+		/**
+		 * @brief Updates the contents of the UBO.
+		 *
+		 * Uploads the new contents of the block if they changed since the last upload.
+		 *
+		 * @param data The contents of the block. Must be as big as the block.
+		 *
+		 * @returns True if the contents were uploaded. False if they did not change.
+		 */
+		bool update(const void* data);
+
+		/**
+		 * @brief Removes the UBO.
+		 *
+		 * Removes the UBO from OpenGL.
+		 */
+		void remove();
+
+		/**
+		 * @brief Unbinds the UBO.
+		 *
+		 * Unbinds the UBO from its binding point.
+		 */
+		void unbind();
+
+		/**
+		 * @brief Get the number of uploads.
+		 *
+		 * Get the number of block uploads that reached the GPU, shared by all UBOs.
+		 *
+		 * @returns The number of uploads since the last reset.
+		 */
+		static unsigned long getUploads();
+
+		/**
+		 * @brief Reset the number of uploads.
+		 *
+		 * Reset the upload counter, typically at the beginning of every frame.
+		 */
+		static void resetUploads();
+
+	private:
+
+		GLuint ID = 0;						/// GL ID of the UBO.
+		GLuint binding;						/// Binding point of the block.
+		std::vector<unsigned char> shadow;	/// Copy of the last contents uploaded.
+		bool uploaded = false;				/// Whether the shadow holds valid contents.
+
+		static unsigned long uploads;		/// Uploads since the last reset.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_CLASS_UBO_H_
@@ -17,22 +17,53 @@
 
 #include "GL/glew.h"
 
+#include "classes/draw_counter/draw_counter.h"
+#include "classes/gl_state/gl_state.h"
 #include "classes/vbo/vbo.h"
 
 namespace bgq_opengl {
 
 	VAO::VAO() {
 
-		// Generate the buffer.
+		// Generate the VAO.
 		glGenVertexArrays(1, &this->ID);
-		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
+
+	}
+
+	VAO::VAO(VAO&& other) noexcept : ID(other.ID) {
+
+		// Leave the other one empty so it does not delete the object.
+		other.ID = 0;
+
+	}
+
+	VAO& VAO::operator=(VAO&& other) noexcept {
+
+		if (this != &other) {
+
+			// Release the current object before taking the other one.
+			this->remove();
+
+			this->ID = other.ID;
+			other.ID = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	VAO::~VAO() {
+
+		this->remove();
 
 	}
 
 	void VAO::bind() {
 
-		// Bind the VAO.
-		glBindVertexArray(this->ID);
+		// Bind the VAO, unless it already is.
+		if (GlState::bindVertexArray(this->ID))
+			DrawCounter::recordVAOBind();
 
 	}
 
@@ -51,17 +82,41 @@ namespace bgq_opengl {
 
 	}
 
+	void VAO::link_instance_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
+		GLsizeiptr step, void* offset) {
+
+		// Bind the VBO.
+		vbo.bind();
+
+		// Integers have to go through the integer pointer or they are converted to floats.
+		if (type == GL_INT || type == GL_UNSIGNED_INT)
+			glVertexAttribIPointer(layout, num_components, type, (GLsizei) step, offset);
+		else
+			glVertexAttribPointer(layout, num_components, type, GL_FALSE, (GLsizei) step, offset);
+		glEnableVertexAttribArray(layout);
+
+		// Advance this attribute once per instance.
+		glVertexAttribDivisor(layout, 1);
+
+		// Unbind the vbo again.
+		vbo.unbind();
+
+	}
+
 	void VAO::remove() {
 
-		// Deletes the VAO from the GL pipe.
-		glDeleteVertexArrays(1, &this->ID);
+		// Deletes the VAO from the GL pipe, if there is one.
+		if (this->ID != 0)
+			GlState::deleteVertexArray(this->ID);
+		this->ID = 0;
 
 	}
 
 	void VAO::unbind() {
 
 		// Unbind the VAO by binding no VAO.
-		glBindVertexArray(0);
+		if (GlState::bindVertexArray(0))
+			DrawCounter::recordVAOBind();
 
 	}
 
@@ -41,6 +41,42 @@ namespace bgq_opengl {
 		 */
 		VAO();
 
+		/**
+		 * @brief VAO objects cannot be copied.
+		 *
+		 * VAO objects own their vertex array, so they cannot be copied.
+		 */
+		VAO(const VAO&) = delete;
+		VAO& operator=(const VAO&) = delete;
+
+		/**
+		 * @brief Moves a VAO.
+		 *
+		 * Takes the vertex array from another VAO, which is left empty.
+		 *
+		 * @param other The VAO to move from.
+		 */
+		VAO(VAO&& other) noexcept;
+
+		/**
+		 * @brief Moves a VAO.
+		 *
+		 * Removes the current vertex array and takes the one of another VAO, which
+		 * is left empty.
+		 *
+		 * @param other The VAO to move from.
+		 *
+		 * @returns This VAO.
+		 */
+		VAO& operator=(VAO&& other) noexcept;
+
+		/**
+		 * @brief Destroys the VAO.
+		 *
+		 * Removes the vertex array from OpenGL.
+		 */
+		~VAO();
+
 		/**
 		 * @brief Binds the VBO.
 		 *
@@ -63,6 +99,22 @@ namespace bgq_opengl {
 		void link_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
 			GLsizeiptr step, void* offset);
 
+		/**
+		 * @brief Links a per-instance VBO attribute to the VAO.
+		 *
+		 * Links a VBO attribute that advances once per instance instead of once
+		 * per vertex. Integer types are passed to the shader as integers.
+		 *
+		 * @param vbo The VBO to link the attribute to.
+		 * @param layout The layout identifier that will be used in the shader.
+		 * @param num_components The number of components that are in the list.
+		 * @param type The type of data that we will be passing.
+		 * @param step The amount of bytes we have to skip to find the next item.
+		 * @param offset The amount of data we have to skip to find the first item.
+		 */
+		void link_instance_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
+			GLsizeiptr step, void* offset);
+
 		/**
 		 * @brief Remove the VAO.
 		 *
@@ -79,7 +131,7 @@ namespace bgq_opengl {
 
 	private:
 
-		GLuint ID; /// OpenGL VAO ID.
+		GLuint ID = 0; /// OpenGL VAO ID.
 	};
 
 }  // namespace bgq_opengl
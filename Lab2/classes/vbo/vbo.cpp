@@ -15,36 +15,96 @@
 
 #include "vbo.h"
 
-#include <vector>
+#include <span>
 
 #include "GL/glew.h"
 
+#include "classes/gl_state/gl_state.h"
 #include "structs/vertex/vertex.h"
 
 namespace bgq_opengl {
 
-	VBO::VBO(const std::vector<Vertex> &vertices) {
+	VBO::VBO(std::span<const Vertex> vertices) {
 
 		// Generate the buffer.
 		glGenBuffers(1, &this->ID);
-		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
+		GlState::bindBuffer(GL_ARRAY_BUFFER, this->ID);
 
 		// Link the vertices.
 		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
 
 	}
 
+	VBO::VBO(const void* data, GLsizeiptr size) {
+
+		// Generate the buffer.
+		glGenBuffers(1, &this->ID);
+		GlState::bindBuffer(GL_ARRAY_BUFFER, this->ID);
+
+		// Link the data.
+		glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+
+	}
+
+	VBO::VBO() {
+
+		// Nothing to do. The buffer will be generated when it is updated.
+
+	}
+
+	VBO::VBO(VBO&& other) noexcept : ID(other.ID) {
+
+		// Leave the other one empty so it does not delete the object.
+		other.ID = 0;
+
+	}
+
+	VBO& VBO::operator=(VBO&& other) noexcept {
+
+		if (this != &other) {
+
+			// Release the current object before taking the other one.
+			this->remove();
+
+			this->ID = other.ID;
+			other.ID = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	VBO::~VBO() {
+
+		this->remove();
+
+	}
+
 	void VBO::bind() {
 
 		// Bind the VBO.
-		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
+		GlState::bindBuffer(GL_ARRAY_BUFFER, this->ID);
 
 	}
 
 	void VBO::remove() {
 
-		// Delete the buffer in OpenGL.
-		glDeleteBuffers(1, &this->ID);
+		// Delete the buffer in OpenGL, if there is one.
+		if (this->ID != 0)
+			GlState::deleteBuffer(this->ID);
+		this->ID = 0;
+
+	}
+
+	void VBO::update(const void* data, GLsizeiptr size) {
+
+		// Respecify the whole storage so the driver does not have to wait for
+		// the draws still using the previous contents.
+		if (this->ID == 0)
+			glGenBuffers(1, &this->ID);
+		GlState::bindBuffer(GL_ARRAY_BUFFER, this->ID);
+		glBufferData(GL_ARRAY_BUFFER, size, data, GL_STREAM_DRAW);
 
 	}
 
@@ -52,7 +112,7 @@ namespace bgq_opengl {
 
 		// Unbind it.
 		// To do so, just bind nothing.
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		GlState::bindBuffer(GL_ARRAY_BUFFER, 0);
 
 	}
 
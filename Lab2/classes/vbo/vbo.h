@@ -16,7 +16,7 @@
 #ifndef BGQ_OPENGL_CLASS_VBO_H_
 #define BGQ_OPENGL_CLASS_VBO_H_
 
-#include <vector>
+#include <span>
 
 #include "GL/glew.h"
 
@@ -43,7 +43,63 @@ namespace bgq_opengl {
 		 *
 		 * @param vertices Vertices that will be linked.
 		 */
-		VBO(const std::vector<Vertex> &vertices);
+		VBO(std::span<const Vertex> vertices);
+
+		/**
+		 * @brief Constructs a Vertex Buffer Object.
+		 *
+		 * Constructs a Vertex Buffer Object from raw data that will not change.
+		 *
+		 * @param data The data that will be linked.
+		 * @param size The size of the data in bytes.
+		 */
+		VBO(const void* data, GLsizeiptr size);
+
+		/**
+		 * @brief Constructs an empty Vertex Buffer Object.
+		 *
+		 * Constructs an empty Vertex Buffer Object whose contents will be
+		 * updated often, like the per-instance attributes. The buffer is
+		 * generated the first time it is updated.
+		 */
+		VBO();
+
+		/**
+		 * @brief VBO objects cannot be copied.
+		 *
+		 * VBO objects own their buffer, so they cannot be copied.
+		 */
+		VBO(const VBO&) = delete;
+		VBO& operator=(const VBO&) = delete;
+
+		/**
+		 * @brief Moves a VBO.
+		 *
+		 * Takes the buffer from another VBO, which is left empty.
+		 *
+		 * @param other The VBO to move from.
+		 */
+		VBO(VBO&& other) noexcept;
+
+		/**
+		 * @brief Moves a VBO.
+		 *
+		 * Removes the current buffer and takes the one of another VBO, which
+		 * is left empty.
+		 *
+		 * @param other The VBO to move from.
+		 *
+		 * @returns This VBO.
+		 */
+		VBO& operator=(VBO&& other) noexcept;
+
+		/**
+		 * @brief Destroys the VBO.
+		 *
+		 * Removes the buffer from OpenGL.
+		 */
+		~VBO();
+
 
 		/**
 		 * @brief Binds the VBO.
@@ -59,6 +115,16 @@ namespace bgq_opengl {
 		 */
 		void remove();
 
+		/**
+		 * @brief Updates the contents of the VBO.
+		 *
+		 * Replaces the contents of the VBO with new data.
+		 *
+		 * @param data The new contents.
+		 * @param size The size of the new contents in bytes.
+		 */
+		void update(const void* data, GLsizeiptr size);
+
 		/**
 		 * @brief Unbinds the VBO.
 		 *
@@ -68,7 +134,7 @@ namespace bgq_opengl {
 
 	private:
 
-		GLuint ID; // GL ID of the VBO.
+		GLuint ID = 0; /// GL ID of the VBO.
 
 	};
 
@@ -18,11 +18,18 @@
 #include "main.h"
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <filesystem>
 #include <iostream>
+#include <map>
 #include <random>
+#include <string>
+#include <span>
 #include <vector>
 
 #include "GL/glew.h"
@@ -30,24 +37,434 @@
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_glfw_gl3.h"
 #include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/quaternion.hpp"
 #include "glm/gtx/quaternion.hpp"
 #include "glm/common.hpp"
 #include "glm/gtx/string_cast.hpp"
 
+#include "classes/allocation_tracker/allocation_tracker.h"
+#include "classes/benchmark/benchmark.h"
+#include "classes/bvh/bvh.h"
 #include "classes/camera/camera.h"
 #include "classes/cubemap/cubemap.h"
+#include "classes/draw_counter/draw_counter.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_profiler/gpu_profiler.h"
+#include "classes/gpu_timer/gpu_timer.h"
+#include "classes/texture_file/texture_file.h"
 #include "classes/light/light.h"
+#include "classes/light_clusters/light_clusters.h"
 #include "classes/object/object.h"
+#include "classes/loader_assimp/loader_assimp.h"
+#include "classes/png_writer/png_writer.h"
+#include "classes/ray_tracer/ray_tracer.h"
 #include "classes/shader/shader.h"
 #include "classes/skybox/skybox.h"
+#include "classes/texture/texture.h"
+#include "classes/thread_pool/thread_pool.h"
+#include "classes/ubo/ubo.h"
+#include "structs/benchmark_result/benchmark_result.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/draw_stats/draw_stats.h"
+#include "structs/image_data/image_data.h"
+#include "structs/instance/instance.h"
+#include "structs/mesh_data/mesh_data.h"
+#include "structs/point_light/point_light.h"
+#include "structs/ray/ray.h"
+#include "structs/ray_hit/ray_hit.h"
+#include "structs/uniform/uniform.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
+#include "structs/zone_stats/zone_stats.h"
+
+bool bakeSkyboxes(const char *directory, GLenum format) {
+    
+    // Names used for every face, in the order OpenGL wants them: +X, -X, +Y, -Y, +Z, -Z.
+    const std::array<std::array<const char*, 3>, 6> suffixes {{
+        {"posx", "right", "_rt"},
+        {"negx", "left", "_lf"},
+        {"posy", "top", "_up"},
+        {"negy", "bottom", "_dn"},
+        {"posz", "front", "_ft"},
+        {"negz", "back", "_bk"}
+    }};
+    
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        
+        std::cerr << "Baking error: " << directory << " is not a directory." << std::endl;
+        return false;
+        
+    }
+    
+    // Group the faces by what is left of their name without the face suffix.
+    std::map<std::string, std::array<std::string, 6>> skyboxes;
+    for (const std::filesystem::directory_entry &entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+        
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (!entry.is_regular_file() || (extension != ".jpg" && extension != ".jpeg" && extension != ".png" && extension != ".tga" && extension != ".bmp"))
+            continue;
+        
+        std::string stem = entry.path().stem().string();
+        std::transform(stem.begin(), stem.end(), stem.begin(), ::tolower);
+        for (size_t face = 0; face < suffixes.size(); face++) {
+            
+            auto match = std::find_if(suffixes[face].begin(), suffixes[face].end(), [&](const char *suffix) {
+                return stem.ends_with(suffix);
+            });
+            
+            if (match != suffixes[face].end()) {
+                
+                std::string prefix = (entry.path().parent_path() / stem.substr(0, stem.size() - strlen(*match))).string();
+                skyboxes[prefix][face] = entry.path().string();
+                break;
+                
+            }
+            
+        }
+        
+    }
+    
+    // Only complete skyboxes can be baked.
+    std::vector<std::array<std::string, 6>> complete;
+    for (const auto &[prefix, faces] : skyboxes) {
+        
+        if (std::any_of(faces.begin(), faces.end(), [](const std::string &face) { return face.empty(); }))
+            std::cerr << "Baking warning: " << prefix << " does not have all six faces, so it is skipped." << std::endl;
+        else
+            complete.push_back(faces);
+        
+    }
+    
+    // Decode every face and bake every skybox in parallel.
+    auto start = std::chrono::steady_clock::now();
+    bgq_opengl::ThreadPool pool(LOADER_THREADS);
+    std::vector<std::array<bgq_opengl::ImageData, 6>> images(complete.size());
+    std::vector<char> decoded(complete.size() * 6, 0);
+    for (size_t i = 0; i < complete.size(); i++)
+        for (size_t face = 0; face < 6; face++)
+            pool.submit([&, i, face] {
+                decoded[i * 6 + face] = bgq_opengl::Cubemap::loadFace(complete[i][face], &images[i][face]);
+            });
+    pool.wait();
+    
+    std::vector<char> baked(complete.size(), 0);
+    for (size_t i = 0; i < complete.size(); i++)
+        if (std::all_of(decoded.begin() + i * 6, decoded.begin() + i * 6 + 6, [](char ok) { return ok != 0; }))
+            pool.submit([&, i] {
+                baked[i] = bgq_opengl::TextureFile::bake(images[i], bgq_opengl::TextureFile::getBakedFilename(complete[i][0], ".cubemap"), format);
+                
+                // Prefilter the glossy levels and project the diffuse light too, so that loading the skybox does not have to.
+                bgq_opengl::IrradianceBlock irradiance;
+                baked[i] = baked[i] && bgq_opengl::CubemapFilter::prefilter(images[i], bgq_opengl::CubemapFilter::getCacheFilename(complete[i][0]), format, 1);
+                baked[i] = baked[i] && bgq_opengl::SphericalHarmonics::project(images[i], 1, &irradiance)
+                    && bgq_opengl::SphericalHarmonics::save(bgq_opengl::SphericalHarmonics::getCacheFilename(complete[i][0]), images[i][0].width, irradiance);
+                images[i] = {};
+            });
+    pool.wait();
+    
+    bool success = true;
+    for (size_t i = 0; i < complete.size(); i++) {
+        
+        std::string filename = bgq_opengl::TextureFile::getBakedFilename(complete[i][0], ".cubemap");
+        if (baked[i]) {
+            
+            std::cout << "Baked " << filename << " (" << std::filesystem::file_size(filename, error) / 1024 << " KiB)." << std::endl;
+            
+        } else {
+            
+            std::cerr << "Baking error: " << filename << " could not be baked." << std::endl;
+            success = false;
+            
+        }
+        
+    }
+    
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Baked " << complete.size() << " skyboxes in " << time << " ms on " << pool.getNumThreads() << " threads." << std::endl;
+    
+    return success;
+    
+}
+
+bool bakeTexture(const char *image, GLenum format) {
+    
+    auto start = std::chrono::steady_clock::now();
+    bgq_opengl::ImageData decoded;
+    std::string filename = bgq_opengl::TextureFile::getBakedFilename(image, ".texture");
+    if (!bgq_opengl::Texture::loadImage(image, &decoded) || !bgq_opengl::TextureFile::bake(std::span(&decoded, 1), filename, format)) {
+        
+        std::cerr << "Baking error: " << filename << " could not be baked." << std::endl;
+        return false;
+        
+    }
+    
+    std::error_code error;
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Baked " << filename << " (" << std::filesystem::file_size(filename, error) / 1024 << " KiB) in " << time << " ms." << std::endl;
+    
+    return true;
+    
+}
+
+void benchmarkCase(bgq_opengl::Benchmark *benchmark, bgq_opengl::GpuTimer *gpu_timer, const char *scene, const char *model, const char *skybox, const char *shader) {
+    
+    (*benchmark).beginCase(scene, model, skybox, shader);
+    
+    for (long frame = -BENCH_WARMUP_FRAMES; frame < bench_frames; frame++) {
+        
+        // The warm up is timed too, since some drivers get the first queries wrong, but it is dropped here.
+        if (gpu_timer && frame == 0) {
+            
+            (*gpu_timer).collect(true);
+            (*gpu_timer).clear();
+            
+        }
+        
+        // Every case sees the same frames, the camera going once around the scene.
+        current_frame = frame + BENCH_WARMUP_FRAMES;
+        float angle = 2.0f * M_PI * frame / bench_frames;
+        cameras[current_camera].lookAt(glm::vec3(2.5f * cos(angle), 1.0f, 2.5f * sin(angle)), glm::vec3(0.0f));
+        
+        bgq_opengl::Shader::resetStats();
+        bgq_opengl::UBO::resetUploads();
+        bgq_opengl::DrawCounter::reset();
+        bgq_opengl::GlState::resetStats();
+        
+        // The CPU time goes up to the last command of the frame, before waiting on the swap.
+        auto start = std::chrono::steady_clock::now();
+        if (gpu_timer)
+            (*gpu_timer).begin();
+        
+        clear();
+        displayElements();
+        
+        if (gpu_timer)
+            (*gpu_timer).end();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        
+        if (frame >= 0)
+            (*benchmark).addFrame(elapsed.count(), bgq_opengl::DrawCounter::getStats(), bgq_opengl::Shader::getStats(), bgq_opengl::UBO::getUploads());
+        
+        if (!headless) {
+            
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+            
+        }
+        
+    }
+    
+    // Wait for the last frames of the case.
+    if (gpu_timer) {
+        
+        (*gpu_timer).collect(true);
+        (*benchmark).endCase((*gpu_timer).getTimes());
+        
+    } else {
+        
+        (*benchmark).endCase(std::vector<double>());
+        
+    }
+    
+}
+
+bool benchmarkRays() {
+    
+    bgq_opengl::ThreadPool pool(LOADER_THREADS);
+    std::cout << "Ray queries: " << bench_rays << " rays per model, " << pool.getNumThreads() << " threads, AVX2 " << (bgq_opengl::Bvh::isSimdSupported() ? "on" : "off") << "." << std::endl;
+    std::cout << "  model                triangles   nodes   build ms  pool ms   scalar  simd     batched  per core (Mrays/s)" << std::endl;
+    
+    bool success = true;
+    for (const char *model : {"teapot.obj", "eames_chair.fbx", "volkswagen.fbx"}) {
+        
+        std::vector<bgq_opengl::MeshData> meshes;
+        if (!loadMeshes(model, &meshes)) {
+            
+            success = false;
+            continue;
+            
+        }
+        
+        // Put all the meshes together, so the whole model is a single hierarchy.
+        std::vector<bgq_opengl::Vertex> vertices;
+        std::vector<GLuint> indices;
+        for (const bgq_opengl::MeshData &mesh : meshes) {
+            
+            std::span<const bgq_opengl::Vertex> mesh_vertices = mesh.mapping ? mesh.mapped_vertices : std::span<const bgq_opengl::Vertex>(mesh.vertices);
+            std::span<const GLuint> mesh_indices = mesh.mapping ? mesh.mapped_indices : std::span<const GLuint>(mesh.indices);
+            
+            GLuint offset = (GLuint) vertices.size();
+            vertices.insert(vertices.end(), mesh_vertices.begin(), mesh_vertices.end());
+            for (GLuint index : mesh_indices)
+                indices.push_back(index + offset);
+            
+        }
+        
+        auto build_start = std::chrono::steady_clock::now();
+        bgq_opengl::Bvh serial_bvh(vertices, indices);
+        auto pool_start = std::chrono::steady_clock::now();
+        bgq_opengl::Bvh bvh(vertices, indices, &pool);
+        auto build_end = std::chrono::steady_clock::now();
+        
+        // Shoot from a sphere around the model at random points of its box, so some rays miss it.
+        bgq_opengl::BoundingBox box = bvh.getBoundingBox();
+        glm::vec3 centre = (box.min + box.max) / 2.0f;
+        float radius = glm::length(box.max - box.min);
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        std::vector<bgq_opengl::Ray> rays(bench_rays);
+        for (bgq_opengl::Ray &ray : rays) {
+            
+            glm::vec3 side(distribution(generator), distribution(generator), distribution(generator));
+            glm::vec3 target(distribution(generator), distribution(generator), distribution(generator));
+            ray.origin = centre + glm::normalize(side) * radius;
+            ray.direction = centre + target * (box.max - box.min) * 0.5f - ray.origin;
+            ray.max_t = INFINITY;
+            
+        }
+        
+        // Cast them one by one with each kernel, and then in batches on the pool.
+        std::vector<bgq_opengl::RayHit> scalar_hits(rays.size()), simd_hits(rays.size()), hits(rays.size());
+        bgq_opengl::Bvh::setSimd(false);
+        auto scalar_start = std::chrono::steady_clock::now();
+        bvh.intersect(rays, scalar_hits);
+        bgq_opengl::Bvh::setSimd(true);
+        auto simd_start = std::chrono::steady_clock::now();
+        bvh.intersect(rays, simd_hits);
+        auto batch_start = std::chrono::steady_clock::now();
+        bvh.intersect(rays, hits, &pool);
+        auto batch_end = std::chrono::steady_clock::now();
+        
+        // Both kernels have to find the very same hits.
+        size_t mismatches = 0;
+        for (size_t i = 0; i < rays.size(); i++)
+            if (scalar_hits[i].t != simd_hits[i].t || scalar_hits[i].triangle != simd_hits[i].triangle || simd_hits[i].t != hits[i].t)
+                mismatches++;
+        
+        auto getRate = [&rays](std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+            
+            return rays.size() / std::chrono::duration<double>(end - start).count() / 1e6;
+            
+        };
+        
+        double batched = getRate(batch_start, batch_end);
+        char line[256];
+        snprintf(line, sizeof(line), "  %-20s %9zu %7zu %9.1f %8.1f %8.2f %8.2f %8.2f %8.2f",
+                 model, bvh.getNumTriangles(), bvh.getNumNodes(), std::chrono::duration<double, std::milli>(pool_start - build_start).count(),
+                 std::chrono::duration<double, std::milli>(build_end - pool_start).count(), getRate(scalar_start, simd_start),
+                 getRate(simd_start, batch_start), batched, batched / pool.getNumThreads());
+        std::cout << line << std::endl;
+        
+        if (mismatches > 0) {
+            
+            std::cerr << "Ray query error: " << mismatches << " rays hit differently with each kernel in " << model << "." << std::endl;
+            success = false;
+            
+        }
+        
+    }
+    
+    return success;
+    
+}
+
+void buildMaterials(bgq_opengl::MaterialBlock *basic, bgq_opengl::MaterialBlock *tray_block, bgq_opengl::MaterialBlock *bottle_block, bgq_opengl::MaterialBlock *ico_block, bgq_opengl::MaterialBlock *mirror_block, bgq_opengl::MaterialBlock *mirror_frame_block) {
+    
+    // Build the material of the basic scene.
+    bgq_opengl::MaterialBlock material = {};
+    material.object_color = glm::vec3(1.0f, 1.0f, 1.0f);
+    material.mix_color = 1.0f;
+    material.eta = refraction_eta;
+    material.fresnel_power = fresnel_power;
+    material.eta_r = refraction_eta_r;
+    material.eta_g = refraction_eta_g;
+    material.eta_b = refraction_eta_b;
+    material.roughness = roughness;
+    *basic = material;
+    
+    // Build the materials of the fancy scene.
+    material.object_color = tray_color;
+    material.mix_color = tray_interpol_color;
+    material.fresnel_power = tray_fresnel_power;
+    material.eta_r = tray_eta_r;
+    material.eta_g = tray_eta_g;
+    material.eta_b = tray_eta_b;
+    *tray_block = material;
+    
+    material.object_color = bottle_color;
+    material.mix_color = bottle_interpol_color;
+    material.fresnel_power = bottle_fresnel_power;
+    material.eta_r = bottle_eta_r;
+    material.eta_g = bottle_eta_g;
+    material.eta_b = bottle_eta_b;
+    *bottle_block = material;
+    
+    material.object_color = ico_color;
+    material.mix_color = ico_interpol_color;
+    material.fresnel_power = ico_fresnel_power;
+    material.eta_r = ico_eta_r;
+    material.eta_g = ico_eta_g;
+    material.eta_b = ico_eta_b;
+    *ico_block = material;
+    
+    material.object_color = mirror_color;
+    material.mix_color = mirror_interpol_color;
+    material.fresnel_power = mirror_fresnel_power;
+    material.eta_r = mirror_eta_r;
+    material.eta_g = mirror_eta_g;
+    material.eta_b = mirror_eta_b;
+    *mirror_block = material;
+    
+    // The frame of the mirror is the same material without the tint.
+    material.mix_color = 1.0f;
+    *mirror_frame_block = material;
+    
+}
 
 void clean() {
 
-    // Delete all the shaders.
-    for (size_t i = 0; i < shaders.size(); i++)
-        shaders[i].remove();
+    // Release all the GPU resources while the context is still alive.
+    delete shader_watcher;
+    watched_shaders.clear();
+    delete environment_shaders;
+    skyboxes.clear();
+    objects.clear();
+    delete sky_shader;
+    
+    // Stop building programs before the context of the compiler goes away with the window.
+    bgq_opengl::ShaderCompiler::stop();
+    
+    delete tray;
+    delete bottle;
+    delete ico;
+    delete mirror;
+    delete light_clusters;
+    probes.clear();
+    
+    // Delete the uniform blocks.
+    delete frame_block;
+    delete basic_material;
+    delete irradiance_block;
+    delete tray_material;
+    delete bottle_material;
+    delete ico_material;
+    delete mirror_material;
+    delete mirror_frame_material;
+    delete probe_cluster_block;
+    
+    // Delete the profiler queries.
+    bgq_opengl::GpuProfiler::remove();
+    
+    // Headless runs have no window, only the FBO and the context.
+    if (headless) {
+        
+        delete offscreen;
+        delete headless_context;
+        return;
+        
+    }
     
     // Terminate ImGUI.
     ImGui_ImplGlfwGL3_Shutdown();
@@ -59,6 +476,9 @@ void clean() {
 
 void clear() {
     
+    // Tag the allocations of this phase of the frame.
+    bgq_opengl::AllocationScope allocation_scope("clear");
+    
     // Specify the color of the background
     glClearColor(background.x, background.y, background.z, background.w);
 
@@ -69,205 +489,464 @@ void clear() {
 
 void displayElements() {
     
-    // Get the program internal time.
-    auto current_time = std::chrono::system_clock::now();
-    double real_time = std::chrono::duration<double>(current_time.time_since_epoch()).count();
-    internal_time = real_time - time_start;
+    // Tag the allocations of this phase of the frame.
+    bgq_opengl::AllocationScope allocation_scope("scene");
     
-    for (int i = 0; i < shaders.size(); i++) {
+    // Get the program internal time, which test runs move at a fixed pace.
+    if (time_step > 0) {
         
-        // Pass the parameters to the shaders.
-        shaders[i].activate();
-        shaders[i].passLight(scene_light);
-        shaders[i].passCubemap(skyboxes[current_skybox].getCubemap());
+        internal_time = current_frame * time_step;
         
-        // Pass some parameters to the shaders.
-        shaders[i].passFloat("eta", refraction_eta);
-        shaders[i].passFloat("fresnelPower", fresnel_power);
+    } else {
         
-        shaders[i].passFloat("etaR", refraction_eta_r);
-        shaders[i].passFloat("etaG", refraction_eta_g);
-        shaders[i].passFloat("etaB", refraction_eta_b);
+        auto current_time = std::chrono::system_clock::now();
+        double real_time = std::chrono::duration<double>(current_time.time_since_epoch()).count();
+        internal_time = real_time - time_start;
         
     }
     
     // Updates the camera matrixes.
     cameras[current_camera].update();
     
+    // Upload the blocks that changed.
+    updateBlocks();
+    
+    // Place the fancy scene first, so that its probes are up to date before the frame is drawn.
+    if (current_scene == 1) {
+        
+        // Only the fancy scene reads the point lights.
+        updatePointLights();
+        
+        placeFancyObjects();
+        if (use_probes)
+            updateProbes();
+        
+    }
+    
+    // Bind the current environment to the slot the programs sample it from.
+    skyboxes[current_skybox].getCubemap().bind();
+    
+    // Measure the object draws on the GPU, up to the skybox.
+    bgq_opengl::GpuZone objects_zone("objects");
+    
+    // Collect the draws of the frame, which are sorted by state before they are issued.
+    render_queue.begin(cameras[current_camera]);
+    
     if (current_scene == 0) {
         
         // Get info from the model.
-        bgq_opengl::BoundingBox bb = objects[current_object].getBoundingBox();
-        glm::vec3 centre = (bb.min + bb.max) / 2.0f;
-        glm::vec3 size = bb.max - bb.min;
-        float max_dim = std::max(size.x, std::max(size.y, size.z));
-        float scale_rat = NORM_SIZE / max_dim;
+        glm::vec3 centre = objects[current_object].getCentre();
+        float scale_rat = objects[current_object].getNormalizationScale(NORM_SIZE);
         
-        for (int i = 0; i < 4; i++) {
-            
-            objects[current_object].resetTransforms();
+        // All the copies share the same material.
+        (*basic_material).bind();
+        
+        if (use_instancing) {
             
-            // Rotate
+            std::array<bgq_opengl::Instance, 4> instances;
             float rotating = fmod(internal_time * 10, 360);
-            objects[current_object].rotate(0.0, 1.0, 0.0, rotating);
             
-            // Rotate
-            rotating = -90 * i;
-            objects[current_object].rotate(0.0, 1.0, 0.0, rotating);
+            for (int i = 0; i < 4; i++) {
+                
+                // Same transforms as the per-copy path, composed in the same order.
+                glm::mat4 model = glm::rotate(glm::mat4(1.0f), glm::radians(rotating), glm::vec3(0.0f, 1.0f, 0.0f));
+                model = glm::rotate(model, glm::radians(-90.0f * i), glm::vec3(0.0f, 1.0f, 0.0f));
+                model = glm::translate(model, glm::vec3(0.0f, 0.0f, 1.0f));
+                model = glm::scale(model, glm::vec3(scale_rat));
+                model = glm::translate(model, -centre);
+                
+                // Each copy is shaded with a different model, unless one was picked.
+                instances[i].model = model;
+                instances[i].shading_model = forced_shader >= 0 ? forced_shader : i;
+                
+            }
             
-            objects[current_object].translate(0.0, 0.0, 1.0);
+            // Draw all the copies at once.
+            objects[current_object].drawInstanced((*environment_shaders).get(INSTANCED_FEATURES), cameras[current_camera], instances);
             
-            // Resize it to normalize it.
-            objects[current_object].scale(scale_rat, scale_rat, scale_rat);
+        } else {
             
-            // Center the object and get it in the right position.
-            objects[current_object].translate(-centre.x, -centre.y, -centre.z);
-            
-            // Draw the object.
-            objects[current_object].draw(shaders[i % shaders.size()], cameras[current_camera]);
+            for (int i = 0; i < 4; i++) {
+                
+                objects[current_object].resetTransforms();
+                
+                // Rotate
+                float rotating = fmod(internal_time * 10, 360);
+                objects[current_object].rotate(0.0, 1.0, 0.0, rotating);
+                
+                // Rotate
+                rotating = -90 * i;
+                objects[current_object].rotate(0.0, 1.0, 0.0, rotating);
+                
+                objects[current_object].translate(0.0, 0.0, 1.0);
+                
+                // Resize it to normalize it.
+                objects[current_object].scale(scale_rat, scale_rat, scale_rat);
+                
+                // Center the object and get it in the right position.
+                objects[current_object].translate(-centre.x, -centre.y, -centre.z);
+                
+                // Queue the object.
+                objects[current_object].submit(&render_queue, (*environment_shaders).get(BASIC_FEATURES[forced_shader >= 0 ? forced_shader : i]), cameras[current_camera], {&basic_material, 1});
+                
+            }
             
         }
         
     } else if (current_scene == 1) {
         
-        // Get info from the model.
-        bgq_opengl::BoundingBox bb = (*tray).getBoundingBox();
-        glm::vec3 centre = (bb.min + bb.max) / 2.0f;
-        glm::vec3 size = bb.max - bb.min;
-        float max_dim = std::max(size.x, std::max(size.y, size.z));
-        float scale_rat = NORM_SIZE / max_dim;
-        
-        (*tray).resetTransforms();
-
-        // Rotate
-        float rotating = fmod(internal_time * 10, 360);
-        (*tray).rotate(0.0, 1.0, 0.0, rotating);
-        
-        // Resize it to normalize it.
-        (*tray).scale(scale_rat, scale_rat, scale_rat);
-        
-        // Center the object and get it in the right position.
-        (*tray).translate(-centre.x, -centre.y, -centre.z);
-        
-        // Draw the object.
-        (*fancy_shader).activate();
-        (*fancy_shader).passFloat("mixColor", tray_interpol_color);
-        (*fancy_shader).passVec("objectColor", tray_color);
-        (*fancy_shader).passFloat("fresnelPower", tray_fresnel_power);
-        (*fancy_shader).passFloat("etaR", tray_eta_r);
-        (*fancy_shader).passFloat("etaG", tray_eta_g);
-        (*fancy_shader).passFloat("etaB", tray_eta_b);
-        (*tray).draw(*fancy_shader, cameras[current_camera]);
+        // Queue the objects, each one reflecting its probe.
+        submitFancyScene(&render_queue, cameras[current_camera], -1);
         
-        // Get info from the model.
-        bb = (*bottle).getBoundingBox();
-        centre = (bb.min + bb.max) / 2.0f;
-        size = bb.max - bb.min;
-        max_dim = std::max(size.x, std::max(size.y, size.z));
-        scale_rat = NORM_SIZE / max_dim;
+    }
+    
+    // Draw everything that was queued.
+    render_queue.execute();
+    
+    objects_zone.end();
+    
+    // Print the skybox.
+    skyboxes[current_skybox].draw(*sky_shader, cameras[current_camera]);
         
-        (*bottle).resetTransforms();
+}
+
+void placeFancyObjects() {
+    
+    // Get info from the model.
+    glm::vec3 centre = (*tray).getCentre();
+    float scale_rat = (*tray).getNormalizationScale(NORM_SIZE);
+    
+    (*tray).resetTransforms();
+
+    // Rotate
+    float rotating = fmod(internal_time * 10, 360);
+    (*tray).rotate(0.0, 1.0, 0.0, rotating);
+    
+    // Resize it to normalize it.
+    (*tray).scale(scale_rat, scale_rat, scale_rat);
+    
+    // Center the object and get it in the right position.
+    (*tray).translate(-centre.x, -centre.y, -centre.z);
+    
+    // Get info from the model.
+    centre = (*bottle).getCentre();
+    scale_rat = (*bottle).getNormalizationScale(NORM_SIZE);
+    
+    (*bottle).resetTransforms();
+
+    // Rotate
+    rotating = fmod(internal_time * 10, 360);
+    (*bottle).rotate(0.0, 1.0, 0.0, rotating);
+    
+    (*bottle).translate(0.2, 0.0, 0.2);
+    
+    // Resize it to normalize it.
+    (*bottle).scale(scale_rat / 1.2, scale_rat / 1.2, scale_rat / 1.2);
+    
+    // Center the object and get it in the right position.
+    (*bottle).translate(-centre.x, 0.0, -centre.z);
+    
+    // Get info from the model.
+    centre = (*ico).getCentre();
+    scale_rat = (*ico).getNormalizationScale(NORM_SIZE);
+    
+    (*ico).resetTransforms();
+
+    // Rotate
+    rotating = fmod(internal_time * 10, 360);
+    (*ico).rotate(0.0, 1.0, 0.0, rotating);
+    
+    (*ico).translate(-0.15, 0.0, 0.2);
+    
+    // Resize it to normalize it.
+    (*ico).scale(scale_rat / 3.0, scale_rat / 3.0, scale_rat / 3.0);
+    
+    // Center the object and get it in the right position.
+    (*ico).translate(-centre.x, 0.0, -centre.z);
+    
+    // Get info from the model.
+    centre = (*mirror).getCentre();
+    scale_rat = (*mirror).getNormalizationScale(NORM_SIZE);
+    
+    (*mirror).resetTransforms();
+
+    // Rotate
+    rotating = fmod(internal_time * 10, 360);
+    (*mirror).rotate(0.0, 1.0, 0.0, rotating);
+    
+    (*mirror).translate(0.0, 0.0, -0.15);
+    
+    // Rotate it because i want it in the other direction.
+    (*mirror).rotate(0.0, 1.0, 0.0, -90.0);
+    
+    // Resize it to normalize it.
+    (*mirror).scale(scale_rat / 1.5, scale_rat / 1.5, scale_rat / 1.5);
+    
+    // Center the object and get it in the right position.
+    (*mirror).translate(-centre.x, 0.0, -centre.z);
+    
+}
 
-        // Rotate
-        rotating = fmod(internal_time * 10, 360);
-        (*bottle).rotate(0.0, 1.0, 0.0, rotating);
+void submitFancyScene(bgq_opengl::RenderQueue *queue, bgq_opengl::Camera &camera, int skipped) {
+    
+    // The probes only see the skybox on the other objects, so no probe is sampled while it is rendered.
+    bool in_probe = skipped >= 0;
+    bgq_opengl::Shader &fancy_shader = (*environment_shaders).get(FANCY_FEATURES);
+    
+    if (skipped != 0)
+        (*tray).submit(queue, fancy_shader, camera, {&tray_material, 1}, getEnvironment(in_probe ? -1 : 0));
+    
+    if (skipped != 1)
+        (*bottle).submit(queue, fancy_shader, camera, {&bottle_material, 1}, getEnvironment(in_probe ? -1 : 1));
+    
+    if (skipped != 2)
+        (*ico).submit(queue, fancy_shader, camera, {&ico_material, 1}, getEnvironment(in_probe ? -1 : 2));
+    
+    // The frame of the mirror is not tinted.
+    if (skipped != 3) {
         
-        (*bottle).translate(0.2, 0.0, 0.2);
+        std::array<bgq_opengl::UBO*, 2> mirror_materials = {mirror_material, mirror_frame_material};
+        (*mirror).submit(queue, fancy_shader, camera, mirror_materials, getEnvironment(in_probe ? -1 : 3));
         
-        // Resize it to normalize it.
-        (*bottle).scale(scale_rat / 1.2, scale_rat / 1.2, scale_rat / 1.2);
+    }
+    
+}
+
+bgq_opengl::Cubemap* getEnvironment(int probe) {
+    
+    // Keep the skybox until the probe has a complete level. Rough materials keep it too: the probe only holds one
+    // sharp level, while the levels of the skybox hold the GGX lobes the roughness picks from.
+    if (probe < 0 || !use_probes || !probes[probe].isReady() || roughness > 0.0f)
+        return &skyboxes[current_skybox].getCubemap();
+    
+    return &probes[probe].getCubemap();
+    
+}
+
+void updateProbes() {
+    
+    // Tag the allocations of this phase of the frame.
+    bgq_opengl::AllocationScope allocation_scope("probes");
+    
+    // Measure the probe faces on the GPU.
+    bgq_opengl::GpuZone probes_zone("probes");
+    
+    std::array<bgq_opengl::Object*, 4> fancy_objects = {tray, bottle, ico, mirror};
+    
+    // The materials of the objects change what the probes see too.
+    bgq_opengl::MaterialBlock basic, tray_block, bottle_block, ico_block, mirror_block, mirror_frame_block;
+    buildMaterials(&basic, &tray_block, &bottle_block, &ico_block, &mirror_block, &mirror_frame_block);
+    std::array<bgq_opengl::MaterialBlock*, 4> fancy_blocks = {&tray_block, &bottle_block, &ico_block, &mirror_block};
+    
+    // Pixels per unit of size at a distance of one.
+    int width = render_width, height = render_height;
+    if (!headless)
+        glfwGetFramebufferSize(window, &width, &height);
+    bgq_opengl::Camera &camera = cameras[current_camera];
+    float focal = camera.getProjection()[1][1] * height / 2.0f;
+    
+    for (size_t i = 0; i < probes.size(); i++) {
         
-        // Center the object and get it in the right position.
-        (*bottle).translate(-centre.x, 0.0, -centre.z);
+        // Pick the resolution from the size of the object on the screen.
+        bgq_opengl::BoundingBox box = (*fancy_objects[i]).getWorldBoundingBox();
+        glm::vec3 centre = (box.min + box.max) / 2.0f;
+        float radius = glm::length(box.max - box.min) / 2.0f;
+        float distance = std::max(glm::length(centre - camera.getPosition()), radius);
+        probes[i].begin(centre, 2.0f * radius * focal / distance);
         
-        // Draw the object.
-        (*fancy_shader).activate();
-        (*fancy_shader).passFloat("mixColor", bottle_interpol_color);
-        (*fancy_shader).passVec("objectColor", bottle_color);
-        (*fancy_shader).passFloat("fresnelPower", bottle_fresnel_power);
-        (*fancy_shader).passFloat("etaR", bottle_eta_r);
-        (*fancy_shader).passFloat("etaG", bottle_eta_g);
-        (*fancy_shader).passFloat("etaB", bottle_eta_b);
-        (*bottle).draw(*fancy_shader, cameras[current_camera]);
+        // Anything in range that moves or changes makes the faces out of date.
+        probes[i].watch(&current_skybox, sizeof(current_skybox));
+        for (size_t j = 0; j < fancy_objects.size(); j++) {
+            
+            if (j == i || !probes[i].isInRange((*fancy_objects[j]).getWorldBoundingBox()))
+                continue;
+            
+            for (size_t k = 0; k < (*fancy_objects[j]).getNumOfGeometries(); k++) {
+                
+                glm::mat4 transform = (*fancy_objects[j]).getTransformMat((int) k);
+                probes[i].watch(&transform, sizeof(transform));
+                
+            }
+            
+            probes[i].watch(fancy_blocks[j], sizeof(bgq_opengl::MaterialBlock));
+            if (fancy_objects[j] == mirror)
+                probes[i].watch(&mirror_frame_block, sizeof(mirror_frame_block));
+            
+        }
         
-        // Get info from the model.
-        bb = (*ico).getBoundingBox();
-        centre = (bb.min + bb.max) / 2.0f;
-        size = bb.max - bb.min;
-        max_dim = std::max(size.x, std::max(size.y, size.z));
-        scale_rat = NORM_SIZE / max_dim;
+    }
+    
+    // Render the faces that are out of date, one probe after another, up to the budget.
+    int rendered = 0;
+    size_t checked = 0;
+    while (checked < probes.size() && rendered < probe_faces_per_frame) {
         
-        (*ico).resetTransforms();
-
-        // Rotate
-        rotating = fmod(internal_time * 10, 360);
-        (*ico).rotate(0.0, 1.0, 0.0, rotating);
+        int probe = next_probe;
+        next_probe = (next_probe + 1) % (int) probes.size();
         
-        (*ico).translate(-0.15, 0.0, 0.2);
+        if (!probes[probe].isStale()) {
+            
+            checked++;
+            continue;
+            
+        }
         
-        // Resize it to normalize it.
-        (*ico).scale(scale_rat / 3.0, scale_rat / 3.0, scale_rat / 3.0);
+        // The clusters belong to the main camera, so the probes go without the point lights.
+        if (rendered == 0)
+            (*probe_cluster_block).bind();
         
-        // Center the object and get it in the right position.
-        (*ico).translate(-centre.x, 0.0, -centre.z);
+        renderProbeFace(probe);
+        rendered++;
+        checked = 0;
         
-        // Draw the object.
-        (*fancy_shader).activate();
-        (*fancy_shader).passFloat("mixColor", ico_interpol_color);
-        (*fancy_shader).passVec("objectColor", ico_color);
-        (*fancy_shader).passFloat("fresnelPower", ico_fresnel_power);
-        (*fancy_shader).passFloat("etaR", ico_eta_r);
-        (*fancy_shader).passFloat("etaG", ico_eta_g);
-        (*fancy_shader).passFloat("etaB", ico_eta_b);
-        (*ico).draw(*fancy_shader, cameras[current_camera]);
+    }
+    
+    // Put the frame back as it was.
+    if (rendered > 0) {
         
-        // Get info from the model.
-        bb = (*mirror).getBoundingBox();
-        centre = (bb.min + bb.max) / 2.0f;
-        size = bb.max - bb.min;
-        max_dim = std::max(size.x, std::max(size.y, size.z));
-        scale_rat = NORM_SIZE / max_dim;
+        updateFrameBlock(camera);
+        (*light_clusters).bind();
+        bindOutput();
         
-        (*mirror).resetTransforms();
+    }
+    
+}
 
-        // Rotate
-        rotating = fmod(internal_time * 10, 360);
-        (*mirror).rotate(0.0, 1.0, 0.0, rotating);
+void reloadShaders() {
+    
+    // Tag the allocations of this phase of the frame.
+    bgq_opengl::AllocationScope allocation_scope("shaders");
+    
+    changed_shaders.clear();
+    (*shader_watcher).poll(&changed_shaders);
+    
+    // Whether a pair of files has a saved one.
+    auto saved = [](const std::string &vertex, const std::string &fragment) {
         
-        (*mirror).translate(0.0, 0.0, -0.15);
+        for (const std::string &filename : changed_shaders)
+            if (filename == vertex || filename == fragment)
+                return true;
         
-        // Rotate it because i want it in the other direction.
-        (*mirror).rotate(0.0, 1.0, 0.0, -90.0);
+        return false;
         
-        // Resize it to normalize it.
-        (*mirror).scale(scale_rat / 1.5, scale_rat / 1.5, scale_rat / 1.5);
+    };
+    
+    // Start building the programs that use a saved file, and swap in the ones that are done.
+    for (bgq_opengl::Shader *shader : watched_shaders) {
         
-        // Center the object and get it in the right position.
-        (*mirror).translate(-centre.x, 0.0, -centre.z);
+        if (saved((*shader).getVertexFilename(), (*shader).getFragmentFilename()))
+            (*shader).reload();
+        (*shader).pollReload();
         
-        // Draw the object.
-        (*fancy_shader).activate();
-        (*fancy_shader).passFloat("mixColor", mirror_interpol_color);
-        (*fancy_shader).passVec("objectColor", mirror_color);
-        (*fancy_shader).passFloat("fresnelPower", mirror_fresnel_power);
-        (*fancy_shader).passFloat("etaR", mirror_eta_r);
-        (*fancy_shader).passFloat("etaG", mirror_eta_g);
-        (*fancy_shader).passFloat("etaB", mirror_eta_b);
-        (*mirror).getGeometries()[0].draw(*fancy_shader, cameras[current_camera]);
+    }
+    
+    // The permutations share their files, so all of them are built again.
+    if (saved((*environment_shaders).getVertexFilename(), (*environment_shaders).getFragmentFilename()))
+        (*environment_shaders).reload();
+    (*environment_shaders).pollReload();
+    
+}
+
+void renderProbeFace(int probe) {
+    
+    // Render with the same clipping distances as the main camera.
+    bgq_opengl::Camera &camera = cameras[current_camera];
+    bgq_opengl::Camera face_camera = probes[probe].beginFace(camera.getNear(), camera.getFar());
+    updateFrameBlock(face_camera);
+    
+    // Draw the other objects, and the skybox behind them.
+    probe_queue.begin(face_camera);
+    submitFancyScene(&probe_queue, face_camera, probe);
+    probe_queue.execute();
+    skyboxes[current_skybox].draw(*sky_shader, face_camera);
+    
+    probes[probe].endFace();
+    
+}
+
+void bindOutput() {
+    
+    // Headless runs draw into their FBO.
+    if (headless) {
         
-        // Draw the object.
-        (*fancy_shader).passFloat("mixColor", 1.0);
-        (*mirror).getGeometries()[1].draw(*fancy_shader, cameras[current_camera]);
+        (*offscreen).bind();
+        return;
         
     }
     
-    // Print the skybox.
-    skyboxes[current_skybox].draw(*sky_shader, cameras[current_camera]);
+    int width, height;
+    glfwGetFramebufferSize(window, &width, &height);
+    bgq_opengl::GlState::bindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+    
+}
+
+void updatePointLights() {
+    
+    // Tag the allocations of this phase of the frame.
+    bgq_opengl::AllocationScope allocation_scope("lights");
+    
+    // Every light orbits the scene at its own height, radius and speed.
+    for (size_t i = 0; i < point_lights.size(); i++) {
+        
+        float phase = i * 2.399963f;
+        float speed = 0.3f + 0.05f * (i % 7);
+        float orbit = 0.3f + 0.1f * (i % 5);
+        float angle = (float) internal_time * speed + phase;
+        point_lights[i].position = glm::vec3(orbit * cosf(angle), 0.1f * (i % 4) - 0.1f, orbit * sinf(angle));
         
+    }
+    
+    // Assign the lights that are on to the clusters.
+    int width = render_width, height = render_height;
+    if (!headless)
+        glfwGetFramebufferSize(window, &width, &height);
+    std::span<const bgq_opengl::PointLight> lights(point_lights.data(), num_point_lights);
+    (*light_clusters).update(lights, cameras[current_camera], width, height);
+    (*light_clusters).bind();
+    
+}
+
+void updateBlocks() {
+    
+    // Tag the allocations of this phase of the frame.
+    bgq_opengl::AllocationScope allocation_scope("blocks");
+    
+    // Build the per-frame block.
+    updateFrameBlock(cameras[current_camera]);
+    
+    // Build the materials.
+    bgq_opengl::MaterialBlock basic, tray_block, bottle_block, ico_block, mirror_block, mirror_frame_block;
+    buildMaterials(&basic, &tray_block, &bottle_block, &ico_block, &mirror_block, &mirror_frame_block);
+    (*basic_material).update(&basic);
+    (*tray_material).update(&tray_block);
+    (*bottle_material).update(&bottle_block);
+    (*ico_material).update(&ico_block);
+    (*mirror_material).update(&mirror_block);
+    (*mirror_frame_material).update(&mirror_frame_block);
+    
+    // The diffuse light only changes with the skybox, so it is rarely uploaded.
+    (*irradiance_block).update(&skyboxes[current_skybox].getCubemap().getIrradiance());
+    
+}
+
+void updateFrameBlock(bgq_opengl::Camera &camera) {
+    
+    bgq_opengl::FrameBlock frame;
+    frame.view = camera.getView();
+    frame.projection = camera.getProjection();
+    frame.light_color = scene_light.getColor();
+    frame.light_position = glm::vec3(frame.view * glm::vec4(scene_light.getPosition(), 1.0f));
+    frame.time = (float) internal_time;
+    (*frame_block).update(&frame);
+    
 }
 
 void displayGUI() {
     
+    // Tag the allocations of this phase of the frame.
+    bgq_opengl::AllocationScope allocation_scope("gui");
+    
     // Init ImGUI for rendering.
     ImGui_ImplGlfwGL3_NewFrame();
     
@@ -277,6 +956,11 @@ void displayGUI() {
     ImGui::Text("Scene");
     ImGui::RadioButton("Basic", &current_scene, 0);
     ImGui::RadioButton("Fancy", &current_scene, 1);
+    ImGui::Checkbox("Instancing", &use_instancing);
+    if (ImGui::Checkbox("Frustum culling", &use_culling))
+        bgq_opengl::Object::setCulling(use_culling);
+    ImGui::Checkbox("Reflection probes", &use_probes);
+    ImGui::SliderInt("Probe faces per frame", &probe_faces_per_frame, 1, bgq_opengl::ReflectionProbe::NUM_FACES);
     
     // Pass these values to the shaders.
     ImGui::Text("Model");
@@ -295,17 +979,114 @@ void displayGUI() {
     ImGui::SliderFloat("ETA R", &refraction_eta_r, 0.1, 1.0);
     ImGui::SliderFloat("ETA G", &refraction_eta_g, 0.1, 1.0);
     ImGui::SliderFloat("ETA B", &refraction_eta_b, 0.1, 1.0);
+    ImGui::SliderFloat("Roughness", &roughness, 0.0, 1.0);
+    if (current_scene == 1 && use_probes && roughness > 0.0f)
+        ImGui::Text("Rough objects reflect the skybox, not the probes.");
+    ImGui::SliderInt("Point lights", &num_point_lights, 0, MAX_POINT_LIGHTS);
     
-    ImGui::End();
+    // Show how many uniform uploads reached the driver this frame.
+    bgq_opengl::UniformStats stats = bgq_opengl::Shader::getStats();
+    ImGui::Text("Uniforms");
+    ImGui::Text("Uploads: %lu Skipped: %lu", stats.uploads, stats.skipped);
+    ImGui::Text("Block uploads: %lu", bgq_opengl::UBO::getUploads());
+    ImGui::Text("GL lookups: %lu Name lookups: %lu", stats.gl_lookups, stats.name_lookups);
     
-    // Render ImGUI.
-    ImGui::Render();
+    // Show the draw calls and binds of this frame.
+    bgq_opengl::DrawStats draws = bgq_opengl::DrawCounter::getStats();
+    ImGui::Text("Draws: %lu Culled: %lu Instances: %lu", draws.draws, draws.culled, draws.instances);
+    ImGui::Text("Binds: %lu programs, %lu VAOs, %lu textures", draws.program_binds, draws.vao_binds, draws.texture_binds);
+    bgq_opengl::GlStateStats state = bgq_opengl::GlState::getStats();
+    ImGui::Text("State calls: %lu Filtered: %lu", state.calls, state.filtered);
+    ImGui::Text("Light indices: %u Dropped: %u", (*light_clusters).getAssigned(), (*light_clusters).getDropped());
+    ImGui::Text("Time to first frame: %.1f ms", time_to_first_frame);
     
-}
-
-void handleKeyEvents() {
+    // Show what the skyboxes take on the GPU, which the baked formats bring down.
+    size_t cubemap_memory = 0;
+    for (bgq_opengl::Skybox &skybox : skyboxes)
+        cubemap_memory += skybox.getCubemap().getMemorySize();
+    ImGui::Text("Cubemap memory: %.1f MiB", cubemap_memory / (1024.0 * 1024.0));
     
-    // Key W will move camera 0 forward.
+    // Show the heap allocations of the last frame by phase.
+    if (bgq_opengl::AllocationTracker::isEnabled()) {
+        
+        bgq_opengl::AllocationStats total = bgq_opengl::AllocationTracker::getTotal();
+        ImGui::Text("Allocations: %lu (%lu B)", total.allocations, total.bytes);
+        for (int i = 0; i < bgq_opengl::AllocationTracker::getNumTags(); i++) {
+            
+            bgq_opengl::AllocationStats phase = bgq_opengl::AllocationTracker::getStats(i);
+            ImGui::Text("  %s: %lu (%lu B) Frees: %lu", phase.tag, phase.allocations, phase.bytes, phase.frees);
+            
+        }
+        
+    }
+    
+    // Show the GPU time of every pass over the last frames.
+    if (bgq_opengl::GpuProfiler::isEnabled()) {
+        
+        ImGui::Text("GPU passes (last %d frames, %lu dropped)", bgq_opengl::GpuProfiler::HISTORY, bgq_opengl::GpuProfiler::getDropped());
+        for (int i = 0; i < bgq_opengl::GpuProfiler::getNumZones(); i++) {
+            
+            bgq_opengl::ZoneStats zone = bgq_opengl::GpuProfiler::getStats(i);
+            ImGui::Text("  %s: %.3f ms avg, p50 %.3f, p95 %.3f, max %.3f", zone.name, zone.mean, zone.median, zone.p95, zone.max);
+            
+        }
+        
+    }
+    
+    ImGui::End();
+    
+    // Render ImGUI.
+    bgq_opengl::GpuZone gpu_zone("gui");
+    ImGui::Render();
+    
+    // ImGui binds its own program, VAO and font texture behind the state cache.
+    bgq_opengl::GlState::invalidate();
+    
+}
+
+std::vector<std::string> getSkyboxFaces(int skybox) {
+    
+    if (skybox == 0) {
+        
+        return std::vector<std::string> {
+            "right.jpg",
+            "left.jpg",
+            "top.jpg",
+            "bottom.jpg",
+            "front.jpg",
+            "back.jpg"
+        };
+        
+    } else if (skybox == 1) {
+        
+        return std::vector<std::string> {
+            "dallas_posx.jpg",
+            "dallas_negx.jpg",
+            "dallas_posy.jpg",
+            "dallas_negy.jpg",
+            "dallas_posz.jpg",
+            "dallas_negz.jpg"
+        };
+        
+    }
+    
+    return std::vector<std::string> {
+        "posx.jpg",
+        "negx.jpg",
+        "posy.jpg",
+        "negy.jpg",
+        "posz.jpg",
+        "negz.jpg"
+    };
+    
+}
+
+void handleKeyEvents() {
+    
+    // Tag the allocations of this phase of the frame.
+    bgq_opengl::AllocationScope allocation_scope("input");
+    
+    // Key W will move camera 0 forward.
     if (ImGui::IsKeyPressed('W')) {
 
         // Move forward.
@@ -387,81 +1168,662 @@ void handleKeyEvents() {
     
 }
 
+void parseArguments(int argc, char** argv) {
+    
+    for (int i = 1; i < argc; i++) {
+        
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            
+            max_frames = atol(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            
+            headless = true;
+            
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            
+            output_filename = argv[++i];
+            
+        } else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            
+            current_scene = parseChoice(argv[i], argv[i + 1], {"basic", "fancy"});
+            i++;
+            
+        } else if (strcmp(argv[i], "--model") == 0 && i + 1 < argc) {
+            
+            current_object = parseChoice(argv[i], argv[i + 1], {"teapot", "chair", "van"});
+            i++;
+            
+        } else if (strcmp(argv[i], "--skybox") == 0 && i + 1 < argc) {
+            
+            current_skybox = parseChoice(argv[i], argv[i + 1], {"sky", "hotel", "chapel"});
+            i++;
+            
+        } else if (strcmp(argv[i], "--shader") == 0 && i + 1 < argc) {
+            
+            forced_shader = parseChoice(argv[i], argv[i + 1], {"reflection", "refraction", "fresnel", "chromatic"});
+            i++;
+            
+        } else if (strcmp(argv[i], "--instancing") == 0 && i + 1 < argc) {
+            
+            use_instancing = parseChoice(argv[i], argv[i + 1], {"off", "on"}) == 1;
+            i++;
+            
+        } else if (strcmp(argv[i], "--culling") == 0 && i + 1 < argc) {
+            
+            use_culling = parseChoice(argv[i], argv[i + 1], {"off", "on"}) == 1;
+            bgq_opengl::Object::setCulling(use_culling);
+            i++;
+            
+        } else if (strcmp(argv[i], "--probes") == 0 && i + 1 < argc) {
+            
+            use_probes = parseChoice(argv[i], argv[i + 1], {"off", "on"}) == 1;
+            i++;
+            
+        } else if (strcmp(argv[i], "--roughness") == 0 && i + 1 < argc) {
+            
+            roughness = atof(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--width") == 0 && i + 1 < argc) {
+            
+            render_width = atoi(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--height") == 0 && i + 1 < argc) {
+            
+            render_height = atoi(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--time-step") == 0 && i + 1 < argc) {
+            
+            time_step = atof(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--reference") == 0) {
+            
+            reference = true;
+            
+        } else if (strcmp(argv[i], "--reference-depth") == 0 && i + 1 < argc) {
+            
+            reference_depth = atoi(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--two-interface") == 0) {
+            
+            two_interface = true;
+            
+        } else if (strcmp(argv[i], "--bake-skyboxes") == 0 && i + 1 < argc) {
+            
+            bake_directory = argv[++i];
+            
+        } else if (strcmp(argv[i], "--bake-texture") == 0 && i + 1 < argc) {
+            
+            bake_image = argv[++i];
+            
+        } else if (strcmp(argv[i], "--bake-format") == 0 && i + 1 < argc) {
+            
+            i++;
+            if (strcmp(argv[i], "rgba8") == 0)
+                bake_format = GL_RGBA8;
+            else if (strcmp(argv[i], "bc1") == 0)
+                bake_format = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            else if (strcmp(argv[i], "bc7") == 0)
+                bake_format = GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
+            else {
+                
+                std::cerr << "Argument error: unknown format " << argv[i] << "." << std::endl;
+                exit(1);
+                
+            }
+            
+        } else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            
+            bench_prefix = argv[++i];
+            
+        } else if (strcmp(argv[i], "--bench-frames") == 0 && i + 1 < argc) {
+            
+            bench_frames = atol(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--bench-rays") == 0 && i + 1 < argc) {
+            
+            bench_rays = atol(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--compare") == 0 && i + 2 < argc) {
+            
+            compare_baseline = argv[++i];
+            compare_current = argv[++i];
+            
+        } else if (strcmp(argv[i], "--allocation-budget") == 0 && i + 1 < argc) {
+            
+            allocation_budget = atol(argv[++i]);
+            
+            if (!bgq_opengl::AllocationTracker::isEnabled())
+                std::cerr << "Allocation warning: the budget is ignored without BGQ_TRACK_ALLOCATIONS." << std::endl;
+            
+        } else {
+            
+            std::cerr << "Argument error: unknown argument " << argv[i] << "." << std::endl;
+            exit(1);
+            
+        }
+        
+    }
+    
+    if (render_width <= 0 || render_height <= 0) {
+        
+        std::cerr << "Argument error: the size has to be positive." << std::endl;
+        exit(1);
+        
+    }
+    
+    if (bench_frames <= 0) {
+        
+        std::cerr << "Argument error: the benchmark needs at least one frame." << std::endl;
+        exit(1);
+        
+    }
+    
+    if (reference && (!output_filename || reference_depth < 0)) {
+        
+        std::cerr << "Argument error: the reference renderer needs --output and a depth of at least 0." << std::endl;
+        exit(1);
+        
+    }
+    
+    // Headless and reference runs must end on their own and render the same frames every time.
+    if ((headless || reference) && max_frames < 0)
+        max_frames = 1;
+    if ((headless || reference) && time_step <= 0)
+        time_step = 1.0 / 60.0;
+    
+    // Baking is done offline, so the program ends right after it.
+    if (bake_directory || bake_image) {
+        
+        bool success = true;
+        if (bake_directory)
+            success = bakeSkyboxes(bake_directory, bake_format) && success;
+        if (bake_image)
+            success = bakeTexture(bake_image, bake_format) && success;
+        
+        exit(success ? 0 : 1);
+        
+    }
+    
+    // Comparing two runs does not render anything either.
+    if (compare_baseline) {
+        
+        std::vector<bgq_opengl::BenchmarkResult> baseline, current;
+        if (!bgq_opengl::Benchmark::readCSV(compare_baseline, &baseline) || !bgq_opengl::Benchmark::readCSV(compare_current, &current)) {
+            
+            std::cerr << "Benchmark error: " << compare_baseline << " or " << compare_current << " could not be read." << std::endl;
+            exit(1);
+            
+        }
+        
+        int regressions = bgq_opengl::Benchmark::compare(baseline, current, BENCH_T_THRESHOLD, std::cout);
+        exit(regressions > 0 ? 1 : 0);
+        
+    }
+    
+    // The ray queries do not render anything either.
+    if (bench_rays > 0)
+        exit(benchmarkRays() ? 0 : 1);
+    
+    // The reference renderer runs on the CPU alone, so it does not need a context.
+    if (reference)
+        exit(renderReference() ? 0 : 1);
+    
+}
+
+int parseChoice(const char *option, const char *value, std::initializer_list<const char*> choices) {
+    
+    int index = 0;
+    for (const char *choice : choices) {
+        
+        if (strcmp(value, choice) == 0)
+            return index;
+        index++;
+        
+    }
+    
+    std::cerr << "Argument error: unknown value " << value << " for " << option << "." << std::endl;
+    exit(1);
+    
+}
+
+bool loadMeshes(const char *filename, std::vector<bgq_opengl::MeshData> *meshes) {
+    
+    // Load the meshes without uploading them.
+    bgq_opengl::LoaderAssimp loader(filename, MESH_CACHE_DIRECTORY);
+    loader.loadModel();
+    
+    std::vector<glm::mat4> matrices;
+    loader.takeMeshes(meshes, &matrices);
+    if ((*meshes).empty()) {
+        
+        std::cerr << "Loading error: " << filename << " has no meshes." << std::endl;
+        return false;
+        
+    }
+    
+    return true;
+    
+}
+
+bool loadReferenceModel(const char *filename, bgq_opengl::RayTracer *tracer, std::vector<int> *meshes, glm::vec3 *centre, float *scale_rat) {
+    
+    std::vector<bgq_opengl::MeshData> data;
+    if (!loadMeshes(filename, &data))
+        return false;
+    
+    // Same centre and normalization as the objects.
+    bgq_opengl::BoundingBox box = data[0].bounding_box;
+    for (size_t i = 1; i < data.size(); i++) {
+        
+        box.min = glm::min(box.min, data[i].bounding_box.min);
+        box.max = glm::max(box.max, data[i].bounding_box.max);
+        
+    }
+    
+    glm::vec3 size = box.max - box.min;
+    *centre = (box.min + box.max) / 2.0f;
+    *scale_rat = NORM_SIZE / std::max(size.x, std::max(size.y, size.z));
+    
+    // Build a BVH per mesh.
+    for (const bgq_opengl::MeshData &mesh : data) {
+        
+        std::span<const bgq_opengl::Vertex> vertices = mesh.mapping ? mesh.mapped_vertices : std::span<const bgq_opengl::Vertex>(mesh.vertices);
+        std::span<const GLuint> indices = mesh.mapping ? mesh.mapped_indices : std::span<const GLuint>(mesh.indices);
+        (*meshes).push_back((*tracer).addMesh(vertices, indices));
+        
+    }
+    
+    return true;
+    
+}
+
+bool renderReference() {
+    
+    // Decode the faces of the environment.
+    std::vector<std::string> faces = getSkyboxFaces(current_skybox);
+    std::vector<bgq_opengl::ImageData> images(faces.size());
+    for (size_t i = 0; i < faces.size(); i++) {
+        
+        if (!bgq_opengl::Cubemap::loadFace(faces[i], &images[i])) {
+            
+            std::cerr << "Reference error: " << faces[i] << " could not be loaded." << std::endl;
+            return false;
+            
+        }
+        
+    }
+    
+    bgq_opengl::RayTracer tracer(images);
+    tracer.setMaxDepth(reference_depth);
+    tracer.setTwoInterface(two_interface);
+    
+    bgq_opengl::MaterialBlock basic, tray_block, bottle_block, ico_block, mirror_block, mirror_frame_block;
+    buildMaterials(&basic, &tray_block, &bottle_block, &ico_block, &mirror_block, &mirror_frame_block);
+    
+    // The scene is placed like in the last frame of a headless run.
+    float rotating = fmod((max_frames - 1) * time_step * 10, 360);
+    glm::mat4 turn = glm::rotate(glm::mat4(1.0f), glm::radians(rotating), glm::vec3(0.0f, 1.0f, 0.0f));
+    
+    std::vector<int> meshes;
+    glm::vec3 centre;
+    float scale_rat;
+    
+    if (current_scene == 0) {
+        
+        const char *models[] = {"teapot.obj", "eames_chair.fbx", "volkswagen.fbx"};
+        if (!loadReferenceModel(models[current_object], &tracer, &meshes, &centre, &scale_rat))
+            return false;
+        
+        for (int i = 0; i < 4; i++) {
+            
+            // Same transforms as displayElements.
+            glm::mat4 model = glm::rotate(turn, glm::radians(-90.0f * i), glm::vec3(0.0f, 1.0f, 0.0f));
+            model = glm::translate(model, glm::vec3(0.0f, 0.0f, 1.0f));
+            model = glm::scale(model, glm::vec3(scale_rat));
+            model = glm::translate(model, -centre);
+            
+            int shading_model = forced_shader >= 0 ? forced_shader : i;
+            for (int mesh : meshes)
+                tracer.addInstance(mesh, model, basic, (bgq_opengl::RayTracer::ShadingModels) shading_model);
+            
+        }
+        
+    } else {
+        
+        // Same transforms as displayElements.
+        if (!loadReferenceModel("tray.obj", &tracer, &meshes, &centre, &scale_rat))
+            return false;
+        glm::mat4 model = glm::scale(turn, glm::vec3(scale_rat));
+        model = glm::translate(model, -centre);
+        for (int mesh : meshes)
+            tracer.addInstance(mesh, model, tray_block, bgq_opengl::RayTracer::TINTED_CHROMATIC);
+        
+        meshes.clear();
+        if (!loadReferenceModel("bottle.obj", &tracer, &meshes, &centre, &scale_rat))
+            return false;
+        model = glm::translate(turn, glm::vec3(0.2f, 0.0f, 0.2f));
+        model = glm::scale(model, glm::vec3(scale_rat / 1.2f));
+        model = glm::translate(model, glm::vec3(-centre.x, 0.0f, -centre.z));
+        for (int mesh : meshes)
+            tracer.addInstance(mesh, model, bottle_block, bgq_opengl::RayTracer::TINTED_CHROMATIC);
+        
+        meshes.clear();
+        if (!loadReferenceModel("icosahedron.obj", &tracer, &meshes, &centre, &scale_rat))
+            return false;
+        model = glm::translate(turn, glm::vec3(-0.15f, 0.0f, 0.2f));
+        model = glm::scale(model, glm::vec3(scale_rat / 3.0f));
+        model = glm::translate(model, glm::vec3(-centre.x, 0.0f, -centre.z));
+        for (int mesh : meshes)
+            tracer.addInstance(mesh, model, ico_block, bgq_opengl::RayTracer::TINTED_CHROMATIC);
+        
+        // The first mesh of the mirror is the glass and the second one the frame.
+        meshes.clear();
+        if (!loadReferenceModel("mirror.obj", &tracer, &meshes, &centre, &scale_rat))
+            return false;
+        model = glm::translate(turn, glm::vec3(0.0f, 0.0f, -0.15f));
+        model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        model = glm::scale(model, glm::vec3(scale_rat / 1.5f));
+        model = glm::translate(model, glm::vec3(-centre.x, 0.0f, -centre.z));
+        for (size_t i = 0; i < meshes.size(); i++)
+            tracer.addInstance(meshes[i], model, i == 0 ? mirror_block : mirror_frame_block, bgq_opengl::RayTracer::TINTED_CHROMATIC);
+        
+    }
+    
+    // Same camera as initElements.
+    bgq_opengl::Camera camera(glm::vec3(2.0f, 1.0f, 2.0f), glm::vec3(-1.0f, -0.5f, -1.0f), 45.0f, 0.1f, 300.0f, render_width, render_height);
+    camera.update();
+    
+    auto render_start = std::chrono::steady_clock::now();
+    
+    bgq_opengl::ThreadPool pool(REFERENCE_THREADS);
+    std::vector<unsigned char> pixels;
+    tracer.render(camera.getView(), camera.getProjection(), render_width, render_height, pool, &pixels);
+    
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - render_start;
+    std::cout << "Reference: " << render_width << "x" << render_height << " in " << elapsed.count() << " ms on " << pool.getNumThreads() << " threads." << std::endl;
+    
+    if (!bgq_opengl::PngWriter::write(output_filename, render_width, render_height, pixels.data(), false)) {
+        
+        std::cerr << "Reference error: " << output_filename << " could not be written." << std::endl;
+        return false;
+        
+    }
+    
+    return true;
+    
+}
+
+bool runBenchmark() {
+    
+    const char *scene_names[] = {"basic", "fancy"};
+    const char *model_names[] = {"teapot", "chair", "van"};
+    const char *skybox_names[] = {"sky", "hotel", "chapel"};
+    const char *shader_names[] = {"reflection", "refraction", "fresnel", "chromatic"};
+    
+    // Do not wait for the screen, and move the scene at the same pace on every machine.
+    if (!headless)
+        glfwSwapInterval(0);
+    if (time_step <= 0)
+        time_step = 1.0 / 60.0;
+    
+    // Timer queries are core since OpenGL 3.3.
+    bgq_opengl::Benchmark benchmark;
+    bgq_opengl::GpuTimer *gpu_timer = 0;
+    if (GLEW_VERSION_3_3 || GLEW_ARB_timer_query)
+        gpu_timer = new bgq_opengl::GpuTimer();
+    else
+        std::cerr << "Benchmark warning: there are no timer queries, so the GPU times are not measured." << std::endl;
+    
+    // The basic scene draws one model with one program at a time, the fancy one has them all.
+    for (current_scene = 0; current_scene < 2; current_scene++) {
+        
+        int num_models = current_scene == 0 ? 3 : 1;
+        int num_shaders = current_scene == 0 ? 4 : 1;
+        for (current_object = 0; current_object < num_models; current_object++) {
+            
+            for (current_skybox = 0; current_skybox < 3; current_skybox++) {
+                
+                for (int shader = 0; shader < num_shaders; shader++) {
+                    
+                    forced_shader = current_scene == 0 ? shader : -1;
+                    const char *model = current_scene == 0 ? model_names[current_object] : "all";
+                    const char *shader_name = current_scene == 0 ? shader_names[shader] : "fancy";
+                    benchmarkCase(&benchmark, gpu_timer, scene_names[current_scene], model, skybox_names[current_skybox], shader_name);
+                    
+                    const bgq_opengl::BenchmarkResult &result = benchmark.getResults().back();
+                    std::cerr << result.scene << "/" << result.model << "/" << result.skybox << "/" << result.shader << ": CPU " << result.cpu.mean << " ms, GPU " << result.gpu.mean << " ms, " << result.draws << " draws" << std::endl;
+                    
+                }
+                
+            }
+            
+        }
+        
+    }
+    
+    delete gpu_timer;
+    
+    std::string prefix(bench_prefix);
+    bool success = benchmark.writeJSON(prefix + ".json") && benchmark.writeCSV(prefix + ".csv");
+    if (!success)
+        std::cerr << "Benchmark error: " << prefix << ".json or " << prefix << ".csv could not be written." << std::endl;
+    
+    return success;
+    
+}
+
+void writeFrame(long frame) {
+    
+    // Tag the allocations of this phase of the frame.
+    bgq_opengl::AllocationScope allocation_scope("output");
+    
+    // Put the number of the frame in the name, if it asks for it.
+    std::string filename(output_filename);
+    size_t pattern = filename.find("%d");
+    if (pattern != std::string::npos)
+        filename.replace(pattern, 2, std::to_string(frame));
+    
+    (*offscreen).read(&output_pixels);
+    if (!bgq_opengl::PngWriter::write(filename, (*offscreen).getWidth(), (*offscreen).getHeight(), output_pixels.data(), true)) {
+        
+        std::cerr << "Output error: " << filename << " could not be written." << std::endl;
+        clean();
+        exit(1);
+        
+    }
+    
+}
+
 void initElements() {
+    
+    // Start loading the models and decoding the skyboxes on the workers, so the rest of the setup overlaps with them.
+    bgq_opengl::AssetLoader assets(startup_time, LOADER_THREADS);
+    
+    int sky = assets.addCubemap(getSkyboxFaces(0), "sky", 0);
+    int dallas = assets.addCubemap(getSkyboxFaces(1), "dallas", 0);
+    int chapel = assets.addCubemap(getSkyboxFaces(2), "chapel", 0);
+    
+    // The biggest models go first so they do not end up last on a single worker.
+    int volkswagen = assets.addModel("volkswagen.fbx", "Assimp", MESH_CACHE_DIRECTORY);
+    int eames_chair = assets.addModel("eames_chair.fbx", "Assimp", MESH_CACHE_DIRECTORY);
+    int teapot = assets.addModel("teapot.obj", "Assimp", MESH_CACHE_DIRECTORY);
+    int tray_model = assets.addModel("tray.obj", "Assimp", MESH_CACHE_DIRECTORY);
+    int bottle_model = assets.addModel("bottle.obj", "Assimp", MESH_CACHE_DIRECTORY);
+    int ico_model = assets.addModel("icosahedron.obj", "Assimp", MESH_CACHE_DIRECTORY);
+    int mirror_model = assets.addModel("mirror.obj", "Assimp", MESH_CACHE_DIRECTORY);
 
     // Create a white light in the center of the world.
     scene_light = bgq_opengl::Light(glm::vec3(2.0f, 8.0, 2.0f), glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 
-    // Get the shaders.
-    shaders.push_back(bgq_opengl::Shader("reflection.vert", "reflection.frag"));
-    shaders.push_back(bgq_opengl::Shader("refraction.vert", "refraction.frag"));
-    shaders.push_back(bgq_opengl::Shader("fresnel.vert", "fresnel.frag"));
-    shaders.push_back(bgq_opengl::Shader("fresnelChromatic.vert", "fresnelChromatic.frag"));
+    // Get the shaders. Their permutations are only built once something is drawn with them.
+    environment_shaders = new bgq_opengl::ShaderPermutations("environment.vert", "environment.frag", PROGRAM_CACHE_DIRECTORY);
 
     // Creates the first camera object
-    bgq_opengl::Camera camera(glm::vec3(2.0f, 1.0f, 2.0f), glm::vec3(-1.0f, -0.5f, -1.0f), 45.0f, 0.1f, 300.0f, WINDOW_WIDTH, WINDOW_HEIGHT);
+    bgq_opengl::Camera camera(glm::vec3(2.0f, 1.0f, 2.0f), glm::vec3(-1.0f, -0.5f, -1.0f), 45.0f, 0.1f, 300.0f, render_width, render_height);
     cameras.push_back(camera);
     
-    // Load the skyboxes.
-    std::vector<std::string> faces {
-        "right.jpg",
-        "left.jpg",
-        "top.jpg",
-        "bottom.jpg",
-        "front.jpg",
-        "back.jpg"
-    };
-    bgq_opengl::Cubemap cubemap(faces, "sky", 0);
-    bgq_opengl::Skybox skybox_1(cubemap);
-    skyboxes.push_back(skybox_1);
-    
-    // Load the skyboxes.
-    faces = std::vector<std::string> {
-        "dallas_posx.jpg",
-        "dallas_negx.jpg",
-        "dallas_posy.jpg",
-        "dallas_negy.jpg",
-        "dallas_posz.jpg",
-        "dallas_negz.jpg"
-    };
-    cubemap = bgq_opengl::Cubemap(faces, "dallas", 0);
-    bgq_opengl::Skybox dallas(cubemap);
-    skyboxes.push_back(dallas);
+    // Create the uniform blocks and attach the per-frame and irradiance ones for good.
+    frame_block = new bgq_opengl::UBO(sizeof(bgq_opengl::FrameBlock), bgq_opengl::FRAME_BLOCK_BINDING);
+    (*frame_block).bind();
+    basic_material = new bgq_opengl::UBO(sizeof(bgq_opengl::MaterialBlock), bgq_opengl::MATERIAL_BLOCK_BINDING);
+    irradiance_block = new bgq_opengl::UBO(sizeof(bgq_opengl::IrradianceBlock), bgq_opengl::IRRADIANCE_BLOCK_BINDING);
+    (*irradiance_block).bind();
+    tray_material = new bgq_opengl::UBO(sizeof(bgq_opengl::MaterialBlock), bgq_opengl::MATERIAL_BLOCK_BINDING);
+    bottle_material = new bgq_opengl::UBO(sizeof(bgq_opengl::MaterialBlock), bgq_opengl::MATERIAL_BLOCK_BINDING);
+    ico_material = new bgq_opengl::UBO(sizeof(bgq_opengl::MaterialBlock), bgq_opengl::MATERIAL_BLOCK_BINDING);
+    mirror_material = new bgq_opengl::UBO(sizeof(bgq_opengl::MaterialBlock), bgq_opengl::MATERIAL_BLOCK_BINDING);
+    mirror_frame_material = new bgq_opengl::UBO(sizeof(bgq_opengl::MaterialBlock), bgq_opengl::MATERIAL_BLOCK_BINDING);
     
-    // Load the skyboxes.
-    faces = std::vector<std::string> {
-        "posx.jpg",
-        "negx.jpg",
-        "posy.jpg",
-        "negy.jpg",
-        "posz.jpg",
-        "negz.jpg"
-    };
-    cubemap = bgq_opengl::Cubemap(faces, "chapel", 0);
-    bgq_opengl::Skybox chapel(cubemap);
-    skyboxes.push_back(chapel);
+    // Create the point lights with colors spread around the hue circle.
+    point_lights = std::vector<bgq_opengl::PointLight>(MAX_POINT_LIGHTS);
+    for (size_t i = 0; i < point_lights.size(); i++) {
+        
+        float hue = fmod(i * 0.618034f, 1.0f) * 6.0f;
+        point_lights[i].color = glm::clamp(glm::vec3(fabs(hue - 3.0f) - 1.0f, 2.0f - fabs(hue - 2.0f), 2.0f - fabs(hue - 4.0f)), 0.0f, 1.0f);
+        point_lights[i].radius = 0.4f;
+        point_lights[i].intensity = 1.0f;
+        
+    }
+    light_clusters = new bgq_opengl::LightClusters(MAX_POINT_LIGHTS, 16, 9, 24, 64);
+    
+    // Create a probe per object of the fancy scene, in the slot of the skybox they replace, and the empty clusters they are rendered with.
+    probes.reserve(4);
+    for (int i = 0; i < 4; i++)
+        probes.emplace_back(PROBE_RANGE, 0);
+    bgq_opengl::ClusterBlock no_clusters = {};
+    probe_cluster_block = new bgq_opengl::UBO(sizeof(bgq_opengl::ClusterBlock), bgq_opengl::CLUSTER_BLOCK_BINDING);
+    (*probe_cluster_block).update(&no_clusters);
     
     // Init the shader.
-    sky_shader = new bgq_opengl::Shader("skybox.vert", "skybox.frag");
+    sky_shader = new bgq_opengl::Shader("skybox.vert", "skybox.frag", PROGRAM_CACHE_DIRECTORY);
+    
+    // Report how much of the shader setup the program cache saved.
+    bgq_opengl::ProgramCacheStats program_stats = bgq_opengl::ProgramCache::getStats();
+    std::cerr << "Program cache: " << program_stats.hits << " programs loaded in " << program_stats.load_time << " ms, saving " << program_stats.saved_time << " ms, "
+              << program_stats.misses << " missed and " << program_stats.rejected << " rejected." << std::endl;
     
-    // Init the fancy shader.
-    fancy_shader = new bgq_opengl::Shader("fancyFresnelChromatic.vert", "fancyFresnelChromatic.frag");
+    // Rebuild the programs when their sources are saved. Nobody edits them during headless runs.
+    if (!headless) {
+        
+        watched_shaders.push_back(sky_shader);
+        
+        shader_watcher = new bgq_opengl::ShaderWatcher();
+        for (bgq_opengl::Shader *shader : watched_shaders) {
+            
+            (*shader_watcher).watch((*shader).getVertexFilename());
+            (*shader_watcher).watch((*shader).getFragmentFilename());
+            
+        }
+        (*shader_watcher).watch((*environment_shaders).getVertexFilename());
+        (*shader_watcher).watch((*environment_shaders).getFragmentFilename());
+        
+    }
 
-    // Load the objects.
-    objects.push_back(bgq_opengl::Object("teapot.obj", "Assimp"));
-    objects.push_back(bgq_opengl::Object("eames_chair.fbx", "Assimp"));
-    objects.push_back(bgq_opengl::Object("volkswagen.fbx", "Assimp"));
+    // Upload the assets as the workers finish them.
+    assets.finish();
+    assets.printTimeline();
+    
+    // Get the skyboxes.
+    skyboxes.push_back(bgq_opengl::Skybox(assets.takeCubemap(sky)));
+    skyboxes.push_back(bgq_opengl::Skybox(assets.takeCubemap(dallas)));
+    skyboxes.push_back(bgq_opengl::Skybox(assets.takeCubemap(chapel)));
+
+    // Get the objects.
+    objects.push_back(assets.takeObject(teapot));
+    objects.push_back(assets.takeObject(eames_chair));
+    objects.push_back(assets.takeObject(volkswagen));
     
-    // Load the objects of the fancy scene.
-    tray = new bgq_opengl::Object("tray.obj", "Assimp");
-    bottle = new bgq_opengl::Object("bottle.obj", "Assimp");
-    ico = new bgq_opengl::Object("icosahedron.obj", "Assimp");
-    mirror = new bgq_opengl::Object("mirror.obj", "Assimp");
+    // Get the objects of the fancy scene.
+    tray = new bgq_opengl::Object(assets.takeObject(tray_model));
+    bottle = new bgq_opengl::Object(assets.takeObject(bottle_model));
+    ico = new bgq_opengl::Object(assets.takeObject(ico_model));
+    mirror = new bgq_opengl::Object(assets.takeObject(mirror_model));
 
 }
 
 void initEnvironment(int argc, char** argv) {
     
+    if (headless) {
+        
+        // There is no window, so the context is created straight through EGL.
+        headless_context = new bgq_opengl::HeadlessContext(3, 3);
+        if (!(*headless_context).isOpen()) {
+            
+            std::cerr << "Error 121-1003 - Failed to create the headless context." << std::endl;
+            exit(1);
+            
+        }
+        
+    } else {
+        
+        initWindow();
+        
+    }
+    
+    // Initialize GLEW and OpenGL. Headless runs have no window system, so they only load the functions and extensions of the context.
+    GLenum res = headless ? glewContextInit() : glewInit();
+
+    // Check for any errors.
+    if (res != GLEW_OK) {
+
+        std::cerr << "Error 121-1002 - GLEW could not be initialized:" << glewGetErrorString(res) << std::endl;
+        exit(1);
+
+    }
+    
+    // Get version info.
+    std::cerr << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
+    std::cerr << "OpenGL version supported " << glGetString(GL_VERSION) << std::endl;
+    std::cerr << "GLSL version supported " << (char *) glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
+    
+    // Let the driver build the programs of hot reloads on its own threads.
+    if (GLEW_KHR_parallel_shader_compile)
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    
+    // Otherwise build them on a thread of their own, with a hidden context that shares the programs with this one.
+    if (!headless && !GLEW_KHR_parallel_shader_compile && !GLEW_ARB_parallel_shader_compile) {
+        
+        glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+        compile_window = glfwCreateWindow(1, 1, GAME_NAME, NULL, window);
+        glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
+        if (compile_window)
+            bgq_opengl::ShaderCompiler::start([]() { glfwMakeContextCurrent(compile_window); }, []() { glfwMakeContextCurrent(NULL); });
+        else
+            std::cerr << "Warning - Could not create the context of the shader compiler, so saved shaders will not be reloaded." << std::endl;
+        
+    }
+    
+    // Setup ImGui binding, or the FBO that replaces the window.
+    if (headless) {
+        
+        offscreen = new bgq_opengl::FBO(render_width, render_height);
+        (*offscreen).bind();
+        
+    } else {
+        
+        ImGui_ImplGlfwGL3_Init(window, true);
+        
+    }
+
+    // Nothing is known about the state of the new context yet.
+    bgq_opengl::GlState::invalidate();
+    
+    // tell GL to only draw onto a pixel if the shape is closer to the viewer
+    bgq_opengl::GlState::setEnabled(GL_DEPTH_TEST, true); // enable depth-testing
+    bgq_opengl::GlState::setDepthFunc(GL_LESS); // depth-testing interprets a smaller value as "closer"
+    
+    // Measure the render passes on the GPU, if the driver can.
+    bgq_opengl::GpuProfiler::init();
+    
+    // Init the initial time.
+    auto current_time = std::chrono::system_clock::now();
+    time_start = std::chrono::duration<double>(current_time.time_since_epoch()).count();
+
+}
+
+void initWindow() {
+    
     // start GL context and O/S window using the GLFW helper library
     if (!glfwInit()) {
         
@@ -477,7 +1839,7 @@ void initEnvironment(int argc, char** argv) {
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     
     // Create the window.
-    window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, GAME_NAME, NULL, NULL);
+    window = glfwCreateWindow(render_width, render_height, GAME_NAME, NULL, NULL);
     if (!window) {
         
         std::cerr << "Error 121-1001 - Failed to create the window." << std::endl;
@@ -489,62 +1851,127 @@ void initEnvironment(int argc, char** argv) {
     
     // Tell what function handles the events.
     // glfwSetKeyCallback(window, handleKeyEvents);
-    
-    // Initialize GLEW and OpenGL.
-    GLenum res = glewInit();
-
-    // Check for any errors.
-    if (res != GLEW_OK) {
-
-        std::cerr << "Error 121-1002 - GLEW could not be initialized:" << glewGetErrorString(res) << std::endl;
-        exit(1);
-
-    }
-    
-    // Get version info.
-    std::cerr << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
-    std::cerr << "OpenGL version supported " << glGetString(GL_VERSION) << std::endl;
-    std::cerr << "GLSL version supported " << (char *) glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
-    
-    // Setup ImGui binding
-    ImGui_ImplGlfwGL3_Init(window, true);
-
-    // tell GL to only draw onto a pixel if the shape is closer to the viewer
-    glEnable(GL_DEPTH_TEST); // enable depth-testing
-    glDepthFunc(GL_LESS); // depth-testing interprets a smaller value as "closer"
-    
-    // Init the initial time.
-    auto current_time = std::chrono::system_clock::now();
-    time_start = std::chrono::duration<double>(current_time.time_since_epoch()).count();
 
 }
 
 int main(int argc, char** argv) {
+    
+    // Everything in the startup timeline is measured from here.
+    startup_time = std::chrono::steady_clock::now();
 
+    // Read the options of test runs.
+    parseArguments(argc, argv);
+    
     // Initialise the environment.
     initEnvironment(argc, argv);
     
     // Initialise the objects and elements.
     initElements();
+    
+    // The benchmark replaces the main loop.
+    if (bench_prefix) {
+        
+        bool success = runBenchmark();
+        clean();
+        exit(success ? 0 : 1);
+        
+    }
+    
+    // Loading is allowed to allocate, steady frames are not.
+    bgq_opengl::AllocationTracker::setBudget(allocation_budget, ALLOCATION_WARMUP_FRAMES);
 
     // Main loop.
-    while(!glfwWindowShouldClose(window)) {
+    auto loop_start = std::chrono::steady_clock::now();
+    for (long frame = 0; (headless || !glfwWindowShouldClose(window)) && (max_frames < 0 || frame < max_frames); frame++) {
+        
+        current_frame = frame;
+        
+        // Start counting the uniform uploads and allocations of this frame.
+        bgq_opengl::Shader::resetStats();
+        bgq_opengl::UBO::resetUploads();
+        bgq_opengl::DrawCounter::reset();
+        bgq_opengl::GlState::resetStats();
+        bgq_opengl::AllocationTracker::beginFrame();
+        bgq_opengl::GpuProfiler::beginFrame();
         
         // Clear the scene.
         clear();
         
         // Handle key events.
-        handleKeyEvents();
+        if (!headless)
+            handleKeyEvents();
+        
+        // Swap in the shaders that were saved, once they are built.
+        if (shader_watcher)
+            reloadShaders();
         
         // Display the scene.
         displayElements();
         
-        // Make the things to print everything.
-        displayGUI();
+        if (headless) {
+            
+            bgq_opengl::GpuProfiler::endFrame();
+            
+            // Write the frames that were asked for.
+            if (output_filename && (strstr(output_filename, "%d") || frame == max_frames - 1))
+                writeFrame(frame);
+            
+        } else {
+            
+            // Make the things to print everything.
+            displayGUI();
+            bgq_opengl::GpuProfiler::endFrame();
+            
+            // Update other events like input handling.
+            bgq_opengl::AllocationScope allocation_scope("events");
+            glfwPollEvents();
+            glfwSwapBuffers(window);
+            
+        }
+        
+        // Report how long it took to get something on screen.
+        if (frame == 0) {
+            
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startup_time;
+            time_to_first_frame = elapsed.count();
+            std::cerr << "Time to first frame: " << time_to_first_frame << " ms" << std::endl;
+            
+        }
+        
+        // Fail the run if a steady frame went over the budget.
+        if (!bgq_opengl::AllocationTracker::endFrame()) {
+            
+            bgq_opengl::AllocationStats total = bgq_opengl::AllocationTracker::getTotal();
+            std::cerr << "Allocation error: frame " << frame << " allocated " << total.allocations << " times (" << total.bytes << " bytes), over the budget of " << allocation_budget << "." << std::endl;
+            for (int i = 0; i < bgq_opengl::AllocationTracker::getNumTags(); i++) {
+                
+                bgq_opengl::AllocationStats phase = bgq_opengl::AllocationTracker::getStats(i);
+                std::cerr << "  " << phase.tag << ": " << phase.allocations << " (" << phase.bytes << " bytes)" << std::endl;
+                
+            }
+            
+            clean();
+            exit(1);
+            
+        }
         
-        // Update other events like input handling.
-        glfwPollEvents();
-        glfwSwapBuffers(window);
+    }
+
+    // Report the throughput of headless runs once the GPU is done.
+    if (headless) {
+        
+        glFinish();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - loop_start;
+        std::cerr << "Rendered " << max_frames << " frames at " << render_width << "x" << render_height << " in " << elapsed.count() << " ms (" << elapsed.count() / max_frames << " ms per frame)." << std::endl;
+        
+        // Read the last frames too, and report the GPU time of every pass.
+        bgq_opengl::GpuProfiler::beginFrame();
+        for (int i = 0; i < bgq_opengl::GpuProfiler::getNumZones(); i++) {
+            
+            bgq_opengl::ZoneStats zone = bgq_opengl::GpuProfiler::getStats(i);
+            std::cerr << "  GPU " << zone.name << ": " << zone.mean << " ms avg, p50 " << zone.median << ", p95 " << zone.p95 << ", max " << zone.max << " (" << zone.samples << " frames)" << std::endl;
+            
+        }
         
     }
 
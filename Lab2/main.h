@@ -20,22 +20,54 @@
 #define WINDOW_HEIGHT 800
 #define GAME_NAME "Real-time animation"
 #define NORM_SIZE 1.0
+#define MAX_POINT_LIGHTS 128
+#define ALLOCATION_WARMUP_FRAMES 60
+#define MESH_CACHE_DIRECTORY "mesh_cache"
+#define PROGRAM_CACHE_DIRECTORY "program_cache"
+#define LOADER_THREADS 0
+#define BENCH_FRAMES 120
+#define BENCH_WARMUP_FRAMES 10
+#define BENCH_T_THRESHOLD 3.0
+#define REFERENCE_THREADS 0
+#define PROBE_FACES_PER_FRAME 2
+#define PROBE_RANGE 2.0
 
+#include <initializer_list>
 #include <vector>
 #include <string>
 #include <ctime>
+#include <chrono>
 
 #include "GL/glew.h"
 #include "GLFW/glfw3.h"
 
+#include "classes/allocation_tracker/allocation_tracker.h"
+#include "classes/asset_loader/asset_loader.h"
+#include "classes/benchmark/benchmark.h"
 #include "classes/camera/camera.h"
+#include "classes/cubemap_filter/cubemap_filter.h"
+#include "classes/fbo/fbo.h"
+#include "classes/gpu_timer/gpu_timer.h"
+#include "classes/headless_context/headless_context.h"
+#include "classes/light_clusters/light_clusters.h"
 #include "classes/object/object.h"
+#include "classes/program_cache/program_cache.h"
+#include "classes/ray_tracer/ray_tracer.h"
+#include "classes/reflection_probe/reflection_probe.h"
+#include "classes/render_queue/render_queue.h"
 #include "classes/shader/shader.h"
+#include "classes/shader_compiler/shader_compiler.h"
+#include "classes/shader_permutations/shader_permutations.h"
+#include "classes/shader_watcher/shader_watcher.h"
+#include "classes/spherical_harmonics/spherical_harmonics.h"
 #include "classes/skybox/skybox.h"
+#include "classes/ubo/ubo.h"
+#include "structs/mesh_data/mesh_data.h"
+#include "structs/point_light/point_light.h"
+#include "structs/uniform_blocks/uniform_blocks.h"
 
 std::vector<bgq_opengl::Camera> cameras;	/// Holds all the existing cameras.
 std::vector<bgq_opengl::Object> objects;	/// Holds all the displayed objects.
-std::vector<bgq_opengl::Shader> shaders;    /// Holds all the initialized shanders.
 std::vector<bgq_opengl::Skybox> skyboxes;   /// Holds all the initialized skyboxes.
 int current_camera = 0;                     /// Current camera activated.
 int current_shader = 0;                     /// Current shader activated.
@@ -43,16 +75,34 @@ int current_skybox = 0;                     /// Current skybox activated.
 int current_object = 0;                     /// Current object activated.
 int current_scene = 0;
 GLFWwindow *window = 0;						/// Window ID.
+GLFWwindow *compile_window = 0;				/// Hidden window whose context builds the programs of hot reloads, or 0.
 double internal_time = 0;					/// Time that will rule everything in the game.
 double time_start = 0;						/// Time that will count as the beginning.
 bgq_opengl::Light scene_light;              /// The light in the scene.
 bgq_opengl::Shader *sky_shader;
-bgq_opengl::Shader *fancy_shader;
+bgq_opengl::ShaderPermutations *environment_shaders;   /// Every reflection and refraction model, built as it is used.
+bool use_instancing = true;                 /// Draw the basic scene with a single instanced call.
+bool use_culling = true;                    /// Skip the geometries outside the view of the camera.
+bgq_opengl::UBO *frame_block;               /// Camera and light, shared by all programs.
+bgq_opengl::UBO *basic_material;            /// Material of the basic scene.
+bgq_opengl::UBO *irradiance_block;          /// Diffuse light of the current skybox.
+bgq_opengl::RenderQueue render_queue;       /// Draws of the frame, sorted by state.
 float refraction_eta = 0.8;
 float fresnel_power = 5.0;
 float refraction_eta_r = 0.8;
 float refraction_eta_g = 0.8;
 float refraction_eta_b = 0.8;
+float roughness = 0.0;                      /// Picks the prefiltered level of the environment, shared by all materials.
+
+// Features of the reflection, refraction, fresnel and chromatic fresnel models of the basic scene.
+const unsigned int BASIC_FEATURES[4] = {
+    bgq_opengl::ShaderPermutations::REFLECT,
+    bgq_opengl::ShaderPermutations::REFRACT,
+    bgq_opengl::ShaderPermutations::REFLECT | bgq_opengl::ShaderPermutations::REFRACT | bgq_opengl::ShaderPermutations::FRESNEL,
+    bgq_opengl::ShaderPermutations::REFLECT | bgq_opengl::ShaderPermutations::REFRACT | bgq_opengl::ShaderPermutations::FRESNEL | bgq_opengl::ShaderPermutations::DISPERSION
+};
+const unsigned int FANCY_FEATURES = BASIC_FEATURES[3] | bgq_opengl::ShaderPermutations::TINT;  /// Features of the objects of the fancy scene.
+const unsigned int INSTANCED_FEATURES = bgq_opengl::ShaderPermutations::INSTANCED;            /// Features of the copies of the basic scene drawn at once, which pick their own models.
 
 // Fancy scene.
 float tray_interpol_color = 1.0;
@@ -62,6 +112,7 @@ float tray_eta_r = 0.1;
 float tray_eta_g = 0.1;
 float tray_eta_b = 0.1;
 bgq_opengl::Object *tray;
+bgq_opengl::UBO *tray_material;
 
 float bottle_interpol_color = 0.3;
 glm::vec3 bottle_color = glm::vec3(41.0f / 255.0f, 71.0f / 255.0f, 41.0f / 255.0f);
@@ -70,6 +121,7 @@ float bottle_eta_r = 0.1;
 float bottle_eta_g = 0.1;
 float bottle_eta_b = 0.1;
 bgq_opengl::Object *bottle;
+bgq_opengl::UBO *bottle_material;
 
 float ico_interpol_color = 1.0;
 glm::vec3 ico_color = glm::vec3(1.0f, 1.0f, 1.0f);
@@ -78,6 +130,7 @@ float ico_eta_r = 0.85;
 float ico_eta_g = 0.80;
 float ico_eta_b = 0.83;
 bgq_opengl::Object *ico;
+bgq_opengl::UBO *ico_material;
 
 float mirror_interpol_color = 0.6;
 glm::vec3 mirror_color = glm::vec3(238.0 / 255.0, 185.0 / 255.0, 32.0 / 255.0);
@@ -86,9 +139,145 @@ float mirror_eta_r = 0.85;
 float mirror_eta_g = 0.80;
 float mirror_eta_b = 0.83;
 bgq_opengl::Object *mirror;
+bgq_opengl::UBO *mirror_material;
+bgq_opengl::UBO *mirror_frame_material;    /// The frame of the mirror is not tinted.
+
+// Point lights of the fancy scene.
+std::vector<bgq_opengl::PointLight> point_lights;   /// Allocated once with MAX_POINT_LIGHTS lights.
+bgq_opengl::LightClusters *light_clusters;          /// Assigns the point lights to the clusters.
+int num_point_lights = 32;                          /// Number of point lights turned on.
+
+// Reflection probes of the fancy scene.
+bool use_probes = true;                             /// Reflect the nearby objects with a probe per object.
+int probe_faces_per_frame = PROBE_FACES_PER_FRAME;  /// Probe faces rendered per frame, at most.
+int next_probe = 0;                                 /// Probe that is looked at first for the next face.
+std::vector<bgq_opengl::ReflectionProbe> probes;    /// One probe per object of the fancy scene, in the same order.
+bgq_opengl::RenderQueue probe_queue;                /// Draws of the probe faces.
+bgq_opengl::UBO *probe_cluster_block;               /// Empty light clusters, which leave the point lights out of the probes.
+
+// Startup.
+std::chrono::steady_clock::time_point startup_time;    /// Start of the program, where the startup timeline begins.
+double time_to_first_frame = -1;                        /// Milliseconds until the first frame was shown, or -1 before that.
+
+// Shader hot reload.
+bgq_opengl::ShaderWatcher *shader_watcher = 0;          /// Watches the sources of the programs, or 0 in headless runs.
+std::vector<bgq_opengl::Shader*> watched_shaders;       /// Programs that are rebuilt when their sources are saved.
+std::vector<std::string> changed_shaders;               /// Sources saved since the last frame, kept between frames.
+
+// Test runs.
+long allocation_budget = -1;    /// Allocations allowed per frame after the warm up, or -1 for no limit.
+long max_frames = -1;           /// Frames to render before exiting, or -1 to run until the window closes.
+const char *bake_directory = 0; /// Directory whose skyboxes are baked before exiting, if any.
+const char *bake_image = 0;     /// Image that is baked into a texture before exiting, if any.
+GLenum bake_format = GL_RGBA8;  /// Format of the baked files.
+
+// Headless runs.
+bool headless = false;                              /// Render into an FBO through a surfaceless context instead of a window.
+int render_width = WINDOW_WIDTH;                    /// Width of the window or the FBO.
+int render_height = WINDOW_HEIGHT;                  /// Height of the window or the FBO.
+int forced_shader = -1;                             /// Shading model of every copy in the basic scene, or -1 for one each.
+double time_step = 0;                               /// Fixed time between frames, or 0 to follow the clock.
+long current_frame = 0;                             /// Number of the frame being rendered.
+const char *output_filename = 0;                    /// PNG the last frame is written to, or every frame if it has a %d.
+bgq_opengl::HeadlessContext *headless_context = 0;  /// The context of headless runs.
+bgq_opengl::FBO *offscreen = 0;                     /// The FBO headless runs render into.
+std::vector<unsigned char> output_pixels;           /// Pixels read back from the FBO, kept between frames.
+
+// Benchmark runs. The rtr_bench target is the same program built with BGQ_BENCH_MAIN, which runs the benchmark by default.
+#ifdef BGQ_BENCH_MAIN
+const char *bench_prefix = "rtr_bench"; /// Name of the JSON and CSV files of the benchmark, without extension, if one is run.
+#else
+const char *bench_prefix = 0;       /// Name of the JSON and CSV files of the benchmark, without extension, if one is run.
+#endif
+long bench_frames = BENCH_FRAMES;   /// Frames measured in every case of the benchmark.
+long bench_rays = 0;                /// Rays cast per model by the ray query benchmark, or 0 to skip it.
+const char *compare_baseline = 0;   /// CSV of the baseline run to compare against, if any.
+const char *compare_current = 0;    /// CSV of the run to check against the baseline.
+
+// Reference runs.
+bool reference = false;     /// Render the frame on the CPU with the ray tracer instead of the GPU.
+int reference_depth = 0;    /// Bounces traced before the environment is looked up, 0 to match the shaders.
+bool two_interface = false; /// Trace the refracted rays through the objects instead of stopping at the first surface.
 
 const glm::vec4 background(82 / 255.0, 103 / 255.0, 125 / 255.0, 1.0);	/// This is just the fog color.
 
+/**
+ * @brief Bake the skyboxes of a directory.
+ *
+ * Looks for skyboxes in a directory and its subdirectories, decodes their
+ * faces in parallel and bakes every one of them into a .cubemap file next to
+ * its +X face, which is then loaded instead of the images. Compressing them
+ * is done in parallel too, one skybox per thread.
+ *
+ * @param directory The directory with the skyboxes.
+ * @param format GL_RGBA8, or the compressed format of the baked files.
+ *
+ * @returns True if every skybox was baked. False otherwise.
+ */
+bool bakeSkyboxes(const char *directory, GLenum format);
+
+/**
+ * @brief Bake a texture.
+ *
+ * Decodes an image and bakes it into a .texture file next to it, which is
+ * then loaded instead of the image.
+ *
+ * @param image The image.
+ * @param format GL_RGBA8, or the compressed format of the baked file.
+ *
+ * @returns True if the texture was baked. False otherwise.
+ */
+bool bakeTexture(const char *image, GLenum format);
+
+/**
+ * @brief Run a benchmark case.
+ *
+ * Renders the current scene while the camera orbits it, first a few frames
+ * to warm up and then the measured ones, and adds them to the benchmark.
+ *
+ * @param benchmark The benchmark the frames are added to.
+ * @param gpu_timer The timer of the GPU, or nullptr if there are no timer queries.
+ * @param scene The name of the scene.
+ * @param model The name of the model.
+ * @param skybox The name of the skybox.
+ * @param shader The name of the shading program.
+ */
+void benchmarkCase(bgq_opengl::Benchmark *benchmark, bgq_opengl::GpuTimer *gpu_timer, const char *scene, const char *model, const char *skybox, const char *shader);
+
+/**
+ * @brief Benchmark the ray queries.
+ *
+ * Builds the Bvh of every model of the basic scene, on this thread and on a
+ * pool, and casts random rays against it with the scalar and the AVX2
+ * kernels and then in batches on the pool, reporting the rays per second of
+ * each and per core. Both kernels have to find the same hits.
+ *
+ * @returns True if every model was loaded and the kernels agree. False otherwise.
+ */
+bool benchmarkRays();
+
+/**
+ * @brief Build the materials.
+ *
+ * Fills the material blocks of both scenes from the current settings, for
+ * the GPU and the reference renderer alike.
+ *
+ * @param basic Outputs the material of the basic scene.
+ * @param tray_block Outputs the material of the tray.
+ * @param bottle_block Outputs the material of the bottle.
+ * @param ico_block Outputs the material of the icosahedron.
+ * @param mirror_block Outputs the material of the mirror.
+ * @param mirror_frame_block Outputs the material of the frame of the mirror.
+ */
+void buildMaterials(bgq_opengl::MaterialBlock *basic, bgq_opengl::MaterialBlock *tray_block, bgq_opengl::MaterialBlock *bottle_block, bgq_opengl::MaterialBlock *ico_block, bgq_opengl::MaterialBlock *mirror_block, bgq_opengl::MaterialBlock *mirror_frame_block);
+
+/**
+ * @brief Bind the output of the frame.
+ *
+ * Binds the FBO of headless runs, or the window otherwise, with its viewport.
+ */
+void bindOutput();
+
 /**
  * @brief Clean everything to end the program.
  *
@@ -117,6 +306,31 @@ void displayElements();
  */
 void displayGUI();
 
+/**
+ * @brief Get the environment of a fancy object.
+ *
+ * Get the cube map an object of the fancy scene reflects, which is its probe
+ * once it is ready and the skybox otherwise. Probes are not prefiltered, so
+ * rough materials always reflect the skybox.
+ *
+ * @param probe The index of the object, or -1 for the skybox.
+ *
+ * @returns The cube map.
+ */
+bgq_opengl::Cubemap* getEnvironment(int probe);
+
+/**
+ * @brief Get the faces of a skybox.
+ *
+ * Get the images of the faces of a skybox, in the +X, -X, +Y, -Y, +Z, -Z
+ * order of the cubemaps.
+ *
+ * @param skybox The index of the skybox.
+ *
+ * @returns The names of the images.
+ */
+std::vector<std::string> getSkyboxFaces(int skybox);
+
 /**
  * @brief Handles the key events.
  *
@@ -134,10 +348,197 @@ void initElements();
 /**
  * @brief Init the environment.
  *
- * Initialize the OpenGL, Glew and Freeglut environments.
+ * Initialize the OpenGL, Glew and Freeglut environments. Headless runs get a
+ * surfaceless context and an FBO instead of a window.
  */
 void initEnvironment(int argc, char** argv);
 
+/**
+ * @brief Init the window.
+ *
+ * Initialize GLFW and create the window and its context.
+ */
+void initWindow();
+
+/**
+ * @brief Load the meshes of a model.
+ *
+ * Loads the meshes of a model, through the mesh cache, without a context.
+ *
+ * @param filename The name of the model file.
+ * @param meshes Outputs the meshes.
+ *
+ * @returns True if the model has meshes. False otherwise.
+ */
+bool loadMeshes(const char *filename, std::vector<bgq_opengl::MeshData> *meshes);
+
+/**
+ * @brief Load a model for the reference renderer.
+ *
+ * Loads the meshes of a model without a context and adds them to the ray
+ * tracer, along with the centre and scale the objects get from them.
+ *
+ * @param filename The name of the model file.
+ * @param tracer The ray tracer.
+ * @param meshes Outputs the indices of the meshes in the ray tracer.
+ * @param centre Outputs the centre of the model.
+ * @param scale_rat Outputs the scale that normalizes the model.
+ *
+ * @returns True if the model was loaded. False otherwise.
+ */
+bool loadReferenceModel(const char *filename, bgq_opengl::RayTracer *tracer, std::vector<int> *meshes, glm::vec3 *centre, float *scale_rat);
+
+/**
+ * @brief Parse the command line arguments.
+ *
+ * Parse the command line arguments. --frames N exits after N frames and
+ * --allocation-budget N fails the run when a frame allocates more than N
+ * times after the warm up. The budget needs BGQ_TRACK_ALLOCATIONS.
+ * --bake-skyboxes DIR bakes the skyboxes in DIR and --bake-texture IMAGE
+ * bakes a texture, and then the program exits. --bake-format sets the
+ * format of the baked files to rgba8, which is the default, bc1 or bc7.
+ *
+ * --headless renders without a window, which needs BGQ_HEADLESS, and
+ * --output FILE writes the last frame, or every frame if FILE has a %d, as a
+ * PNG. Headless runs default to 1 frame and a time step of 1/60 s, so that
+ * they always render the same images. The frames are set with --scene
+ * basic|fancy, --model teapot|chair|van, --skybox sky|hotel|chapel,
+ * --shader reflection|refraction|fresnel|chromatic, --instancing on|off,
+ * --culling on|off, --probes on|off, --roughness R, --width W, --height H
+ * and --time-step S.
+ *
+ * --bench PREFIX runs the benchmark and writes PREFIX.json and PREFIX.csv,
+ * measuring --bench-frames N frames per case. --compare BASE CURRENT reads
+ * two of those CSV files, reports the cases that got slower and exits with
+ * an error if there are any. --bench-rays N casts N rays against every
+ * model of the basic scene and reports how many per second, without a
+ * context.
+ *
+ * --reference renders the frame with the CPU ray tracer instead and writes
+ * it to --output, without a context. --reference-depth N traces N bounces
+ * before looking the environment up, and --two-interface bends the
+ * refracted rays again as they leave the objects.
+ */
+void parseArguments(int argc, char** argv);
+
+/**
+ * @brief Parse a named option.
+ *
+ * Finds the value of an option among its choices, and ends the program if
+ * it is not one of them.
+ *
+ * @param option The name of the option, for the error message.
+ * @param value The value given.
+ * @param choices The accepted values.
+ *
+ * @returns The index of the value among the choices.
+ */
+int parseChoice(const char *option, const char *value, std::initializer_list<const char*> choices);
+
+/**
+ * @brief Place the objects of the fancy scene.
+ *
+ * Sets the transforms of the objects of the fancy scene for this frame.
+ */
+void placeFancyObjects();
+
+/**
+ * @brief Reload the saved shaders.
+ *
+ * Starts rebuilding the programs whose sources were saved since the last
+ * frame, and swaps in the ones the driver is done with. The programs keep
+ * drawing with their previous version until then, or for good if the new
+ * one does not build. Without parallel shader compilation the programs are
+ * built by the ShaderCompiler, so the frame never waits for the driver.
+ */
+void reloadShaders();
+
+/**
+ * @brief Render a face of a probe.
+ *
+ * Renders the next out of date face of a probe with the other objects of the
+ * fancy scene and the skybox, but without the point lights.
+ *
+ * @param probe The index of the probe.
+ */
+void renderProbeFace(int probe);
+
+/**
+ * @brief Render the reference frame.
+ *
+ * Ray traces the frame a headless run would render, with the same models,
+ * materials, camera and environment, on every core, and writes it as a PNG.
+ *
+ * @returns True if the frame was written. False otherwise.
+ */
+bool renderReference();
+
+/**
+ * @brief Run the benchmark.
+ *
+ * Renders every combination of scene, model, skybox and shading program with
+ * the same camera orbit and a fixed time step, and writes the times and
+ * counters of every case.
+ *
+ * @returns True if the results could be written. False otherwise.
+ */
+bool runBenchmark();
+
+/**
+ * @brief Queue the fancy scene.
+ *
+ * Queues the objects of the fancy scene with their materials and
+ * environments.
+ *
+ * @param queue The queue the draws go to.
+ * @param camera The camera the objects are culled with.
+ * @param skipped The object whose probe is being rendered, which is left out and makes the rest reflect the skybox, or -1.
+ */
+void submitFancyScene(bgq_opengl::RenderQueue *queue, bgq_opengl::Camera &camera, int skipped);
+
+/**
+ * @brief Update the point lights.
+ *
+ * Moves the point lights of the fancy scene and assigns them to the light
+ * clusters. The lights are updated in place, so nothing is allocated.
+ */
+void updatePointLights();
+
+/**
+ * @brief Update the uniform blocks.
+ *
+ * Update the per-frame and per-material uniform blocks. Only the blocks whose
+ * contents changed since the last frame are uploaded.
+ */
+void updateBlocks();
+
+/**
+ * @brief Update the per-frame block.
+ *
+ * Update the per-frame block with the matrices of a camera.
+ *
+ * @param camera The camera.
+ */
+void updateFrameBlock(bgq_opengl::Camera &camera);
+
+/**
+ * @brief Update the reflection probes.
+ *
+ * Picks the resolution of every probe, checks what changed around it and
+ * renders a few of the faces that are out of date, going round the probes.
+ */
+void updateProbes();
+
+/**
+ * @brief Write the rendered frame.
+ *
+ * Reads the FBO of headless runs back and writes it as a PNG. A %d in the
+ * output name is replaced by the number of the frame.
+ *
+ * @param frame The number of the frame.
+ */
+void writeFrame(long frame);
+
 /**
  * @brief Main function.
  * 
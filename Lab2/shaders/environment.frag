@@ -0,0 +1,247 @@
+#version 330 core
+
+// This shader has been adapted from the code found on https://www.scss.tcd.ie/Michael.Manzke/CS7055/GLSL/GLSL-3rdEd-refraction.pdf.
+// Its features are described in environment.vert.
+
+#ifdef INSTANCED
+#define REFLECT
+#define REFRACT
+#define FRESNEL
+#define DISPERSION
+#endif
+
+#ifdef FRESNEL
+#define VERTEX_RAYS
+#endif
+
+#ifdef INSTANCED
+// Only the chromatic fresnel copies refract every channel with its own ratio.
+#define ETA (shadingModel == 3 ? etaG : eta)
+#define ETA_R (shadingModel == 3 ? etaR : eta)
+#define ETA_B (shadingModel == 3 ? etaB : eta)
+#elif defined(DISPERSION)
+#define ETA etaG
+#define ETA_R etaR
+#define ETA_B etaB
+#else
+#define ETA eta
+#endif
+
+#if !defined(VERTEX_RAYS) || defined(TINT) || defined(INSTANCED)
+in vec3 vertexPosition;             // Position from the VS.
+in vec3 vertexNormal;	            // Normal from the VS.
+#endif
+
+#ifdef VERTEX_RAYS
+#ifdef REFLECT
+in vec3 Reflect;
+#endif
+#ifdef REFRACT
+in vec3 Refract;
+#ifdef DISPERSION
+in vec3 RefractR;
+in vec3 RefractB;
+#endif
+#endif
+#if defined(REFLECT) && defined(REFRACT)
+in float Ratio;
+#endif
+#endif
+
+#ifdef INSTANCED
+flat in int shadingModel;           // Shading model of the copy.
+#endif
+
+layout (std140) uniform FrameBlock {
+    mat4 View;              // Imports the View matrix.
+    mat4 Projection;        // Imports the projection matrix.
+    vec4 lightColor;        // Light color.
+    vec3 lightPos;          // Light position in view space.
+    float time;             // Time in seconds.
+};
+
+layout (std140) uniform MaterialBlock {
+    vec3 objectColor;       // Tint of the object.
+    float mixColor;         // How much of the environment is mixed with the tint.
+    float eta;              // The ratio.
+    float fresnelPower;     // Power of the fresnel term.
+    float etaR;             // The ratio of the red channel.
+    float etaG;             // The ratio of the green channel.
+    float etaB;             // The ratio of the blue channel.
+    float roughness;        // Picks the level of the prefiltered environment.
+};
+
+uniform samplerCube skybox;         // The skybox.
+
+out vec4 outColor; // Outputs color in RGBA.
+
+// Levels of the prefiltered environment past the first one, which go from a roughness of 0 to 1.
+const float ROUGH_LEVELS = 5.0;
+
+#ifdef TINT
+layout (std140) uniform ClusterBlock {
+    uvec4 clusterGrid;      // Number of clusters in x, y and z, and number of lights.
+    vec2 screenSize;        // Size of the framebuffer in pixels.
+    float sliceScale;       // Scale applied to the log of the depth to get the slice.
+    float sliceBias;        // Bias added to the scaled log of the depth to get the slice.
+};
+
+layout (std140) uniform IrradianceBlock {
+    vec4 irradiance[9];     // Spherical harmonics of the diffuse light of the environment, with their constants folded in.
+};
+
+uniform float materialShininess;    // Shininess of the material.
+uniform samplerBuffer lightData;    // Position and radius, and color and intensity of the point lights in view space.
+uniform usamplerBuffer clusterRanges;   // Offset and count of the lights of every cluster.
+uniform usamplerBuffer lightIndices;    // Light indices of all the clusters.
+
+// Adds the highlights of the point lights in the cluster of this fragment.
+vec3 pointLightsSpecular() {
+    
+    if (clusterGrid.w == 0u)
+        return vec3(0.0);
+    
+    // Find the cluster from the tile on the screen and the depth slice.
+    uvec2 tile = uvec2(gl_FragCoord.xy / screenSize * vec2(clusterGrid.xy));
+    tile = min(tile, clusterGrid.xy - 1u);
+    int slice = int(floor(log(-vertexPosition.z) * sliceScale + sliceBias));
+    uint z = uint(clamp(slice, 0, int(clusterGrid.z) - 1));
+    uint cluster = (z * clusterGrid.y + tile.y) * clusterGrid.x + tile.x;
+    uvec2 range = texelFetch(clusterRanges, int(cluster)).rg;
+    
+    vec3 n = normalize(vertexNormal);
+    vec3 v = normalize(-vertexPosition);
+    float shininess = materialShininess > 1.0 ? materialShininess : 64.0;
+    vec3 specular = vec3(0.0);
+    
+    for (uint i = range.x; i < range.x + range.y; i++) {
+        
+        int light = int(texelFetch(lightIndices, int(i)).r);
+        vec4 positionRadius = texelFetch(lightData, 2 * light);
+        vec4 colorIntensity = texelFetch(lightData, 2 * light + 1);
+        
+        // Blinn-Phong highlight that fades out smoothly at the radius.
+        vec3 toLight = positionRadius.xyz - vertexPosition;
+        float dist = length(toLight);
+        float falloff = clamp(1.0 - dist / positionRadius.w, 0.0, 1.0);
+        vec3 h = normalize(toLight / dist + v);
+        specular += colorIntensity.rgb * colorIntensity.a * falloff * falloff * pow(max(dot(n, h), 0.0), shininess);
+        
+    }
+    
+    return specular;
+    
+}
+
+// Diffuse light of the environment around a world space normal, mirrored along z like the lookups.
+vec3 environmentIrradiance(vec3 n) {
+    
+    vec3 color = irradiance[0].rgb;
+    color += irradiance[1].rgb * n.y + irradiance[2].rgb * n.z + irradiance[3].rgb * n.x;
+    color += irradiance[4].rgb * (n.x * n.y) + irradiance[5].rgb * (n.y * n.z) + irradiance[6].rgb * (3.0 * n.z * n.z - 1.0);
+    color += irradiance[7].rgb * (n.x * n.z) + irradiance[8].rgb * (n.x * n.x - n.y * n.y);
+    
+    return max(color, vec3(0.0));
+    
+}
+#endif
+
+// Moves a direction from view space to where the environment is looked up.
+vec3 toEnvironment(vec3 direction) {
+    
+#ifdef TINT
+    // The environments of the fancy scene are looked up in world space, mirrored along z like the skybox does.
+    return mat3(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, -1.0) * transpose(mat3(View)) * direction;
+#else
+    return direction;
+#endif
+    
+}
+
+// Looks a direction up in the environment. The fresnel models are as rough as the material, and the level only
+// depends on the roughness, since the levels past the first hold GGX lobes instead of minified copies.
+vec3 environment(vec3 direction) {
+    
+#ifdef FRESNEL
+    return textureLod(skybox, direction, roughness * ROUGH_LEVELS).rgb;
+#else
+    // The pure models are perfect mirrors and lenses, so they ignore the roughness.
+    return textureLod(skybox, direction, 0.0).rgb;
+#endif
+    
+}
+
+void main() {
+    
+#ifndef VERTEX_RAYS
+    // Without the fresnel term, the rays are traced per fragment.
+    vec3 i = normalize(vertexPosition);
+    vec3 n = normalize(vertexNormal);
+    
+#ifdef REFLECT
+    vec3 Reflect = toEnvironment(reflect(i, n));
+#endif
+    
+#ifdef REFRACT
+    vec3 Refract = toEnvironment(refract(i, n, ETA));
+#ifdef DISPERSION
+    vec3 RefractR = toEnvironment(refract(i, n, ETA_R));
+    vec3 RefractB = toEnvironment(refract(i, n, ETA_B));
+#endif
+#endif
+    
+#if defined(REFLECT) && defined(REFRACT)
+    // Both are weighed the same.
+    float Ratio = 0.5;
+#endif
+#endif
+    
+    vec3 color = vec3(0.0);
+    
+#ifdef INSTANCED
+    // The pure copies trace their rays per fragment and ignore the roughness, like their own permutations.
+    if (shadingModel < 2) {
+        
+        vec3 i = normalize(vertexPosition);
+        vec3 n = normalize(vertexNormal);
+        vec3 direction = shadingModel == 0 ? reflect(i, n) : refract(i, n, eta);
+        color = textureLod(skybox, toEnvironment(direction), 0.0).rgb;
+        
+    } else {
+#endif
+    
+#ifdef REFRACT
+#ifdef DISPERSION
+#ifdef INSTANCED
+    // The plain fresnel copies only need one refraction fetch.
+    if (shadingModel == 2)
+        color = environment(Refract);
+    else
+#endif
+    color = vec3(environment(RefractR).r, environment(Refract).g, environment(RefractB).b);
+#else
+    color = environment(Refract);
+#endif
+#endif
+    
+#ifdef REFLECT
+#ifdef REFRACT
+    color = mix(color, environment(Reflect), Ratio);
+#else
+    color = environment(Reflect);
+#endif
+#endif
+    
+#ifdef INSTANCED
+    }
+#endif
+    
+#ifdef TINT
+    // The tint is lit by the environment.
+    vec3 tint = objectColor * environmentIrradiance(toEnvironment(normalize(vertexNormal)));
+    color = mix(tint, color, mixColor) + pointLightsSpecular();
+#endif
+    
+    outColor = vec4(color, 1.0);
+    
+}
@@ -0,0 +1,154 @@
+#version 330 core
+
+// This shader has been adapted from the code found on https://www.scss.tcd.ie/Michael.Manzke/CS7055/GLSL/GLSL-3rdEd-refraction.pdf.
+// It is the source of every reflection and refraction model. Each one is a
+// permutation of these features, which the program defines before compiling it:
+//
+// REFLECT      Looks the reflected ray up in the environment.
+// REFRACT      Looks the refracted ray up in the environment.
+// FRESNEL      Weighs both by the fresnel term. The rays are traced per vertex, and per fragment without it.
+// DISPERSION   Refracts every channel with its own ratio.
+// TINT         Mixes in the tint of the object, lit by the environment and the point lights, and looks the environment up in world space.
+// INSTANCED    Reads the model matrix and the shading model of every copy from its instance, so that the copies of the
+//              comparison scene are drawn at once. Each copy picks its model: 0 reflection, 1 refraction, 2 fresnel and
+//              3 chromatic fresnel. The fresnel copies are shaded like their own permutations, and the pure ones trace
+//              their rays per fragment and ignore the roughness, like theirs do.
+//
+// Only the outputs a permutation reads are declared, so nothing else is computed or interpolated.
+
+#ifdef INSTANCED
+#define REFLECT
+#define REFRACT
+#define FRESNEL
+#define DISPERSION
+#endif
+
+#ifdef FRESNEL
+#define VERTEX_RAYS
+#endif
+
+#ifdef INSTANCED
+// Only the chromatic fresnel copies refract every channel with its own ratio.
+#define ETA (shadingModel == 3 ? etaG : eta)
+#define ETA_R (shadingModel == 3 ? etaR : eta)
+#define ETA_B (shadingModel == 3 ? etaB : eta)
+#elif defined(DISPERSION)
+#define ETA etaG
+#define ETA_R etaR
+#define ETA_B etaB
+#else
+#define ETA eta
+#endif
+
+layout (location = 0) in vec3 inVertex;	// Vertex.
+layout (location = 1) in vec3 inNormal;	// Normal (not necessarily normalized).
+
+#ifdef INSTANCED
+layout (location = 5) in mat4 inModel;	// Model matrix of the instance (takes locations 5 to 8).
+layout (location = 9) in int inShadingModel;	// Shading model of the instance.
+
+flat out int shadingModel;  // Passes the shading model to the fragment shader.
+#endif
+
+layout (std140) uniform FrameBlock {
+    mat4 View;              // Imports the View matrix.
+    mat4 Projection;        // Imports the projection matrix.
+    vec4 lightColor;        // Light color.
+    vec3 lightPos;          // Light position in view space.
+    float time;             // Time in seconds.
+};
+
+layout (std140) uniform MaterialBlock {
+    vec3 objectColor;       // Tint of the object.
+    float mixColor;         // How much of the environment is mixed with the tint.
+    float eta;              // The ratio.
+    float fresnelPower;     // Power of the fresnel term.
+    float etaR;             // The ratio of the red channel.
+    float etaG;             // The ratio of the green channel.
+    float etaB;             // The ratio of the blue channel.
+    float roughness;        // Picks the level of the prefiltered environment.
+};
+
+#ifndef INSTANCED
+uniform mat4 modelView;		// Imports the modelView already multiplied.
+uniform mat4 normalMatrix;	// Imports the normal matrix.
+#endif
+
+#if !defined(VERTEX_RAYS) || defined(TINT) || defined(INSTANCED)
+out vec3 vertexNormal;		// Passes the normal to the fragment shader.
+out vec3 vertexPosition;    // Passes the current vertex to the fragment shader.
+#endif
+
+#ifdef VERTEX_RAYS
+#ifdef REFLECT
+out vec3 Reflect;
+#endif
+#ifdef REFRACT
+out vec3 Refract;
+#ifdef DISPERSION
+out vec3 RefractR;
+out vec3 RefractB;
+#endif
+#endif
+#if defined(REFLECT) && defined(REFRACT)
+out float Ratio;
+#endif
+#endif
+
+// Moves a direction from view space to where the environment is looked up.
+vec3 toEnvironment(vec3 direction) {
+    
+#ifdef TINT
+    // The environments of the fancy scene are looked up in world space, mirrored along z like the skybox does.
+    return mat3(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, -1.0) * transpose(mat3(View)) * direction;
+#else
+    return direction;
+#endif
+    
+}
+
+void main() {
+    
+#ifdef INSTANCED
+    // The copies are only scaled uniformly, so the upper 3x3 of the modelView
+    // transforms the normals correctly once they are normalized.
+    mat4 modelView = View * inModel;
+    vec3 normal = mat3(modelView) * inNormal;
+    shadingModel = inShadingModel;
+#else
+    vec3 normal = vec3(normalMatrix * vec4(inNormal, 0.0));
+#endif
+    vec3 position = vec3(modelView * vec4(inVertex, 1.0));
+    
+#if !defined(VERTEX_RAYS) || defined(TINT) || defined(INSTANCED)
+    vertexNormal = normal;
+    vertexPosition = position;
+#endif
+    
+#ifdef VERTEX_RAYS
+    vec3 i = normalize(position);
+    vec3 n = normalize(normal);
+    
+#ifdef REFLECT
+    Reflect = toEnvironment(reflect(i, n));
+#endif
+    
+#ifdef REFRACT
+    Refract = toEnvironment(refract(i, n, ETA));
+#ifdef DISPERSION
+    RefractR = toEnvironment(refract(i, n, ETA_R));
+    RefractB = toEnvironment(refract(i, n, ETA_B));
+#endif
+#endif
+    
+#if defined(REFLECT) && defined(REFRACT)
+    // Compute the fresnel equation.
+    float F = ((1.0 - ETA) * (1.0 - ETA)) / ((1.0 + ETA) * (1.0 + ETA));
+    Ratio = F + (1.0 - F) * pow((1.0 - dot(-i, n)), fresnelPower);
+#endif
+#endif
+    
+    // Sets the visualized position by applying the camera matrix.
+    gl_Position = Projection * vec4(position, 1.0);
+    
+}
@@ -8,6 +8,7 @@ out vec4 outColor;
 
 void main() {
     
-    outColor = texture(sky, texCoords);
+    // The levels past the first one are prefiltered for glossy materials, so the background only reads the first.
+    outColor = textureLod(sky, texCoords, 0.0);
     
 }
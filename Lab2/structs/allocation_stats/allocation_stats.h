@@ -0,0 +1,37 @@
+/**
+ * @file allocation_stats.h
+ * @brief AllocationStats struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_ALLOCATIONSTATS_H_
+#define BGQ_OPENGL_STRUCT_ALLOCATIONSTATS_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Heap allocation counters.
+	 *
+	 * This Struct holds the heap allocations made while a scope was active.
+	 */
+	struct AllocationStats {
+
+		const char *tag;			/// Name of the scope.
+		unsigned long allocations;	/// Number of calls to operator new.
+		unsigned long bytes;		/// Bytes requested to operator new.
+		unsigned long frees;		/// Number of calls to operator delete.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_ALLOCATIONSTATS_H_
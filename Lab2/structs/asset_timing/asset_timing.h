@@ -0,0 +1,44 @@
+/**
+ * @file asset_timing.h
+ * @brief AssetTiming struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_ASSETTIMING_H_
+#define BGQ_OPENGL_STRUCT_ASSETTIMING_H_
+
+#include <string>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The startup timeline of an asset.
+	 *
+	 * This Struct records when an asset was loaded, in milliseconds since the
+	 * program started. Assets loaded by several jobs, like the faces of a
+	 * cubemap, span from the first job to start to the last one to end.
+	 */
+	struct AssetTiming {
+
+		std::string name;		/// Name of the asset.
+		int jobs;				/// Number of jobs that loaded it.
+		double load_start;		/// When the first job started.
+		double load_end;		/// When the last job ended.
+		double load_time;		/// Time spent by all the jobs together.
+		double upload_start;	/// When the upload started.
+		double upload_end;		/// When the upload ended.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_ASSETTIMING_H_
@@ -0,0 +1,66 @@
+/**
+ * @file benchmark_result.h
+ * @brief BenchmarkResult struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_BENCHMARKRESULT_H_
+#define BGQ_OPENGL_STRUCT_BENCHMARKRESULT_H_
+
+#include <string>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Summary of a series of times.
+	 *
+	 * This Struct holds the statistics of the times of a series of frames, in
+	 * milliseconds.
+	 */
+	struct TimeStats {
+
+		long samples;		/// Number of times.
+		double mean;		/// Mean time.
+		double median;		/// Median time.
+		double p95;			/// 95th percentile.
+		double stddev;		/// Sample standard deviation.
+
+	};
+
+	/**
+	 * @brief The result of a benchmark case.
+	 *
+	 * This Struct holds what was measured while rendering a combination of
+	 * scene, model, skybox and shading program. The counters are averages per
+	 * frame.
+	 */
+	struct BenchmarkResult {
+
+		std::string scene;				/// Name of the scene.
+		std::string model;				/// Name of the model.
+		std::string skybox;				/// Name of the skybox.
+		std::string shader;				/// Name of the shading program.
+		TimeStats cpu;					/// CPU time to record every frame.
+		TimeStats gpu;					/// GPU time of every frame, with no samples if it could not be measured.
+		double draws;					/// Draw calls per frame.
+		double instances;				/// Instances drawn per frame.
+		double program_binds;			/// Program binds per frame.
+		double vao_binds;				/// VAO binds per frame.
+		double texture_binds;			/// Texture binds per frame.
+		double uniform_uploads;			/// Uniform uploads per frame.
+		double block_uploads;			/// Uniform block uploads per frame.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_BENCHMARKRESULT_H_
@@ -0,0 +1,37 @@
+/**
+ * @file bounding_sphere.h
+ * @brief BoundingSphere struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_BOUNDINGSPHERE_H_
+#define BGQ_OPENGL_STRUCT_BOUNDINGSPHERE_H_
+
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A bounding sphere struct.
+	 *
+	 * This Struct represents the bounding sphere of an object.
+	 */
+	struct BoundingSphere {
+
+		glm::vec3 centre;	/// Centre of the sphere.
+		float radius;		/// Radius of the sphere.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_BOUNDINGSPHERE_H_
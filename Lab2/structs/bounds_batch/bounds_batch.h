@@ -0,0 +1,45 @@
+/**
+ * @file bounds_batch.h
+ * @brief BoundsBatch struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_BOUNDSBATCH_H_
+#define BGQ_OPENGL_STRUCT_BOUNDSBATCH_H_
+
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A batch of bounding volumes.
+	 *
+	 * This Struct holds the world boxes and spheres of many things, one array
+	 * per component, so that several of them can be tested at once. The boxes
+	 * are stored as their centres and half extents, and the spheres share the
+	 * centres of the boxes.
+	 */
+	struct BoundsBatch {
+
+		std::vector<float> centre_x;	/// X of the centres.
+		std::vector<float> centre_y;	/// Y of the centres.
+		std::vector<float> centre_z;	/// Z of the centres.
+		std::vector<float> extent_x;	/// Half extents of the boxes along x.
+		std::vector<float> extent_y;	/// Half extents of the boxes along y.
+		std::vector<float> extent_z;	/// Half extents of the boxes along z.
+		std::vector<float> radius;		/// Radii of the spheres around the centres.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_BOUNDSBATCH_H_
@@ -0,0 +1,43 @@
+/**
+ * @file bvh_node.h
+ * @brief BvhNode struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_BVHNODE_H_
+#define BGQ_OPENGL_STRUCT_BVHNODE_H_
+
+#include <cstdint>
+
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A node of a bounding volume hierarchy.
+	 *
+	 * This Struct holds the box of a node and either its children or its
+	 * triangles. The second child always follows the first one, so only the
+	 * first one is stored.
+	 */
+	struct BvhNode {
+
+		glm::vec3 min;		/// Minimum corner of the box.
+		uint32_t first;		/// First triangle of a leaf, or first child of an inner node.
+		glm::vec3 max;		/// Maximum corner of the box.
+		uint32_t count;		/// Number of triangles of a leaf, or 0 for an inner node.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_BVHNODE_H_
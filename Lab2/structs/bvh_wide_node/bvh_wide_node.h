@@ -0,0 +1,47 @@
+/**
+ * @file bvh_wide_node.h
+ * @brief BvhWideNode struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_BVHWIDENODE_H_
+#define BGQ_OPENGL_STRUCT_BVHWIDENODE_H_
+
+#include <cstdint>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A node of a bounding volume hierarchy with 8 children.
+	 *
+	 * This Struct holds the boxes of up to 8 children, one array per
+	 * coordinate, so that a ray can be tested against all of them at once.
+	 * Every child is either another node or a leaf with its triangles. The
+	 * boxes of the unused children are empty and at infinity, so no ray hits
+	 * them.
+	 */
+	struct alignas(32) BvhWideNode {
+
+		float min_x[8];		/// Minimum x of the boxes.
+		float min_y[8];		/// Minimum y of the boxes.
+		float min_z[8];		/// Minimum z of the boxes.
+		float max_x[8];		/// Maximum x of the boxes.
+		float max_y[8];		/// Maximum y of the boxes.
+		float max_z[8];		/// Maximum z of the boxes.
+		uint32_t child[8];	/// Index of the child node, or first triangle of a leaf.
+		uint32_t count[8];	/// Number of triangles of a leaf, or 0 for a node.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_BVHWIDENODE_H_
@@ -0,0 +1,43 @@
+/**
+ * @file compile_job.h
+ * @brief CompileJob struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_COMPILEJOB_H_
+#define BGQ_OPENGL_STRUCT_COMPILEJOB_H_
+
+#include <string>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A program built by the shader compiler.
+	 *
+	 * This Struct holds the sources of a program built on the thread of the
+	 * shader compiler, and the objects it created for them. The objects belong
+	 * to whoever submitted the job once it is done.
+	 */
+	struct CompileJob {
+
+		std::string sources[2];		/// Vertex and fragment sources.
+		bool retrievable;			/// Whether the driver should keep the binary of the program.
+		unsigned int program;		/// The linked program, once it is done.
+		unsigned int shaders[2];	/// Vertex and fragment shaders, once it is done.
+		bool done;					/// Whether the program was built. Guarded by the compiler.
+		bool cancelled;				/// Whether nobody waits for it anymore. Guarded by the compiler.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_COMPILEJOB_H_
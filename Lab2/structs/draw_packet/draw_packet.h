@@ -0,0 +1,51 @@
+/**
+ * @file draw_packet.h
+ * @brief DrawPacket struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_DRAWPACKET_H_
+#define BGQ_OPENGL_STRUCT_DRAWPACKET_H_
+
+#include <cstdint>
+
+#include "GL/glew.h"
+
+#include "classes/cubemap/cubemap.h"
+#include "classes/geometry/geometry.h"
+#include "classes/shader/shader.h"
+#include "classes/ubo/ubo.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A single draw call.
+	 *
+	 * This Struct holds everything a render queue needs to issue one draw call
+	 * later. The geometry brings the VAO, its textures and its shininess, and
+	 * the model matrix is kept in the queue.
+	 */
+	struct DrawPacket {
+
+		Shader *shader;			/// Program the geometry is drawn with.
+		Geometry *geometry;		/// Geometry that is drawn.
+		UBO *material;			/// Material block bound for the draw, or nullptr to keep the current one.
+		Cubemap *environment;	/// Environment bound for the draw, or nullptr to keep the current one.
+		uint32_t transform;		/// Index of the model matrix in the queue.
+		GLsizei count;			/// Number of indices of the geometry.
+		float depth;			/// Distance to the camera along its view direction.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_DRAWPACKET_H_
@@ -0,0 +1,41 @@
+/**
+ * @file draw_stats.h
+ * @brief DrawStats struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_DRAWSTATS_H_
+#define BGQ_OPENGL_STRUCT_DRAWSTATS_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Draw and bind counters.
+	 *
+	 * This Struct holds how many draw calls and binds a frame made, so that
+	 * changes to the renderer can be compared by the work they send to the
+	 * driver.
+	 */
+	struct DrawStats {
+
+		unsigned long draws;			/// Draw calls.
+		unsigned long instances;		/// Instances drawn by those calls.
+		unsigned long program_binds;	/// Calls to glUseProgram.
+		unsigned long vao_binds;		/// Calls to glBindVertexArray.
+		unsigned long texture_binds;	/// Calls to glBindTexture.
+		unsigned long culled;			/// Draw calls skipped because their geometry was outside the view.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_DRAWSTATS_H_
@@ -0,0 +1,37 @@
+/**
+ * @file gl_state_stats.h
+ * @brief GlStateStats struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_GLSTATESTATS_H_
+#define BGQ_OPENGL_STRUCT_GLSTATESTATS_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief State call counters.
+	 *
+	 * This Struct holds how many state changes went through the state cache,
+	 * and how many of them were dropped because they would not have changed
+	 * anything.
+	 */
+	struct GlStateStats {
+
+		unsigned long calls;		/// State changes that reached the driver.
+		unsigned long filtered;		/// State changes dropped as redundant.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_GLSTATESTATS_H_
@@ -0,0 +1,41 @@
+/**
+ * @file image_data.h
+ * @brief ImageData struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_IMAGEDATA_H_
+#define BGQ_OPENGL_STRUCT_IMAGEDATA_H_
+
+#include <memory>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A decoded image.
+	 *
+	 * This Struct holds the pixels of an image decoded on any thread, waiting to
+	 * be uploaded on the one with the OpenGL context. The pixels are freed with
+	 * the last copy of the struct.
+	 */
+	struct ImageData {
+
+		int width;								/// Width in pixels.
+		int height;								/// Height in pixels.
+		int channels;							/// Channels per pixel.
+		std::shared_ptr<unsigned char> pixels;	/// Pixels, row by row.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_IMAGEDATA_H_
@@ -0,0 +1,39 @@
+/**
+ * @file instance.h
+ * @brief Instance struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_INSTANCE_H_
+#define BGQ_OPENGL_STRUCT_INSTANCE_H_
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief An instance of a geometry.
+	 *
+	 * This Struct represents the attributes of every copy of a geometry that is
+	 * drawn with instancing.
+	 */
+	struct Instance {
+
+		glm::mat4 model;		/// Model matrix of the copy.
+		GLint shading_model;	/// Shading model of the copy, when the program picks it per instance.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_INSTANCE_H_
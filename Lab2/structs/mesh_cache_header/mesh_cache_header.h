@@ -0,0 +1,65 @@
+/**
+ * @file mesh_cache_header.h
+ * @brief MeshCacheHeader struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_MESHCACHEHEADER_H_
+#define BGQ_OPENGL_STRUCT_MESHCACHEHEADER_H_
+
+#include <cstdint>
+
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/bounding_sphere/bounding_sphere.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The header of a mesh cache file.
+	 *
+	 * This Struct is at the start of every mesh cache file. It is followed by one
+	 * MeshCacheEntry per geometry and then by the vertices and indices.
+	 */
+	struct MeshCacheHeader {
+
+		char magic[8];			/// Always "BGQMESH".
+		uint32_t version;		/// Version of the format.
+		uint32_t vertex_size;	/// Size of a Vertex when the file was written.
+		uint64_t source_hash;	/// Hash of the contents of the model file.
+		uint64_t source_size;	/// Size of the model file in bytes.
+		int64_t source_time;	/// Time the model file was last written, in nanoseconds of its clock.
+		uint32_t loader_flags;	/// Flags the model file was imported with.
+		uint32_t num_entries;	/// Number of geometries in the file.
+
+	};
+
+	/**
+	 * @brief A geometry in a mesh cache file.
+	 *
+	 * This Struct describes where the data of a geometry is in a mesh cache file,
+	 * along with everything that is derived from it at load.
+	 */
+	struct MeshCacheEntry {
+
+		uint64_t vertex_offset;			/// Offset of the vertices from the start of the file.
+		uint64_t num_vertices;			/// Number of vertices.
+		uint64_t index_offset;			/// Offset of the indices from the start of the file.
+		uint64_t num_indices;			/// Number of indices.
+		float shininess;				/// Shininess of the material.
+		BoundingBox bounding_box;		/// Bounding box of the vertices.
+		BoundingSphere bounding_sphere;	/// Bounding sphere of the vertices.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_MESHCACHEHEADER_H_
@@ -0,0 +1,55 @@
+/**
+ * @file mesh_data.h
+ * @brief MeshData struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_MESHDATA_H_
+#define BGQ_OPENGL_STRUCT_MESHDATA_H_
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/bounding_sphere/bounding_sphere.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A loaded mesh that has not been uploaded yet.
+	 *
+	 * This Struct holds everything a Geometry is built from, so that it can be
+	 * prepared on any thread and only uploaded on the one with the OpenGL context.
+	 * The vertices and indices are either owned in the vectors or, when the
+	 * mapping is set, viewed in the mapped file.
+	 */
+	struct MeshData {
+
+		std::vector<Vertex> vertices;				/// Vertices, when they are owned.
+		std::vector<GLuint> indices;				/// Indices, when they are owned.
+		std::shared_ptr<const MappedFile> mapping;	/// File holding the vertices and indices, when they are not.
+		std::span<const Vertex> mapped_vertices;	/// Vertices inside the mapping.
+		std::span<const GLuint> mapped_indices;		/// Indices inside the mapping.
+		float shininess;							/// Shininess of the material.
+		BoundingBox bounding_box;					/// Bounding box of the vertices.
+		BoundingSphere bounding_sphere;				/// Bounding sphere of the vertices.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_MESHDATA_H_
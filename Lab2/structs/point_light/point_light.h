@@ -0,0 +1,39 @@
+/**
+ * @file point_light.h
+ * @brief PointLight struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_POINTLIGHT_H_
+#define BGQ_OPENGL_STRUCT_POINTLIGHT_H_
+
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A point light struct.
+	 *
+	 * This Struct represents a point light whose influence ends at a given radius.
+	 */
+	struct PointLight {
+
+		glm::vec3 position;	/// Position of the light in world space.
+		float radius;		/// Distance at which the light stops having any effect.
+		glm::vec3 color;	/// Color of the light in RGB.
+		float intensity;	/// Intensity of the light.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_POINTLIGHT_H_
@@ -0,0 +1,42 @@
+/**
+ * @file program_cache_header.h
+ * @brief ProgramCacheHeader struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_PROGRAMCACHEHEADER_H_
+#define BGQ_OPENGL_STRUCT_PROGRAMCACHEHEADER_H_
+
+#include <cstdint>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The header of a program cache file.
+	 *
+	 * This Struct is at the start of every program cache file. It is followed by
+	 * the binary of the program, as the driver returned it.
+	 */
+	struct ProgramCacheHeader {
+
+		char magic[8];			/// Always "BGQPROG".
+		uint32_t version;		/// Version of the format.
+		uint32_t binary_format;	/// Format of the binary, which only the driver understands.
+		uint64_t key;			/// Hash of the sources, the renderer and the version of OpenGL.
+		uint64_t binary_size;	/// Size of the binary in bytes.
+		double compile_time;	/// Milliseconds it took to build the program from its sources.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_PROGRAMCACHEHEADER_H_
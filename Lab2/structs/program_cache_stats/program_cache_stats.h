@@ -0,0 +1,40 @@
+/**
+ * @file program_cache_stats.h
+ * @brief ProgramCacheStats struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_PROGRAMCACHESTATS_H_
+#define BGQ_OPENGL_STRUCT_PROGRAMCACHESTATS_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Program cache counters.
+	 *
+	 * This Struct holds how many programs were loaded from their cached binaries
+	 * and how much time that saved, compared with building them from their
+	 * sources as the run that cached them did.
+	 */
+	struct ProgramCacheStats {
+
+		unsigned long hits;			/// Programs loaded from their binaries.
+		unsigned long misses;		/// Programs without a usable cache file.
+		unsigned long rejected;		/// Binaries the driver did not take.
+		double load_time;			/// Milliseconds spent loading the binaries.
+		double saved_time;			/// Milliseconds saved by not building the programs from their sources.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_PROGRAMCACHESTATS_H_
@@ -0,0 +1,38 @@
+/**
+ * @file ray.h
+ * @brief Ray struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_RAY_H_
+#define BGQ_OPENGL_STRUCT_RAY_H_
+
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A ray.
+	 *
+	 * This Struct holds a ray and how far along it hits are looked for.
+	 */
+	struct Ray {
+
+		glm::vec3 origin;		/// Origin of the ray.
+		glm::vec3 direction;	/// Direction of the ray, which does not need to be normalized.
+		float max_t;			/// Maximum distance, in units of the direction.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_RAY_H_
@@ -0,0 +1,41 @@
+/**
+ * @file ray_hit.h
+ * @brief RayHit struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_RAYHIT_H_
+#define BGQ_OPENGL_STRUCT_RAYHIT_H_
+
+#include <cstdint>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The closest hit of a ray.
+	 *
+	 * This Struct holds where a ray hit a triangle, as the distance along the
+	 * ray and the barycentric coordinates on the triangle.
+	 */
+	struct RayHit {
+
+		float t;			/// Distance along the ray, in units of its direction.
+		float u;			/// Weight of the second vertex.
+		float v;			/// Weight of the third vertex.
+		uint32_t triangle;	/// Index of the triangle in the indices of its mesh.
+		int instance;		/// Instance hit, when the ray was cast against a scene.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_RAYHIT_H_
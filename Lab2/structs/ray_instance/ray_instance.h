@@ -0,0 +1,44 @@
+/**
+ * @file ray_instance.h
+ * @brief RayInstance struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_RAYINSTANCE_H_
+#define BGQ_OPENGL_STRUCT_RAYINSTANCE_H_
+
+#include "glm/glm.hpp"
+
+#include "structs/uniform_blocks/uniform_blocks.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A mesh placed in the scene of the ray tracer.
+	 *
+	 * This Struct holds a mesh with its transforms and the material it is
+	 * shaded with, which uses the same parameters as the shaders.
+	 */
+	struct RayInstance {
+
+		int mesh;					/// Index of the mesh.
+		glm::mat4 model;			/// Model matrix.
+		glm::mat4 inverse;			/// Inverse of the model matrix, to take rays to the space of the mesh.
+		glm::mat3 normal_matrix;	/// Transforms the normals of the mesh to world space.
+		MaterialBlock material;		/// Parameters of the shading model.
+		int shading_model;			/// One of RayTracer::ShadingModels.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_RAYINSTANCE_H_
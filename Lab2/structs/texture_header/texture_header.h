@@ -0,0 +1,59 @@
+/**
+ * @file texture_header.h
+ * @brief TextureHeader struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_TEXTUREHEADER_H_
+#define BGQ_OPENGL_STRUCT_TEXTUREHEADER_H_
+
+#include <cstdint>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The header of a baked texture file.
+	 *
+	 * This Struct is at the start of every baked texture file. It is followed by
+	 * one TextureLevel per mip level and then by the pixels, laid out exactly as
+	 * OpenGL takes them.
+	 */
+	struct TextureHeader {
+
+		char magic[8];				/// Always "BGQTEX".
+		uint32_t version;			/// Version of the format.
+		uint32_t internal_format;	/// OpenGL internal format of the texture.
+		uint32_t format;			/// OpenGL format of the pixels, or 0 if they are compressed.
+		uint32_t type;				/// OpenGL type of the pixels, or 0 if they are compressed.
+		uint32_t width;				/// Width of the faces in the first level.
+		uint32_t height;			/// Height of the faces in the first level.
+		uint32_t num_faces;			/// 1 for a 2D texture and 6 for a cubemap.
+		uint32_t num_levels;		/// Number of mip levels.
+
+	};
+
+	/**
+	 * @brief A mip level in a baked texture file.
+	 *
+	 * This Struct says where the faces of a mip level are. They are stored one
+	 * after the other, in the usual +X, -X, +Y, -Y, +Z, -Z order for cubemaps.
+	 */
+	struct TextureLevel {
+
+		uint64_t offset;		/// Offset of the first face from the start of the file.
+		uint64_t face_bytes;	/// Size of every face in bytes.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_TEXTUREHEADER_H_
@@ -0,0 +1,59 @@
+/**
+ * @file uniform.h
+ * @brief Uniform struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_UNIFORM_H_
+#define BGQ_OPENGL_STRUCT_UNIFORM_H_
+
+#include <string>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief An active uniform of a shader program.
+	 *
+	 * This Struct represents an active uniform as reflected from a linked
+	 * program, together with a shadow copy of the last value uploaded to it.
+	 */
+	struct Uniform {
+
+		std::string name;			/// Name of the uniform in the shaders.
+		GLint location;				/// Location of the uniform in the program.
+		GLenum type;				/// GL type of the uniform (GL_FLOAT_VEC3, GL_SAMPLER_CUBE...).
+		GLint size;					/// Number of elements if it is an array.
+		GLfloat value[16];			/// Shadow copy of the last value uploaded.
+		bool uploaded;				/// Whether the shadow copy holds a valid value.
+
+	};
+
+	/**
+	 * @brief Uniform upload counters.
+	 *
+	 * This Struct holds the counters of the uniform uploads so we can check
+	 * how many of them reach the driver and how many are filtered.
+	 */
+	struct UniformStats {
+
+		unsigned long gl_lookups;	/// Calls to glGetUniformLocation.
+		unsigned long name_lookups;	/// Uniforms resolved by name in the table.
+		unsigned long uploads;		/// glUniform* calls that reached the driver.
+		unsigned long skipped;		/// Uploads skipped because the value was unchanged.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_UNIFORM_H_
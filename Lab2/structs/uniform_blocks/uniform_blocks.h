@@ -0,0 +1,98 @@
+/**
+ * @file uniform_blocks.h
+ * @brief Uniform block structs header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_UNIFORM_BLOCKS_H_
+#define BGQ_OPENGL_STRUCT_UNIFORM_BLOCKS_H_
+
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Binding points of the uniform blocks.
+	 *
+	 * Binding points shared by all the programs and the uniform buffers.
+	 */
+	enum UniformBlockBinding { FRAME_BLOCK_BINDING = 0, MATERIAL_BLOCK_BINDING = 1, CLUSTER_BLOCK_BINDING = 2, IRRADIANCE_BLOCK_BINDING = 3 };
+
+	/**
+	 * @brief Texture units of the shared buffer textures.
+	 *
+	 * Texture units that the buffer textures shared by all the programs are bound to.
+	 */
+	enum BufferTextureUnit { LIGHT_DATA_UNIT = 4, CLUSTER_RANGES_UNIT = 5, LIGHT_INDICES_UNIT = 6 };
+
+	/**
+	 * @brief The per-frame uniform block.
+	 *
+	 * This Struct mirrors the std140 layout of the FrameBlock in the shaders.
+	 */
+	struct FrameBlock {
+
+		glm::mat4 view;				/// View matrix.
+		glm::mat4 projection;		/// Projection matrix.
+		glm::vec4 light_color;		/// Color of the light.
+		glm::vec3 light_position;	/// Position of the light in view space.
+		float time;					/// Time in seconds.
+
+	};
+
+	/**
+	 * @brief The per-material uniform block.
+	 *
+	 * This Struct mirrors the std140 layout of the MaterialBlock in the shaders.
+	 */
+	struct MaterialBlock {
+
+		glm::vec3 object_color;		/// Tint of the object.
+		float mix_color;			/// How much of the environment is mixed with the tint.
+		float eta;					/// Refraction ratio.
+		float fresnel_power;		/// Power of the fresnel term.
+		float eta_r;				/// Refraction ratio of the red channel.
+		float eta_g;				/// Refraction ratio of the green channel.
+		float eta_b;				/// Refraction ratio of the blue channel.
+		float roughness;			/// Roughness, which picks the level of the prefiltered environment.
+		float padding[2];			/// std140 rounds the block up to 16 bytes.
+
+	};
+
+	/**
+	 * @brief The light clusters uniform block.
+	 *
+	 * This Struct mirrors the std140 layout of the ClusterBlock in the shaders.
+	 */
+	struct ClusterBlock {
+
+		glm::uvec4 grid;			/// Number of clusters in x, y and z, and number of lights.
+		glm::vec2 screen_size;		/// Size of the framebuffer in pixels.
+		float slice_scale;			/// Scale applied to the log of the depth to get the slice.
+		float slice_bias;			/// Bias added to the scaled log of the depth to get the slice.
+
+	};
+
+	/**
+	 * @brief The environment irradiance uniform block.
+	 *
+	 * This Struct mirrors the std140 layout of the IrradianceBlock in the shaders.
+	 */
+	struct IrradianceBlock {
+
+		glm::vec4 coefficients[9];	/// Spherical harmonics of the diffuse light in RGB, with their constants folded in.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_UNIFORM_BLOCKS_H_
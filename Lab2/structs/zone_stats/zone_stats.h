@@ -0,0 +1,42 @@
+/**
+ * @file zone_stats.h
+ * @brief ZoneStats struct header file.
+ * @version 1.0.0 (2026-10-16)
+ * @date 2026-10-16
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_ZONESTATS_H_
+#define BGQ_OPENGL_STRUCT_ZONESTATS_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief GPU time of a zone.
+	 *
+	 * This Struct holds the GPU time a zone took in the last frames, in
+	 * milliseconds. When a zone is entered several times in a frame, its times
+	 * are added up.
+	 */
+	struct ZoneStats {
+
+		const char *name;	/// Name of the zone.
+		long samples;		/// Number of frames measured.
+		double last;		/// Time of the last frame measured.
+		double mean;		/// Mean time.
+		double median;		/// Median time.
+		double p95;			/// 95th percentile.
+		double max;			/// Longest time.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_ZONESTATS_H_
@@ -0,0 +1,147 @@
+/**
+ * @file benchmark_test.cpp
+ * @brief Test of the regression checks of the Benchmark class.
+ * @version 1.0.0 (2022-10-21)
+ * @date 2022-10-21
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include <stdlib.h>
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "classes/benchmark/benchmark.h"
+#include "structs/benchmark_result/benchmark_result.h"
+#include "structs/draw_stats/draw_stats.h"
+#include "structs/uniform/uniform.h"
+
+namespace {
+
+	// The same threshold the benchmark mode uses.
+	const double T_THRESHOLD = 3.0;
+
+	/**
+	 * @brief Builds a result with the given times.
+	 *
+	 * @param shader The name of the shading program, which tells the cases apart.
+	 * @param cpu The CPU times.
+	 * @param gpu The GPU times.
+	 *
+	 * @returns The result.
+	 */
+	bgq_opengl::BenchmarkResult makeResult(const std::string &shader, bgq_opengl::TimeStats cpu, bgq_opengl::TimeStats gpu) {
+
+		bgq_opengl::BenchmarkResult result{};
+		result.scene = "basic";
+		result.model = "teapot";
+		result.skybox = "field";
+		result.shader = shader;
+		result.cpu = cpu;
+		result.gpu = gpu;
+
+		return result;
+
+	}
+
+	/**
+	 * @brief Compares a baseline and a current case and checks the regressions found.
+	 *
+	 * @param name The name of the check.
+	 * @param baseline The baseline case.
+	 * @param current The current case.
+	 * @param expected The number of regressions expected.
+	 *
+	 * @returns True if the number of regressions is the expected one. False otherwise.
+	 */
+	bool check(const std::string &name, const bgq_opengl::BenchmarkResult &baseline, const bgq_opengl::BenchmarkResult &current, int expected) {
+
+		std::ostringstream report;
+		int regressions = bgq_opengl::Benchmark::compare({baseline}, {current}, T_THRESHOLD, report);
+		bool passed = regressions == expected;
+		std::cout << name << ": " << regressions << " regression(s), " << expected << " expected" << (passed ? "" : " FAILED") << std::endl;
+		if (!passed)
+			std::cout << report.str();
+
+		return passed;
+
+	}
+
+	/**
+	 * @brief Checks that a run written as CSV reads back the same.
+	 *
+	 * @returns True if the run read back has no regressions against itself. False otherwise.
+	 */
+	bool checkCSV() {
+
+		// Frames that alternate between two times, with and without GPU times.
+		bgq_opengl::Benchmark benchmark;
+		bgq_opengl::DrawStats draws{};
+		bgq_opengl::UniformStats uniforms{};
+		draws.draws = 4;
+		benchmark.beginCase("basic", "teapot", "field", "reflection");
+		for (int i = 0; i < 100; i++)
+			benchmark.addFrame(i % 2 == 0 ? 2.0 : 3.0, draws, uniforms, 1);
+		benchmark.endCase({});
+		benchmark.beginCase("basic", "teapot", "field", "fresnel");
+		for (int i = 0; i < 100; i++)
+			benchmark.addFrame(i % 2 == 0 ? 4.0 : 5.0, draws, uniforms, 1);
+		benchmark.endCase(std::vector<double>(100, 1.5));
+
+		std::string filename = "benchmark_test.csv";
+		std::vector<bgq_opengl::BenchmarkResult> results;
+		bool read = benchmark.writeCSV(filename) && bgq_opengl::Benchmark::readCSV(filename, &results);
+		std::remove(filename.c_str());
+
+		std::ostringstream report;
+		bool passed = read && results.size() == 2 && results[1].cpu.samples == 100 && results[1].cpu.mean == 4.5 && results[1].gpu.samples == 100 && results[1].draws == 4.0;
+		passed = passed && bgq_opengl::Benchmark::compare(results, benchmark.getResults(), T_THRESHOLD, report) == 0;
+		std::cout << "CSV round trip: " << (passed ? "passed" : "FAILED") << std::endl;
+
+		return passed;
+
+	}
+
+}
+
+int main() {
+
+	// Times as {samples, mean, median, p95, stddev}.
+	const bgq_opengl::TimeStats steady = {300, 10.0, 10.0, 10.8, 0.5};
+	const bgq_opengl::TimeStats steady_slower = {300, 11.0, 11.0, 11.8, 0.5};
+	const bgq_opengl::TimeStats steady_faster = {300, 9.0, 9.0, 9.8, 0.5};
+	const bgq_opengl::TimeStats steady_a_bit_slower = {300, 10.2, 10.2, 11.0, 0.5};
+	const bgq_opengl::TimeStats noisy = {10, 10.0, 9.0, 20.0, 5.0};
+	const bgq_opengl::TimeStats noisy_slower = {10, 11.0, 10.0, 21.0, 5.0};
+	const bgq_opengl::TimeStats exact = {300, 10.0, 10.0, 10.0, 0.0};
+	const bgq_opengl::TimeStats exact_slower = {300, 11.0, 11.0, 11.0, 0.0};
+	const bgq_opengl::TimeStats none = {0, 0.0, 0.0, 0.0, 0.0};
+
+	bool passed = true;
+	passed &= check("same times", makeResult("fresnel", steady, steady), makeResult("fresnel", steady, steady), 0);
+	passed &= check("10% slower CPU", makeResult("fresnel", steady, none), makeResult("fresnel", steady_slower, none), 1);
+	passed &= check("10% slower CPU and GPU", makeResult("fresnel", steady, steady), makeResult("fresnel", steady_slower, steady_slower), 2);
+	passed &= check("10% faster", makeResult("fresnel", steady, steady), makeResult("fresnel", steady_faster, steady_faster), 0);
+	passed &= check("2% slower", makeResult("fresnel", steady, steady), makeResult("fresnel", steady_a_bit_slower, steady_a_bit_slower), 0);
+	passed &= check("10% slower within the noise", makeResult("fresnel", noisy, none), makeResult("fresnel", noisy_slower, none), 0);
+	passed &= check("same times without noise", makeResult("fresnel", exact, none), makeResult("fresnel", exact, none), 0);
+	passed &= check("10% slower without noise", makeResult("fresnel", exact, none), makeResult("fresnel", exact_slower, none), 1);
+	passed &= check("GPU only measured now", makeResult("fresnel", steady, none), makeResult("fresnel", steady, steady_slower), 0);
+	passed &= check("case not in the baseline", makeResult("reflection", steady, steady), makeResult("fresnel", steady_slower, steady_slower), 0);
+	passed &= checkCSV();
+
+	std::cout << "Benchmark: " << (passed ? "passed" : "FAILED") << std::endl;
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
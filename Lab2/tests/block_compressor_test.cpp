@@ -0,0 +1,536 @@
+/**
+ * @file block_compressor_test.cpp
+ * @brief Round trip test of the BlockCompressor class.
+ * @version 1.0.0 (2022-10-21)
+ * @date 2022-10-21
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/block_compressor/block_compressor.h"
+
+namespace {
+
+	const int NUM_IMAGES = 6;
+
+	// Largest root mean square error of a channel, out of 255, for the solid, gradient, odd sized gradient, smooth,
+	// regions and noisy images. BC7 is measured with the alpha and BC1 without it.
+	const double BC1_MAX_ERRORS[NUM_IMAGES] = {2.5, 4.0, 4.0, 4.5, 12.5, 58.0};
+	const double BC7_MAX_ERRORS[NUM_IMAGES] = {1.0, 1.0, 1.0, 3.0, 2.5, 36.0};
+
+	/**
+	 * @brief Reads the bits of a block, from the lowest one.
+	 */
+	class BitReader {
+
+		public:
+
+			BitReader(const std::byte *input) : input(input) {}
+
+			uint32_t read(int bits) {
+
+				uint32_t value = 0;
+				for (int i = 0; i < bits; i++, this->position++)
+					value |= (uint32_t) ((std::to_integer<int>(this->input[this->position / 8]) >> (this->position % 8)) & 1) << i;
+
+				return value;
+
+			}
+
+		private:
+
+			const std::byte *input;
+			int position = 0;
+
+	};
+
+	/**
+	 * @brief Decodes a BC1 block.
+	 *
+	 * Decodes a block the way the hardware does, so that the test does not
+	 * depend on the code of the compressor.
+	 *
+	 * @param block The 8 bytes of the block.
+	 * @param pixels Outputs the 16 pixels, 4 bytes each.
+	 */
+	void decodeBC1(const std::byte *block, unsigned char *pixels) {
+
+		BitReader reader(block);
+		uint32_t endpoints[2] = {reader.read(16), reader.read(16)};
+
+		int palette[4][3];
+		for (int e = 0; e < 2; e++) {
+
+			int r = (endpoints[e] >> 11) & 31, g = (endpoints[e] >> 5) & 63, b = endpoints[e] & 31;
+			palette[e][0] = (r << 3) | (r >> 2);
+			palette[e][1] = (g << 2) | (g >> 4);
+			palette[e][2] = (b << 3) | (b >> 2);
+
+		}
+
+		for (int c = 0; c < 3; c++) {
+
+			// The order of the endpoints picks between four colours and three colours plus black.
+			if (endpoints[0] > endpoints[1]) {
+
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+
+			} else {
+
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+
+			}
+
+		}
+
+		for (int i = 0; i < 16; i++) {
+
+			uint32_t index = reader.read(2);
+			for (int c = 0; c < 3; c++)
+				pixels[i * 4 + c] = (unsigned char) palette[index][c];
+			pixels[i * 4 + 3] = 255;
+
+		}
+
+	}
+
+	/**
+	 * @brief Decodes a BC7 block in mode 1.
+	 *
+	 * @param reader The reader of the block, past the mode.
+	 * @param pixels Outputs the 16 pixels, 4 bytes each.
+	 */
+	void decodeBC7Mode1(BitReader &reader, unsigned char *pixels) {
+
+		static const int WEIGHTS[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+
+		// Subset of every pixel, one row of the table per partition.
+		static const char *PARTITIONS[64] = {
+			"0011001100110011", "0001000100010001", "0111011101110111", "0001001100110111", "0000000100010011", "0011011101111111", "0001001101111111", "0000000100110111",
+			"0000000000010011", "0011011111111111", "0000000101111111", "0000000000010111", "0001011111111111", "0000000011111111", "0000111111111111", "0000000000001111",
+			"0000100011101111", "0111000100000000", "0000000010001110", "0111001100010000", "0011000100000000", "0000100011001110", "0000000010001100", "0111001100110001",
+			"0011000100010000", "0000100010001100", "0110011001100110", "0011011001101100", "0001011111101000", "0000111111110000", "0111000110001110", "0011100110011100",
+			"0101010101010101", "0000111100001111", "0101101001011010", "0011001111001100", "0011110000111100", "0101010110101010", "0110100101101001", "0101101010100101",
+			"0111001111001110", "0001001111001000", "0011001001001100", "0011101111011100", "0110100110010110", "0011110011000011", "0110011010011001", "0000011001100000",
+			"0100111001000000", "0010011100100000", "0000001001110010", "0000010011100100", "0110110010010011", "0011011011001001", "0110001110011100", "0011100111000110",
+			"0110110011001001", "0110001100111001", "0111111010000001", "0001100011100111", "0000111100110011", "0011001111110000", "0010001011101110", "0100010001110111"
+		};
+		static const int ANCHORS[64] = {
+			15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+			15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+			15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+			6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15
+		};
+
+		int partition = (int) reader.read(6);
+
+		// The endpoints are stored channel by channel, the two of the first subset first.
+		int colors[4][4];
+		for (int c = 0; c < 3; c++)
+			for (int e = 0; e < 4; e++)
+				colors[e][c] = (int) reader.read(6) << 2;
+
+		// Every subset shares a low bit, and the 7 bits are widened to 8 by repeating the top one.
+		for (int s = 0; s < 2; s++) {
+
+			int low_bit = (int) reader.read(1);
+			for (int e = 2 * s; e < 2 * s + 2; e++) {
+
+				for (int c = 0; c < 3; c++)
+					colors[e][c] = colors[e][c] | (low_bit << 1) | (colors[e][c] >> 7);
+				colors[e][3] = 255;
+
+			}
+
+		}
+
+		for (int i = 0; i < 16; i++) {
+
+			// The anchors of both subsets leave out the top bit of their index, which is always 0.
+			int subset = PARTITIONS[partition][i] - '0';
+			int weight = WEIGHTS[reader.read(i == 0 || i == ANCHORS[partition] ? 2 : 3)];
+			for (int c = 0; c < 4; c++)
+				pixels[i * 4 + c] = (unsigned char) (((64 - weight) * colors[2 * subset][c] + weight * colors[2 * subset + 1][c] + 32) >> 6);
+
+		}
+
+	}
+
+	/**
+	 * @brief Decodes a BC7 block.
+	 *
+	 * Decodes a block the way the hardware does. Only modes 1 and 6 are
+	 * decoded, since they are the only ones the compressor writes.
+	 *
+	 * @param block The 16 bytes of the block.
+	 * @param pixels Outputs the 16 pixels, 4 bytes each.
+	 * @param mode Outputs the mode of the block.
+	 *
+	 * @returns True if the block is in mode 1 or 6. False otherwise.
+	 */
+	bool decodeBC7(const std::byte *block, unsigned char *pixels, int *mode) {
+
+		static const int WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		// The mode is the number of 0 bits before the first 1.
+		BitReader reader(block);
+		for (*mode = 0; *mode < 8 && reader.read(1) == 0; (*mode)++);
+
+		if (*mode == 1) {
+
+			decodeBC7Mode1(reader, pixels);
+			return true;
+
+		}
+
+		if (*mode != 6)
+			return false;
+
+		int colors[2][4];
+		for (int c = 0; c < 4; c++) {
+
+			colors[0][c] = (int) reader.read(7) << 1;
+			colors[1][c] = (int) reader.read(7) << 1;
+
+		}
+
+		for (int e = 0; e < 2; e++) {
+
+			int low_bit = (int) reader.read(1);
+			for (int c = 0; c < 4; c++)
+				colors[e][c] |= low_bit;
+
+		}
+
+		for (int i = 0; i < 16; i++) {
+
+			// The first index leaves out its top bit, which is always 0.
+			int weight = WEIGHTS[reader.read(i == 0 ? 3 : 4)];
+			for (int c = 0; c < 4; c++)
+				pixels[i * 4 + c] = (unsigned char) (((64 - weight) * colors[0][c] + weight * colors[1][c] + 32) >> 6);
+
+		}
+
+		return true;
+
+	}
+
+	/**
+	 * @brief Compresses an image, decodes it and measures the error.
+	 *
+	 * @param format The compressed format.
+	 * @param rgba The pixels of the image, 4 bytes each.
+	 * @param width The width of the image in pixels.
+	 * @param height The height of the image in pixels.
+	 * @param channels The number of channels compared, 3 to leave the alpha out.
+	 * @param error Outputs the root mean square error of a channel, out of 255.
+	 *
+	 * @returns True if the image could be compressed and decoded. False otherwise.
+	 */
+	bool roundTrip(GLenum format, const std::vector<unsigned char> &rgba, int width, int height, int channels, double *error) {
+
+		size_t block_bytes = format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? 8 : 16;
+		int blocks_x = (width + 3) / 4;
+		int blocks_y = (height + 3) / 4;
+		if (bgq_opengl::BlockCompressor::getCompressedSize(format, width, height) != (size_t) blocks_x * blocks_y * block_bytes) {
+
+			std::cerr << "Wrong compressed size of a " << width << "x" << height << " image." << std::endl;
+			return false;
+
+		}
+
+		std::vector<std::byte> blocks(bgq_opengl::BlockCompressor::getCompressedSize(format, width, height));
+		if (!bgq_opengl::BlockCompressor::compress(format, rgba.data(), width, height, blocks.data()))
+			return false;
+
+		double squared = 0.0;
+		unsigned char pixels[16 * 4];
+		for (int by = 0; by < blocks_y; by++) {
+
+			for (int bx = 0; bx < blocks_x; bx++) {
+
+				const std::byte *block = blocks.data() + ((size_t) by * blocks_x + bx) * block_bytes;
+				if (format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT) {
+
+					decodeBC1(block, pixels);
+
+				} else if (int mode; !decodeBC7(block, pixels, &mode)) {
+
+					std::cerr << "BC7 block " << bx << ", " << by << " is in mode " << mode << "." << std::endl;
+					return false;
+
+				}
+
+				// The pixels of the edge blocks past the image are not compared.
+				for (int i = 0; i < 16; i++) {
+
+					int x = bx * 4 + i % 4, y = by * 4 + i / 4;
+					if (x >= width || y >= height)
+						continue;
+
+					for (int c = 0; c < channels; c++) {
+
+						double difference = (double) pixels[i * 4 + c] - rgba[((size_t) y * width + x) * 4 + c];
+						squared += difference * difference;
+
+					}
+
+				}
+
+			}
+
+		}
+
+		*error = std::sqrt(squared / ((double) width * height * channels));
+
+		return true;
+
+	}
+
+	/**
+	 * @brief Builds a test image with the colours along a line.
+	 *
+	 * Every colour is a mix of the same two, which both formats can store with
+	 * little error.
+	 *
+	 * @param width The width of the image in pixels.
+	 * @param height The height of the image in pixels.
+	 *
+	 * @returns The pixels, 4 bytes each.
+	 */
+	std::vector<unsigned char> makeGradientImage(int width, int height) {
+
+		const int start[4] = {20, 200, 90, 255};
+		const int end[4] = {240, 30, 160, 64};
+
+		std::vector<unsigned char> rgba((size_t) width * height * 4);
+		for (int y = 0; y < height; y++) {
+
+			for (int x = 0; x < width; x++) {
+
+				double t = 0.5 + 0.5 * std::sin(x * 0.1 + y * 0.07);
+				for (int c = 0; c < 4; c++)
+					rgba[((size_t) y * width + x) * 4 + c] = (unsigned char) std::lround(start[c] + t * (end[c] - start[c]));
+
+			}
+
+		}
+
+		return rgba;
+
+	}
+
+	/**
+	 * @brief Builds a test image of solid blocks.
+	 *
+	 * @param width The width of the image in pixels.
+	 * @param height The height of the image in pixels.
+	 *
+	 * @returns The pixels, 4 bytes each, with one random colour per block.
+	 */
+	std::vector<unsigned char> makeSolidImage(int width, int height) {
+
+		std::mt19937 generator(42);
+		std::uniform_int_distribution<int> distribution(0, 255);
+		std::vector<unsigned char> colors((size_t) ((width + 3) / 4) * ((height + 3) / 4) * 4);
+		for (unsigned char &value : colors)
+			value = (unsigned char) distribution(generator);
+
+		std::vector<unsigned char> rgba((size_t) width * height * 4);
+		for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+				for (int c = 0; c < 4; c++)
+					rgba[((size_t) y * width + x) * 4 + c] = colors[((size_t) (y / 4) * ((width + 3) / 4) + x / 4) * 4 + c];
+
+		return rgba;
+
+	}
+
+	/**
+	 * @brief Builds a smooth test image.
+	 *
+	 * @param width The width of the image in pixels.
+	 * @param height The height of the image in pixels.
+	 *
+	 * @returns The pixels, 4 bytes each, with a gradient in every channel.
+	 */
+	std::vector<unsigned char> makeSmoothImage(int width, int height) {
+
+		std::vector<unsigned char> rgba((size_t) width * height * 4);
+		for (int y = 0; y < height; y++) {
+
+			for (int x = 0; x < width; x++) {
+
+				unsigned char *pixel = &rgba[((size_t) y * width + x) * 4];
+				pixel[0] = (unsigned char) (255 * x / std::max(width - 1, 1));
+				pixel[1] = (unsigned char) (255 * y / std::max(height - 1, 1));
+				pixel[2] = (unsigned char) (128 + 127 * std::sin((x + y) * 0.05));
+				pixel[3] = (unsigned char) (255 - pixel[0] / 2);
+
+			}
+
+		}
+
+		return rgba;
+
+	}
+
+	/**
+	 * @brief Builds a test image of flat regions.
+	 *
+	 * Every pixel takes the colour of the closest of a few random points, so
+	 * many blocks hold three colours, which do not fit a single line.
+	 *
+	 * @param width The width of the image in pixels.
+	 * @param height The height of the image in pixels.
+	 *
+	 * @returns The pixels, 4 bytes each, opaque.
+	 */
+	std::vector<unsigned char> makeRegionsImage(int width, int height) {
+
+		std::mt19937 generator(7);
+		std::uniform_int_distribution<int> distribution(0, 255);
+		std::vector<int> points(64 * 5);
+		for (size_t i = 0; i < points.size(); i += 5) {
+
+			points[i] = distribution(generator) * width / 256;
+			points[i + 1] = distribution(generator) * height / 256;
+			for (int c = 0; c < 3; c++)
+				points[i + 2 + c] = distribution(generator);
+
+		}
+
+		std::vector<unsigned char> rgba((size_t) width * height * 4);
+		for (int y = 0; y < height; y++) {
+
+			for (int x = 0; x < width; x++) {
+
+				size_t closest = 0;
+				int closest_distance = -1;
+				for (size_t i = 0; i < points.size(); i += 5) {
+
+					int distance = (x - points[i]) * (x - points[i]) + (y - points[i + 1]) * (y - points[i + 1]);
+					if (closest_distance < 0 || distance < closest_distance) {
+
+						closest = i;
+						closest_distance = distance;
+
+					}
+
+				}
+
+				unsigned char *pixel = &rgba[((size_t) y * width + x) * 4];
+				for (int c = 0; c < 3; c++)
+					pixel[c] = (unsigned char) points[closest + 2 + c];
+				pixel[3] = 255;
+
+			}
+
+		}
+
+		return rgba;
+
+	}
+
+	/**
+	 * @brief Builds a noisy test image.
+	 *
+	 * @param width The width of the image in pixels.
+	 * @param height The height of the image in pixels.
+	 *
+	 * @returns The pixels, 4 bytes each, with random colours and opaque, so that both formats are compared on the same channels.
+	 */
+	std::vector<unsigned char> makeNoisyImage(int width, int height) {
+
+		std::mt19937 generator(1234);
+		std::uniform_int_distribution<int> distribution(0, 255);
+		std::vector<unsigned char> rgba((size_t) width * height * 4);
+		for (size_t i = 0; i < rgba.size(); i++)
+			rgba[i] = i % 4 == 3 ? 255 : (unsigned char) distribution(generator);
+
+		return rgba;
+
+	}
+
+	/**
+	 * @brief Checks the error of a round trip against its limit.
+	 *
+	 * @param name The name of the case.
+	 * @param format The compressed format.
+	 * @param rgba The pixels of the image, 4 bytes each.
+	 * @param width The width of the image in pixels.
+	 * @param height The height of the image in pixels.
+	 * @param max_error The largest error allowed.
+	 * @param color_error Outputs the error of the colour alone, without the alpha.
+	 *
+	 * @returns True if the error is under the limit. False otherwise.
+	 */
+	bool check(const std::string &name, GLenum format, const std::vector<unsigned char> &rgba, int width, int height, double max_error, double *color_error) {
+
+		double error = 0.0;
+		int channels = format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? 3 : 4;
+		bool passed = roundTrip(format, rgba, width, height, channels, &error) && roundTrip(format, rgba, width, height, 3, color_error) && error <= max_error;
+		std::cout << name << ": error " << error << " (at most " << max_error << ")" << (passed ? "" : " FAILED") << std::endl;
+
+		return passed;
+
+	}
+
+}
+
+int main() {
+
+	bool passed = true;
+	if (bgq_opengl::BlockCompressor::isSupported(GL_RGBA) || !bgq_opengl::BlockCompressor::isSupported(GL_COMPRESSED_RGB_S3TC_DXT1_EXT) || !bgq_opengl::BlockCompressor::isSupported(GL_COMPRESSED_RGBA_BPTC_UNORM_ARB)) {
+
+		std::cerr << "Wrong supported formats." << std::endl;
+		passed = false;
+
+	}
+
+	// The odd size leaves partial blocks at the edges.
+	std::vector<unsigned char> images[NUM_IMAGES] = {makeSolidImage(64, 64), makeGradientImage(64, 64), makeGradientImage(37, 23), makeSmoothImage(64, 64), makeRegionsImage(64, 64), makeNoisyImage(64, 64)};
+	const char *names[NUM_IMAGES] = {"solid", "gradient", "gradient 37x23", "smooth", "regions", "noisy"};
+	const int sizes[NUM_IMAGES][2] = {{64, 64}, {64, 64}, {37, 23}, {64, 64}, {64, 64}, {64, 64}};
+	for (int i = 0; i < NUM_IMAGES; i++) {
+
+		double bc1_error = 0.0, bc7_error = 0.0;
+		passed &= check(std::string("BC1 ") + names[i], GL_COMPRESSED_RGB_S3TC_DXT1_EXT, images[i], sizes[i][0], sizes[i][1], BC1_MAX_ERRORS[i], &bc1_error);
+		passed &= check(std::string("BC7 ") + names[i], GL_COMPRESSED_RGBA_BPTC_UNORM_ARB, images[i], sizes[i][0], sizes[i][1], BC7_MAX_ERRORS[i], &bc7_error);
+
+		// BC7 takes twice the space, so its colours have to be at least as close.
+		if (bc7_error > bc1_error) {
+
+			std::cerr << "BC7 " << names[i] << " has a colour error of " << bc7_error << ", over the " << bc1_error << " of BC1." << std::endl;
+			passed = false;
+
+		}
+
+	}
+
+	std::cout << "BlockCompressor: " << (passed ? "passed" : "FAILED") << std::endl;
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
@@ -0,0 +1,188 @@
+/**
+ * @file concurrent_queue_test.cpp
+ * @brief Stress test of the ConcurrentQueue class.
+ * @version 1.0.0 (2022-10-21)
+ * @date 2022-10-21
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "classes/concurrent_queue/concurrent_queue.h"
+
+namespace {
+
+	const int PRODUCERS = 4;
+	const int CONSUMERS = 4;
+	const int ITEMS_PER_PRODUCER = 250000;
+
+	/**
+	 * @brief Checks the queue from a single thread.
+	 *
+	 * Fills the queue, empties it and goes around the ring a few times,
+	 * checking that the items come out in order and that a full or empty queue
+	 * refuses to push or pop.
+	 *
+	 * @returns True if the queue behaved. False otherwise.
+	 */
+	bool testSingleThread() {
+
+		// The capacity is rounded up to 8.
+		bgq_opengl::ConcurrentQueue<int> queue(5);
+		int item = 0;
+		if (queue.pop(&item)) {
+
+			std::cerr << "Popped an item from an empty queue." << std::endl;
+			return false;
+
+		}
+
+		int pushed = 0;
+		while (queue.push(pushed))
+			pushed++;
+
+		if (pushed != 8) {
+
+			std::cerr << "Pushed " << pushed << " items into a queue of 8." << std::endl;
+			return false;
+
+		}
+
+		for (int i = 0; i < pushed; i++) {
+
+			if (!queue.pop(&item) || item != i) {
+
+				std::cerr << "Popped item " << item << " when " << i << " was expected." << std::endl;
+				return false;
+
+			}
+
+		}
+
+		// Wrap around the ring with the queue half full.
+		for (int i = 0; i < 4; i++)
+			queue.push(i);
+
+		for (int i = 4; i < 100; i++) {
+
+			if (!queue.push(i) || !queue.pop(&item) || item != i - 4) {
+
+				std::cerr << "Lost the order after wrapping around at item " << i << "." << std::endl;
+				return false;
+
+			}
+
+		}
+
+		return true;
+
+	}
+
+	/**
+	 * @brief Checks the queue from several threads at once.
+	 *
+	 * Several producers push their own items into a small queue while several
+	 * consumers pop them. Every item has to be popped exactly once, and every
+	 * consumer has to see the items of each producer in the order they were
+	 * pushed.
+	 *
+	 * @returns True if the queue behaved. False otherwise.
+	 */
+	bool testStress() {
+
+		// Small enough to be full and empty all the time.
+		bgq_opengl::ConcurrentQueue<int> queue(64);
+		const int total = PRODUCERS * ITEMS_PER_PRODUCER;
+		std::vector<std::atomic<int>> seen(total);
+		std::atomic<int> popped{0};
+		std::atomic<bool> out_of_order{false};
+
+		std::vector<std::thread> threads;
+		for (int p = 0; p < PRODUCERS; p++) {
+
+			threads.emplace_back([&queue, p]() {
+
+				for (int i = 0; i < ITEMS_PER_PRODUCER; i++)
+					while (!queue.push(p * ITEMS_PER_PRODUCER + i))
+						std::this_thread::yield();
+
+			});
+
+		}
+
+		for (int c = 0; c < CONSUMERS; c++) {
+
+			threads.emplace_back([&]() {
+
+				std::vector<int> last(PRODUCERS, -1);
+				while (popped.load(std::memory_order_relaxed) < total) {
+
+					int item = 0;
+					if (!queue.pop(&item)) {
+
+						std::this_thread::yield();
+						continue;
+
+					}
+
+					int producer = item / ITEMS_PER_PRODUCER;
+					if (item <= last[producer])
+						out_of_order.store(true);
+					last[producer] = item;
+
+					seen[item].fetch_add(1, std::memory_order_relaxed);
+					popped.fetch_add(1, std::memory_order_relaxed);
+
+				}
+
+			});
+
+		}
+
+		for (std::thread &thread : threads)
+			thread.join();
+
+		if (out_of_order.load()) {
+
+			std::cerr << "A consumer saw the items of a producer out of order." << std::endl;
+			return false;
+
+		}
+
+		for (int i = 0; i < total; i++) {
+
+			if (seen[i].load() != 1) {
+
+				std::cerr << "Item " << i << " was popped " << seen[i].load() << " times." << std::endl;
+				return false;
+
+			}
+
+		}
+
+		return true;
+
+	}
+
+}
+
+int main() {
+
+	bool passed = testSingleThread() && testStress();
+	std::cout << "ConcurrentQueue: " << (passed ? "passed" : "FAILED") << std::endl;
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}